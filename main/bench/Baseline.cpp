@@ -0,0 +1,130 @@
+/*
+ * Baseline.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "Baseline.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// Value of "key" within one JSON object: strings without quotes, numbers as
+// text. Sufficient for the flat run objects of Google Benchmark.
+bool findValue(const std::string &object, const std::string &key, std::string &value) {
+    std::string quoted = "\"" + key + "\"";
+    size_t pos = object.find(quoted);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    pos = object.find(':', pos + quoted.size());
+    if (pos == std::string::npos) {
+        return false;
+    }
+    pos = object.find_first_not_of(" \t\r\n", pos + 1);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    if (object[pos] == '"') {
+        size_t end = object.find('"', pos + 1);
+        if (end == std::string::npos) {
+            return false;
+        }
+        value = object.substr(pos + 1, end - pos - 1);
+    } else {
+        size_t end = object.find_first_of(", \t\r\n}", pos);
+        value = object.substr(pos, end - pos);
+    }
+    return true;
+}
+
+double nanosecondsPer(const std::string &unit) {
+    if (unit == "us") {
+        return 1e3;
+    } else if (unit == "ms") {
+        return 1e6;
+    } else if (unit == "s") {
+        return 1e9;
+    }
+    return 1.0;
+}
+
+}
+
+bool Baseline::load(const std::string &path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::stringstream ss;
+    ss << in.rdbuf();
+    std::string text = ss.str();
+
+    size_t pos = text.find("\"benchmarks\"");
+    if (pos == std::string::npos) {
+        return false;
+    }
+    while ((pos = text.find('{', pos)) != std::string::npos) {
+        size_t end = text.find('}', pos);
+        if (end == std::string::npos) {
+            break;
+        }
+        std::string object = text.substr(pos, end - pos);
+        std::string name, realTime, unit = "ns";
+        if (findValue(object, "name", name) && findValue(object, "real_time", realTime)) {
+            findValue(object, "time_unit", unit);
+            try {
+                entries[name] = std::stod(realTime) * nanosecondsPer(unit);
+            } catch (const std::logic_error &) {
+                // not a number -> entry ignored
+            }
+        }
+        pos = end + 1;
+    }
+    return !entries.empty();
+}
+
+bool Baseline::save(const std::string &path) const {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        return false;
+    }
+    out << "{\n  \"benchmarks\": [\n" << std::setprecision(6);
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        out << "    {\"name\": \"" << it->first << "\", \"real_time\": " << it->second
+            << ", \"time_unit\": \"ns\"}" << (std::next(it) == entries.end() ? "\n" : ",\n");
+    }
+    out << "  ]\n}\n";
+    return out.good();
+}
+
+int Baseline::compare(const Baseline &baseline, double threshold, std::ostream &out) const {
+    int regressions = 0;
+    out << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(14)
+        << "Baseline [ns]" << std::setw(14) << "Current [ns]" << std::setw(10) << "Change"
+        << std::endl;
+    out << std::fixed;
+    for (const auto &entry : entries) {
+        out << std::left << std::setw(48) << entry.first << std::right;
+        auto base = baseline.entries.find(entry.first);
+        if (base == baseline.entries.end() || base->second <= 0.0) {
+            out << std::setw(14) << "-" << std::setw(14) << std::setprecision(1) << entry.second
+                << std::setw(10) << "new" << std::endl;
+            continue;
+        }
+        double change = entry.second / base->second - 1.0;
+        out << std::setw(14) << std::setprecision(1) << base->second << std::setw(14)
+            << entry.second << std::setw(9) << std::showpos << change * 100.0 << '%'
+            << std::noshowpos;
+        if (change > threshold) {
+            out << "  REGRESSION";
+            regressions++;
+        }
+        out << std::endl;
+    }
+    return regressions;
+}
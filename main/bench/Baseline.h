@@ -0,0 +1,45 @@
+/*
+ * Baseline.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include <map>
+#include <ostream>
+#include <string>
+
+/**
+ * Time per iteration of each benchmark [ns] (wall clock, the round trips
+ * wait for other threads), stored as JSON.
+ *
+ * The file format is the "benchmarks" array of Google Benchmark
+ * (--benchmark_out), reduced to name, real_time and time_unit. Files written
+ * by --benchmark_out can be loaded as well.
+ */
+class Baseline {
+  public:
+    void set(const std::string &name, double timeNs) { entries[name] = timeNs; }
+
+    bool empty() const { return entries.empty(); }
+
+    /**
+     * @return true if the file was read and contains at least one benchmark
+     */
+    bool load(const std::string &path);
+
+    bool save(const std::string &path) const;
+
+    /**
+     * Prints one line per benchmark of this run and its change against the
+     * baseline. Benchmarks missing in the baseline are listed as new.
+     *
+     * @param threshold allowed increase of the time, 0.2 = 20 %
+     * @return number of benchmarks slower than the baseline by more than
+     *         threshold
+     */
+    int compare(const Baseline &baseline, double threshold, std::ostream &out) const;
+
+  private:
+    std::map<std::string, double> entries;
+};
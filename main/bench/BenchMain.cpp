@@ -0,0 +1,118 @@
+/*
+ * BenchMain.cpp
+ *
+ *  Created on: 19.10.2026
+ *
+ * Runs the microbenchmarks of bench/ (Google Benchmark). In addition to the
+ * options of Google Benchmark (e.g. --benchmark_filter, --benchmark_out):
+ *
+ *   --baseline=<file>       compare the times with a stored baseline,
+ *                           exit code 1 on regressions
+ *   --threshold=<percent>   allowed increase against the baseline (20)
+ *   --save-baseline=<file>  store the times of this run as baseline
+ */
+#include "Baseline.h"
+#include "logger/logger.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// Console output as usual, collects the time of each benchmark
+class CollectingReporter : public benchmark::ConsoleReporter {
+  public:
+    Baseline results;
+
+    CollectingReporter() : ConsoleReporter(isatty(STDOUT_FILENO) ? OO_Defaults : OO_Tabular) {}
+
+    void ReportRuns(const std::vector<Run> &runs) override {
+        for (const Run &run : runs) {
+            // single run or median of the repetitions
+            bool single = run.run_type == Run::RT_Iteration && run.repetitions <= 1;
+            bool median = run.run_type == Run::RT_Aggregate && run.aggregate_name == "median";
+            if (!run.error_occurred && (single || median)) {
+                results.set(run.run_name.str(),
+                            run.GetAdjustedRealTime() * nanosecondsPer(run.time_unit));
+            }
+        }
+        ConsoleReporter::ReportRuns(runs);
+    }
+
+  private:
+    static double nanosecondsPer(benchmark::TimeUnit unit) {
+        switch (unit) {
+        case benchmark::kMicrosecond:
+            return 1e3;
+        case benchmark::kMillisecond:
+            return 1e6;
+        case benchmark::kSecond:
+            return 1e9;
+        default:
+            return 1.0;
+        }
+    }
+};
+
+// Removes "--<name>=<value>" from the arguments
+bool takeOption(int &argc, char **argv, const char *name, std::string &value) {
+    std::string prefix = std::string("--") + name + "=";
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], prefix.c_str(), prefix.size()) == 0) {
+            value = argv[i] + prefix.size();
+            for (int j = i; j < argc - 1; j++) {
+                argv[j] = argv[j + 1];
+            }
+            argc--;
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+int main(int argc, char **argv) {
+    std::string baselinePath, savePath, threshold = "20";
+    takeOption(argc, argv, "baseline", baselinePath);
+    takeOption(argc, argv, "save-baseline", savePath);
+    takeOption(argc, argv, "threshold", threshold);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return EXIT_FAILURE;
+    }
+    // Messages of the measured components would mix with the results
+    Logger::set_level(Logger::level::ERR);
+
+    CollectingReporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+
+    if (!savePath.empty() && !reporter.results.save(savePath)) {
+        std::cerr << "Failed to write baseline " << savePath << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (baselinePath.empty()) {
+        return EXIT_SUCCESS;
+    }
+    Baseline baseline;
+    if (!baseline.load(baselinePath)) {
+        std::cerr << "Failed to read baseline " << baselinePath << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << std::endl;
+    int regressions = reporter.results.compare(baseline, std::atof(threshold.c_str()) / 100.0,
+                                               std::cout);
+    if (regressions > 0) {
+        std::cout << regressions << " benchmark(s) slower than the baseline by more than "
+                  << threshold << " %" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+/*
+ * Bench_Events.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "configuration/Configuration.h"
+#include "events/EventManager.h"
+#include "events/EventSender.h"
+
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Service of the partner system, receives and drops the forwarded events
+class PartnerService {
+  public:
+    PartnerService() {
+        const char *name = Configuration::getInstance().systemIsMaster() ? ATTACH_POINT_LOCAL_S
+                                                                         : ATTACH_POINT_LOCAL_M;
+        attach = name_attach(NULL, name, NAME_FLAG_ATTACH_GLOBAL);
+        if (attach != nullptr) {
+            receiver = std::thread([this]() {
+                _pulse pulse;
+                while (MsgReceivePulse(attach->chid, &pulse, sizeof(pulse), NULL) != -1) {
+                }
+            });
+        }
+    }
+
+    ~PartnerService() {
+        if (attach != nullptr) {
+            name_detach(attach, 0);
+            receiver.join();
+        }
+    }
+
+    bool attached() const { return attach != nullptr; }
+
+  private:
+    name_attach_t *attach;
+    std::thread receiver;
+};
+
+}
+
+// Synchronous dispatch to the subscribers of one event type
+static void BM_EventManager_HandleEvent(benchmark::State &state) {
+    EventManager manager;
+    int64_t nCalls = 0;
+    for (int i = 0; i < state.range(0); i++) {
+        manager.subscribe(EventType::LBA_M_BLOCKED, [&nCalls](Event) { nCalls++; });
+    }
+    manager.subscribe(EventMask::range(EventType::LBA_M_BLOCKED, EventType::LBR_M_UNBLOCKED),
+                      [&nCalls](Event) { nCalls++; });
+    Event event{EventType::LBA_M_BLOCKED, 0};
+    for (auto _ : state) {
+        manager.handleEvent(event);
+    }
+    benchmark::DoNotOptimize(nCalls);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventManager_HandleEvent)->Arg(1)->Arg(8);
+
+// Pulse to the EventManager, receiver thread, priority queue, dispatcher
+// thread and back to the subscriber
+static void BM_EventSender_RoundTrip(benchmark::State &state) {
+    PartnerService partner;
+    if (!partner.attached()) {
+        state.SkipWithError("name_attach of the partner service failed");
+        return;
+    }
+    auto manager = std::make_shared<EventManager>();
+    std::mutex mtx;
+    std::condition_variable cv;
+    int received = 0;
+    manager->subscribe(EventType::LBA_M_BLOCKED, [&](Event) {
+        std::lock_guard<std::mutex> lock(mtx);
+        received++;
+        cv.notify_one();
+    });
+    manager->start();
+    EventSender sender;
+    sender.connect(manager);
+
+    int sent = 0;
+    for (auto _ : state) {
+        sender.sendEvent(Event{EventType::LBA_M_BLOCKED, sent});
+        sent++;
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&]() { return received == sent; });
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    sender.disconnect();
+    manager->stop();
+}
+BENCHMARK(BM_EventSender_RoundTrip)->UseRealTime();
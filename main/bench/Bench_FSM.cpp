@@ -0,0 +1,39 @@
+/*
+ * Bench_FSM.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "configuration/Configuration.h"
+#include "events/EventManager.h"
+#include "events/IEventSender.h"
+#include "logic/main_fsm/MainContext.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+
+namespace {
+
+// Drops the events of the actions, the FSM is benchmarked alone
+class NullSender : public IEventSender {
+  public:
+    bool connect(std::shared_ptr<IEventManager> evm) override { return true; }
+    void disconnect() override {}
+    bool sendEvent(Event event) override { return true; }
+};
+
+}
+
+// Standby -> ServiceMode -> Standby, includes creating the substate of
+// ServiceMode
+static void BM_MainContext_Transitions(benchmark::State &state) {
+    Configuration::getInstance().setDesiredWorkpieceOrder({WS_F, WS_BOM, WS_OB});
+    Configuration::getInstance().setOffsetCalibration(3600);
+    Configuration::getInstance().setReferenceCalibration(2500);
+    MainContext fsm(new MainActions(std::make_shared<EventManager>(), new NullSender()));
+    for (auto _ : state) {
+        fsm.handleEvent(Event{EventType::START_M_LONG});
+        fsm.handleEvent(Event{EventType::STOP_M_SHORT});
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_MainContext_Transitions);
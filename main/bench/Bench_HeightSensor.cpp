@@ -0,0 +1,52 @@
+/*
+ * Bench_HeightSensor.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "events/EventManager.h"
+#include "hal/HeightSensor.h"
+#include "logic/hm/HeightContextData.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+
+// One ADC sample: the measure thread adds each sample to the window and
+// takes the median of every full window
+static void BM_HeightSensor_AddValue(benchmark::State &state) {
+    HeightSensor sensor(std::make_shared<EventManager>());
+    int value = 2500;
+    for (auto _ : state) {
+        sensor.addValue(value);
+        value = 2500 + (value * 7 + 13) % 1100;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HeightSensor_AddValue);
+
+static void BM_HeightSensor_GetMedianHeight(benchmark::State &state) {
+    HeightSensor sensor(std::make_shared<EventManager>());
+    int value = 2500;
+    for (auto _ : state) {
+        // the window is sorted by getMedianHeight(), refill it unsorted
+        state.PauseTiming();
+        for (int i = 0; i < ADC_SAMPLE_SIZE; i++) {
+            sensor.addValue(value);
+            value = 2500 + (value * 7 + 13) % 1100;
+        }
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(sensor.getMedianHeight());
+    }
+}
+BENCHMARK(BM_HeightSensor_GetMedianHeight);
+
+// Result of a workpiece with the given number of height values
+static void BM_HeightContextData_GetCurrentResult(benchmark::State &state) {
+    HeightContextData data;
+    for (int i = 0; i < state.range(0); i++) {
+        data.addValue(20.0f + (i % 7) * 0.5f);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(data.getCurrentResult());
+    }
+}
+BENCHMARK(BM_HeightContextData_GetCurrentResult)->Arg(20)->Arg(200);
@@ -0,0 +1,41 @@
+/*
+ * Bench_Logger.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "logger/logger.hpp"
+
+#include <benchmark/benchmark.h>
+#include <iostream>
+#include <sstream>
+
+// Message below the log level, e.g. the debug messages of each event
+static void BM_Logger_Suppressed(benchmark::State &state) {
+    Logger::set_level(Logger::level::INFO);
+    for (auto _ : state) {
+        Logger::debug("[EventManager] handleEvent: LBA_M_BLOCKED");
+    }
+    Logger::set_level(Logger::level::ERR);
+}
+BENCHMARK(BM_Logger_Suppressed);
+
+// Formatted message on the console (discarded)
+static void BM_Logger_Console(benchmark::State &state) {
+    std::ostringstream sink;
+    std::streambuf *console = std::cout.rdbuf(sink.rdbuf());
+    Logger::set_level(Logger::level::INFO);
+    for (auto _ : state) {
+        Logger::info("[EventManager] handleEvent: LBA_M_BLOCKED");
+        sink.str("");
+    }
+    Logger::set_level(Logger::level::ERR);
+    std::cout.rdbuf(console);
+}
+BENCHMARK(BM_Logger_Console);
+
+static void BM_Logger_File(benchmark::State &state) {
+    for (auto _ : state) {
+        Logger::to_file("hm_value: 21.50 mm");
+    }
+}
+BENCHMARK(BM_Logger_File);
@@ -0,0 +1,33 @@
+/*
+ * Bench_Metrics.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "metrics/Metrics.h"
+
+#include <benchmark/benchmark.h>
+
+// Shared counter, e.g. events of one type dispatched by several threads
+static void BM_Metrics_CounterInc(benchmark::State &state) {
+    static Counter &counter = MetricsRegistry::getInstance().counter("esep_bench_total");
+    for (auto _ : state) {
+        counter.inc();
+    }
+}
+BENCHMARK(BM_Metrics_CounterInc)->Threads(1)->Threads(4);
+
+static void BM_Metrics_HistogramRecord(benchmark::State &state) {
+    static Histogram &histogram = MetricsRegistry::getInstance().histogram("esep_bench_us");
+    uint64_t value = 0;
+    for (auto _ : state) {
+        histogram.record(value++ & 0xfff);
+    }
+}
+BENCHMARK(BM_Metrics_HistogramRecord);
+
+static void BM_Metrics_Snapshot(benchmark::State &state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MetricsRegistry::getInstance().snapshot());
+    }
+}
+BENCHMARK(BM_Metrics_Snapshot);
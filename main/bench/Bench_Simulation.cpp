@@ -0,0 +1,116 @@
+/*
+ * Bench_Simulation.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "simheightprofile.h"
+#include "simitemhandling.h"
+#include "simitemhandlingaction.h"
+#include "simmasks.h"
+#include "simreport.h"
+#include "simulation.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+static void BM_SimJSON_ParseItemAction(benchmark::State &state) {
+    const std::string message = "{\"type\":\"itemaction\", \"atTime\": 1200, \"action\": \"add\", "
+            "\"kind\": \"metalup\", \"x\": 20.5, \"y\": 60.0, \"f\": false, \"sticky\": true}";
+    SimItemHandlingAction action;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(action.parseJSON(message.data(), message.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * message.size());
+}
+BENCHMARK(BM_SimJSON_ParseItemAction);
+
+// One simulation cycle (doSimulationCycle() through simulateTime()) with the
+// given number of items spread over the belt. The belt changes its
+// direction every second, so the items stay on it.
+static void BM_Simulation_Cycle(benchmark::State &state) {
+    SimItemHandling handling;
+    for (int i = 0; i < state.range(0); i++) {
+        SimItemHandlingAction action(0, ItemKinds::flat);
+        action.x = 20.0 + (600.0 * i) / state.range(0);
+        handling.addAction(action);
+    }
+    Simulation sim(&handling);
+    sim.simulateTime(SimulationBase::timeslice);   // add items
+    unsigned short direction = SIM_DRIVE_DIRECTION_RIGHT;
+    sim.writeOut(direction);
+    unsigned int cycle = 0;
+    for (auto _ : state) {
+        sim.simulateTime(SimulationBase::timeslice);
+        if (++cycle * SimulationBase::timeslice % 1000 == 0) {
+            direction ^= SIM_DRIVE_DIRECTION_RIGHT | SIM_DRIVE_DIRECTION_LEFT;
+            sim.writeOut(direction);
+        }
+    }
+}
+BENCHMARK(BM_Simulation_Cycle)->Arg(1)->Arg(100);
+
+// One simulated second with the given number of items, timeslice [ms] and
+// sub-step [ms] (0: none). Sub-steps only around the sensors, 100 items are
+// always close to one.
+static void BM_Simulation_Second(benchmark::State &state) {
+    SimItemHandling handling;
+    for (int i = 0; i < state.range(0); i++) {
+        SimItemHandlingAction action(0, ItemKinds::flat);
+        action.x = 20.0 + (600.0 * i) / state.range(0);
+        handling.addAction(action);
+    }
+    Simulation sim(&handling);
+    sim.setTimeslice(state.range(1));
+    sim.setSubstep(state.range(2));
+    sim.simulateTime(sim.getTimeslice());   // add items
+    unsigned short direction = SIM_DRIVE_DIRECTION_RIGHT;
+    for (auto _ : state) {
+        sim.writeOut(direction);
+        sim.simulateTime(1000);
+        direction ^= SIM_DRIVE_DIRECTION_RIGHT | SIM_DRIVE_DIRECTION_LEFT;
+    }
+}
+BENCHMARK(BM_Simulation_Second)
+        ->Args({1, 20, 0})->Args({1, 5, 0})->Args({1, 1, 0})->Args({1, 20, 1})
+        ->Args({100, 20, 0})->Args({100, 5, 0})->Args({100, 1, 0})->Args({100, 20, 1})
+        ->Unit(benchmark::kMicrosecond);
+
+// Height and ADC value of an item under the height sensor, looked up in the
+// tables generated at compile time
+static void BM_SimHeightProfile_Lookup(benchmark::State &state) {
+    int i = 0;
+    for (auto _ : state) {
+        ItemKinds kind = static_cast<ItemKinds>(i % SIM_HEIGHT_KINDS);
+        double x = -32.0 + (i % 6400) * 0.01;
+        benchmark::DoNotOptimize(SimHeightProfile::adc(kind, x));
+        benchmark::DoNotOptimize(SimHeightProfile::height(kind, x));
+        i++;
+    }
+}
+BENCHMARK(BM_SimHeightProfile_Lookup);
+
+// Binary delta report of 100 moving items, encoded once per cycle
+static void BM_SimReport_Encode(benchmark::State &state) {
+    SimItemHandling handling;
+    for (int i = 0; i < 100; i++) {
+        SimItemHandlingAction action(0, ItemKinds::flat);
+        action.x = 20.0 + 6.0 * i;
+        handling.addAction(action);
+    }
+    Simulation sim(&handling);
+    sim.simulateTime(SimulationBase::timeslice);   // add items
+    sim.writeOut(SIM_DRIVE_DIRECTION_RIGHT);
+    SimReportEncoder encoder('A', 'F', SimulationBase::itemCapacity);
+    SimulationIOImage image;
+    unsigned int cycle = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        sim.simulateTime(SimulationBase::timeslice);   // items move between the reports
+        if (++cycle % 25 == 0) {
+            sim.writeOut(cycle % 50 == 0 ? SIM_DRIVE_DIRECTION_RIGHT : SIM_DRIVE_DIRECTION_LEFT);
+        }
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(encoder.encode(sim.currentSimTime(), image, sim.getItems()));
+    }
+}
+BENCHMARK(BM_SimReport_Encode);
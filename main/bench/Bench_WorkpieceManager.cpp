@@ -0,0 +1,57 @@
+/*
+ * Bench_WorkpieceManager.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "data/WorkpieceManager.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void deleteWorkpieces(WorkpieceManager &wpm) {
+    for (AreaType area : {AreaType::AREA_A, AreaType::AREA_B, AreaType::AREA_C, AreaType::AREA_D}) {
+        while (Workpiece *wp = wpm.removeFromArea(area)) {
+            delete wp;
+        }
+    }
+}
+
+}
+
+// A workpiece passes all areas of both systems while the given number of
+// workpieces is in each area
+static void BM_WorkpieceManager_MoveAreas(benchmark::State &state) {
+    WorkpieceManager wpm;
+    for (int i = 0; i < state.range(0); i++) {
+        wpm.addWorkpiece();
+        wpm.addToArea(AreaType::AREA_B, new Workpiece());
+        wpm.addToArea(AreaType::AREA_C, new Workpiece());
+        wpm.addToArea(AreaType::AREA_D, new Workpiece());
+    }
+    for (auto _ : state) {
+        wpm.moveFromAreaToArea(AreaType::AREA_A, AreaType::AREA_B);
+        wpm.moveFromAreaToArea(AreaType::AREA_B, AreaType::AREA_C);
+        wpm.moveFromAreaToArea(AreaType::AREA_C, AreaType::AREA_D);
+        wpm.moveFromAreaToArea(AreaType::AREA_D, AreaType::AREA_A);
+    }
+    state.SetItemsProcessed(state.iterations() * 4);
+    deleteWorkpieces(wpm);
+}
+BENCHMARK(BM_WorkpieceManager_MoveAreas)->Arg(1)->Arg(10);
+
+// Removal of a workpiece from the middle of an area (sorted out, flipped)
+static void BM_WorkpieceManager_RemoveFromArea(benchmark::State &state) {
+    WorkpieceManager wpm;
+    for (int i = 0; i < state.range(0); i++) {
+        wpm.addWorkpiece();
+    }
+    for (auto _ : state) {
+        Workpiece *wp = wpm.addWorkpiece();
+        wpm.moveFromAreaToArea(AreaType::AREA_A, AreaType::AREA_A);
+        wpm.removeFromArea(AreaType::AREA_A, wp);
+        delete wp;
+    }
+    deleteWorkpieces(wpm);
+}
+BENCHMARK(BM_WorkpieceManager_RemoveFromArea)->Arg(1)->Arg(10);
@@ -0,0 +1,238 @@
+/*
+ * LineHal.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "LineHal.h"
+
+#include <algorithm>
+
+#include "hal/Sensors.h"
+#include "logger/logger.hpp"
+
+LineHeightSensor::LineHeightSensor() {
+    window.reserve(ADC_SAMPLE_SIZE);
+    Calibration cal = Configuration::getInstance().getCalibration();
+    calibrateOffset(cal.calOffset);
+    calibrateRefHigh(cal.calRef);
+}
+
+void LineHeightSensor::registerOnNewValueCallback(HeightCallback callback) {
+    heightValueCallback = callback;
+}
+
+void LineHeightSensor::unregisterOnNewValueCallback() { heightValueCallback = nullptr; }
+
+void LineHeightSensor::start() { running = true; }
+
+void LineHeightSensor::stop() { running = false; }
+
+void LineHeightSensor::addValue(int value) {
+    if (!running) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_cal);
+        if (window.size() == ADC_SAMPLE_SIZE) {
+            window.erase(window.begin());
+        }
+        window.push_back(value);
+    }
+    if (++nMeasurements == ADC_SAMPLE_SIZE) {
+        nMeasurements = 0;
+        if (heightValueCallback != nullptr) {
+            heightValueCallback(getMedianHeight());
+        }
+    }
+}
+
+float LineHeightSensor::adcValueToMillimeter(int adcValue) {
+    float mm = (float) (adcOffset - adcValue) / adcIncPerMillimeter;
+    return mm < 0 ? 0.0 : mm;
+}
+
+float LineHeightSensor::getAverageHeight() {
+    std::lock_guard<std::mutex> lock(mutex_cal);
+    if (window.empty()) {
+        return 0.0;
+    }
+    long sum = 0;
+    for (int value : window) {
+        sum += value;
+    }
+    return adcValueToMillimeter(sum / window.size());
+}
+
+float LineHeightSensor::getMaxHeight() {
+    std::lock_guard<std::mutex> lock(mutex_cal);
+    if (window.empty()) {
+        return 0.0;
+    }
+    // the highest item has the lowest ADC value
+    return adcValueToMillimeter(*std::min_element(window.begin(), window.end()));
+}
+
+float LineHeightSensor::getMedianHeight() {
+    std::lock_guard<std::mutex> lock(mutex_cal);
+    if (window.empty()) {
+        return 0.0;
+    }
+    std::vector<int> sorted(window);
+    std::sort(sorted.begin(), sorted.end());
+    size_t size = sorted.size();
+    int median = size % 2 == 0 ? (sorted[size / 2 - 1] + sorted[size / 2]) / 2 : sorted[size / 2];
+    return adcValueToMillimeter(median);
+}
+
+int LineHeightSensor::getLastRawValue() {
+    std::lock_guard<std::mutex> lock(mutex_cal);
+    return window.empty() ? 0 : window.back();
+}
+
+LineSensors::LineSensors(std::shared_ptr<EventManager> mngr, Simulation &sim)
+    : in(sim.readIn()) {
+    if (!connect(mngr)) {
+        Logger::error("[LineSensors] Error while connecting to EventManager");
+    }
+    // as Sensors: E-Stop and ramp already active
+    if ((in & SIM_EMERGENCY_STOP) == 0) {
+        send(EventType::ESTOP_S_PRESSED);
+    }
+    if (lbRampBlocked()) {
+        send(EventType::LBR_S_BLOCKED);
+    }
+}
+
+void LineSensors::cycleCompletedWith(unsigned long simulationtime, const SimulationIOImage &result,
+                                     unsigned short ADCRaw) {
+    unsigned short changed = in ^ result.in;
+    in = result.in;
+    if (changed == 0) {
+        return;
+    }
+    // same precedence as the interrupt handler of Sensors
+    if (changed & SIM_EMERGENCY_STOP) {
+        send((in & SIM_EMERGENCY_STOP) == 0 ? EventType::ESTOP_S_PRESSED
+                                            : EventType::ESTOP_S_RELEASED);
+    }
+    if (changed & SIM_BUTTON_START) {
+        if (in & SIM_BUTTON_START) {
+            startPressedAt = simulationtime;
+        } else {
+            send(simulationtime - startPressedAt >= BTN_LONG_PRESSED_TIME_MS
+                     ? EventType::START_S_LONG
+                     : EventType::START_S_SHORT);
+        }
+    }
+    if ((changed & SIM_BUTTON_STOP) && (in & SIM_BUTTON_STOP)) {
+        send(EventType::STOP_S_SHORT);
+    }
+    if (changed & SIM_BUTTON_RESET) {
+        if (in & SIM_BUTTON_RESET) {
+            resetPressedAt = simulationtime;
+        } else {
+            send(simulationtime - resetPressedAt >= BTN_LONG_PRESSED_TIME_MS
+                     ? EventType::RESET_S_LONG
+                     : EventType::RESET_S_SHORT);
+        }
+    }
+    barrier(changed, SIM_ITEM_DETECTED, EventType::LBA_S_BLOCKED, EventType::LBA_S_UNBLOCKED);
+    barrier(changed, SIM_ITEM_AT_JUNCTION, EventType::LBW_S_BLOCKED, EventType::LBW_S_UNBLOCKED);
+    barrier(changed, SIM_ITEM_AT_END, EventType::LBE_S_BLOCKED, EventType::LBE_S_UNBLOCKED);
+    barrier(changed, SIM_BUFFER_IS_FULL, EventType::LBR_S_BLOCKED, EventType::LBR_S_UNBLOCKED);
+    if ((changed & SIM_ITEM_IS_METTAL) && (in & SIM_ITEM_IS_METTAL)) {
+        send(EventType::MD_S_PAYLOAD, 1);
+    }
+}
+
+void LineSensors::send(EventType type, int data) {
+    Event event{type, data};
+    event.traceId = Tracer::getInstance().newTrace();
+    sendEvent(event);
+}
+
+void LineSensors::barrier(unsigned short changed, unsigned short mask, EventType blocked,
+                          EventType unblocked) {
+    if (changed & mask) {
+        // light barriers are active low
+        send((in & mask) == 0 ? blocked : unblocked);
+    }
+}
+
+LineActuators::LineActuators(std::shared_ptr<EventManager> mngr, Simulation &sim)
+    : IActuators(mngr), sim(sim) {}
+
+void LineActuators::set(unsigned short mask, bool on) {
+    std::lock_guard<std::mutex> lock(mtx);
+    out = on ? out | mask : out & ~mask;
+    sim.writeOut(out);
+}
+
+void LineActuators::standbyMode() {
+    allOff();
+    closeSwitch();
+    startLedOn();
+}
+
+void LineActuators::runningMode() {
+    redLampOff();
+    yellowLampOff();
+    greenLampOn();
+    startLedOff();
+    resetLedOff();
+    q1LedOff();
+    q2LedOff();
+    set(SIM_DRIVE_STOP, false);
+}
+
+void LineActuators::serviceMode() {
+    redLampOff();
+    greenLampOn();
+    startLedOff();
+    resetLedOff();
+    q1LedOff();
+    q2LedOff();
+    set(SIM_DRIVE_STOP | SIM_DRIVE_DIRECTION_RIGHT | SIM_DRIVE_DIRECTION_LEFT | SIM_DRIVE_SLOW,
+        false);
+}
+
+void LineActuators::errorMode() {
+    greenLampOff();
+    redLampOn();
+    motorStop();
+    closeSwitch();
+}
+
+void LineActuators::estopMode() {
+    allOff();
+    closeSwitch();
+}
+
+void LineActuators::connectionLost() {
+    greenLampOff();
+    redLampOff();
+    motorStop();
+    closeSwitch();
+}
+
+void LineActuators::allOff() {
+    motorStop();
+    set(SIM_ALARM_LAMP_GREEN | SIM_ALARM_LAMP_YELLOW | SIM_ALARM_LAMP_RED | SIM_LED_START_BUTTON
+            | SIM_LED_RESET_BUTTON | SIM_LED_Q1 | SIM_LED_Q2,
+        false);
+}
+
+void LineActuators::motorStop() {
+    set(SIM_DRIVE_SLOW | SIM_DRIVE_DIRECTION_RIGHT | SIM_DRIVE_DIRECTION_LEFT, false);
+    set(SIM_DRIVE_STOP, true);
+}
+
+void LineActuators::motorSlow() {
+    set(SIM_DRIVE_STOP | SIM_DRIVE_DIRECTION_LEFT, false);
+    set(SIM_DRIVE_DIRECTION_RIGHT | SIM_DRIVE_SLOW, true);
+}
+
+void LineActuators::motorFast() {
+    set(SIM_DRIVE_STOP | SIM_DRIVE_DIRECTION_LEFT | SIM_DRIVE_SLOW, false);
+    set(SIM_DRIVE_DIRECTION_RIGHT, true);
+}
@@ -0,0 +1,134 @@
+/*
+ * LineHal.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "events/EventManager.h"
+#include "events/EventSender.h"
+#include "hal/IActuators.h"
+#include "hal/IHeightSensor.h"
+#include "isimulationcycleendhandler.h"
+#include "simmasks.h"
+#include "simulation.h"
+
+/*
+ * HAL of the line benchmark. The register based HAL (Sensors, Actuators)
+ * serves the simulation of the master system, there is only one simulated
+ * GPIO controller per process. The slave works on the image of its own
+ * Simulation instead: the same events and outputs, without the registers in
+ * between. The ADC driver (TSCADC) does not reach the simulation, both
+ * systems measure the height on the image.
+ */
+
+/**
+ * Height measurement fed with the ADC value of each simulation cycle.
+ * Reports the median of ADC_SAMPLE_SIZE samples like HeightSensor.
+ */
+class LineHeightSensor : public IHeightSensor, public ISimulationCycleEndHandler {
+  public:
+    LineHeightSensor();
+
+    void cycleCompletedWith(unsigned long simulationtime, const SimulationIOImage &result,
+                            unsigned short ADCRaw) override {
+        addValue(ADCRaw);
+    }
+
+    void registerOnNewValueCallback(HeightCallback callback) override;
+    void unregisterOnNewValueCallback() override;
+    void start() override;
+    void stop() override;
+    float getAverageHeight() override;
+    float getMaxHeight() override;
+    float getMedianHeight() override;
+    int getLastRawValue() override;
+
+    /**
+     * Adds the ADC value of a cycle, calls the callback for every
+     * ADC_SAMPLE_SIZE values.
+     */
+    void addValue(int value);
+
+  private:
+    int nMeasurements{0};
+    float adcValueToMillimeter(int adcValue);
+};
+
+/**
+ * Sensors of the slave: edges of the input image raise the same events as
+ * Sensors::handleGpioInterrupt(). Buttons are pressed long after
+ * BTN_LONG_PRESSED_TIME_MS of simulation time.
+ */
+class LineSensors : public ISimulationCycleEndHandler, public EventSender {
+  public:
+    LineSensors(std::shared_ptr<EventManager> mngr, Simulation &sim);
+
+    void cycleCompletedWith(unsigned long simulationtime, const SimulationIOImage &result,
+                            unsigned short ADCRaw) override;
+
+    bool lbStartBlocked() { return (in & SIM_ITEM_DETECTED) == 0; }
+    bool lbRampBlocked() { return (in & SIM_BUFFER_IS_FULL) == 0; }
+    bool lbEndBlocked() { return (in & SIM_ITEM_AT_END) == 0; }
+
+  private:
+    std::atomic<unsigned short> in;
+    unsigned long startPressedAt{0};
+    unsigned long resetPressedAt{0};
+
+    void send(EventType type, int data = -1);
+    void barrier(unsigned short changed, unsigned short mask, EventType blocked,
+                 EventType unblocked);
+};
+
+/**
+ * Actuators of the slave, write the output image of its simulation. A
+ * blinking lamp is shown as switched on.
+ */
+class LineActuators : public IActuators {
+  public:
+    LineActuators(std::shared_ptr<EventManager> mngr, Simulation &sim);
+
+    void standbyMode() override;
+    void runningMode() override;
+    void serviceMode() override;
+    void errorMode() override;
+    void estopMode() override;
+    void greenLampOn() override { set(SIM_ALARM_LAMP_GREEN, true); }
+    void setGreenBlinking(bool on) override { set(SIM_ALARM_LAMP_GREEN, on); }
+    void greenLampOff() override { set(SIM_ALARM_LAMP_GREEN, false); }
+    void yellowLampOn() override { set(SIM_ALARM_LAMP_YELLOW, true); }
+    void setYellowBlinking(bool on) override { set(SIM_ALARM_LAMP_YELLOW, on); }
+    void yellowLampOff() override { set(SIM_ALARM_LAMP_YELLOW, false); }
+    void redLampOn() override { set(SIM_ALARM_LAMP_RED, true); }
+    void setRedBlinking(bool on, bool fast) override { set(SIM_ALARM_LAMP_RED, on); }
+    void redLampOff() override { set(SIM_ALARM_LAMP_RED, false); }
+    void startLedOn() override { set(SIM_LED_START_BUTTON, true); }
+    void startLedOff() override { set(SIM_LED_START_BUTTON, false); }
+    void resetLedOn() override { set(SIM_LED_RESET_BUTTON, true); }
+    void resetLedOff() override { set(SIM_LED_RESET_BUTTON, false); }
+    void q1LedOn() override { set(SIM_LED_Q1, true); }
+    void q1LedOff() override { set(SIM_LED_Q1, false); }
+    void q2LedOn() override { set(SIM_LED_Q2, true); }
+    void q2LedOff() override { set(SIM_LED_Q2, false); }
+    void motorStop() override;
+    void motorSlow() override;
+    void motorFast() override;
+    void openSwitch() override { set(SIM_FEED_SEPARATOR, true); }
+    void closeSwitch() override { set(SIM_FEED_SEPARATOR, false); }
+    void sortOut() override { closeSwitch(); }
+    void letPass() override { openSwitch(); }
+    void connectionLost() override;
+    void allOff() override;
+
+  private:
+    Simulation &sim;
+    std::mutex mtx;
+    unsigned short out{0};
+
+    void set(unsigned short mask, bool on);
+};
@@ -0,0 +1,254 @@
+/*
+ * LineMain.cpp
+ *
+ *  Created on: 19.10.2026
+ *
+ * Line benchmark: runs the application of master and slave against
+ * simulated scenarios (see LineRun.h) and reports the throughput, the sort
+ * accuracy, the error stops, the transit time of the items and the dispatch
+ * latency of the EventManagers. Compare before and after changes, use an
+ * optimized build (preset host-release).
+ *
+ *   --filter=<text>     only the standard scenarios whose name contains text
+ *   --file=<path>       scenario description (see SimScenarioGenerator)
+ *                       instead of the standard scenarios
+ *   --duration=<ms>     simulated time of each run
+ *   --seeds=<n>         runs per scenario with the seeds 1..n (3)
+ *   --jobs=<n>          runs in parallel (half of the cores)
+ *   --verbose           console output of the application and simulation
+ *
+ * Each run is a process of its own (the application uses singletons). The
+ * exit code is 1 if a run failed or no item has left the line.
+ */
+#include "LineRun.h"
+#include "simscenariogenerator.h"
+
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct NamedScenario {
+    std::string name;
+    std::string description;
+};
+
+// Order of the application and the judge, the other kinds belong on the
+// slides. The operator empties the slides every 20 s.
+const char *lineOrder = "order flat holeup metalup\n"
+                        "mix flat 2 holeup 2 metalup 2 holedown 1 metaldown 1\n";
+
+const std::vector<NamedScenario> standardScenarios = {
+    {"periodic", "periodic 30 4000\nrampclear 20000 20000\nduration 180000\n"},
+    {"poisson", "poisson 30 4000 2000\nrampclear 20000 20000\nduration 180000\n"},
+    {"bursts", "burst 6 5 2000 12000\nrampclear 20000 20000\nduration 180000\n"},
+    {"flips", "flip 0.3\nsticky 0.2\npoisson 30 4000 2000\nrampclear 20000 20000\n"
+              "duration 180000\n"},
+    {"faults", "poisson 30 4000 2000\nestop 30000 3000\nrampfull 60000\nrampclear 80000 20000\n"
+               "duration 180000\n"},
+};
+
+struct Job {
+    size_t scenario;
+    SimScenario run;
+    int fd = -1;
+    pid_t pid = -1;
+};
+
+const char *option(const char *arg, const char *name) {
+    size_t length = strlen(name);
+    return strncmp(arg, name, length) == 0 ? arg + length : nullptr;
+}
+
+// Runs the scenario in a child process, its result is written to a pipe
+void start(Job &job, bool verbose) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        return;
+    }
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        if (!verbose) {
+            int null = open("/dev/null", O_WRONLY);
+            dup2(null, STDOUT_FILENO);
+        }
+        std::string text = runLine(job.run).toText() + "\n";
+        ssize_t written = write(fds[1], text.data(), text.size());
+        // _exit does not flush the console output
+        std::cout.flush();
+        fflush(stdout);
+        _exit(written == (ssize_t) text.size() ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    close(fds[1]);
+    if (pid < 0) {
+        perror("fork");
+        close(fds[0]);
+        return;
+    }
+    job.pid = pid;
+    job.fd = fds[0];
+}
+
+bool finish(Job &job, LineResult &result) {
+    std::string text;
+    char buffer[4096];
+    ssize_t length;
+    while ((length = read(job.fd, buffer, sizeof(buffer))) > 0) {
+        text.append(buffer, length);
+    }
+    close(job.fd);
+    int status = 0;
+    waitpid(job.pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS && result.fromText(text);
+}
+
+void worst(LineLatency &into, const LineLatency &latency) {
+    into.p50 = std::max(into.p50, latency.p50);
+    into.p90 = std::max(into.p90, latency.p90);
+    into.p99 = std::max(into.p99, latency.p99);
+    into.max = std::max(into.max, latency.max);
+}
+
+std::string format(const LineLatency &latency) {
+    std::ostringstream text;
+    text << latency.p50 << "/" << latency.p90 << "/" << latency.p99 << "/" << latency.max;
+    return text.str();
+}
+
+}
+
+int main(int argc, char **argv) {
+    std::string filter;
+    std::string file;
+    unsigned int duration = 0;
+    unsigned int seeds = 3;
+    unsigned int jobs = std::max(1u, std::thread::hardware_concurrency() / 2);
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        const char *value;
+        if ((value = option(argv[i], "--filter="))) {
+            filter = value;
+        } else if ((value = option(argv[i], "--file="))) {
+            file = value;
+        } else if ((value = option(argv[i], "--duration="))) {
+            duration = atoi(value);
+        } else if ((value = option(argv[i], "--seeds="))) {
+            seeds = std::max(1, atoi(value));
+        } else if ((value = option(argv[i], "--jobs="))) {
+            jobs = std::max(1, atoi(value));
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else {
+            std::cerr << "Unknown option " << argv[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<NamedScenario> scenarios;
+    if (!file.empty()) {
+        std::ifstream in(file);
+        std::stringstream description;
+        description << in.rdbuf();
+        if (!in) {
+            std::cerr << "Scenario " << file << " not read" << std::endl;
+            return EXIT_FAILURE;
+        }
+        scenarios.push_back({file, description.str()});
+    } else {
+        for (const auto &named : standardScenarios) {
+            if (named.name.find(filter) != std::string::npos) {
+                scenarios.push_back({named.name, lineOrder + named.description});
+            }
+        }
+    }
+
+    SimScenarioGenerator generator;
+    std::vector<Job> queue;
+    for (size_t index = 0; index < scenarios.size(); index++) {
+        std::string description = scenarios[index].description;
+        if (duration > 0) {
+            description += "duration " + std::to_string(duration) + "\n";
+        }
+        for (unsigned int seed = 1; seed <= seeds; seed++) {
+            Job job;
+            job.scenario = index;
+            if (!generator.generate(description, seed, job.run)) {
+                std::cerr << scenarios[index].name << ": " << generator.error() << std::endl;
+                return EXIT_FAILURE;
+            }
+            if (job.run.sortOrder.order.size() != 3) {
+                std::cerr << scenarios[index].name << ": order of 3 kinds required" << std::endl;
+                return EXIT_FAILURE;
+            }
+            queue.push_back(job);
+        }
+    }
+
+    // no threads in this process before the children are forked
+    auto begin = std::chrono::steady_clock::now();
+    std::map<size_t, std::vector<LineResult>> results;
+    bool failed = false;
+    size_t next = 0;
+    std::vector<Job> running;
+    while (next < queue.size() || !running.empty()) {
+        while (next < queue.size() && running.size() < jobs) {
+            start(queue[next], verbose);
+            if (queue[next].pid < 0) {
+                return EXIT_FAILURE;
+            }
+            running.push_back(queue[next++]);
+        }
+        // the oldest run finishes first in most cases
+        Job job = running.front();
+        running.erase(running.begin());
+        LineResult result;
+        if (finish(job, result)) {
+            results[job.scenario].push_back(result);
+        } else {
+            std::cerr << scenarios[job.scenario].name << " seed " << job.run.seed << " failed"
+                      << std::endl;
+            failed = true;
+        }
+    }
+
+    for (size_t index = 0; index < scenarios.size(); index++) {
+        std::vector<SimScenarioResult> runs;
+        LineLatency master, slave;
+        for (const LineResult &result : results[index]) {
+            runs.push_back(result.scenario);
+            worst(master, result.master);
+            worst(slave, result.slave);
+        }
+        SimScenarioSummary summary = SimScenarioRunner::summarize(runs);
+        failed = failed || summary.passed + summary.sortedOut == 0;
+        std::cout << "[Line] " << std::left << std::setw(9) << scenarios[index].name << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(6) << summary.itemsPerMinute
+                  << " items/min, order accuracy " << std::setprecision(3) << summary.orderAccuracy
+                  << " (" << summary.passed + summary.sortedOut << "/" << summary.added
+                  << " items), error stops " << summary.errorStops << ", transit p50/p90/p99 "
+                  << summary.transitP50 << "/" << summary.transitP90 << "/" << summary.transitP99
+                  << " ms, dispatch latency p50/p90/p99/max master " << format(master)
+                  << " us, slave " << format(slave) << " us" << std::endl;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "[Line] " << queue.size() << " runs in " << std::setprecision(1) << seconds << " s"
+              << std::endl;
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
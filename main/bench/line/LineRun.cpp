@@ -0,0 +1,476 @@
+/*
+ * LineRun.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "LineRun.h"
+
+#include <sys/stat.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "LineHal.h"
+#include "common/Clock.h"
+#include "common/Quiescence.h"
+#include "common/TimerService.h"
+#include "configuration/Configuration.h"
+#include "events/EventManager.h"
+#include "events/EventSender.h"
+#include "hal/Actuators.h"
+#include "hal/Sensors.h"
+#include "logger/logger.hpp"
+#include "logic/LinkSync.h"
+#include "logic/hm/HeightContext.h"
+#include "logic/main_fsm/MainContext.h"
+#include "logic/motor_fsm/MotorContext.h"
+#include "metrics/Metrics.h"
+#include "isimdrophandler.h"
+#include "simclockadvancer.h"
+#include "simconf.h"
+#include "simhci.h"
+#include "simheightprofile.h"
+#include "simitemhandling.h"
+#include "simmasks.h"
+#include "simqnxgpio.h"
+#include "simqnxirq.h"
+
+namespace {
+
+// ADC value of the empty belt
+const int beltAdc = 0x0e3c;
+// [ms] the operator looks at the line
+const unsigned int operatorPeriod = 2000;
+// [ms] the operator takes an item from the end of the line
+const unsigned int takeDelay = 500;
+
+WorkpieceType workpieceTypeOf(ItemKinds kind) {
+    switch (kind) {
+    case ItemKinds::flat:
+        return WorkpieceType::WS_F;
+    case ItemKinds::holeup:
+        return WorkpieceType::WS_BOM;
+    case ItemKinds::metalup:
+        return WorkpieceType::WS_BUM;
+    default:
+        return WorkpieceType::WS_OB;
+    }
+}
+
+LineLatency latencyOf(bool master) {
+    Histogram &histogram = MetricsRegistry::getInstance().histogram(
+        std::string("esep_event_dispatch_latency_us{system=\"") + (master ? "master" : "slave")
+        + "\"}");
+    LineLatency latency;
+    latency.p50 = histogram.percentile(0.5);
+    latency.p90 = histogram.percentile(0.9);
+    latency.p99 = histogram.percentile(0.99);
+    latency.max = histogram.max();
+    return latency;
+}
+
+// Items of the line: time of the entry at the master, where they left
+class LineItems {
+  private:
+    SimScenarioSortJudge judge;
+    SimScenarioResult &result;
+    std::map<unsigned int, unsigned long> entriesMaster;   // by ID of the master simulation
+    std::map<unsigned int, unsigned long> entriesSlave;
+    std::deque<unsigned long> passing;   // entries of the items passed to the slave
+    std::set<unsigned int> slideMaster;
+    std::set<unsigned int> slideSlave;
+
+    void left(ItemKinds kind, bool passed, unsigned long entry, unsigned long now) {
+        (passed ? result.passed : result.sortedOut)++;
+        if (judge.left(kind, passed)) {
+            result.asOrdered++;
+        }
+        result.transitTimes.push_back(now - entry);
+        result.lastExit = now;
+    }
+
+    void scan(Simulation &sim, std::map<unsigned int, unsigned long> &entries,
+              std::set<unsigned int> &slide, bool slave) {
+        for (const auto &item : sim.getItems()) {
+            if (item->state == ItemState::onBelt) {
+                if (entries.count(item->ID) == 0) {
+                    unsigned long entry = sim.currentSimTime();
+                    if (slave && !passing.empty()) {
+                        entry = passing.front();
+                        passing.pop_front();
+                    }
+                    entries[item->ID] = entry;
+                }
+            } else if (item->state == ItemState::onSlide && slide.insert(item->ID).second) {
+                // items put on the slide by the scenario have never been on the belt
+                auto entry = entries.find(item->ID);
+                if (entry != entries.end()) {
+                    left(item->kind, false, entry->second, sim.currentSimTime());
+                }
+            }
+        }
+    }
+
+  public:
+    LineItems(const SimSortOrder &sortOrder, SimScenarioResult &result)
+        : judge(sortOrder), result(result) {}
+
+    void passed(unsigned int masterId, unsigned long now) {
+        auto entry = entriesMaster.find(masterId);
+        passing.push_back(entry != entriesMaster.end() ? entry->second : now);
+    }
+
+    void leftLine(SimItem *item, unsigned long now) {
+        auto entry = entriesSlave.find(item->ID);
+        left(item->kind, true, entry != entriesSlave.end() ? entry->second : now, now);
+    }
+
+    void scan(Simulation &master, Simulation &slave) {
+        scan(master, entriesMaster, slideMaster, false);
+        scan(slave, entriesSlave, slideSlave, true);
+    }
+};
+
+// End of the master belt: the item is put on the slave belt (twin mode)
+class LineTransfer : public ISimDropHandler {
+  private:
+    LineItems &items;
+    Simulation &master;
+    SimItemHandling &slaveHandling;
+
+  public:
+    LineTransfer(LineItems &items, Simulation &master, SimItemHandling &slaveHandling)
+        : items(items), master(master), slaveHandling(slaveHandling) {}
+
+    void dropEnd(SimItem *droppeditem) override {
+        droppeditem->evalFlip();
+        SimItemHandlingAction action(0, droppeditem->kind, false, droppeditem->sticky);
+        action.x = 0.0;
+        action.y = droppeditem->y;
+        slaveHandling.addAction(action);
+        items.passed(droppeditem->ID, master.currentSimTime());
+    }
+};
+
+// End of the slave belt: the item has left the line. The slave stops the
+// belt at the end, the operator takes the item away.
+class LineExit : public ISimDropHandler {
+  private:
+    LineItems &items;
+    Simulation &slave;
+    SimItemHandling &slaveHandling;
+    std::set<unsigned int> taken;
+    // range of removeatend of SimItemManager
+    static constexpr double endX = 630.0;
+
+  public:
+    LineExit(LineItems &items, Simulation &slave, SimItemHandling &slaveHandling)
+        : items(items), slave(slave), slaveHandling(slaveHandling) {}
+
+    void dropEnd(SimItem *droppeditem) override {
+        items.leftLine(droppeditem, slave.currentSimTime());
+    }
+
+    void look() {
+        // light barrier at the end is active low
+        if (slave.readIn() & SIM_ITEM_AT_END) {
+            return;
+        }
+        for (const auto &item : slave.getItems()) {
+            if (item->state == ItemState::onBelt && item->x >= endX && taken.insert(item->ID).second) {
+                items.leftLine(item, slave.currentSimTime());
+                slaveHandling.addAction(SimItemHandlingAction(
+                    slave.currentSimTime() + takeDelay, SimItemHandlingActionKind::removeid, item->ID));
+            }
+        }
+    }
+};
+
+// Presses the buttons like the operator of the line: Start in Standby,
+// Reset at both systems after an E-Stop has been released, Reset and Start
+// in Error. Leaves the buttons alone while an E-Stop is pressed. The
+// application forgets its items in E-Stop and takes no item already at the
+// start: the belts are cleared before the Reset, the start of the master
+// before the Start in Standby.
+class LineOperator {
+  private:
+    Simulation &master;
+    SimHCI &masterHci;
+    SimHCI &slaveHci;
+    SimItemHandling &masterHandling;
+    SimItemHandling &slaveHandling;
+    unsigned long next = 500;
+
+    // behind the light barrier at the start of the belt
+    static constexpr double startX = 60.0;
+
+    static void press(SimHCI &hci, unsigned long at, SimHCIActionKind kind) {
+        hci.addAction(SimHCIAction(at, kind));
+        hci.addAction(SimHCIAction(at + 200, SimHCIActionKind::releaseAll));
+    }
+
+    void clearStart(unsigned long at) {
+        for (const auto &item : master.getItems()) {
+            if (item->state == ItemState::onBelt && item->x < startX) {
+                masterHandling.addAction(
+                    SimItemHandlingAction(at, SimItemHandlingActionKind::removeid, item->ID));
+            }
+        }
+    }
+
+  public:
+    LineOperator(Simulation &master, SimHCI &masterHci, SimHCI &slaveHci,
+                 SimItemHandling &masterHandling, SimItemHandling &slaveHandling)
+        : master(master), masterHci(masterHci), slaveHci(slaveHci),
+          masterHandling(masterHandling), slaveHandling(slaveHandling) {}
+
+    void look(unsigned long now, EventType mode, bool estopPressed) {
+        if (now < next) {
+            return;
+        }
+        next = now + operatorPeriod;
+        if (estopPressed) {
+            return;
+        }
+        switch (mode) {
+        case EventType::MODE_RUNNING:
+        case EventType::MODE_SERVICE:
+            break;
+        case EventType::MODE_ESTOP:
+            masterHandling.addAction(SimItemHandlingAction(now + 1, SimItemHandlingActionKind::removeall));
+            slaveHandling.addAction(SimItemHandlingAction(now + 1, SimItemHandlingActionKind::removeall));
+            press(masterHci, now + 1, SimHCIActionKind::pressResetOnly);
+            press(slaveHci, now + 1, SimHCIActionKind::pressResetOnly);
+            break;
+        case EventType::MODE_ERROR:
+            press(masterHci, now + 1, SimHCIActionKind::pressResetOnly);
+            press(masterHci, now + 700, SimHCIActionKind::pressStartOnly);
+            break;
+        default:   // Standby
+            clearStart(now + 1);
+            press(masterHci, now + 1, SimHCIActionKind::pressStartOnly);
+        }
+    }
+};
+
+// The application of both systems as in main.cpp, not shut down (the
+// process ends after the run)
+struct LineApplication {
+    std::shared_ptr<EventManager> slaveEventManager;
+    std::shared_ptr<LineActuators> slaveActuators;
+    std::shared_ptr<LineHeightSensor> slaveHeightSensor;
+    std::shared_ptr<LineSensors> slaveSensors;
+    std::shared_ptr<SlaveLinkSync> slaveLinkSync;
+    std::shared_ptr<HeightContext> slaveHeightFSM;
+
+    std::shared_ptr<EventManager> eventManager;
+    std::shared_ptr<Actuators> actuators;
+    std::shared_ptr<MotorContext> motorFSM_Master;
+    std::shared_ptr<MotorContext> motorFSM_Slave;
+    std::shared_ptr<MainContext> mainFSM;
+    std::shared_ptr<MasterLinkSync> linkSync;
+    std::shared_ptr<Sensors> sensors;
+    std::shared_ptr<LineHeightSensor> heightSensor;
+    std::shared_ptr<HeightContext> heightFSM;
+
+    std::atomic<int> mode{-1};   // last MODE_* of the master
+    std::atomic<unsigned int> errorStops{0};
+
+    LineApplication(Simulation &masterSim, Simulation &slaveSim) {
+        Configuration &conf = Configuration::getInstance();
+        // The components read the system from the configuration when they
+        // are created
+        conf.setMaster(false);
+        slaveEventManager = std::make_shared<EventManager>();
+        slaveActuators = std::make_shared<LineActuators>(slaveEventManager, slaveSim);
+        slaveActuators->standbyMode();
+        slaveSensors = std::make_shared<LineSensors>(slaveEventManager, slaveSim);
+        slaveSim.addCycleEndHandler(slaveSensors.get());
+        slaveHeightSensor = std::make_shared<LineHeightSensor>();
+        slaveSim.addCycleEndHandler(slaveHeightSensor.get());
+        LineSensors *sensorsS = slaveSensors.get();
+        slaveLinkSync = std::make_shared<SlaveLinkSync>(
+            slaveEventManager, [sensorsS]() { return sensorsS->lbRampBlocked(); },
+            [sensorsS]() { return sensorsS->lbStartBlocked(); },
+            [sensorsS]() { return sensorsS->lbEndBlocked(); });
+        slaveEventManager->getLinkRecovery().addParticipant(slaveLinkSync.get());
+        HeightContextData *slaveHeightData = new HeightContextData();
+        slaveHeightFSM = std::make_shared<HeightContext>(
+            new HeightActions(slaveHeightData, new EventSender(), slaveEventManager),
+            slaveHeightData, slaveHeightSensor);
+
+        conf.setMaster(true);
+        eventManager = std::make_shared<EventManager>();
+        actuators = std::make_shared<Actuators>(eventManager);
+        actuators->standbyMode();
+        motorFSM_Master = std::make_shared<MotorContext>(
+            new MotorActions(eventManager, new EventSender(), true), true);
+        motorFSM_Slave = std::make_shared<MotorContext>(
+            new MotorActions(eventManager, new EventSender(), false), false);
+        MainActions *mainActions = new MainActions(eventManager, new EventSender());
+        mainFSM = std::make_shared<MainContext>(mainActions);
+        mainActions->setData(mainFSM->data);
+        linkSync = std::make_shared<MasterLinkSync>(mainFSM.get());
+        eventManager->getLinkRecovery().addParticipant(linkSync.get());
+        sensors = std::make_shared<Sensors>(eventManager);
+        sensors->startEventLoop();
+        heightSensor = std::make_shared<LineHeightSensor>();
+        masterSim.addCycleEndHandler(heightSensor.get());
+        HeightContextData *heightData = new HeightContextData();
+        heightFSM = std::make_shared<HeightContext>(
+            new HeightActions(heightData, new EventSender(), eventManager), heightData,
+            heightSensor);
+
+        eventManager->subscribe(EventMask::range(EventType::MODE_STANDBY, EventType::MODE_ERROR),
+                                [this](Event event) {
+                                    bool stop = event.type == EventType::MODE_ERROR
+                                                || event.type == EventType::MODE_ESTOP;
+                                    if (mode.exchange(event.type) != event.type && stop) {
+                                        errorStops++;
+                                    }
+                                });
+    }
+
+    // Each EventManager blocks until the service of the other one exists
+    void start() {
+        std::thread slave([this]() { slaveEventManager->start(); });
+        eventManager->start();
+        slave.join();
+    }
+};
+
+}
+
+std::string LineResult::toText() const {
+    std::ostringstream text;
+    text << scenario.seed << ' ' << scenario.simTime << ' ' << scenario.lastExit << ' '
+         << scenario.added << ' ' << scenario.passed << ' ' << scenario.sortedOut << ' '
+         << scenario.asOrdered << ' ' << scenario.errorStops;
+    for (const LineLatency *latency : {&master, &slave}) {
+        text << ' ' << latency->p50 << ' ' << latency->p90 << ' ' << latency->p99 << ' '
+             << latency->max;
+    }
+    text << ' ' << scenario.transitTimes.size();
+    for (unsigned int transit : scenario.transitTimes) {
+        text << ' ' << transit;
+    }
+    return text.str();
+}
+
+bool LineResult::fromText(const std::string &text) {
+    std::istringstream words(text);
+    words >> scenario.seed >> scenario.simTime >> scenario.lastExit >> scenario.added
+        >> scenario.passed >> scenario.sortedOut >> scenario.asOrdered >> scenario.errorStops;
+    for (LineLatency *latency : {&master, &slave}) {
+        words >> latency->p50 >> latency->p90 >> latency->p99 >> latency->max;
+    }
+    size_t count = 0;
+    words >> count;
+    scenario.transitTimes.clear();
+    for (size_t i = 0; i < count && words; i++) {
+        unsigned int transit = 0;
+        words >> transit;
+        scenario.transitTimes.push_back(transit);
+    }
+    return !words.fail();
+}
+
+LineResult runLine(const SimScenario &scenario) {
+    LineResult result;
+    SimScenarioResult &run = result.scenario;
+    run.seed = scenario.seed;
+
+    // The logger fails without its folder
+    mkdir("/tmp/esep_2.1", 0777);
+    // as main.cpp: QNX_DEBUG=TRUE logs everything
+    const char *debug = getenv("QNX_DEBUG");
+    Logger::set_level(debug && std::string(debug) == "TRUE" ? Logger::level::DEBUG
+                                                            : Logger::level::ERR);
+    SimConfiguration::setQuiet(true);
+
+    Configuration &conf = Configuration::getInstance();
+    conf.setPusherMounted(false);
+    conf.setOffsetCalibration(beltAdc);
+    conf.setReferenceCalibration(SimHeightProfile::adc(ItemKinds::holeup, -15.0));
+    std::vector<WorkpieceType> order;
+    for (ItemKinds kind : scenario.sortOrder.order) {
+        order.push_back(workpieceTypeOf(kind));
+    }
+    conf.setDesiredWorkpieceOrder(order);
+
+    // Master: the items and buttons of the scenario, slave: emptied with the
+    // slide of the master. The simulations are used by the threads of the
+    // application until the process ends.
+    SimItemHandling &masterHandling = *new SimItemHandling();
+    SimItemHandling &slaveHandling = *new SimItemHandling();
+    for (const auto &action : scenario.script) {
+        masterHandling.addAction(action);
+        if (action.actionkind == SimItemHandlingActionKind::add) {
+            run.added++;
+        } else if (action.actionkind == SimItemHandlingActionKind::removeallslide) {
+            slaveHandling.addAction(action);
+        }
+    }
+    SimHCI &masterHci = *new SimHCI();
+    SimHCI &slaveHci = *new SimHCI();
+    for (const auto &action : scenario.hciScript) {
+        masterHci.addAction(action);
+    }
+    Simulation &master = *new Simulation(&masterHandling, &masterHci);
+    Simulation &slave = *new Simulation(&slaveHandling, &slaveHci);
+    for (Simulation *sim : {&master, &slave}) {
+        sim->setTimeslice(1);
+        sim->setSubstep(0);
+    }
+
+    // Headless mode as in SimulationStarterQNX: the clock is advanced when
+    // the application of both systems is idle, the partner events count as
+    // well
+    VirtualClock *clock = new VirtualClock();
+    Clock::setInstance(clock);
+    Quiescence &quiescence = Quiescence::getInstance();
+    quiescence.setEnabled(true);
+    quiescence.setLinkCounted(true);
+    quiescence.addProbe([]() { return SimQNXIRQ::getSimIRQ()->isIdle(); });
+    quiescence.addProbe([]() { return TimerService::getInstance().isIdle(); });
+    SimClockAdvancer &advancer = *new SimClockAdvancer([clock](unsigned int ms) { clock->advance(ms); },
+                                                       [&quiescence]() { return quiescence.waitIdle(200); });
+    master.addCycleEndHandler(&advancer);
+    SimQNXGPIO::getGPIO()->setSimulation(&master);
+    master.addCycleEndHandler(SimQNXGPIO::getGPIO());
+    std::thread(std::ref(*SimQNXIRQ::getSimIRQ())).detach();
+    SimQNXGPIO::getGPIO()->setIRQHandler(SimQNXIRQ::getSimIRQ());
+
+    LineItems items(scenario.sortOrder, run);
+    LineTransfer transfer(items, master, slaveHandling);
+    LineExit exit(items, slave, slaveHandling);
+    master.setDropHandler(&transfer);
+    slave.setDropHandler(&exit);
+
+    LineApplication *application = new LineApplication(master, slave);
+    application->start();
+
+    LineOperator lineOperator(master, masterHci, slaveHci, masterHandling, slaveHandling);
+    while (master.currentSimTime() < scenario.duration) {
+        master.simulateTime(1);
+        slave.simulateTime(1);
+        items.scan(master, slave);
+        exit.look();
+        bool estop = (master.readIn() & SIM_EMERGENCY_STOP) == 0
+                     || (slave.readIn() & SIM_EMERGENCY_STOP) == 0;
+        lineOperator.look(master.currentSimTime(), (EventType) application->mode.load(), estop);
+    }
+    quiescence.waitIdle(200);
+    run.simTime = master.currentSimTime();
+    run.errorStops = application->errorStops;
+    result.master = latencyOf(true);
+    result.slave = latencyOf(false);
+    return result;
+}
@@ -0,0 +1,51 @@
+/*
+ * LineRun.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "simscenariorunner.h"
+
+/**
+ * Dispatch latency of an EventManager [us], from the event queue to the end
+ * of the dispatch (esep_event_dispatch_latency_us).
+ */
+struct LineLatency {
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+    uint64_t max = 0;
+};
+
+struct LineResult {
+    SimScenarioResult scenario;   // errorStops: modes ERROR and ESTOP entered
+    LineLatency master;
+    LineLatency slave;
+
+    std::string toText() const;
+    /**
+     * @return false if the text is not a complete result of toText()
+     */
+    bool fromText(const std::string &text);
+};
+
+/**
+ * Runs the application of both systems against a scenario: the FSMs and
+ * EventManagers of master and slave, connected by the channels of the host
+ * platform, on two simulations in the headless mode (virtual clock). Items
+ * leaving the end of the master are passed to the slave like in the twin
+ * mode of the simulation.
+ *
+ * An operator starts the line, acknowledges E-Stops and errors with the
+ * buttons and takes the items from the end of the line. The kinds of the scenario order (exactly 3) are configured as
+ * the desired workpiece order.
+ *
+ * The application uses singletons (configuration, clock, simulated GPIO
+ * controller) and is not shut down after the run: only one run per
+ * process, see LineMain.cpp.
+ */
+LineResult runLine(const SimScenario &scenario);
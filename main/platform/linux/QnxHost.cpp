@@ -0,0 +1,265 @@
+/*
+ * QnxHost.cpp
+ *
+ *  Created on: 19.10.2026
+ *
+ * Linux implementation of the QNX calls declared in platform/linux/include.
+ * Channels are queues of pulses within the process, so the EventManager,
+ * the HAL threads and the simulation communicate like on the target.
+ * Synchronous messages (MsgSend) are not supported.
+ */
+
+#include <hw/inout.h>
+#include <sys/dispatch.h>
+#include <sys/neutrino.h>
+#include <sys/procmgr.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace {
+
+struct Channel {
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<_pulse> pulses;
+    bool destroyed = false;
+};
+
+struct Kernel {
+    std::mutex mtx;
+    int nextId = 1;
+    std::map<int, std::shared_ptr<Channel>> channels;
+    std::map<int, std::shared_ptr<Channel>> connections;
+    std::map<std::string, int> names;
+    std::map<uint64_t, void *> deviceMemory;
+    int nextInterruptId = 1;
+};
+
+Kernel &kernel() {
+    static Kernel instance;
+    return instance;
+}
+
+std::shared_ptr<Channel> findChannel(int chid) {
+    Kernel &k = kernel();
+    std::lock_guard<std::mutex> lock(k.mtx);
+    auto it = k.channels.find(chid);
+    return it == k.channels.end() ? nullptr : it->second;
+}
+
+std::shared_ptr<Channel> findConnection(int coid) {
+    Kernel &k = kernel();
+    std::lock_guard<std::mutex> lock(k.mtx);
+    auto it = k.connections.find(coid);
+    return it == k.connections.end() ? nullptr : it->second;
+}
+
+}
+
+int ChannelCreate(unsigned flags) {
+    Kernel &k = kernel();
+    std::lock_guard<std::mutex> lock(k.mtx);
+    int chid = k.nextId++;
+    k.channels[chid] = std::make_shared<Channel>();
+    return chid;
+}
+
+int ChannelDestroy(int chid) {
+    std::shared_ptr<Channel> channel;
+    {
+        Kernel &k = kernel();
+        std::lock_guard<std::mutex> lock(k.mtx);
+        auto it = k.channels.find(chid);
+        if (it == k.channels.end()) {
+            errno = EINVAL;
+            return -1;
+        }
+        channel = it->second;
+        k.channels.erase(it);
+    }
+    std::lock_guard<std::mutex> lock(channel->mtx);
+    channel->destroyed = true;
+    channel->cv.notify_all();
+    return EOK;
+}
+
+int ConnectAttach(uint32_t nd, pid_t pid, int chid, unsigned index, int flags) {
+    Kernel &k = kernel();
+    std::lock_guard<std::mutex> lock(k.mtx);
+    auto it = k.channels.find(chid);
+    if (it == k.channels.end()) {
+        errno = ESRCH;
+        return -1;
+    }
+    int coid = k.nextId++;
+    k.connections[coid] = it->second;
+    return coid;
+}
+
+int ConnectDetach(int coid) {
+    Kernel &k = kernel();
+    std::lock_guard<std::mutex> lock(k.mtx);
+    if (k.connections.erase(coid) == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    return EOK;
+}
+
+int MsgSendPulse(int coid, int priority, int code, int value) {
+    std::shared_ptr<Channel> channel = findConnection(coid);
+    if (!channel) {
+        errno = EBADF;
+        return -1;
+    }
+    _pulse pulse;
+    memset(&pulse, 0, sizeof(pulse));
+    pulse.code = (int8_t) code;
+    pulse.value.sival_int = value;
+    std::lock_guard<std::mutex> lock(channel->mtx);
+    if (channel->destroyed) {
+        errno = ESRCH;
+        return -1;
+    }
+    channel->pulses.push_back(pulse);
+    channel->cv.notify_one();
+    return EOK;
+}
+
+int MsgReceivePulse(int chid, void *pulse, size_t bytes, void *info) {
+    std::shared_ptr<Channel> channel = findChannel(chid);
+    if (!channel) {
+        errno = ESRCH;
+        return -1;
+    }
+    std::unique_lock<std::mutex> lock(channel->mtx);
+    channel->cv.wait(lock, [&]() { return channel->destroyed || !channel->pulses.empty(); });
+    if (channel->pulses.empty()) {
+        errno = ESRCH;
+        return -1;
+    }
+    memcpy(pulse, &channel->pulses.front(), std::min(bytes, sizeof(_pulse)));
+    channel->pulses.pop_front();
+    return 0;
+}
+
+int MsgReceive(int chid, void *msg, size_t bytes, void *info) {
+    // only pulses are sent on the host -> rcvid 0
+    return MsgReceivePulse(chid, msg, bytes, info);
+}
+
+int MsgReply(int rcvid, long status, const void *msg, size_t bytes) {
+    errno = ESRCH;
+    return -1;
+}
+
+int MsgError(int rcvid, int error) {
+    errno = ESRCH;
+    return -1;
+}
+
+int MsgRead(int rcvid, void *msg, size_t bytes, size_t offset) {
+    errno = ESRCH;
+    return -1;
+}
+
+int ThreadCtl(int cmd, void *data) { return EOK; }
+
+int InterruptEnable(void) { return EOK; }
+
+int InterruptDisable(void) { return EOK; }
+
+int InterruptAttach(int intr, const struct sigevent *(*handler)(void *, int),
+                    const void *area, int size, unsigned flags) {
+    Kernel &k = kernel();
+    std::lock_guard<std::mutex> lock(k.mtx);
+    return k.nextInterruptId++;
+}
+
+int InterruptAttachEvent(int intr, const struct sigevent *event, unsigned flags) {
+    Kernel &k = kernel();
+    std::lock_guard<std::mutex> lock(k.mtx);
+    return k.nextInterruptId++;
+}
+
+int InterruptDetach(int id) { return EOK; }
+
+int InterruptMask(int intr, int id) { return 0; }
+
+int InterruptUnmask(int intr, int id) { return 0; }
+
+name_attach_t *name_attach(void *dpp, const char *path, unsigned flags) {
+    int chid = ChannelCreate(0);
+    Kernel &k = kernel();
+    std::lock_guard<std::mutex> lock(k.mtx);
+    if (k.names.count(path) > 0) {
+        k.channels.erase(chid);
+        errno = EEXIST;
+        return nullptr;
+    }
+    k.names[path] = chid;
+    name_attach_t *attach = new name_attach_t();
+    attach->dpp = dpp;
+    attach->chid = chid;
+    return attach;
+}
+
+int name_detach(name_attach_t *attach, unsigned flags) {
+    if (attach == nullptr) {
+        errno = EINVAL;
+        return -1;
+    }
+    {
+        Kernel &k = kernel();
+        std::lock_guard<std::mutex> lock(k.mtx);
+        for (auto it = k.names.begin(); it != k.names.end(); ++it) {
+            if (it->second == attach->chid) {
+                k.names.erase(it);
+                break;
+            }
+        }
+    }
+    ChannelDestroy(attach->chid);
+    delete attach;
+    return EOK;
+}
+
+int name_open(const char *name, int flags) {
+    int chid;
+    {
+        Kernel &k = kernel();
+        std::lock_guard<std::mutex> lock(k.mtx);
+        auto it = k.names.find(name);
+        if (it == k.names.end()) {
+            errno = ENOENT;
+            return -1;
+        }
+        chid = it->second;
+    }
+    return ConnectAttach(0, 0, chid, _NTO_SIDE_CHANNEL, 0);
+}
+
+int name_close(int coid) { return ConnectDetach(coid); }
+
+uintptr_t mmap_device_io(size_t len, uint64_t io) {
+    Kernel &k = kernel();
+    std::lock_guard<std::mutex> lock(k.mtx);
+    // all mappings of a device share the memory, it is kept until exit
+    void *&memory = k.deviceMemory[io];
+    if (memory == nullptr) {
+        memory = calloc(1, len);
+    }
+    return (uintptr_t) memory;
+}
+
+int munmap_device_io(uintptr_t io, size_t len) { return EOK; }
+
+int procmgr_ability(pid_t pid, unsigned ability, ...) { return EOK; }
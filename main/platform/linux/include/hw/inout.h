@@ -0,0 +1,28 @@
+/*
+ * inout.h
+ *
+ *  Created on: 19.10.2026
+ *
+ * Linux host build: device registers are plain memory, written values can be
+ * read back. Without SIM_ACTIVE no sensor ever changes.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAP_DEVICE_FAILED ((uintptr_t) -1)
+
+uintptr_t mmap_device_io(size_t len, uint64_t io);
+int munmap_device_io(uintptr_t io, size_t len);
+
+static inline uint32_t in32(uintptr_t port) { return *(volatile uint32_t *) port; }
+static inline void out32(uintptr_t port, uint32_t value) { *(volatile uint32_t *) port = value; }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,33 @@
+/*
+ * dispatch.h
+ *
+ *  Created on: 19.10.2026
+ *
+ * Linux host build: name service of QNX (name_attach / name_open). Names are
+ * known within the process, GNS is not available.
+ */
+#pragma once
+
+#include <sys/neutrino.h>
+
+#define NAME_FLAG_ATTACH_GLOBAL 0x00000002
+
+typedef struct _name_attach {
+    void *dpp;
+    int chid;
+    int mntid;
+    int zero[2];
+} name_attach_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+name_attach_t *name_attach(void *dpp, const char *path, unsigned flags);
+int name_detach(name_attach_t *attach, unsigned flags);
+int name_open(const char *name, int flags);
+int name_close(int coid);
+
+#ifdef __cplusplus
+}
+#endif
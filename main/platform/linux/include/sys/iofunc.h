@@ -0,0 +1,10 @@
+/*
+ * iofunc.h
+ *
+ *  Created on: 19.10.2026
+ *
+ * Linux host build: the _IO_* message types are in sys/neutrino.h.
+ */
+#pragma once
+
+#include <sys/neutrino.h>
@@ -0,0 +1,89 @@
+/*
+ * neutrino.h
+ *
+ *  Created on: 19.10.2026
+ *
+ * Linux host build: subset of the QNX kernel calls used by the ESEP, see
+ * platform/linux/QnxHost.cpp. Channels, connections and pulses work within
+ * one process, interrupts and IO privileges are accepted without effect.
+ */
+#pragma once
+
+#include <errno.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifndef EOK
+#define EOK 0
+#endif
+
+#define _NTO_SIDE_CHANNEL        0x40000000
+#define _NTO_TCTL_IO             14
+#define _NTO_INTR_FLAGS_TRK_MSK  0x0004
+#define SIGEV_PULSE_PRIO_INHERIT (-1)
+
+#define _PULSE_CODE_MINAVAIL   0
+#define _PULSE_CODE_MAXAVAIL   127
+#define _PULSE_CODE_UNBLOCK    (-32)
+#define _PULSE_CODE_DISCONNECT (-33)
+
+#define _IO_BASE    0x100
+#define _IO_CONNECT 0x100
+#define _IO_MAX     0x1FF
+
+/*
+ * QNX sigevent fields of a pulse. glibc has no such members, the padding of
+ * its struct sigevent holds them.
+ */
+#define SIGEV_PULSE    4
+#define sigev_coid     _sigev_un._pad[0]
+#define sigev_priority _sigev_un._pad[1]
+#define sigev_code     _sigev_un._pad[2]
+
+#define SIGEV_PULSE_INIT(__e, __f, __p, __c, __v)                                   \
+    ((__e)->sigev_notify = SIGEV_PULSE, (__e)->sigev_coid = (__f),                  \
+     (__e)->sigev_priority = (__p), (__e)->sigev_code = (__c),                      \
+     (__e)->sigev_value.sival_int = (int) (__v))
+#define SIGEV_UNBLOCK_INIT(__e) ((__e)->sigev_notify = SIGEV_NONE)
+
+struct _pulse {
+    uint16_t type;
+    uint16_t subtype;
+    int8_t code;
+    uint8_t zero[3];
+    union sigval value;
+    int32_t scoid;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int ChannelCreate(unsigned flags);
+int ChannelDestroy(int chid);
+int ConnectAttach(uint32_t nd, pid_t pid, int chid, unsigned index, int flags);
+int ConnectDetach(int coid);
+
+int MsgSendPulse(int coid, int priority, int code, int value);
+int MsgReceivePulse(int chid, void *pulse, size_t bytes, void *info);
+int MsgReceive(int chid, void *msg, size_t bytes, void *info);
+int MsgReply(int rcvid, long status, const void *msg, size_t bytes);
+int MsgError(int rcvid, int error);
+int MsgRead(int rcvid, void *msg, size_t bytes, size_t offset);
+
+int ThreadCtl(int cmd, void *data);
+
+int InterruptEnable(void);
+int InterruptDisable(void);
+int InterruptAttach(int intr, const struct sigevent *(*handler)(void *, int),
+                    const void *area, int size, unsigned flags);
+int InterruptAttachEvent(int intr, const struct sigevent *event, unsigned flags);
+int InterruptDetach(int id);
+int InterruptMask(int intr, int id);
+int InterruptUnmask(int intr, int id);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,8 @@
+/*
+ * platform.h
+ *
+ *  Created on: 19.10.2026
+ *
+ * Linux host build: nothing platform specific is used.
+ */
+#pragma once
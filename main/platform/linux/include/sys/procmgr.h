@@ -0,0 +1,25 @@
+/*
+ * procmgr.h
+ *
+ *  Created on: 19.10.2026
+ *
+ * Linux host build: abilities are always granted.
+ */
+#pragma once
+
+#define PROCMGR_ADN_ROOT      0x00010000
+#define PROCMGR_ADN_NONROOT   0x00020000
+#define PROCMGR_AOP_ALLOW     0x00040000
+#define PROCMGR_AID_EOL       0
+#define PROCMGR_AID_IO        1
+#define PROCMGR_AID_INTERRUPT 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int procmgr_ability(pid_t pid, unsigned ability, ...);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,10 @@
+/*
+ * siginfo.h
+ *
+ *  Created on: 19.10.2026
+ *
+ * Linux host build: struct sigevent with the QNX pulse fields.
+ */
+#pragma once
+
+#include <sys/neutrino.h>
@@ -7,6 +7,7 @@
 #include "simqnxirq.h"
 #include "simqnxgpio.h"
 #include "simconfquery.h"
+#include "common/Quiescence.h"
 #include <sys/neutrino.h>
 #include <iostream>
 #include <sys/siginfo.h>
@@ -16,7 +17,7 @@ using namespace std;
 SimQNXIRQ::SimQNXIRQ() :
 		timestamp(0), lastADCRawValue(0),
 		gpio(nullptr),
-		run(0), pending(0),
+		run(0), pending(0), raising(false),
 		irqmasked_gpio(false), irqmasked_adc(false),
 		isr_handler_gpio(nullptr), isr_handler_adc(nullptr),
 		isr_area_gpio(nullptr),  isr_area_adc(nullptr),
@@ -104,6 +105,8 @@ void SimQNXIRQ::raiseISRGPIO() {
 		if (isr_result != NULL) {
 			if ((isr_result->sigev_notify == SIGEV_PULSE)
 					|| (isr_result->sigev_notify == (SIGEV_PULSE & 0x0f))) {
+				// pending until handled by the driver thread (headless)
+				Quiescence::getInstance().begin();
 				MsgSendPulse(isr_result->sigev_coid, isr_result->sigev_priority,
 						isr_result->sigev_code,
 						isr_result->sigev_value.sival_int);
@@ -120,6 +123,8 @@ void SimQNXIRQ::raiseISRADC() {
 		if (isr_result != NULL) {
 			if ((isr_result->sigev_notify == SIGEV_PULSE)
 					|| (isr_result->sigev_notify == (SIGEV_PULSE & 0x0f))) {
+				// pending until handled by the driver thread (headless)
+				Quiescence::getInstance().begin();
 				MsgSendPulse(isr_result->sigev_coid, isr_result->sigev_priority,
 						isr_result->sigev_code,
 						isr_result->sigev_value.sival_int);
@@ -134,6 +139,7 @@ void SimQNXIRQ::raiseEventGPIO() {
 		if ((event_gpio.sigev_notify == SIGEV_PULSE)
 				|| (event_gpio.sigev_notify == (SIGEV_PULSE & 0x0f))) {
 			irqmasked_gpio = true;
+			Quiescence::getInstance().begin();
 			MsgSendPulse(event_gpio.sigev_coid, event_gpio.sigev_priority,
 					event_gpio.sigev_code, event_gpio.sigev_value.sival_int);
 		}
@@ -145,6 +151,7 @@ void SimQNXIRQ::raiseEventADC() {
 		if ((event_adc.sigev_notify == (SIGEV_PULSE))
 				|| (event_adc.sigev_notify == (SIGEV_PULSE & 0x0f))) {
 			irqmasked_adc = true;
+			Quiescence::getInstance().begin();
 			MsgSendPulse(event_adc.sigev_coid, event_adc.sigev_priority,
 					event_adc.sigev_code, event_adc.sigev_value.sival_int);
 		}
@@ -217,6 +224,7 @@ void SimQNXIRQ::operator()() {
 			std::unique_lock<std::mutex> lock(runmutex);
 			cv.wait(lock, [this]{return pending;}); // wait on semaphore
 			pending = false;
+			raising = true;
 		}
 		//cout << "unlocked " << endl;
 
@@ -259,9 +267,18 @@ void SimQNXIRQ::operator()() {
 			cout << "<SIM> Error ISR locked by pending level IRQ ADC" << endl;
 		}
 
+		{
+			std::unique_lock<std::mutex> lock(runmutex);
+			raising = false;
+		}
 	}
 }
 
+bool SimQNXIRQ::isIdle(){
+	std::unique_lock<std::mutex> lock(runmutex);
+	return !pending && !raising;
+}
+
 void SimQNXIRQ::unmask_called(){
 	irqPending();
 }
@@ -30,6 +30,7 @@ private:
 	SimQNXGPIO* gpio;
 	bool run = true;
 	bool pending = false;
+	bool raising = false;   // raising the IRQs of a pending cycle
 	// QNX-API
 	bool irqmasked_gpio;
 	bool irqmasked_adc;
@@ -66,6 +67,10 @@ public:
 	void operator()();
 	void unmask_called();
 	void irqPending();
+	/**
+	 * @return true if no IRQs are pending or being raised (headless mode)
+	 */
+	bool isIdle();
 	void kill() {run = false;};
 
 	// IRQ handling
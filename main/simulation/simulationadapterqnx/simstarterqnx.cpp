@@ -10,6 +10,10 @@
 #include "simqnxgpio.h"
 #include "simstarterqnx.h"
 #include <iostream>
+#ifdef SIM_SCENARIO
+#include <fstream>
+#include <sstream>
+#endif
 
 using namespace std;
 
@@ -29,6 +33,10 @@ bool simulationStart() {
 #error System B defined without defining to be a Twin-system
 #endif
 
+#if defined(SIM_HEADLESS) && defined(SIM_TWIN)
+#error Headless mode is not allowed for Twin-systems
+#endif
+
 SimulationStarterQNX::SimulationStarterQNX() {
     // Sim HCI UDP support
     simudpconf = new UDPConfigFileReader(0, std::string("/simudp.conf"));
@@ -73,6 +81,10 @@ SimulationStarterQNX::SimulationStarterQNX() {
 #endif
     }
 
+#ifdef SIM_SCENARIO
+    loadScenario(SIM_SCENARIO);
+#endif
+
     confhandler = new SimConfHandler();
 
 #ifdef SIM_TWIN
@@ -84,6 +96,22 @@ SimulationStarterQNX::SimulationStarterQNX() {
 #endif
 
     if (sim != nullptr) {
+        sim->setTimeslice(SIM_TIMESLICE);
+        sim->setSubstep(SIM_SUBSTEP);
+#ifdef SIM_HEADLESS
+        // Application timers and sleeps follow the simulation time, the clock
+        // has to be advanced before the GPIO raises the IRQs of a cycle.
+        // The clock waits until the IRQs, events and due timers of the last
+        // cycle are handled.
+        virtualclock = new VirtualClock();
+        Clock::setInstance(virtualclock);
+        Quiescence::getInstance().setEnabled(true);
+        Quiescence::getInstance().addProbe([](){ return SimQNXIRQ::getSimIRQ()->isIdle(); });
+        Quiescence::getInstance().addProbe([](){ return TimerService::getInstance().isIdle(); });
+        clockadvancer = new SimClockAdvancer([this](unsigned int ms){ virtualclock->advance(ms); },
+                [](){ return Quiescence::getInstance().waitIdle(SIM_HEADLESS_IDLE_TIMEOUT); });
+        sim->addCycleEndHandler(clockadvancer);
+#endif
         SimQNXGPIO::getGPIO()->setSimulation(sim);
         sim->addCycleEndHandler(SimQNXGPIO::getGPIO());
     }
@@ -94,27 +122,67 @@ SimulationStarterQNX::SimulationStarterQNX() {
         SimQNXGPIO::getGPIO()->setIRQHandler(SimQNXIRQ::getSimIRQ());
     }
     if (sim != nullptr) {
-        simrunner = new SimulationExecuter(sim, SimulationBase::timeslice);
+#ifdef SIM_HEADLESS
+        simrunner = new SimulationExecuter(sim, sim->getTimeslice(), true, SIM_HEADLESS_SPEEDUP);
+#else
+        // the configured timeslice in real time, sub-steps are paced by the simulation
+        sim->setRealTime(true);
+        simrunner = new SimulationExecuter(sim, sim->getTimeslice());
+#endif
         simrunnerthread = new thread(*simrunner);
     }
     simulationStarted = (sim != nullptr) && (simrunner != nullptr) && (simrunnerthread != nullptr);
 
     simreporthandling = new UDPSenderSimReport(*simudpconf);
     sim->addReportHandler(simreporthandling);
+#ifdef SIM_REPORT_FILE
+    simreportfile = new SimReportFileSink(SIM_REPORT_FILE);
+    sim->addReportHandler(simreportfile);
+#endif
 
 #if defined(SIM_TWIN) || defined(SIM_EXT_CTRL)
     simctrlh = new SimCtrlHandler(sim);
     simjsonmh = new SimJSONMessageHandler(handler, simctrlh, hci, confhandler);
     simrecvitemhandling = new UDPReceiverThreadSimItemHandling(*simudpconf, simjsonmh);
+#ifdef SIM_UDP_IOTHREAD
+    // one thread serves the sockets of the simulation
+    simudpiothread = new UDPIOThread();
+    if (simrecvitemhandling->open() >= 0) {
+        simudpiothread->addEndpoint(simrecvitemhandling);
+    }
+    simupdreceiverthread = new thread(std::ref(*simudpiothread));
+#else
     simupdreceiverthread = new thread(std::ref(*simrecvitemhandling));
 #endif
+#endif
 #ifdef SIM_TWIN
     sim->setDropHandler(drophandler);
+    sim->addCycleEndHandler(drophandler);
 #endif
     cout << "QNX-Sim (version " << SimulationBase::simVersionCode << ") configuration "
             << (simulationStarted ? "completed" : "failed") << endl;
 }
 
+#ifdef SIM_SCENARIO
+void SimulationStarterQNX::loadScenario(const char *filename) {
+    ifstream file(filename);
+    stringstream description;
+    description << file.rdbuf();
+    SimScenarioGenerator generator;
+    SimScenario scenario;
+    if (!file || !generator.generate(description.str(), SIM_SCENARIO_SEED, scenario)) {
+        cout << "<SIM> Error, scenario " << filename << " not loaded " << generator.error() << endl;
+        return;
+    }
+    for (const auto &action : scenario.script) {
+        handler->addAction(action);
+    }
+    for (const auto &action : scenario.hciScript) {
+        hci->addAction(action);
+    }
+}
+#endif
+
 unsigned long SimulationStarterQNX::currentSimTime(){
     unsigned long result = 0;
     if(nullptr!=sim){
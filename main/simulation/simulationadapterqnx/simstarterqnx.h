@@ -15,13 +15,41 @@
 #include "simitemhandling.h"
 #include "simqnxirq.h"
 #include "UDPSendersimreport.h"
+#ifdef SIM_REPORT_FILE
+#include "simreportfilesink.h"
+#endif
 #if defined(SIM_TWIN) || defined(SIM_MANUAL_START) || defined(SIM_EXT_CTRL)
 #include "UDPConfigFileReader.h"
 #include "UDPReceiverThreadSimItemHandling.h"
+#include "UDPIOThread.h"
 #include "UDPSendersim.h"
 #include "simjsonmessagehandler.h"
 #include "simctrlhandler.h"
 #endif
+#ifdef SIM_SCENARIO
+#include "simscenariogenerator.h"
+#ifndef SIM_SCENARIO_SEED
+#define SIM_SCENARIO_SEED 1
+#endif
+#endif
+#ifndef SIM_TIMESLICE
+#define SIM_TIMESLICE SimulationBase::timeslice
+#endif
+#ifndef SIM_SUBSTEP
+#define SIM_SUBSTEP 0
+#endif
+#ifdef SIM_HEADLESS
+#include "common/Clock.h"
+#include "common/Quiescence.h"
+#include "common/TimerService.h"
+#include "simclockadvancer.h"
+#ifndef SIM_HEADLESS_SPEEDUP
+#define SIM_HEADLESS_SPEEDUP 0
+#endif
+#ifndef SIM_HEADLESS_IDLE_TIMEOUT
+#define SIM_HEADLESS_IDLE_TIMEOUT 200
+#endif
+#endif
 #include <thread>
 
 class SimulationStarterQNX {
@@ -36,10 +64,20 @@ private:
     thread *simrunnerthread = nullptr;
     thread *simirqthread = nullptr;
     UDPSenderSimReport* simreporthandling = nullptr;
+#ifdef SIM_REPORT_FILE
+    SimReportFileSink *simreportfile = nullptr;
+#endif
     UDPConfigFileReader *simudpconf = nullptr;
+#ifdef SIM_HEADLESS
+    VirtualClock *virtualclock = nullptr;
+    SimClockAdvancer *clockadvancer = nullptr;
+#endif
 #if defined(SIM_TWIN) || defined(SIM_EXT_CTRL)
     UDPReceiverThreadSimItemHandling *simrecvitemhandling = nullptr;
     thread *simupdreceiverthread = nullptr;
+#ifdef SIM_UDP_IOTHREAD
+    UDPIOThread *simudpiothread = nullptr;
+#endif
     SimJSONMessageHandler *simjsonmh = nullptr;
     SimCtrlHandler *simctrlh = nullptr;
     UDPSenderSim* drophandler = nullptr;
@@ -52,6 +90,10 @@ public:
     }
     unsigned long currentSimTime();
     void startSimulation();
+private:
+#ifdef SIM_SCENARIO
+    void loadScenario(const char *filename);
+#endif
 };
 extern SimulationStarterQNX *simulationStarter;
 
@@ -18,6 +18,7 @@ public:
     static constexpr unsigned int realTimeSlice = 20;   // Do step only if this time has expired since last call
     static constexpr unsigned int simVersionCode = 22;
     static constexpr unsigned int displayEachNCycle = 10;
+    static constexpr unsigned int itemCapacity = 16384;     // max. items in one simulation
 };
 
 
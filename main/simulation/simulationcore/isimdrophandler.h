@@ -8,7 +8,6 @@
 #ifndef SRC_SIMULATIONCORE_ISIMDROPHANDLER_H_
 #define SRC_SIMULATIONCORE_ISIMDROPHANDLER_H_
 
-#include <memory>
 #include "simitem.h"
 
 using namespace std;
@@ -16,7 +15,8 @@ using namespace std;
 class ISimDropHandler{
 public:
 	virtual ~ISimDropHandler(){};
-	virtual void dropEnd(shared_ptr<SimItem> droppeditem)=0;
+	// the item is destroyed by the next housekeeping, do not keep it
+	virtual void dropEnd(SimItem *droppeditem)=0;
 };
 
 #endif /* SRC_SIMULATIONCORE_ISIMDROPHANDLER_H_ */
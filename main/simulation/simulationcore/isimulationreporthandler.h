@@ -7,12 +7,16 @@
 #ifndef ISIMULATIONREPORTHANDLER_H
 #define ISIMULATIONREPORTHANDLER_H
 
-#include <string>
+#include <cstdint>
 
 class ISimulationReportHandler{
 public:
     virtual ~ISimulationReportHandler(){};
-    virtual void handlereport(const std::string jsonreport)=0;
+    /**
+     * @param report Binary report of the cycle (see simreport.h), only valid
+     * during the call
+     */
+    virtual void handlereport(const uint8_t *report, unsigned int size)=0;
 };
 
 
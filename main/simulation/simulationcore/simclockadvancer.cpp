@@ -0,0 +1,22 @@
+/* 
+ * File:   simclockadvancer.cpp
+ * @date 19. Oktober 2026
+ */
+
+#include "simclockadvancer.h"
+#include <iostream>
+
+SimClockAdvancer::SimClockAdvancer(TimeAdvancer advanceTime, IdleWaiter waitIdle)
+        : advanceTime(advanceTime), waitIdle(waitIdle), lastSimTime(0) {
+}
+
+void SimClockAdvancer::cycleCompletedWith(unsigned long simulationtime, const SimulationIOImage &result, unsigned short ADCRaw) {
+    // simulation time restarts on init()
+    if (simulationtime > lastSimTime && advanceTime) {
+        if (waitIdle && !waitIdle()) {
+            cout << "<SIM> Warning: application still busy at " << lastSimTime << " ms, advancing anyway" << endl;
+        }
+        advanceTime(simulationtime - lastSimTime);
+    }
+    lastSimTime = simulationtime;
+}
@@ -0,0 +1,43 @@
+/* 
+ * File:   simclockadvancer.h
+ * @date 19. Oktober 2026
+ */
+
+#ifndef SIMCLOCKADVANCER_H
+#define SIMCLOCKADVANCER_H
+
+#include "isimulationcycleendhandler.h"
+#include <functional>
+
+using namespace std;
+
+/**
+ * Headless mode: advances the clock of the application to the time of each
+ * completed cycle (or sub-step). Has to be registered as first cycle end
+ * handler, so the application sees the new time together with the edges.
+ *
+ * With an idle waiter the clock is only advanced after the application has
+ * handled everything of the previous cycle (quiescence barrier), otherwise
+ * the belt could run ahead of the control logic.
+ */
+class SimClockAdvancer : public ISimulationCycleEndHandler {
+public:
+    /**
+     * Advances the time of the application by the given milliseconds.
+     */
+    typedef function<void(unsigned int)> TimeAdvancer;
+    /**
+     * Blocks until the application is idle.
+     * @return false if the application is still busy (timeout)
+     */
+    typedef function<bool()> IdleWaiter;
+private:
+    TimeAdvancer advanceTime;
+    IdleWaiter waitIdle;
+    unsigned long lastSimTime;
+public:
+    SimClockAdvancer(TimeAdvancer advanceTime, IdleWaiter waitIdle = nullptr);
+    void cycleCompletedWith(unsigned long simulationtime, const SimulationIOImage &result, unsigned short ADCRaw) override;
+};
+
+#endif /* SIMCLOCKADVANCER_H */
@@ -20,6 +20,8 @@ const char* SimConfiguration::SimConfStrings[] = {
 };
 #undef SIMCONF
 
+thread_local bool SimConfiguration::quiet = false;
+
 int SimConfiguration::string_table_size(){
     int len = 0;
 
@@ -43,18 +45,32 @@ SimConfiguration::SimConfiguration(){
     setToDefault();
 }
 
+void SimConfiguration::setQuiet(bool enable){
+    quiet = enable;
+}
+
+bool SimConfiguration::isQuiet(){
+    return quiet;
+}
+
 SimConfiguration* SimConfiguration::getInstance(){
     static SimConfiguration configuration;
     return &configuration;
 }
 
 bool SimConfiguration::isactive(SimConfCodes parametercode){
+	if (quiet) {
+		return false;
+	}
 	int index = static_cast<int>(parametercode);
 	bool querryResult = config_parameter[index];
     return querryResult;
 }
 
 bool SimConfiguration::isactive(std::string parametername){
+    if (quiet) {
+        return false;
+    }
     return config_parameter[static_cast<int>(config_names[parametername])];
 }
 
@@ -114,32 +130,46 @@ bool SimConfiguration::configSetTo(std::string parameter, bool value){
 	return valid_parameter;
 }
 
-bool SimConfiguration::evalPair(const char* key, const char* value){
-    std::cout << key << " : " << value << std::endl;
+SimConfCodes SimConfiguration::codeOf(SimJSONView name){
+    SimConfCodes code = SimConfCodes::None;
+
+    switch (simJSONHash(name)) {
+#define SIMCONF(X) case simJSONHash(#X): code = (name == #X) ? SimConfCodes::X : SimConfCodes::None; break;
+#include "simconfparameter.h"
+#undef SIMCONF
+        default:
+            ;
+    }
+    return code;
+}
+
+bool SimConfiguration::evalPair(SimJSONView key, SimJSONView value){
+    std::cout << key.str() << " : " << value.str() << std::endl;
     bool validPair = false;
 
-    if (std::string("type") == key) {
-        if (std::string("simconfig") == value) {
+    if (key == "type") {
+        if (value == "simconfig") {
             validPair = true; // got valid string
         }
     } else {
-        if(config_names.count(key)==1) {
-            if (std::string("true") == value) {
-                config_parameter[static_cast<int>(config_names[key])] = true;
+        SimConfCodes code = codeOf(key);
+        if(code != SimConfCodes::None) {
+            if (value == "true") {
+                config_parameter[static_cast<int>(code)] = true;
                 validPair = true; // got valid string
             }
-            if (std::string("false") == value) {
-                config_parameter[static_cast<int>(config_names[key])] = false;
+            if (value == "false") {
+                config_parameter[static_cast<int>(code)] = false;
                 validPair = true; // got valid string
             }
         } else {
-            std::cout << "<SimConfig> Error, unknown parameter: " << key << std::endl;
+            std::cout << "<SimConfig> Error, unknown parameter: " << key.str() << std::endl;
         }
     }
     return validPair;
 }
 
-bool SimConfiguration::evalPair(const char* key, double value){
+bool SimConfiguration::evalPair(SimJSONView key, double value){
     return false;
 }
 
@@ -26,15 +26,27 @@ class SimConfiguration : public SimJSONBase {
 private:
     std::vector<bool> config_parameter;
     std::map<std::string, SimConfCodes> config_names;
+    static thread_local bool quiet;
     SimConfiguration();
 public:
     static const char* SimConfStrings[];
     static int string_table_size();
+    /**
+     * @return code of the parameter name, SimConfCodes::None if unknown
+     */
+    static SimConfCodes codeOf(SimJSONView name);
 public:
     ~SimConfiguration(){};
     static SimConfiguration* getInstance();
     bool isactive(SimConfCodes parametercode);
     bool isactive(std::string parametername);
+    /**
+     * Quiet mode of the calling thread: all parameters are reported as
+     * inactive, so simulations of the thread do not write to the console
+     * (e.g. the workers of the scenario runner).
+     */
+    static void setQuiet(bool enable);
+    static bool isQuiet();
     void activate(SimConfCodes parametercode);
     void deactivate(SimConfCodes parametercode);
     bool configSetTo(std::string parameter, bool value);
@@ -44,8 +56,8 @@ public:
     void readFromFile(std::string configfilename="simconf.json");
     virtual std::string toJSONString();
 protected:    
-    virtual bool evalPair(const char* key, const char* value);
-    virtual bool evalPair(const char* key, double value);
+    virtual bool evalPair(SimJSONView key, SimJSONView value);
+    virtual bool evalPair(SimJSONView key, double value);
     virtual void setToDefault();
 };
 
@@ -31,42 +31,45 @@ SimConfAction::SimConfAction(unsigned int atTime, const std::string& parameter,
     }
 }
 
-bool SimConfAction::evalPair(const char* key, const char* value) {
+bool SimConfAction::evalPair(SimJSONView key, SimJSONView value) {
     //cout << "text>" << key << ":" << value << endl;
     bool validPair = false;
-    if (string("type") == key) {
-        if (string("simconfaction") == value) {
-            validPair = true; // got valid string
-        }
-    }
-    if (string("parameter") == key) {
-        unsigned int table_size = SimConfiguration::string_table_size();
-        for(unsigned int index=0; index<table_size; index++){
-            std::string temp = SimConfiguration::SimConfStrings[index];
-            if(temp == value){
-                parameter2configure = static_cast<SimConfCodes>(index);
-                validPair = true; // got valid string
+    switch (simJSONHash(key)) {
+        case simJSONHash("type"):
+            validPair = (key == "type") && (value == "simconfaction"); // got valid string
+            break;
+        case simJSONHash("parameter"):
+            if (key == "parameter") {
+                SimConfCodes code = SimConfiguration::codeOf(value);
+                if (code != SimConfCodes::None) {
+                    parameter2configure = code;
+                    validPair = true; // got valid string
+                }
             }
-        }
-    }
-    if (string("value") == key) {
-       if (std::string("true") == value) {
-            value2configure = true;
-            validPair = true; // got valid string
-        }
-        if (std::string("false") == value) {
-            value2configure = false;
-            validPair = true; // got valid string
-        }
+            break;
+        case simJSONHash("value"):
+            if (key == "value") {
+                if (value == "true") {
+                    value2configure = true;
+                    validPair = true; // got valid string
+                }
+                if (value == "false") {
+                    value2configure = false;
+                    validPair = true; // got valid string
+                }
+            }
+            break;
+        default:
+            ;
     }
     //cout << "valid:" << (validPair?"T":"F") << endl;
     return validPair;
 };
 
-bool SimConfAction::evalPair(const char* key, double value) {
+bool SimConfAction::evalPair(SimJSONView key, double value) {
     //cout << "nummeric>" << key << ":" << value << endl;
     bool validPair = false;
-    if (std::string("atTime") == key) {
+    if (simJSONHash(key) == simJSONHash("atTime") && key == "atTime") {
         atTime = (int) value;
         validPair = true;
     }
@@ -20,14 +20,14 @@ public:
     SimConfCodes parameter2configure;
     bool value2configure;
 public:
-    SimConfAction() = default;
+    SimConfAction() : executed(false), atTime(0), parameter2configure(SimConfCodes::None), value2configure(false) {};
     SimConfAction(unsigned int atTime, const std::string& parameter, bool value);
     SimConfAction(const std::string& parameter, bool value);
     ~SimConfAction(){};
     std::string toJSONString() override;
 private:
-    bool evalPair(const char* key, const char* value) override;
-    bool evalPair(const char* key, double value) override;
+    bool evalPair(SimJSONView key, SimJSONView value) override;
+    bool evalPair(SimJSONView key, double value) override;
     void setToDefault()override;
 };
 
@@ -6,9 +6,11 @@
 
 #include "simconveyorbelt.h"
 #include "simconfquery.h"
+#include "simitemindex.h"
 
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 using namespace std;
 
@@ -19,19 +21,19 @@ using namespace std;
 #define BELT_GUIDANCE_RAMP_BEGIN 200.0
 #define BELT_GUIDANCE_LENGTH     300.0
 
-SimConveyorBelt::SimConveyorBelt(vector<shared_ptr<SimItem>> *items,
+SimConveyorBelt::SimConveyorBelt(vector<SimItem *> *items, SimItemStore *itemstore,
         SimSlide* slide, SimDrive* drive, ISimSeparator* separator) :
-        items(items), slide(slide), drive(drive), separator(separator), 
+        items(items), itemstore(itemstore), slide(slide), drive(drive), separator(separator), 
         speedX(0.0), speedY(0.0), dh(nullptr), 
         displayCounter(SimulationBase::displayEachNCycle - 1), previousMode(false) {
-    speedX = SPEED_X_NORMAL * SimulationBase::timeslice / 1000.0; // x mm/s * sim cycle time/step --> mm / step, reduced to improve sampling
-    speedY = SPEED_Y_NORMAL * SimulationBase::timeslice / 1000.0; // y mm/s * sim cycle time/step --> mm / step
+    speedX = SPEED_X_NORMAL / 1000.0; // x mm/s --> mm / ms, multiplied with the step duration
+    speedY = SPEED_Y_NORMAL / 1000.0; // y mm/s --> mm / ms
     if (separator != NULL) {
         previousMode = separator->isModePassing();
     }
 }
 
-bool SimConveyorBelt::positionOnBelt(const shared_ptr<SimItem> &item){
+bool SimConveyorBelt::positionOnBelt(SimItem *item){
 	bool result = false;
 
 	result = (item->x >= BELT_POS_DROP_LEFT) && (item->x <= BELT_POS_DROP_RIGHT);
@@ -40,7 +42,7 @@ bool SimConveyorBelt::positionOnBelt(const shared_ptr<SimItem> &item){
 	return result;
 }
 
-bool SimConveyorBelt::collisions(const shared_ptr<SimItem> &item){
+bool SimConveyorBelt::collisions(SimItem *item){
 	bool collision = false;
 
 	if((item->y < BELT_POS_LOWER_LIMIT) || (item->y > BELT_POS_UPPER_LIMIT)){
@@ -68,10 +70,10 @@ bool SimConveyorBelt::collisions(const shared_ptr<SimItem> &item){
 	return collision;
 }
 
-void SimConveyorBelt::addItem(const shared_ptr<SimItem> &item) {
+void SimConveyorBelt::addItem(SimItem *item) {
     if (items != nullptr) {
         if(positionOnBelt(item) && !collisions(item)) {
-            items->push_back(item);
+            SimItemIndex::insert(items, item);
         }
         else {
         	item->state=ItemState::removed;
@@ -79,8 +81,8 @@ void SimConveyorBelt::addItem(const shared_ptr<SimItem> &item) {
     }
 }
 
-void SimConveyorBelt::evalTimeStep(unsigned int simTime) {
-    vector<shared_ptr<SimItem>>::iterator it;
+void SimConveyorBelt::evalTimeStep(unsigned int simTime, unsigned int duration) {
+    vector<SimItem *>::iterator it;
     double currentSpeed = 0.0;
     double stepX = 0.0;
     double stepY = 0.0;
@@ -91,15 +93,17 @@ void SimConveyorBelt::evalTimeStep(unsigned int simTime) {
         double phi1 = (2 * M_PI) * ((double) (simTime - (simTime / 8000)*8000) / 8000.0);
         double phi2 = (2 * M_PI) * ((double) (simTime - (simTime / 17000)*17000) / 17000.0);
         //cout << "phi:" << phi1 << " Factor:" << 1+sin(phi1)*0.1 << endl;
-        stepX = speedX * currentSpeed * (1 + sin(phi1)*0.1 + sin(phi2)*0.05);
+        stepX = speedX * duration * currentSpeed * (1 + sin(phi1)*0.1 + sin(phi2)*0.05);
 #else
-        stepX = speedX * currentSpeed;
+        stepX = speedX * duration * currentSpeed;
 #endif
-        stepY = speedY * currentSpeed;
+        stepY = speedY * duration * currentSpeed;
     }
     //cout << "x increment:" << stepX << endl;
     if (items != nullptr) {
-        for (it = items->begin(); it != items->end(); ++it) {
+        // items around the separator need the detailed evaluation
+        SimItemIndex::Range range = SimItemIndex::inRange(items, separator->getPosition(), 40.0 + abs(stepX));
+        for (it = range.first; it != range.second; ++it) {
             double current_x = (*it)->x;
             if (current_x >= BELT_POS_DROP_LEFT && current_x <= BELT_POS_DROP_RIGHT) {
                 if (separator->isPusher()) {
@@ -152,7 +156,16 @@ void SimConveyorBelt::evalTimeStep(unsigned int simTime) {
                         (*it)->x = current_x + stepX;
                     }
                 }
+                itemstore->flags[(*it)->getSlot()] |= SIM_ITEM_FLAG_STEPPED;
             }
+        }
+        // all other items simply move with the belt
+        itemstore->moveBelt(stepX, BELT_POS_DROP_LEFT, BELT_POS_DROP_RIGHT);
+        SimItemIndex::restoreOrder(items);
+
+        // only items at the ramp can collide
+        range = SimItemIndex::inRange(items, BELT_GUIDANCE_RAMP_BEGIN - 8 + 19, 19);
+        for (it = range.first; it != range.second; ++it) {
             // Ramp collisions
             if(((*it)->x > BELT_GUIDANCE_RAMP_BEGIN-8) && ((*it)->x <= BELT_GUIDANCE_RAMP_BEGIN-8+38)){
             	// in Ramp section
@@ -167,9 +180,12 @@ void SimConveyorBelt::evalTimeStep(unsigned int simTime) {
         			}
             	}
             }
+        }
 
-            if (SIMCONFQUERRY_ISACTIVE(showpositions)) {
+        SimItemIndex::restoreOrder(items);
 
+        if (SIMCONFQUERRY_ISACTIVE(showpositions)) {
+            for (it = items->begin(); it != items->end(); ++it) {
 				if (displayCounter <= 0) {
 					cout << "<SIM> " << (*it)->x << ", " << (*it)->y << endl;
 					displayCounter = SimulationBase::displayEachNCycle - 1;
@@ -180,8 +196,9 @@ void SimConveyorBelt::evalTimeStep(unsigned int simTime) {
         }
         previousMode = separator->isModePassing();
 
-        it = items->begin();
-        while (it != items->end()) {
+        // remaining items are moved to the front, no erase in the middle
+        vector<SimItem *>::iterator keep = items->begin();
+        for (it = items->begin(); it != items->end(); ++it) {
             // check dropped
             bool erase = false;
             if ((*it)->state == ItemState::removed) {
@@ -213,13 +230,22 @@ void SimConveyorBelt::evalTimeStep(unsigned int simTime) {
                     }
                 }
             }
-            if (erase) {
-            	//(*it)->state = ItemState::removed;
-                it = items->erase(it);
-            } else {
-                it++;
+            if (!erase) {
+                if (keep != it) {
+                    *keep = std::move(*it);
+                }
+                ++keep;
             }
         }
+        items->erase(keep, items->end());
+    }
+}
+
+void SimConveyorBelt::housekeeping() {
+    if (items != nullptr) {
+        items->erase(remove_if(items->begin(), items->end(), [](SimItem *item) {
+            return item->state != ItemState::onBelt;
+        }), items->end());
     }
 }
 
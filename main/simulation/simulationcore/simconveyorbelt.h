@@ -22,7 +22,8 @@ using namespace std;
 
 class SimConveyorBelt{
 private:
-    vector<shared_ptr<SimItem>> *items;
+    vector<SimItem *> *items;
+    SimItemStore *itemstore;
     SimSlide *slide;
     SimDrive *drive;
     ISimSeparator *separator;
@@ -32,12 +33,13 @@ private:
     int displayCounter;
     bool previousMode;
 public:
-    SimConveyorBelt(vector<shared_ptr<SimItem>> *items, SimSlide *slide, SimDrive *drive, ISimSeparator *separator);
-    void addItem(const shared_ptr<SimItem> &item);
-    void evalTimeStep(unsigned int simTime);
+    SimConveyorBelt(vector<SimItem *> *items, SimItemStore *itemstore, SimSlide *slide, SimDrive *drive, ISimSeparator *separator);
+    void addItem(SimItem *item);
+    void evalTimeStep(unsigned int simTime, unsigned int duration);
+    void housekeeping();   // drops items no longer on the belt from the list
     void setDropHandler(ISimDropHandler* dh);
-    bool positionOnBelt(const shared_ptr<SimItem>  &item);
-    bool collisions(const shared_ptr<SimItem>  &item);
+    bool positionOnBelt(SimItem *item);
+    bool collisions(SimItem *item);
 };
 
 #endif /* SIMCONVEYORBELT_H */
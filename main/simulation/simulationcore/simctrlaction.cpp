@@ -17,32 +17,36 @@ SimCtrlAction::SimCtrlAction(const std::string& command) : start(false), restart
     }
 }
 
-bool SimCtrlAction::evalPair(const char* key, const char* value) {
+bool SimCtrlAction::evalPair(SimJSONView key, SimJSONView value) {
     //cout << "text>" << key << ":" << value << endl;
     bool validPair = false;
-    if (string("type") == key) {
-        if (string("simctrl") == value) {
-            validPair = true; // got valid string
-        }
-    }
-    if (string("action") == key) {
-        if (string("nop") == value) {
-            validPair = true;
-        }
-        if (string("start") == value) {
-            start = true;
-            validPair = true;
-        }
-        if (string("restart") == value) {
-            restart = true;
-            validPair = true;
-        }
+    switch (simJSONHash(key)) {
+        case simJSONHash("type"):
+            validPair = (key == "type") && (value == "simctrl"); // got valid string
+            break;
+        case simJSONHash("action"):
+            if (key == "action") {
+                if (value == "nop") {
+                    validPair = true;
+                }
+                if (value == "start") {
+                    start = true;
+                    validPair = true;
+                }
+                if (value == "restart") {
+                    restart = true;
+                    validPair = true;
+                }
+            }
+            break;
+        default:
+            ;
     }
     //cout << "valid:" << (validPair?"T":"F") << endl;
     return validPair;
 };
 
-bool SimCtrlAction::evalPair(const char* key, double value) {
+bool SimCtrlAction::evalPair(SimJSONView key, double value) {
     //cout << "nummeric>" << key << ":" << value << endl;
     bool validPair = false;
     // this object has no digits
@@ -25,8 +25,8 @@ public:
     bool isCommandStart(){return (start && !restart);};
     bool isCommandRestart(){return (!start && restart);};
 private:
-    bool evalPair(const char* key, const char* value) override;
-    bool evalPair(const char* key, double value)override;
+    bool evalPair(SimJSONView key, SimJSONView value) override;
+    bool evalPair(SimJSONView key, double value) override;
     void setToDefault()override;
 };
 
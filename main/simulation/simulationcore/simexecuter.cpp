@@ -1,4 +1,3 @@
-
 /* 
  * File:   simexecutionthread.cpp
  * @author Lehmann
@@ -14,17 +13,40 @@ using namespace std;
 
 void SimulationExecuter::operator()() {
     if (simulation != nullptr && timeslice > 0) {
-        std::chrono::time_point<std::chrono::high_resolution_clock> lastUpdateTimeHigh;
-        std::chrono::time_point<std::chrono::high_resolution_clock> nowHigh;
+        if (headless) {
+            runHeadless();
+        } else {
+            runRealTime();
+        }
+    }
+}
+
+void SimulationExecuter::runRealTime() {
+    std::chrono::time_point<std::chrono::high_resolution_clock> lastUpdateTimeHigh;
+    std::chrono::time_point<std::chrono::high_resolution_clock> nowHigh;
+
+    lastUpdateTimeHigh = std::chrono::high_resolution_clock::now();
+    while (run) {
+        // paced sub-steps take part of the timeslice, wait only for the rest
+        std::this_thread::sleep_until(lastUpdateTimeHigh + std::chrono::milliseconds(timeslice));
+        nowHigh = std::chrono::high_resolution_clock::now();
+        int elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds> (nowHigh - lastUpdateTimeHigh).count();
+        lastUpdateTimeHigh = nowHigh;
+        //cout << "call with:" << elapsed_milliseconds << endl;
+        simulation->simulateTime(elapsed_milliseconds);
+    }
+}
 
-        lastUpdateTimeHigh = std::chrono::high_resolution_clock::now();
-        while (run) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(timeslice));
-            nowHigh = std::chrono::high_resolution_clock::now();
-            int elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds> (nowHigh - lastUpdateTimeHigh).count();
-            lastUpdateTimeHigh = nowHigh;
-            //cout << "call with:" << elapsed_milliseconds << endl;
-            simulation->simulateTime(elapsed_milliseconds);
+void SimulationExecuter::runHeadless() {
+    std::chrono::microseconds realSlice(speedup > 0 ? (timeslice * 1000) / speedup : 0);
+    while (run) {
+        simulation->simulateTime(timeslice);
+        if (realSlice.count() > 0) {
+            std::this_thread::sleep_for(realSlice);
+        } else {
+            // the clock advancer waits until the application is idle, the
+            // yield only gives the application threads the CPU earlier
+            std::this_thread::yield();
         }
     }
 }
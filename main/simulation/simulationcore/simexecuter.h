@@ -14,8 +14,19 @@ private:
     ISimlationExecution *simulation;
     unsigned int timeslice = 200;
     bool run = true;
+    bool headless = false;
+    unsigned int speedup = 0;
+    void runRealTime();
+    void runHeadless();
 public:
     SimulationExecuter(ISimlationExecution *simulation, unsigned int timeslice): simulation(simulation), timeslice(timeslice), run(true){};
+    /**
+     * Headless mode: simulation time is not coupled to the wall clock, the
+     * application clock follows the simulated cycles (see SimClockAdvancer).
+     * 
+     * @param speedup Factor relative to real time, 0 runs as fast as possible.
+     */
+    SimulationExecuter(ISimlationExecution *simulation, unsigned int timeslice, bool headless, unsigned int speedup = 0): simulation(simulation), timeslice(timeslice), run(true), headless(headless), speedup(speedup){};
     void operator()();
 };
 #endif /* SIMLATIONEXECUTIONTHREAD_H */
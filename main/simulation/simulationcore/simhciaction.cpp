@@ -78,41 +78,46 @@ void SimHCIAction::setToDefault() {
     pattern = SIM_BUTTON_STOP | SIM_EMERGENCY_STOP;
 }
 
-bool SimHCIAction::evalPair(const char* key, const char* value) {
+bool SimHCIAction::evalPair(SimJSONView key, SimJSONView value) {
     //cout << "text>" << key << ":" << value << endl;
     bool validPair = false;
-    if (std::string("type") == key) {
-        if (std::string("hciaction") == value) {
-            validPair = true;   // got valid string
-        }        
+    if (simJSONHash(key) == simJSONHash("type") && key == "type") {
+        validPair = (value == "hciaction");   // got valid string
     }
     //cout << "valid:" << (validPair?"T":"F") << endl;
     return validPair;
 };
 
-bool SimHCIAction::evalPair(const char* key, double value) {
+bool SimHCIAction::evalPair(SimJSONView key, double value) {
     //cout << "nummeric>" << key << ":" << value << endl;
     bool validPair = false;
-    if (std::string("atTime") == key) {
-        atTime = (int) value;
-        validPair = true;
-    }
-    if (std::string("pattern") == key) {
-        pattern = SIM_BUTTON_STOP | SIM_EMERGENCY_STOP;;
-        if(((int)value) & 0x01){
-           pattern = pattern | SIM_BUTTON_START;
-        };
-        if(((int)value) & 0x02){  // active low;
-           pattern = pattern & (~SIM_BUTTON_STOP);
-        };
-        if(((int)value) & 0x04){
-           pattern = pattern | SIM_BUTTON_RESET;
-        };
-        if(((int)value) & 0x08){  // active low
-           pattern = pattern & (~SIM_EMERGENCY_STOP);
-        };
-        
-        validPair = true;
+    switch (simJSONHash(key)) {
+        case simJSONHash("atTime"):
+            if (key == "atTime") {
+                atTime = (int) value;
+                validPair = true;
+            }
+            break;
+        case simJSONHash("pattern"):
+            if (key == "pattern") {
+                pattern = SIM_BUTTON_STOP | SIM_EMERGENCY_STOP;;
+                if(((int)value) & 0x01){
+                   pattern = pattern | SIM_BUTTON_START;
+                };
+                if(((int)value) & 0x02){  // active low;
+                   pattern = pattern & (~SIM_BUTTON_STOP);
+                };
+                if(((int)value) & 0x04){
+                   pattern = pattern | SIM_BUTTON_RESET;
+                };
+                if(((int)value) & 0x08){  // active low
+                   pattern = pattern & (~SIM_EMERGENCY_STOP);
+                };
+                validPair = true;
+            }
+            break;
+        default:
+            ;
     }
     return validPair;
 };
@@ -35,8 +35,8 @@ public:
 public:
     std::string toJSONString()override;
 protected:
-    bool evalPair(const char* key, const char* value) override;
-    bool evalPair(const char* key, double value) override;
+    bool evalPair(SimJSONView key, SimJSONView value) override;
+    bool evalPair(SimJSONView key, double value) override;
     void setToDefault() override;
 };
 
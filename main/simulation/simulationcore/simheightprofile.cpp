@@ -0,0 +1,266 @@
+/* 
+ * File:   simheightprofile.cpp
+ * @date 19. Oktober 2026
+ */
+
+#include "simheightprofile.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/* ADC values measured at the real system in steps of 1 mm, centre of the item
+ * at index 20 (32 for lego).
+ */
+constexpr short int measuredADC[13][41] = {
+    { 0x0a3f, 0x0a1f, 0x0a19, 0x0a14,
+        0x0a17, 0x0a11, 0x0a18, 0x0a1a, 0x0a15, 0x0a14, 0x0a12, 0x0a19, 0x0a19,
+        0x0a11, 0x0a15, 0x0a1f, 0x0a14, 0x0a1c, 0x0a18, 0x0a16, 0x0a19, 0x0a17,
+        0x0a19, 0x0a18, 0x0a16, 0x0a17, 0x0a18, 0x0a15, 0x0a17, 0x0a15, 0x0a18,
+        0x0a1a, 0x0a1b, 0x0a14, 0x0a1a, 0x0a19, 0x0a14, 0x0a1a, 0x0a18, 0x0a1a,
+        0x0a27}, // flat
+    { 0x0b9d, 0x0949, 0x0937, 0x092b, 0x0936, 0x0930, 0x092d, 0x092c,
+        0x092f, 0x092a, 0x0931, 0x0932, 0x092a, 0x092f, 0x0cc7, 0x0cde,
+        0x0cda, 0x0ce3, 0x0cea, 0x0ce4, 0x0cbf, 0x0cc4, 0x0ccf, 0x0cd2,
+        0x0cd8, 0x0cd5, 0x0cda, 0x0cd2, 0x0915, 0x0924, 0x0928, 0x092f,
+        0x0927, 0x0932, 0x0924, 0x092e, 0x092d, 0x092f, 0x092b, 0x092c,
+        0x0943}, // hole up
+    { 0x0b9d, 0x0949, 0x0937, 0x092b, 0x0936, 0x0930, 0x092d, 0x092c,
+        0x092f, 0x092a, 0x0931, 0x0932, 0x0937, 0x092b, 0x0936, 0x0930,
+        0x092d, 0x092c, 0x092f, 0x092a, 0x0931, 0x0932, 0x0937, 0x092b,
+        0x0936, 0x0930, 0x092d, 0x092c, 0x092f, 0x092a, 0x0931, 0x0932,
+        0x0927, 0x0932, 0x0924, 0x092e, 0x092d, 0x092f, 0x092b, 0x092c,
+        0x0943}, // hole down
+    { 0x0995, 0x0967, 0x0930, 0x093c, 0x092c, 0x0937, 0x0939, 0x093b,
+        0x092f, 0x093e, 0x090c, 0x0977, 0x0938, 0x0cbc, 0x0d10, 0x0d0d,
+        0x0d14, 0x0d15, 0x0d10, 0x0d05, 0x0cd5, 0x0cea, 0x0cdf, 0x0ceb,
+        0x0cea, 0x0cfa, 0x0cec, 0x0d55, 0x092a, 0x092f, 0x0977, 0x0916,
+        0x092f, 0x092f, 0x093b, 0x091e, 0x092e, 0x0920, 0x0920, 0x0924,
+        0x0959}, // metal up
+    { 0x0b9d, 0x0949, 0x0937, 0x092b, 0x0936, 0x0930, 0x092d, 0x092c,
+        0x092f, 0x092a, 0x0931, 0x0932, 0x0937, 0x092b, 0x0936, 0x0930,
+        0x092d, 0x092c, 0x092f, 0x092a, 0x0931, 0x0932, 0x0937, 0x092b,
+        0x0936, 0x0930, 0x092d, 0x092c, 0x092f, 0x092a, 0x0931, 0x0932,
+        0x0927, 0x0932, 0x0924, 0x092e, 0x092d, 0x092f, 0x092b, 0x092c,
+        0x0943}, // metal down
+    { 0x096f, 0x0968, 0x095c, 0x09a4, 0x0a13, 0x0a09, 0x0992, 0x0963,
+        0x095c, 0x09a4, 0x0a13, 0x0a09, 0x0992, 0x0963, 0x0963, 0x096f,
+        0x0a08, 0x0a0f, 0x0a12, 0x0a18, 0x0a0b, 0x0a03, 0x0a12, 0x0a01,
+        0x0a0e, 0x095c, 0x0957, 0x0968, 0x0977, 0x0a10, 0x0a14, 0x09d8,
+        0x095d, 0x0968, 0x0977, 0x0a10, 0x0a14, 0x09d8, 0x095d, 0x095f,
+        0x096f}, // coded000
+    { 0x096f, 0x0968, 0x095c, 0x09a4, 0x0a13, 0x0a09, 0x0992, 0x0963,
+        0x095c, 0x09a4, 0x0a13, 0x0a09, 0x0992, 0x0963, 0x0963, 0x096f,
+        0x0abc, 0x0ac3, 0x0ac6, 0x0acc, 0x0abf, 0x0ab7, 0x0ac6, 0x0ab5,
+        0x0ac2, 0x095c, 0x0957, 0x0968, 0x0977, 0x0a10, 0x0a14, 0x09d8,
+        0x095d, 0x0968, 0x0977, 0x0a10, 0x0a14, 0x09d8, 0x095d, 0x095f,
+        0x096f}, // coded001
+    { 0x096f, 0x0968, 0x095c, 0x09a4, 0x0a13, 0x0a09, 0x0992, 0x0963,
+        0x095d, 0x0983, 0x0abf, 0x0ab2, 0x0998, 0x095d, 0x0963, 0x096f,
+        0x0a08, 0x0a0f, 0x0a12, 0x0a18, 0x0a0b, 0x0a03, 0x0a12, 0x0a01,
+        0x0a0e, 0x095c, 0x0957, 0x095f, 0x097c, 0x0ab9, 0x0aa8, 0x0981,
+        0x0950, 0x0968, 0x0977, 0x0a10, 0x0a14, 0x09d8, 0x095d, 0x095f,
+        0x096f}, // coded010
+    { 0x096f, 0x0968, 0x095c, 0x09a4, 0x0a13, 0x0a09, 0x0992, 0x0963,
+        0x095d, 0x0983, 0x0abf, 0x0ab2, 0x0998, 0x095d, 0x0963, 0x096f,
+        0x0abc, 0x0ac3, 0x0ac6, 0x0acc, 0x0abf, 0x0ab7, 0x0ac6, 0x0ab5,
+        0x0ac2, 0x095c, 0x0957, 0x095f, 0x097c, 0x0ab9, 0x0aa8, 0x0981,
+        0x0950, 0x0968, 0x0977, 0x0a10, 0x0a14, 0x09d8, 0x095d, 0x095f,
+        0x096f}, // coded011
+    { 0x096f, 0x0968, 0x095d, 0x0983, 0x0abf, 0x0ab2, 0x0998, 0x095d,
+        0x095c, 0x09a4, 0x0a13, 0x0a09, 0x0992, 0x0963, 0x0963, 0x096f,
+        0x0a08, 0x0a0f, 0x0a12, 0x0a18, 0x0a0b, 0x0a03, 0x0a12, 0x0a01,
+        0x0a0e, 0x095c, 0x0957, 0x0968, 0x0977, 0x0a10, 0x0a14, 0x09d8,
+        0x095d, 0x095f, 0x097c, 0x0ab9, 0x0aa8, 0x0981, 0x0950, 0x095f,
+        0x096f}, // coded100
+    { 0x096f, 0x0968, 0x095d, 0x0983, 0x0abf, 0x0ab2, 0x0998, 0x095d,
+        0x095c, 0x09a4, 0x0a13, 0x0a09, 0x0992, 0x0963, 0x0963, 0x096f,
+        0x0abc, 0x0ac3, 0x0ac6, 0x0acc, 0x0abf, 0x0ab7, 0x0ac6, 0x0ab5,
+        0x0ac2, 0x095c, 0x0957, 0x0968, 0x0977, 0x0a10, 0x0a14, 0x09d8,
+        0x095d, 0x095f, 0x097c, 0x0ab9, 0x0aa8, 0x0981, 0x0950, 0x095f,
+        0x096f}, // coded101
+    { 0x096f, 0x0968, 0x095d, 0x0983, 0x0abf, 0x0ab2, 0x0998, 0x095d,
+        0x095d, 0x0983, 0x0abf, 0x0ab2, 0x0998, 0x095d, 0x0963, 0x096f,
+        0x0a08, 0x0a0f, 0x0a12, 0x0a18, 0x0a0b, 0x0a03, 0x0a12, 0x0a01,
+        0x0a0e, 0x095c, 0x0957, 0x095f, 0x097c, 0x0ab9, 0x0aa8, 0x0981,
+        0x0950, 0x095f, 0x097c, 0x0ab9, 0x0aa8, 0x0981, 0x0950, 0x095f,
+        0x096f}, // coded110
+    { 0x096f, 0x0968, 0x095d, 0x0983, 0x0abf, 0x0ab2, 0x0998, 0x095d,
+        0x095d, 0x0983, 0x0abf, 0x0ab2, 0x0998, 0x095d, 0x0963, 0x096f,
+        0x0abc, 0x0ac3, 0x0ac6, 0x0acc, 0x0abf, 0x0ab7, 0x0ac6, 0x0ab5,
+        0x0ac2, 0x095c, 0x0957, 0x095f, 0x097c, 0x0ab9, 0x0aa8, 0x0981,
+        0x0950, 0x095f, 0x097c, 0x0ab9, 0x0aa8, 0x0981, 0x0950, 0x095f,
+        0x096f} // coded111
+};
+
+constexpr short int measuredADCLego[3][65] = {
+    {   0xbad, 0xbab, 0xbb8, 0xb53, 0xb47, 0xb47, 0xb49, 0xbab,
+        0xbad, 0xbab, 0xbaa, 0xb3b, 0xb35, 0xb42, 0xb40, 0xbb7,
+		0xdb7, 0xd7d, 0xd75, 0xd79, 0xd73, 0xd7d, 0xddd, 0xddd,
+		0xdac, 0xd82, 0xd73, 0xd82, 0xd78, 0xdaa, 0xdd9, 0xde7,
+		0xbb9, 0xb9d, 0xb87, 0xb42, 0xb40, 0xb4d, 0xb4a, 0xbb2,
+		0xbb5, 0xb89, 0xb75, 0xb5d, 0xb48, 0xb48, 0xb55, 0xbaf,
+		0xbba, 0xbaf, 0x989, 0x99b, 0x92a, 0x92f, 0x935, 0x925,
+		0x990, 0x994, 0x98e, 0x98f, 0x913, 0x91e, 0x928, 0x92a,
+		0x996  },
+	{   0xbad, 0xbab, 0xbb8, 0xb53, 0xb47, 0xb47, 0xb49, 0xbab,
+		0xbad, 0xbab, 0xbaa, 0xb3b, 0xb35, 0xb42, 0xb40, 0xbb7,
+		0xdb7, 0xd7d, 0xd75, 0xd79, 0xd73, 0xd7d, 0xddd, 0xddd,
+		0xdac, 0xd82, 0xd73, 0xd82, 0xd78, 0xdaa, 0xdd9, 0xde7,
+		0x92a, 0x996, 0x989, 0x99b, 0x92a, 0x92f, 0x935, 0x925,
+		0x990, 0x994, 0x98e, 0x98f, 0x913, 0x91e, 0x928, 0x92a,
+		0x996, 0xbad, 0xbab, 0xbb8, 0xb53, 0xb47, 0xb47, 0xb49,
+		0xbab, 0xbad, 0xbab, 0xbaa, 0xb3b, 0xb35, 0xb42, 0xb40,
+		0xbb7 },
+	{   0xbad, 0xbab, 0xbb8, 0xb53, 0xb47, 0xb47, 0xb49, 0xbab,
+	    0xbad, 0xbab, 0xbaa, 0xb3b, 0xb35, 0xb42, 0xb40, 0xbb7,
+		0xdb7, 0xd7d, 0xd75, 0xd79, 0xd73, 0xd7d, 0xddd, 0xddd,
+		0xdac, 0xd82, 0xd73, 0xd82, 0xd78, 0xdaa, 0xdd9, 0xde7,
+		0xbb9, 0xb9d, 0xb87, 0xb42, 0xb40, 0xb4d, 0xb4a, 0xbb2,
+		0xbb5, 0xb89, 0xb75, 0xb5d, 0xb48, 0xb48, 0xb55, 0xbaf,
+		0xbba, 0xbaf, 0xbab, 0xbb8, 0xb53, 0xb47, 0xb47, 0xb49,
+		0xbab, 0xbad, 0xbab, 0xbaa, 0xb3b, 0xb35, 0xb42, 0xb40,
+		0xbb7 }
+};
+
+constexpr double measuredRange = 20.0;
+constexpr double measuredRangeLego = 32.0;
+constexpr short int adcNotInRange = static_cast<short int>(0xFFFF);
+
+constexpr double absolute(double value) {
+    return value < 0 ? -value : value;
+}
+
+constexpr bool isLego(ItemKinds kind) {
+    return kind == ItemKinds::lego1 || kind == ItemKinds::lego2 || kind == ItemKinds::lego3;
+}
+
+constexpr double ringHeight(unsigned char code, double relativeX) {
+    double centreDistance = absolute(relativeX);
+    double height = 0; // default belt
+    if (centreDistance <= 20) {
+        height = 25; // default full height
+        if (centreDistance < 5) {
+            height = (code & 0x01) != 0 ? 20 : 23;
+        }
+        if (centreDistance >= 8 && centreDistance < 11) {
+            height = (code & 0x02) != 0 ? 20 : 23;
+        }
+        if (centreDistance >= 14 && centreDistance < 17) {
+            height = (code & 0x04) != 0 ? 20 : 23;
+        }
+    }
+    return height;
+}
+
+constexpr double legoHeight(unsigned char code, double relativeX) {
+    double height = 0; // default belt
+    if (relativeX >= -32 && relativeX <= -16) {
+        height = 3.2 + 9.6 + 1.8;
+    }
+    if (relativeX > -16 && relativeX <= 0) {
+        height = 3.2 + 1.8;
+    }
+    if (relativeX >= 0 && relativeX <= 18) {
+        height = code == 2 ? 3.2 + 9.6 + 9.6 + 1.8 : 3.2 + 9.6 + 1.8;
+    }
+    if (relativeX >= 18 && relativeX <= 33) {
+        height = code == 1 ? 3.2 + 9.6 + 9.6 + 1.8 : 3.2 + 9.6 + 1.8;
+    }
+    return height;
+}
+
+constexpr double heightMM(ItemKinds kind, double relativeX) {
+    bool onItem = absolute(relativeX) <= 20.0;
+    switch (kind) {
+        case ItemKinds::flat:
+            return onItem ? 21.0 : 0.0;
+        case ItemKinds::holedown:
+        case ItemKinds::metaldown:
+            return onItem ? 25.0 : 0.0;
+        case ItemKinds::metalup:
+        case ItemKinds::holeup:
+            return absolute(relativeX) <= 7.5 ? 10.0 : (onItem ? 25.0 : 0.0);
+        case ItemKinds::codeA:
+        case ItemKinds::codeB:
+        case ItemKinds::codeC:
+        case ItemKinds::codeD:
+        case ItemKinds::codeE:
+        case ItemKinds::codeF:
+        case ItemKinds::codeG:
+        case ItemKinds::codeH:
+            return ringHeight(static_cast<int>(kind) - static_cast<int>(ItemKinds::codeA), relativeX);
+        case ItemKinds::lego1:
+            return legoHeight(1, relativeX);
+        case ItemKinds::lego2:
+            return legoHeight(2, relativeX);
+        case ItemKinds::lego3:
+            return legoHeight(3, relativeX);
+    }
+    return 0.0;
+}
+
+// Measured values linearly interpolated, belt (no value) outside the range
+constexpr double heightADC(ItemKinds kind, double relativeX) {
+    const short int *values = isLego(kind) ? measuredADCLego[static_cast<int>(kind) - static_cast<int>(ItemKinds::lego1)]
+                                           : measuredADC[static_cast<int>(kind)];
+    double range = isLego(kind) ? measuredRangeLego : measuredRange;
+    if (absolute(relativeX) > range) {
+        return adcNotInRange;
+    }
+    double pos = relativeX + range;
+    int index = static_cast<int>(pos);
+    if (index >= 2 * range) {
+        return values[index];
+    }
+    double fraction = pos - index;
+    return values[index] + fraction * (values[index + 1] - values[index]);
+}
+
+constexpr SimHeightTable makeTable(ItemKinds kind) {
+    SimHeightTable table{};
+    for (int i = 0; i <= SIM_HEIGHT_TABLE_SIZE; i++) {
+        int sample = std::min(i, SIM_HEIGHT_TABLE_SIZE - 1);   // last one is repeated for the interpolation
+        double relativeX = -SIM_HEIGHT_TABLE_RANGE + static_cast<double>(sample) / SIM_HEIGHT_SAMPLES_PER_MM;
+        table.mm[i] = heightMM(kind, relativeX);
+        table.adc[i] = heightADC(kind, relativeX);
+    }
+    table.adcRange = isLego(kind) ? measuredRangeLego : measuredRange;
+    return table;
+}
+
+constexpr SimHeightTable tables[SIM_HEIGHT_KINDS] = {
+    makeTable(ItemKinds::flat), makeTable(ItemKinds::holeup), makeTable(ItemKinds::holedown),
+    makeTable(ItemKinds::metalup), makeTable(ItemKinds::metaldown),
+    makeTable(ItemKinds::codeA), makeTable(ItemKinds::codeB), makeTable(ItemKinds::codeC), makeTable(ItemKinds::codeD),
+    makeTable(ItemKinds::codeE), makeTable(ItemKinds::codeF), makeTable(ItemKinds::codeG), makeTable(ItemKinds::codeH),
+    makeTable(ItemKinds::lego1), makeTable(ItemKinds::lego2), makeTable(ItemKinds::lego3)
+};
+
+// Index and weight of the sample left of relativeX, clamped to the table
+inline double interpolate(const double *samples, double relativeX) {
+    double pos = (relativeX + SIM_HEIGHT_TABLE_RANGE) * SIM_HEIGHT_SAMPLES_PER_MM;
+    pos = std::min(std::max(pos, 0.0), static_cast<double>(SIM_HEIGHT_TABLE_SIZE - 1));
+    int index = static_cast<int>(pos);
+    double fraction = pos - index;
+    return samples[index] + fraction * (samples[index + 1] - samples[index]);
+}
+
+}
+
+const SimHeightTable& SimHeightProfile::table(ItemKinds kind) {
+    return tables[static_cast<int>(kind)];
+}
+
+double SimHeightProfile::height(ItemKinds kind, double relativeX) {
+    const SimHeightTable &t = tables[static_cast<int>(kind)];
+    double height = interpolate(t.mm, relativeX);
+    return std::fabs(relativeX) <= SIM_HEIGHT_TABLE_RANGE ? height : 0.0;
+}
+
+short int SimHeightProfile::adc(ItemKinds kind, double relativeX) {
+    const SimHeightTable &t = tables[static_cast<int>(kind)];
+    short int height = static_cast<short int>(interpolate(t.adc, relativeX));
+    return std::fabs(relativeX) <= t.adcRange ? height : adcNotInRange;
+}
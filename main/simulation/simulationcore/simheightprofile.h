@@ -0,0 +1,45 @@
+/* 
+ * File:   simheightprofile.h
+ * @date 19. Oktober 2026
+ */
+
+#ifndef SIMHEIGHTPROFILE_H
+#define SIMHEIGHTPROFILE_H
+
+#include "simitemstore.h"
+
+// Tables cover -34 mm to +34 mm around the centre of an item
+#define SIM_HEIGHT_TABLE_RANGE 34
+#define SIM_HEIGHT_SAMPLES_PER_MM 8
+#define SIM_HEIGHT_TABLE_SIZE (2 * SIM_HEIGHT_TABLE_RANGE * SIM_HEIGHT_SAMPLES_PER_MM + 1)
+#define SIM_HEIGHT_KINDS 16
+
+/**
+ * Height profile of one item kind, generated at compile time.
+ * The last sample is repeated, so the interpolation needs no bounds check.
+ */
+struct SimHeightTable {
+    double mm[SIM_HEIGHT_TABLE_SIZE + 1];
+    double adc[SIM_HEIGHT_TABLE_SIZE + 1];
+    double adcRange;   // measured ADC values in -adcRange..adcRange
+};
+
+/**
+ * Height of items relative to the centre of the item, linear interpolation
+ * between the samples of the tables.
+ */
+class SimHeightProfile {
+public:
+    static const SimHeightTable& table(ItemKinds kind);
+    /**
+     * @return height in mm, 0 if not on the item
+     */
+    static double height(ItemKinds kind, double relativeX);
+    /**
+     * @return ADC value as measured at the real system, 0xFFFF if not in range
+     */
+    static short int adc(ItemKinds kind, double relativeX);
+};
+
+#endif /* SIMHEIGHTPROFILE_H */
+
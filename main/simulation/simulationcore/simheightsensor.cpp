@@ -5,6 +5,7 @@
  */
 
 #include "simheightsensor.h"
+#include "simitemindex.h"
 #include <cmath>
 #include <iostream>
 
@@ -12,7 +13,7 @@ using namespace std;
 
 short int SimHeightSensor::beltvalues[41] = {0x0e3d, 0x0e3b, 0x0e3e, 0x0e3b, 0x0e3f, 0x0e3f, 0x0e3f, 0x0e3e, 0x0e3b, 0x0e3e, 0x0e3b, 0x0e3d, 0x0e3c, 0x0e3e, 0x0e3c, 0x0e3f, 0x0e3a, 0x0e3d, 0x0e3f, 0x0e3d, 0x0e3d, 0x0e3d, 0x0e3a, 0x0e3a, 0x0e3b, 0x0e3f, 0x0e3a, 0x0e3c, 0x0e3b, 0x0e39, 0x0e3b, 0x0e3b, 0x0e3c, 0x0e3b, 0x0e3f, 0x0e3d, 0x0e3e, 0x0e3c, 0x0e3b, 0x0e3d, 0x0e3f};
 
-SimHeightSensor::SimHeightSensor(vector<shared_ptr<SimItem> >* items, double position, SimulationIOImage* regs, unsigned short bitmask) :
+SimHeightSensor::SimHeightSensor(vector<SimItem *>* items, double position, SimulationIOImage* regs, unsigned short bitmask) :
 allitems(items), position(position), state(regs), bitmask(bitmask), lastHeight(0.0), beltvaluecounter(0) {
 
 }
@@ -23,7 +24,9 @@ void SimHeightSensor::evalTimeStep(unsigned int simTime) {
      */
     bool heightokay = false; 
 
-    for (const auto &it : (*allitems)) {
+    SimItemIndex::Range range = SimItemIndex::inRange(allitems, position, 32.0);
+    for (SimItemIndex::iterator item = range.first; item != range.second; ++item) {
+        const auto &it = *item;
         if (it->state == ItemState::onBelt) {
             double rel_x = it->x - position;
 
@@ -55,7 +58,9 @@ unsigned short SimHeightSensor::getADCHeight() {
     
     // check if item is in range
     unsigned short item_height = 0xFFFF;
-    for (const auto &it : (*allitems)) {
+    SimItemIndex::Range range = SimItemIndex::inRange(allitems, position, 32.0);
+    for (SimItemIndex::iterator item = range.first; item != range.second; ++item) {
+        const auto &it = *item;
         if (it->state == ItemState::onBelt) {
             double rel_x = it->x - position;
             //cout << "rel x:" << rel_x << endl;
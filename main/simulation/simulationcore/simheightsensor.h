@@ -16,7 +16,7 @@ using namespace std;
 
 class SimHeightSensor {
 private:
-    vector<shared_ptr<SimItem>> *allitems;
+    vector<SimItem *> *allitems;
     double position;
     SimulationIOImage* state;
     unsigned short bitmask;
@@ -24,10 +24,11 @@ private:
     static short int beltvalues[41];
     unsigned char beltvaluecounter = 0;
 public:
-    SimHeightSensor(vector<shared_ptr<SimItem>> *items, double position, SimulationIOImage* regs, unsigned short bitmask);
+    SimHeightSensor(vector<SimItem *> *items, double position, SimulationIOImage* regs, unsigned short bitmask);
     virtual ~SimHeightSensor(){};
     virtual void evalTimeStep(unsigned int simTime);
     unsigned short getADCHeight();
+    double getPosition() const { return position; }
 };
 
 
@@ -7,17 +7,12 @@
 #ifndef ITEM_H
 #define ITEM_H
 
+#include "simitemstore.h"
+
+#include <atomic>
 #include <string>
 #include <iostream>
 
-enum class ItemKinds {
-    flat, holeup, holedown, metalup, metaldown, codeA, codeB, codeC, codeD, codeE, codeF, codeG, codeH, lego1, lego2, lego3
-};
-
-enum class ItemState {
-    onBelt, onSlide, droppedLeft, droppedRight, removed
-};
-
 /* Three non-overlapping regions are defined on the belt. If a workpiece enters 
  * one of these regions, a message is displayed, either on the console or via 
  * network. Since the regions do not overlap, a workpiece can be in one region 
@@ -27,24 +22,32 @@ enum class RoI {
     none, entry, exit, discarded
 };
 
+/* Items live in the slots of the SimItemStore of the simulation, they are
+ * created and destroyed by the store only. Position, kind and state are
+ * references to the arrays of the store. Lists of items hold plain pointers
+ * (handles) into the store.
+ */
 class SimItem {
+    friend class SimItemStore;
 private:
-    static short int heightValues[13][41];
-    static short int heightValuesLego[3][65];
-    static unsigned int IDCounter;
-    unsigned char heightIndex;
+    static std::atomic<unsigned int> IDCounter;   // shared by all simulation instances
+    unsigned int slot;
 public:
-    double x;
-    double y;
-    ItemKinds kind;
-    ItemState state;
+    double &x;
+    double &y;
+    ItemKinds &kind;
+    ItemState &state;
     unsigned int ID;
     RoI roi;
     bool flip;
     bool sticky;
 
-    SimItem(ItemKinds kind);
-    SimItem(ItemKinds kind, double x, double y);
+    SimItem(const SimItem&) = delete;
+    SimItem& operator=(const SimItem&) = delete;
+
+    unsigned int getSlot() {
+        return slot;
+    };
     
     bool isMagnetic() {
         return kind == ItemKinds::metalup;
@@ -60,10 +63,10 @@ public:
 
     std::string toJSONString();
     void typeToShortTypeName(std::ostream& result);
+    static const char* shortTypeName(ItemKinds kind);
 
 private:
-    double calcRingHeight(unsigned char code, double relativeX);
-    double calcLegoHeight(unsigned char code, double relativeX);
+    SimItem(SimItemStore *store, unsigned int slot, ItemKinds kind, double x, double y);
 };
 
 #endif /* ITEM_H */
@@ -10,150 +10,137 @@
 #include <iostream>
 using namespace std;
 
-bool SimItemHandlingAction::evalPair(const char* key, const char* value) {
+bool SimItemHandlingAction::evalPair(SimJSONView key, SimJSONView value) {
     //cout << "text>" << key << ":" << value << endl;
     bool validPair = false;
-    if (string("type") == key) {
-        if (string("itemaction") == value) {
-            validPair = true; // got valid string
-        }
-    }
-    if (string("action") == key) {
-        if (string("add") == value) {
-            actionkind = SimItemHandlingActionKind::add;
-            validPair = true;
-        }
-        if (string("removeatend") == value) {
-            actionkind = SimItemHandlingActionKind::removeatend;
-            validPair = true;
-        }
-        if (string("removeallslide") == value) {
-            actionkind = SimItemHandlingActionKind::removeallslide;
-            validPair = true;
-        }
-        if (string("removeatbegin") == value) {
-            actionkind = SimItemHandlingActionKind::removeatbegin;
-            validPair = true;
-        }
-        if (string("removeall") == value) {
-            actionkind = SimItemHandlingActionKind::removeall;
-            validPair = true;
-        }
-        if (string("removeid") == value) {
-            actionkind = SimItemHandlingActionKind::removeid;
-            validPair = true;
-        }
-    }
-    if (string("kind") == key) {
-        if (string("flat") == value) {
-            kind = ItemKinds::flat;
-            validPair = true;
-        }
-        if (string("holeup") == value) {
-            kind = ItemKinds::holeup;
-            validPair = true;
-        }
-        if (string("holedown") == value) {
-            kind = ItemKinds::holedown;
-            validPair = true;
-        }
-        if (string("metalup") == value) {
-            kind = ItemKinds::metalup;
-            validPair = true;
-        }
-        if (string("metaldown") == value) {
-            kind = ItemKinds::metaldown;
-            validPair = true;
-        }
-        if (string("code0") == value) {
-            kind = ItemKinds::codeA;
-            validPair = true;
-        }
-
-        if (string("code1") == value) {
-            kind = ItemKinds::codeB;
-            validPair = true;
-        }
-        if (string("code2") == value) {
-            kind = ItemKinds::codeC;
-            validPair = true;
-        }
-        if (string("code3") == value) {
-            kind = ItemKinds::codeD;
-            validPair = true;
-        }
-        if (string("code4") == value) {
-            kind = ItemKinds::codeE;
-            validPair = true;
-        }
-        if (string("code5") == value) {
-            kind = ItemKinds::codeF;
-            validPair = true;
-        }
-        if (string("code6") == value) {
-            kind = ItemKinds::codeG;
-            validPair = true;
-        }
-        if (string("code7") == value) {
-            kind = ItemKinds::codeH;
-            validPair = true;
-        }
-        if (string("lego1") == value) {
-            kind = ItemKinds::lego1;
-            validPair = true;
-        }
-        if (string("lego2") == value) {
-            kind = ItemKinds::lego2;
-            validPair = true;
-        }
-        if (string("lego3") == value) {
-            kind = ItemKinds::lego3;
-            validPair = true;
-        }
-    }
-    if (string("f") == key) {
-        if (string("false") == value) {
-            flip = false;
-            validPair = true;
-        }
-        if (string("true") == value) {
-            flip = true;
-            validPair = true;
-        }
-    }
-    if (string("sticky") == key) {
-        if (string("false") == value) {
-            sticky = false;
-            validPair = true;
-        }
-        if (string("true") == value) {
-            sticky = true;
-            validPair = true;
-        }
+    switch (simJSONHash(key)) {
+        case simJSONHash("type"):
+            validPair = (key == "type") && (value == "itemaction"); // got valid string
+            break;
+        case simJSONHash("action"):
+            validPair = (key == "action") && evalActionKind(value);
+            break;
+        case simJSONHash("kind"):
+            validPair = (key == "kind") && evalKind(value);
+            break;
+        case simJSONHash("f"):
+            validPair = (key == "f") && evalBool(value, flip);
+            break;
+        case simJSONHash("sticky"):
+            validPair = (key == "sticky") && evalBool(value, sticky);
+            break;
+        default:
+            ;
     }
 
     //cout << "valid:" << (validPair?"T":"F") << endl;
     return validPair;
 };
 
-bool SimItemHandlingAction::evalPair(const char* key, double value) {
-    //cout << "nummeric>" << key << ":" << value << endl;
-    bool validPair = false;
-    if (string("atTime") == key) {
-        atTime = (int) value;
-        validPair = true;
+bool SimItemHandlingAction::evalActionKind(SimJSONView value) {
+    // same order as SimItemHandlingActionKind
+    static const char* names[] = {"nop", "add", "removeatend", "removeallslide",
+        "removeatbegin", "removeall", "removeid", "fillslide"};
+    int index = -1;
+    switch (simJSONHash(value)) {
+        case simJSONHash("add"): index = 1; break;
+        case simJSONHash("removeatend"): index = 2; break;
+        case simJSONHash("removeallslide"): index = 3; break;
+        case simJSONHash("removeatbegin"): index = 4; break;
+        case simJSONHash("removeall"): index = 5; break;
+        case simJSONHash("removeid"): index = 6; break;
+        case simJSONHash("fillslide"): index = 7; break;
+        default:
+            return false;
     }
-    if (string("x") == key) {
-        x = value;
-        validPair = true;
+    // same hash as a valid value is not sufficient
+    if (value != names[index]) {
+        return false;
     }
-    if (string("y") == key) {
-        y = value;
-        validPair = true;
+    actionkind = static_cast<SimItemHandlingActionKind>(index);
+    return true;
+}
+
+bool SimItemHandlingAction::evalKind(SimJSONView value) {
+    return kindOf(value, kind);
+}
+
+bool SimItemHandlingAction::kindOf(SimJSONView value, ItemKinds &kind) {
+    // same order as ItemKinds
+    static const char* names[] = {"flat", "holeup", "holedown", "metalup", "metaldown",
+        "code0", "code1", "code2", "code3", "code4", "code5", "code6", "code7",
+        "lego1", "lego2", "lego3"};
+    int index = -1;
+    switch (simJSONHash(value)) {
+        case simJSONHash("flat"): index = 0; break;
+        case simJSONHash("holeup"): index = 1; break;
+        case simJSONHash("holedown"): index = 2; break;
+        case simJSONHash("metalup"): index = 3; break;
+        case simJSONHash("metaldown"): index = 4; break;
+        case simJSONHash("code0"): index = 5; break;
+        case simJSONHash("code1"): index = 6; break;
+        case simJSONHash("code2"): index = 7; break;
+        case simJSONHash("code3"): index = 8; break;
+        case simJSONHash("code4"): index = 9; break;
+        case simJSONHash("code5"): index = 10; break;
+        case simJSONHash("code6"): index = 11; break;
+        case simJSONHash("code7"): index = 12; break;
+        case simJSONHash("lego1"): index = 13; break;
+        case simJSONHash("lego2"): index = 14; break;
+        case simJSONHash("lego3"): index = 15; break;
+        default:
+            return false;
     }
-    if (string("id") == key) {
-        ID = (unsigned int) value;
-        validPair = true;
+    if (value != names[index]) {
+        return false;
+    }
+    kind = static_cast<ItemKinds>(index);
+    return true;
+}
+
+bool SimItemHandlingAction::evalBool(SimJSONView value, bool &flag) {
+    bool validValue = false;
+    if (value == "false") {
+        flag = false;
+        validValue = true;
+    }
+    if (value == "true") {
+        flag = true;
+        validValue = true;
+    }
+    return validValue;
+}
+
+bool SimItemHandlingAction::evalPair(SimJSONView key, double value) {
+    //cout << "nummeric>" << key << ":" << value << endl;
+    bool validPair = false;
+    switch (simJSONHash(key)) {
+        case simJSONHash("atTime"):
+            if (key == "atTime") {
+                atTime = (int) value;
+                validPair = true;
+            }
+            break;
+        case simJSONHash("x"):
+            if (key == "x") {
+                x = value;
+                validPair = true;
+            }
+            break;
+        case simJSONHash("y"):
+            if (key == "y") {
+                y = value;
+                validPair = true;
+            }
+            break;
+        case simJSONHash("id"):
+            if (key == "id") {
+                ID = (unsigned int) value;
+                validPair = true;
+            }
+            break;
+        default:
+            ;
     }
     return validPair;
 };
@@ -199,6 +186,9 @@ std::string SimItemHandlingAction::toJSONString() {
 			case SimItemHandlingActionKind::removeallslide:
 				result << "\"removeallslide\", ";
 				break;
+			case SimItemHandlingActionKind::fillslide:
+				result << "\"fillslide\", ";
+				break;
 			case SimItemHandlingActionKind::removeid:
 				// Intentionally left blank. Not needed, just to complete set of cases.
 				break;
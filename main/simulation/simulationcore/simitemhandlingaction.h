@@ -13,7 +13,7 @@
 using namespace std;
 
 enum class SimItemHandlingActionKind {
-    nop, add, removeatend, removeallslide, removeatbegin, removeall, removeid
+    nop, add, removeatend, removeallslide, removeatbegin, removeall, removeid, fillslide
 };
 
 class SimItemHandlingAction : public SimJSONBase {
@@ -44,9 +44,17 @@ public:
     };
     virtual ~SimItemHandlingAction(){};
     std::string toJSONString() override;
+    /**
+     * Kind of the given name as used in the messages, e.g. "metalup".
+     * @return false if the name is unknown
+     */
+    static bool kindOf(SimJSONView name, ItemKinds &kind);
 private:
-    bool evalPair(const char* key, const char* value) override;
-    bool evalPair(const char* key, double value) override;
+    bool evalPair(SimJSONView key, SimJSONView value) override;
+    bool evalPair(SimJSONView key, double value) override;
+    bool evalActionKind(SimJSONView value);
+    bool evalKind(SimJSONView value);
+    bool evalBool(SimJSONView value, bool &flag);
     void setToDefault() override;
 };
 
@@ -0,0 +1,40 @@
+/* 
+ * File:   simitemindex.cpp
+ * @date 19. Oktober 2026
+ */
+
+#include "simitemindex.h"
+#include <algorithm>
+
+using namespace std;
+
+static bool lessX(SimItem *a, SimItem *b) {
+    return a->x < b->x;
+}
+
+void SimItemIndex::insert(vector<SimItem *> *items, SimItem *item) {
+    items->insert(upper_bound(items->begin(), items->end(), item, lessX), item);
+}
+
+void SimItemIndex::restoreOrder(vector<SimItem *> *items) {
+    // insertion sort, stable and O(n) for (nearly) sorted items
+    for (size_t i = 1; i < items->size(); i++) {
+        if ((*items)[i]->x < (*items)[i - 1]->x) {
+            SimItem *item = std::move((*items)[i]);
+            size_t j = i;
+            while (j > 0 && item->x < (*items)[j - 1]->x) {
+                (*items)[j] = std::move((*items)[j - 1]);
+                j--;
+            }
+            (*items)[j] = std::move(item);
+        }
+    }
+}
+
+SimItemIndex::Range SimItemIndex::inRange(vector<SimItem *> *items, double position, double distance) {
+    iterator first = lower_bound(items->begin(), items->end(), position - distance,
+            [](SimItem *item, double x) { return item->x < x; });
+    iterator last = upper_bound(first, items->end(), position + distance,
+            [](double x, SimItem *item) { return x < item->x; });
+    return Range(first, last);
+}
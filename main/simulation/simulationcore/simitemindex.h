@@ -0,0 +1,42 @@
+/* 
+ * File:   simitemindex.h
+ * @date 19. Oktober 2026
+ */
+
+#ifndef SIMITEMINDEX_H
+#define SIMITEMINDEX_H
+
+#include "simitem.h"
+
+#include <vector>
+#include <memory>
+#include <utility>
+
+using namespace std;
+
+/**
+ * Items on the belt are kept sorted by x, so a sensor only has to look at the
+ * items around its position instead of scanning all items in each cycle.
+ */
+class SimItemIndex {
+public:
+    typedef vector<SimItem *>::iterator iterator;
+    typedef pair<iterator, iterator> Range;
+
+    /**
+     * Inserts the item behind all items with the same or a lower x.
+     */
+    static void insert(vector<SimItem *> *items, SimItem *item);
+    /**
+     * Restores the order after items have been moved. Items keep their
+     * order in most cycles, so this is linear in the number of items.
+     */
+    static void restoreOrder(vector<SimItem *> *items);
+    /**
+     * @return all items with position - distance <= x <= position + distance
+     */
+    static Range inRange(vector<SimItem *> *items, double position, double distance);
+};
+
+#endif /* SIMITEMINDEX_H */
+
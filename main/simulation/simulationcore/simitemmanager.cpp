@@ -8,17 +8,24 @@
 #include "simitemmanager.h"
 #include "simconveyorbelt.h"
 #include "simconfquery.h"
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 using namespace std;
 
-SimItemManager::SimItemManager(vector<shared_ptr<SimItem>> *items, SimConveyorBelt *conveyor, SimSlide *slide) :
-allitems(items), conveyor(conveyor), slide(slide) {
+SimItemManager::SimItemManager(vector<SimItem *> *items, const shared_ptr<SimItemStore> &itemstore, SimConveyorBelt *conveyor, SimSlide *slide) :
+allitems(items), itemstore(itemstore), conveyor(conveyor), slide(slide) {
 
 }
 
 void SimItemManager::addItem(ItemKinds kind, bool flip, bool sticky, double x, double y) {
-    auto newitem = make_shared<SimItem>(kind, x, y);
+    if (itemstore->isFull()) {
+        if(SIMCONFQUERRY_ISACTIVE(showactions)){
+            cout << "<SIM> Item store full, item not added" << endl;
+        }
+        return;
+    }
+    SimItem *newitem = itemstore->create(kind, x, y);
     if (flip) {
         newitem->setFlipping();
     }
@@ -34,13 +41,15 @@ void SimItemManager::addItem(ItemKinds kind, bool flip, bool sticky, double x, d
 				conveyor->addItem(newitem);
 				//cout << "added item to belt" << endl;
 			}
+			return;
     	}
     }
+    itemstore->destroy(newitem);
 }
 
 void SimItemManager::handleItemAction(const SimItemHandlingAction &action) {
     if (allitems != nullptr) {
-        vector<shared_ptr < SimItem>>::iterator it;
+        vector<SimItem *>::iterator it;
         switch (action.actionkind) {
             case SimItemHandlingActionKind::nop:
                 break;
@@ -50,7 +59,7 @@ void SimItemManager::handleItemAction(const SimItemHandlingAction &action) {
 
             case SimItemHandlingActionKind::removeall:
             {
-                shared_ptr<SimItem> found = nullptr;
+                SimItem *found = nullptr;
                 for (it = allitems->begin(); it != allitems->end(); ++it) {
                     if ((*it)->state == ItemState::onBelt || (*it)->state == ItemState::onSlide) {
                         (*it)->state = ItemState::removed;
@@ -65,7 +74,7 @@ void SimItemManager::handleItemAction(const SimItemHandlingAction &action) {
 
             case SimItemHandlingActionKind::removeatend:
             {
-                shared_ptr<SimItem> found = nullptr;
+                SimItem *found = nullptr;
                 double maxX = 0.0;
                 for (it = allitems->begin(); it != allitems->end(); ++it) {
                     if ((*it)->state == ItemState::onBelt) {
@@ -99,9 +108,23 @@ void SimItemManager::handleItemAction(const SimItemHandlingAction &action) {
                 }
                 break;
             }
+            case SimItemHandlingActionKind::fillslide:
+            {
+                // items of the given kind until the slide is full
+                double x = SimSlide::entryX;
+                while (slide != nullptr && slide->size() < SimSlide::capacity && !itemstore->isFull()) {
+                    SimItem *newitem = itemstore->create(action.kind, x, 80.0);
+                    allitems->push_back(newitem);
+                    slide->addItem(newitem);
+                }
+                if(SIMCONFQUERRY_ISACTIVE(showactions)){
+                	cout << "<SIM> Filled slide" << endl;
+                }
+                break;
+            }
             case SimItemHandlingActionKind::removeid:
             {
-                shared_ptr<SimItem> found = nullptr;
+                SimItem *found = nullptr;
                 for (it = allitems->begin(); it != allitems->end(); ++it) {
 					// is given ID?
 					if ((*it)->ID == action.ID) {
@@ -127,22 +150,33 @@ void SimItemManager::handleItemAction(const SimItemHandlingAction &action) {
 
 void SimItemManager::housekeeping() {
     if (allitems != nullptr) {
-        vector<shared_ptr < SimItem>>::iterator it;
-        it = allitems->begin();
-        while (it != allitems->end()) {
-            if (((*it)->state == ItemState::removed) || ((*it)->state == ItemState::droppedLeft) || ((*it)->state == ItemState::droppedRight)) {
-                it = allitems->erase(it);
-            } else {
-                ++it;
-            }
+        auto gone = [](SimItem *item) {
+            return (item->state == ItemState::removed) || (item->state == ItemState::droppedLeft) || (item->state == ItemState::droppedRight);
+        };
+        if (none_of(allitems->begin(), allitems->end(), gone)) {
+            return;
+        }
+        // no list may refer to an item once it is destroyed
+        if (conveyor != nullptr) {
+            conveyor->housekeeping();
+        }
+        if (slide != nullptr) {
+            slide->housekeeping();
+        }
+        auto keep = stable_partition(allitems->begin(), allitems->end(), [&gone](SimItem *item) {
+            return !gone(item);
+        });
+        for (auto it = keep; it != allitems->end(); ++it) {
+            itemstore->destroy(*it);
         }
+        allitems->erase(keep, allitems->end());
     }
 }
 
 std::string SimItemManager::toJSONStringFragment() {
     std::stringstream result;
     result << " \"items\": [";
-    vector<shared_ptr < SimItem>>::iterator it;
+    vector<SimItem *>::iterator it;
 
     for (it = allitems->begin(); it != allitems->end(); ++it) {
         if (it != allitems->begin()) {
@@ -157,7 +191,7 @@ std::string SimItemManager::toJSONStringFragment() {
 }
 
 void SimItemManager::checkRoI() {
-    vector<shared_ptr < SimItem>>::iterator it;
+    vector<SimItem *>::iterator it;
 
     for (it = allitems->begin(); it != allitems->end(); ++it) {
         // begin of belt
@@ -20,11 +20,12 @@ using namespace std;
 
 class SimItemManager{
 private:
-    vector<shared_ptr<SimItem>> *allitems;
+    vector<SimItem *> *allitems;
+    shared_ptr<SimItemStore> itemstore;
     SimConveyorBelt *conveyor;
     SimSlide *slide;
 public:
-    SimItemManager(vector<shared_ptr<SimItem>> *items, SimConveyorBelt *conveyor, SimSlide *slide);
+    SimItemManager(vector<SimItem *> *items, const shared_ptr<SimItemStore> &itemstore, SimConveyorBelt *conveyor, SimSlide *slide);
     void addItem(ItemKinds kind=ItemKinds::flat, bool flip=false, bool sticky=false, double x=0, double y=60);
     void handleItemAction(const SimItemHandlingAction &action);
     void housekeeping();
@@ -0,0 +1,77 @@
+/* 
+ * File:   simitemstore.cpp
+ * @date 19. Oktober 2026
+ */
+
+#include "simitemstore.h"
+#include "simitem.h"
+
+#include <new>
+
+SimItemStore::SimItemStore(unsigned int capacity) :
+x(capacity, 0.0), y(capacity, 0.0), state(capacity, ItemState::removed), kind(capacity, ItemKinds::flat), flags(capacity, 0), used(0),
+itemmemory(new unsigned char[capacity * sizeof(SimItem)]) {
+    freeslots.reserve(capacity);
+}
+
+SimItemStore::~SimItemStore() {
+    for (unsigned int slot = 0; slot < used; slot++) {
+        if (flags[slot] & SIM_ITEM_FLAG_LIVE) {
+            reinterpret_cast<SimItem*>(&itemmemory[slot * sizeof(SimItem)])->~SimItem();
+        }
+    }
+}
+
+SimItem *SimItemStore::create(ItemKinds kind, double x, double y) {
+    unsigned int slot = allocate();
+    if (slot == invalidSlot) {
+        return nullptr;
+    }
+    flags[slot] = SIM_ITEM_FLAG_LIVE;
+    return new (&itemmemory[slot * sizeof(SimItem)]) SimItem(this, slot, kind, x, y);
+}
+
+void SimItemStore::destroy(SimItem *item) {
+    unsigned int slot = item->getSlot();
+    item->~SimItem();
+    flags[slot] = 0;
+    release(slot);
+}
+
+unsigned int SimItemStore::allocate() {
+    unsigned int slot = invalidSlot;
+    if (!freeslots.empty()) {
+        slot = freeslots.back();
+        freeslots.pop_back();
+    } else if (used < capacity()) {
+        slot = used++;
+    }
+    if (slot != invalidSlot) {
+        flags[slot] = 0;
+    }
+    return slot;
+}
+
+void SimItemStore::release(unsigned int slot) {
+    if (slot < used) {
+        state[slot] = ItemState::removed;
+        freeslots.push_back(slot);
+    }
+}
+
+bool SimItemStore::isFull() {
+    return freeslots.empty() && used >= capacity();
+}
+
+unsigned int SimItemStore::size() {
+    return used - freeslots.size();
+}
+
+void SimItemStore::moveBelt(double stepX, double left, double right) {
+    // branch free, so the compiler can vectorize the loop
+    for (unsigned int i = 0; i < used; i++) {
+        bool move = (state[i] == ItemState::onBelt) & (x[i] >= left) & (x[i] <= right) & ((flags[i] & SIM_ITEM_FLAG_STEPPED) == 0);
+        x[i] += move ? stepX : 0.0;
+        flags[i] = flags[i] & ~SIM_ITEM_FLAG_STEPPED;
+    }
+}
@@ -0,0 +1,87 @@
+/* 
+ * File:   simitemstore.h
+ * @date 19. Oktober 2026
+ */
+
+#ifndef SIMITEMSTORE_H
+#define SIMITEMSTORE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+enum class ItemKinds : uint8_t {
+    flat, holeup, holedown, metalup, metaldown, codeA, codeB, codeC, codeD, codeE, codeF, codeG, codeH, lego1, lego2, lego3
+};
+
+enum class ItemState : uint8_t {
+    onBelt, onSlide, droppedLeft, droppedRight, removed
+};
+
+// Item has been moved by the detailed evaluation in this cycle
+#define SIM_ITEM_FLAG_STEPPED 0x01
+// Slot holds a SimItem created by the store
+#define SIM_ITEM_FLAG_LIVE 0x02
+
+class SimItem;
+
+/**
+ * Position, state and kind of all items of one simulation, stored as one
+ * array per field (struct of arrays). Slots are stable for the lifetime of an
+ * item and the arrays are allocated once, so the fields can be referenced by
+ * SimItem and the belt can move all items in one tight loop.
+ *
+ * The SimItem objects themselves are placed in the slots of the store as
+ * well, so adding an item never allocates memory.
+ */
+class SimItemStore {
+public:
+    static constexpr unsigned int invalidSlot = ~0u;
+
+    vector<double> x;
+    vector<double> y;
+    vector<ItemState> state;
+    vector<ItemKinds> kind;
+    vector<uint8_t> flags;
+private:
+    vector<unsigned int> freeslots;
+    unsigned int used;   // slots [0, used) have been allocated at least once
+    unique_ptr<unsigned char[]> itemmemory;   // one SimItem per slot
+public:
+    SimItemStore(unsigned int capacity);
+    SimItemStore(const SimItemStore&) = delete;
+    SimItemStore& operator=(const SimItemStore&) = delete;
+    ~SimItemStore();
+
+    /**
+     * Creates an item in a free slot.
+     * @return the item, nullptr if the store is full
+     */
+    SimItem *create(ItemKinds kind, double x, double y);
+    /**
+     * Destroys an item created by this store and frees its slot.
+     */
+    void destroy(SimItem *item);
+
+    /**
+     * @return free slot, invalidSlot if the store is full
+     */
+    unsigned int allocate();
+    void release(unsigned int slot);
+    bool isFull();
+    unsigned int size();
+    unsigned int capacity() {
+        return x.size();
+    };
+
+    /**
+     * Moves all items on the belt between left and right by stepX, except
+     * items flagged as SIM_ITEM_FLAG_STEPPED. Clears the flags.
+     */
+    void moveBelt(double stepX, double left, double right);
+};
+
+#endif /* SIMITEMSTORE_H */
+
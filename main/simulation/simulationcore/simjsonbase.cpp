@@ -1,5 +1,4 @@
-
-/* 
+/*
  * File:   simjsonbase.cpp
  * @author Lehmann
  * @date 16. Mai 2020
@@ -9,157 +8,177 @@
 #include <cstdlib>
 #include <iostream>
 
-bool SimJSONBase::parseJSON(std::string input) {
-    constexpr int MAX = 50;
+namespace {
+
+// Max. characters of a numeric value
+constexpr size_t MAX_NUMBER = 32;
+
+bool isSpace(char character) {
+    return character == ' ' || character == '\t' || character == '\n' || character == '\r';
+}
+
+bool isDigit(char character) {
+    return character >= '0' && character <= '9';
+}
+
+void skipSpace(const char *input, size_t size, size_t &pos) {
+    while (pos < size && isSpace(input[pos])) {
+        pos++;
+    }
+}
+
+// Text in single or double quotes, escaped characters are kept as they are.
+// The position is only moved if the text is complete.
+bool parseText(const char *input, size_t size, size_t &pos, SimJSONView &text) {
+    size_t i = pos;
+    if (i >= size || (input[i] != '"' && input[i] != '\'')) {
+        return false;
+    }
+    char quote = input[i++];
+    size_t begin = i;
+    while (i < size && input[i] != quote) {
+        if (input[i] == '\\') {
+            i++;
+        }
+        i++;
+    }
+    if (i >= size) {
+        return false;
+    }
+    text = SimJSONView(input + begin, i - begin);
+    pos = i + 1;
+    return true;
+}
+
+bool parseNumber(const char *input, size_t size, size_t &pos, double &value) {
+    size_t i = pos;
+    if (i < size && (input[i] == '+' || input[i] == '-')) {
+        i++;
+    }
+    size_t digits = i;
+    while (i < size && isDigit(input[i])) {
+        i++;
+    }
+    if (i == digits) {
+        return false;
+    }
+    if (i < size && input[i] == '.') {
+        i++;
+        while (i < size && isDigit(input[i])) {
+            i++;
+        }
+    }
+    if (i < size && (input[i] == 'e' || input[i] == 'E')) {
+        i++;
+        if (i < size && (input[i] == '+' || input[i] == '-')) {
+            i++;
+        }
+        size_t exponent = i;
+        while (i < size && isDigit(input[i])) {
+            i++;
+        }
+        if (i == exponent) {
+            return false;
+        }
+    }
+    size_t length = i - pos;
+    if (length >= MAX_NUMBER) {
+        return false;
+    }
+    // input is not zero terminated
+    char buffer[MAX_NUMBER];
+    memcpy(buffer, input + pos, length);
+    buffer[length] = '\0';
+    value = std::strtod(buffer, nullptr);
+    pos = i;
+    return true;
+}
+
+bool parseLiteral(const char *input, size_t size, size_t &pos, SimJSONView &literal) {
+    for (const char *candidate : {"true", "false"}) {
+        size_t length = strlen(candidate);
+        if (size - pos >= length && memcmp(input + pos, candidate, length) == 0) {
+            literal = SimJSONView(input + pos, length);
+            pos += length;
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+bool SimJSONBase::parseJSON(const std::string &input) {
+    return parseJSON(input.data(), input.size());
+}
+
+bool SimJSONBase::parseJSON(const char *input, size_t size) {
     setToDefault(); // clear this oject
 
     bool parseResult = false;
+    size_t pos = 0;
     pstate = PJS::waitopen;
-    int counter = 0;
-    char buffer_key[MAX + 1];
-    char buffer_value[MAX + 1];
-
-    for (unsigned int i = 0; i < input.size() && pstate != PJS::error && pstate != PJS::end; i++) {
-        char character = input[i];
-        switch (pstate) {
-            case PJS::waitopen:
-                if (character == '{') {
-                    pstate = PJS::waitkey;
-                }
-                break;
-            case PJS::waitkey:
-                if ((character == 0x27) || (character == 0x22)) {
-                    pstate = PJS::key;
-                    counter = 0;
-                }
-                break;
-            case PJS::key:
-                if ((character == 0x27) || (character == 0x22)) {
-                    buffer_key[counter++] = '\0';
-                    pstate = PJS::waitsep;
-                } else {
-                    if (counter < MAX) {
-                        buffer_key[counter++] = character;
-                    } else {
-                        pstate = PJS::error;
-                    }
-                }
-                break;
-            case PJS::waitsep:
-                if (character == ':') {
-                    pstate = PJS::waitvalue;
-                    counter = 0;
-                }
-                break;
-            case PJS::waitvalue:
-                if (isdigit(character) || character == '+' || character == '-') {
-                    pstate = PJS::value;
-                    //cout <<character << " numeric" << endl;
-                    buffer_value[counter++] = character;
-                }
-                if ((character == 0x27) || (character == 0x22)) {
-                    pstate = PJS::text;
-                    //cout <<character << " text" << endl;
-                }
-                if ((character == 'f') || (character == 't')) {
-                    pstate = PJS::boolean;
-                    buffer_value[counter++] = character;
-                    //std::cout << character << " text" << std::endl;
-                } else {
-                    if (character == ',' || isalpha(character)) {
-                        pstate = PJS::error;
-                    }
-                }
-                break;
-            case PJS::text:
-                if ((character == 0x27) || (character == 0x22)) {
-                    buffer_value[counter] = '\0';
-                    pstate = PJS::waitcomma;
-                    counter = 0;
-                    //evaluate pair
-                    if (!evalPair(buffer_key, buffer_value)) {
-                        pstate = PJS::error;
-                    }
-                } else {
-                    if (counter < MAX) {
-                        buffer_value[counter++] = character;
-                    } else {
-                        pstate = PJS::error;
-                    }
-                }
-                break;
-            case PJS::boolean:
-                //std::cout << character << " bool" << std::endl;
-
-                if ((character == ' ') || (character == ',') || (character == '}')) {
-                    buffer_value[counter] = '\0';
-                    pstate = PJS::waitcomma;
-                    counter = 0;
-                    if (character == ' ') {
-                        pstate = PJS::waitcomma;
-                    }
-                    if (character == ',') {
-                        pstate = PJS::waitkey;
-                    }
-                    if (character == '}') {
-                        pstate = PJS::end;
-                    }
-                    
-                    //evaluate pair
-                    if (!evalPair(buffer_key, buffer_value)) {
-                        pstate = PJS::error;
-                    } else {
-                        if (character == '}') {
-                            pstate = PJS::end;
-                        }
-                    }
-                } else {
-                    if (counter < MAX) {
-                        buffer_value[counter++] = character;
-                    } else {
-                        pstate = PJS::error;
-                    }
-                }
-                break;
-            case PJS::waitcomma:
-                if (character == ',') {
-                    pstate = PJS::waitkey;
-                }
-                if (character == '}') {
-                    pstate = PJS::end;
-                }
-                break;
-            case PJS::value:
-                if (character == ',' || character == '}') {
-                    buffer_value[counter] = '\0';
-                    if (character == '}') {
-                        pstate = PJS::end;
-                    }
-                    if (character == ',') {
-                        pstate = PJS::waitkey;
-                    }
-                    counter = 0;
-                    //cout << buffer_value << " ";
-                    double value = std::atof(buffer_value);
-                    //cout << value << endl;
-                    //evaluate pair
-                    if (!evalPair(buffer_key, value)) {
-                        pstate = PJS::error;
-                    }
-                } else {
-                    if (counter < MAX) {
-                        buffer_value[counter++] = character;
-                    } else {
-                        pstate = PJS::error;
-                    }
-
-                }
-                break;
-            default:
-                // should never happen, so it is an error.
-                pstate = PJS::error;
+
+    // content in front of the object is ignored
+    while (pos < size && input[pos] != '{') {
+        pos++;
+    }
+    if (pos < size) {
+        pos++;
+        pstate = PJS::waitkey;
+        skipSpace(input, size, pos);
+        if (pos < size && input[pos] == '}') {
+            pstate = PJS::end;
+        }
+    } else {
+        pstate = PJS::error;
+    }
+
+    while (pstate == PJS::waitkey) {
+        SimJSONView key;
+        skipSpace(input, size, pos);
+        if (!parseText(input, size, pos, key)) {
+            pstate = PJS::error;
+            break;
+        }
+        skipSpace(input, size, pos);
+        if (pos >= size || input[pos] != ':') {
+            pstate = PJS::error;
+            break;
+        }
+        pos++;
+        skipSpace(input, size, pos);
+        pstate = PJS::value;
+
+        // evalPair() may end the parsing (PJS::end) or mark an error
+        bool validPair = false;
+        SimJSONView text;
+        double number = 0.0;
+        if (parseText(input, size, pos, text) || parseLiteral(input, size, pos, text)) {
+            validPair = evalPair(key, text);
+        } else if (parseNumber(input, size, pos, number)) {
+            validPair = evalPair(key, number);
+        } else {
+            pstate = PJS::error;
+        }
+        if (!validPair) {
+            pstate = PJS::error;
+        }
+        if (pstate != PJS::value) {
+            break;
+        }
+
+        skipSpace(input, size, pos);
+        if (pos < size && input[pos] == ',') {
+            pos++;
+            pstate = PJS::waitkey;
+        } else if (pos < size && input[pos] == '}') {
+            pstate = PJS::end;
+        } else {
+            pstate = PJS::error;
         }
     }
+
     if (pstate == PJS::end) {
         parseResult = true;
     } else {
@@ -170,7 +189,7 @@ bool SimJSONBase::parseJSON(std::string input) {
     return parseResult;
 }
 
-bool SimJSONBase::evalPair(const char* key, const char* value) {
+bool SimJSONBase::evalPair(SimJSONView key, SimJSONView value) {
     //cout << "text>" << key << ":" << value << endl;
     bool validPair = false;
 
@@ -180,7 +199,7 @@ bool SimJSONBase::evalPair(const char* key, const char* value) {
     return validPair;
 };
 
-bool SimJSONBase::evalPair(const char* key, double value) {
+bool SimJSONBase::evalPair(SimJSONView key, double value) {
     //cout << "nummeric>" << key << ":" << value << endl;
     bool validPair = false;
 
@@ -1,5 +1,4 @@
-
-/* 
+/*
  * File:   simjsonbase.h
  * @author Lehmann
  * @date 15. Mai 2020
@@ -8,22 +7,83 @@
 #ifndef SIMJSONBASE_H
 #define SIMJSONBASE_H
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
 
 enum class PJS {
     waitopen, waitkey, key, waitsep, waitvalue, value, text, boolean, waitcomma, end, error
 };
 
+/**
+ * Non-owning view on a key or value within the parsed message (string_view
+ * is not available with C++14). Only valid during evalPair().
+ */
+class SimJSONView {
+public:
+    const char *data;
+    size_t size;
+
+    constexpr SimJSONView() : data(""), size(0) {}
+    constexpr SimJSONView(const char *data, size_t size) : data(data), size(size) {}
+    SimJSONView(const char *text) : data(text), size(strlen(text)) {}
+
+    bool operator==(const char *text) const {
+        return strlen(text) == size && memcmp(data, text, size) == 0;
+    }
+    bool operator!=(const char *text) const {
+        return !(*this == text);
+    }
+    std::string str() const {
+        return std::string(data, size);
+    }
+};
+
+/**
+ * FNV-1a hash of a key. Used as switch label, so keys of one object which
+ * collide are detected by the compiler (duplicate case value). The key has to
+ * be compared after the dispatch, as unknown keys may have the same hash.
+ */
+constexpr uint32_t simJSONHash(const char *data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ (uint8_t) data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+template<size_t N>
+constexpr uint32_t simJSONHash(const char (&key)[N]) {
+    return simJSONHash(key, N - 1);
+}
+
+inline uint32_t simJSONHash(SimJSONView key) {
+    return simJSONHash(key.data, key.size);
+}
+
+/**
+ * Base of all objects received as JSON message. The parser works on the
+ * received buffer without copying (SAX like): each key/value pair of the flat
+ * object is passed to evalPair(), booleans as text "true"/"false".
+ */
 class SimJSONBase {
 protected:
     PJS pstate = PJS::error;
 public:
     virtual ~SimJSONBase(){};
-    virtual bool parseJSON(std::string input);
+    bool parseJSON(const std::string &input);
+    /**
+     * @param input Message, does not need to be zero terminated
+     * @param size Number of bytes of the message
+     * @return true if the object has been parsed completely or evalPair()
+     * ended the parsing
+     */
+    virtual bool parseJSON(const char *input, size_t size);
     virtual std::string toJSONString();
 protected:
-    virtual bool evalPair(const char* key, const char* value);
-    virtual bool evalPair(const char* key, double value);
+    virtual bool evalPair(SimJSONView key, SimJSONView value);
+    virtual bool evalPair(SimJSONView key, double value);
     virtual void setToDefault();
 };
 #endif /* SIMJSONBASE_H */
@@ -10,66 +10,86 @@
 #include "simhciaction.h"
 #include "simconfaction.h"
 
-bool SimJSONMessageHandler::dispatchMessage(std::string message) {
+bool SimJSONMessageHandler::dispatchMessage(const std::string &message) {
+    return dispatchMessage(message.data(), message.size());
+}
+
+bool SimJSONMessageHandler::dispatchMessage(const char *message, size_t size) {
     bool result = false;
-    msgKey = "";
-    msgValue = "";
-    if (parseJSON(message)) {  // only true if type is identified
-        if (string("itemaction") == msgValue) {
-            if (itemhandler != nullptr) {
-                // parse message for item action
-                SimItemHandlingAction action;
-                if (action.parseJSON(message)) {
-                    itemhandler->addAction(action);
-                    result = true;
+    msgType = SimMessageType::unknown;
+    if (parseJSON(message, size)) {  // only true if type is identified
+        switch (msgType) {
+            case SimMessageType::itemaction:
+                if (itemhandler != nullptr) {
+                    // parse message for item action
+                    SimItemHandlingAction action;
+                    if (action.parseJSON(message, size)) {
+                        itemhandler->addAction(action);
+                        result = true;
+                    }
                 }
-            }
-        }
-        if (string("simctrl") == msgValue) {
-            if (simctrlhandler != nullptr) {
-                // parse message for item action
-                SimCtrlAction action;
-                if (action.parseJSON(message)) {
-                    simctrlhandler->addAction(action);
-                    result = true;
+                break;
+            case SimMessageType::simctrl:
+                if (simctrlhandler != nullptr) {
+                    SimCtrlAction action;
+                    if (action.parseJSON(message, size)) {
+                        simctrlhandler->addAction(action);
+                        result = true;
+                    }
                 }
-            }
-        }
-        if (string("hciaction") == msgValue) {
-            if (hcihandler != nullptr) {
-                // parse message for item action
-                SimHCIAction action(0);
-                if (action.parseJSON(message)) {
-                    hcihandler->addAction(action);
-                    result = true;
+                break;
+            case SimMessageType::hciaction:
+                if (hcihandler != nullptr) {
+                    SimHCIAction action(0);
+                    if (action.parseJSON(message, size)) {
+                        hcihandler->addAction(action);
+                        result = true;
+                    }
                 }
-            }
-        }
-        if (string("simconfaction") == msgValue) {
-            if (confhandler != nullptr) {
-                // parse message for item action
-                SimConfAction action;
-                if (action.parseJSON(message)) {
-                    confhandler->addAction(action);
-                    result = true;
+                break;
+            case SimMessageType::simconfaction:
+                if (confhandler != nullptr) {
+                    SimConfAction action;
+                    if (action.parseJSON(message, size)) {
+                        confhandler->addAction(action);
+                        result = true;
+                    }
                 }
-            }
+                break;
+            default:
+                ;
         }
     }
     return result;
 }
 
-bool SimJSONMessageHandler::evalPair(const char* key, const char* value) {
+bool SimJSONMessageHandler::evalPair(SimJSONView key, SimJSONView value) {
     //cout << "text>" << key << ":" << value << endl;
-    bool validPair = false;
-
-    if (string("type") == key) {
+    if (key == "type") {
+        switch (simJSONHash(value)) {
+            case simJSONHash("itemaction"):
+                msgType = (value == "itemaction") ? SimMessageType::itemaction : SimMessageType::unknown;
+                break;
+            case simJSONHash("simctrl"):
+                msgType = (value == "simctrl") ? SimMessageType::simctrl : SimMessageType::unknown;
+                break;
+            case simJSONHash("hciaction"):
+                msgType = (value == "hciaction") ? SimMessageType::hciaction : SimMessageType::unknown;
+                break;
+            case simJSONHash("simconfaction"):
+                msgType = (value == "simconfaction") ? SimMessageType::simconfaction : SimMessageType::unknown;
+                break;
+            default:
+                ;
+        }
         // enough, found message type header.
-        msgKey = string(key);
-        msgValue = string(value);
-        validPair = true;
         pstate = PJS::end;
+        return msgType != SimMessageType::unknown;
     }
+    // other pairs in front of the type are checked by the action
+    return true;
+}
 
-    return validPair;
+bool SimJSONMessageHandler::evalPair(SimJSONView key, double value) {
+    return true;
 }
@@ -14,18 +14,28 @@
 #include "simjsonbase.h"
 #include <string>
 
+enum class SimMessageType {
+    unknown, itemaction, simctrl, hciaction, simconfaction
+};
+
 class SimJSONMessageHandler : public SimJSONBase {
 private:
-    std::string msgKey;
-    std::string msgValue;
+    SimMessageType msgType = SimMessageType::unknown;
     SimItemHandling *itemhandler;
     SimCtrlHandler *simctrlhandler;
     SimHCI *hcihandler;
     SimConfHandler *confhandler;
 public:
     SimJSONMessageHandler(SimItemHandling *itemhandler, SimCtrlHandler *simctrl=nullptr, SimHCI *hcihandler=nullptr, SimConfHandler *confhandler=nullptr) : itemhandler(itemhandler), simctrlhandler(simctrl), hcihandler(hcihandler), confhandler(confhandler) {};
-    bool dispatchMessage(std::string message);
-    bool evalPair(const char* key, const char* value) override;
+    bool dispatchMessage(const std::string &message);
+    /**
+     * Parses the message in place, it does not need to be zero terminated.
+     * Malformed messages are dropped.
+     * @return true if the message has been handed over to a handler
+     */
+    bool dispatchMessage(const char *message, size_t size);
+    bool evalPair(SimJSONView key, SimJSONView value) override;
+    bool evalPair(SimJSONView key, double value) override;
 };
 
 
@@ -5,12 +5,13 @@
  */
 
 #include "simlightbarrier.h"
+#include "simitemindex.h"
 #include <cmath>
 #include <iostream>
 
 using namespace std;
 
-SimLightBarrier::SimLightBarrier(vector<shared_ptr<SimItem> >* items, double position, SimulationIOImage* regs, unsigned short bitmask) : 
+SimLightBarrier::SimLightBarrier(vector<SimItem *>* items, double position, SimulationIOImage* regs, unsigned short bitmask) : 
 allitems(items), position(position), state(regs), bitmask(bitmask) {
 
 }
@@ -18,7 +19,9 @@ allitems(items), position(position), state(regs), bitmask(bitmask) {
 void SimLightBarrier::evalTimeStep(unsigned int simTime){
     bool interrupted = false;  // true if interrupted
     
-    for(const auto &it : (*allitems)){
+    SimItemIndex::Range range = SimItemIndex::inRange(allitems, position, 32.0);
+    for(SimItemIndex::iterator item = range.first; item != range.second; ++item){
+        const auto &it = *item;
         if(it->state==ItemState::onBelt){
             double rel_x = it->x - position;
             if(it->kind == ItemKinds::lego1 || it->kind == ItemKinds::lego2 || it->kind == ItemKinds::lego3){
@@ -47,7 +50,7 @@ void    SimLightBarrier::setStateInImage(bool interrupted){
     //cout << hex << state->in << dec << endl;  
 };
 
-SimLightBarrierSlide::SimLightBarrierSlide(vector<shared_ptr<SimItem> >* items, double position, SimulationIOImage* regs, unsigned short bitmask) :
+SimLightBarrierSlide::SimLightBarrierSlide(vector<SimItem *>* items, double position, SimulationIOImage* regs, unsigned short bitmask) :
 SimLightBarrier(items, position, regs, bitmask){
 
 }
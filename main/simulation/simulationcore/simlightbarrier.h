@@ -16,25 +16,27 @@ using namespace std;
 
 /** 
  * Evaluate an item, whether it interrupts the light barrier or not.
+ * Items on the belt must be sorted by x (see SimItemIndex).
  */
 
 class SimLightBarrier {
 protected:
-    vector<shared_ptr<SimItem>> *allitems;
+    vector<SimItem *> *allitems;
     double position;
     SimulationIOImage* state;
     unsigned short bitmask;
 public:
-    SimLightBarrier(vector<shared_ptr<SimItem>> *items, double position, SimulationIOImage* regs, unsigned short bitmask);
+    SimLightBarrier(vector<SimItem *> *items, double position, SimulationIOImage* regs, unsigned short bitmask);
     virtual ~SimLightBarrier(){};
     virtual void evalTimeStep(unsigned int simTime);
+    double getPosition() const { return position; }
 protected:
     virtual void setStateInImage(bool interrupted);
 };
 
 class SimLightBarrierSlide:public SimLightBarrier{
 public:
-    SimLightBarrierSlide(vector<shared_ptr<SimItem>> *items, double position, SimulationIOImage* regs, unsigned short bitmask);
+    SimLightBarrierSlide(vector<SimItem *> *items, double position, SimulationIOImage* regs, unsigned short bitmask);
     virtual ~SimLightBarrierSlide(){};
     void evalTimeStep(unsigned int simTime) override;
 };
@@ -4,12 +4,13 @@
  * @date 3. April 2020
  */
 #include "simmagneticsensor.h"
+#include "simitemindex.h"
 #include <cmath>
 #include <iostream>
 
 using namespace std;
 
-SimMagneticSensor::SimMagneticSensor(vector<shared_ptr<SimItem> >* items, double position, SimulationIOImage* regs, unsigned short bitmask) : 
+SimMagneticSensor::SimMagneticSensor(vector<SimItem *>* items, double position, SimulationIOImage* regs, unsigned short bitmask) : 
 allitems(items), position(position), state(regs), bitmask(bitmask) {
 
 }
@@ -17,7 +18,9 @@ allitems(items), position(position), state(regs), bitmask(bitmask) {
 void SimMagneticSensor::evalTimeStep(unsigned int simTime){
     bool magnetic = false;  // true if interrupted
     
-    for(const auto &it : (*allitems)){
+    SimItemIndex::Range range = SimItemIndex::inRange(allitems, position, 10.0);
+    for(SimItemIndex::iterator item = range.first; item != range.second; ++item){
+        const auto &it = *item;
         if(it->state==ItemState::onBelt && it->isMagnetic()){
             double rel_x = it->x - position;
             double rel_y = it->y - 60;
@@ -20,14 +20,15 @@ using namespace std;
 
 class SimMagneticSensor {
 protected:
-    vector<shared_ptr<SimItem>> *allitems;
+    vector<SimItem *> *allitems;
     double position;
     SimulationIOImage* state;
     unsigned short bitmask;
 public:
-    SimMagneticSensor(vector<shared_ptr<SimItem>> *items, double position, SimulationIOImage* regs, unsigned short bitmask);
+    SimMagneticSensor(vector<SimItem *> *items, double position, SimulationIOImage* regs, unsigned short bitmask);
     virtual ~SimMagneticSensor(){};
     virtual void evalTimeStep(unsigned int simTime);
+    double getPosition() const { return position; }
 };
 
 #endif /* SIMMAGNETICSENSOR_H */
@@ -0,0 +1,248 @@
+/*
+ * File:   simreport.cpp
+ * @date 19. Oktober 2026
+ */
+
+#include "simreport.h"
+
+#include <cmath>
+#include <sstream>
+
+static int16_t toTenthMM(double value) {
+    long result = lround(value * 10.0);
+    if (result > INT16_MAX) {
+        result = INT16_MAX;
+    } else if (result < INT16_MIN) {
+        result = INT16_MIN;
+    }
+    return (int16_t) result;
+}
+
+static uint16_t get16(const uint8_t *p) {
+    return (uint16_t) (p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t *p) {
+    return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+SimReportEncoder::SimReportEncoder(char systemId, char configuration, unsigned int capacity,
+        unsigned int keyframeInterval) :
+        buffer(SIM_REPORT_MAX_SIZE), size(0), systemId(systemId), configuration(configuration),
+        keyframeInterval(keyframeInterval > 0 ? keyframeInterval : 1), framesToKeyframe(0),
+        sequence(0), generation(1), previousID(capacity), previousKind(capacity),
+        previousX(capacity), previousY(capacity), seen(capacity, 0) {
+    previousSlots.reserve(capacity);
+    currentSlots.reserve(capacity);
+}
+
+void SimReportEncoder::reset() {
+    framesToKeyframe = 0;
+}
+
+bool SimReportEncoder::hasSpace(unsigned int bytes) const {
+    return size + bytes <= buffer.size();
+}
+
+void SimReportEncoder::put8(uint8_t value) {
+    buffer[size++] = value;
+}
+
+void SimReportEncoder::put16(uint16_t value) {
+    buffer[size++] = (uint8_t) value;
+    buffer[size++] = (uint8_t) (value >> 8);
+}
+
+void SimReportEncoder::put32(uint32_t value) {
+    put16((uint16_t) value);
+    put16((uint16_t) (value >> 16));
+}
+
+unsigned int SimReportEncoder::encode(unsigned long simTime, const SimulationIOImage &image,
+        const vector<SimItem *> &items) {
+    bool keyframe = (framesToKeyframe == 0);
+    bool truncated = false;
+    uint16_t records = 0;
+    generation++;
+
+    size = 0;
+    put8(SIM_REPORT_MAGIC0);
+    put8(SIM_REPORT_MAGIC1);
+    put8(SIM_REPORT_VERSION);
+    put8(0);   // flags, set below
+    put8(systemId);
+    put8(configuration);
+    put16(sequence);
+    put32((uint32_t) simTime);
+    put16(image.out);
+    put16(image.in);
+    put16(image.analog);
+    put16(0);  // number of records, set below
+
+    currentSlots.clear();
+    for (const auto &item : items) {
+        unsigned int slot = item->getSlot();
+        if (slot >= seen.size()) {
+            continue;   // item of another store
+        }
+        uint32_t id = item->ID;
+        uint8_t kind = (uint8_t) item->kind;
+        int16_t x = toTenthMM(item->x);
+        int16_t y = toTenthMM(item->y);
+        bool reportedBefore = !keyframe && (seen[slot] == generation - 1);
+
+        if (reportedBefore && previousID[slot] != id) {
+            // slot has been reused within one cycle
+            if (!hasSpace(5)) {
+                truncated = true;
+                break;
+            }
+            put8(SIM_REPORT_ITEM_REMOVED);
+            put32(previousID[slot]);
+            records++;
+            reportedBefore = false;
+        }
+
+        int dx = x - previousX[slot];
+        int dy = y - previousY[slot];
+        if (!reportedBefore || previousKind[slot] != kind || dx > INT8_MAX || dx < INT8_MIN
+                || dy > INT8_MAX || dy < INT8_MIN) {
+            if (!hasSpace(10)) {
+                truncated = true;
+                break;
+            }
+            put8(SIM_REPORT_ITEM_FULL);
+            put32(id);
+            put8(kind);
+            put16((uint16_t) x);
+            put16((uint16_t) y);
+            records++;
+        } else if (dx != 0 || dy != 0) {
+            if (!hasSpace(7)) {
+                truncated = true;
+                break;
+            }
+            put8(SIM_REPORT_ITEM_MOVED);
+            put32(id);
+            put8((uint8_t) (int8_t) dx);
+            put8((uint8_t) (int8_t) dy);
+            records++;
+        }
+        previousID[slot] = id;
+        previousKind[slot] = kind;
+        previousX[slot] = x;
+        previousY[slot] = y;
+        seen[slot] = generation;
+        currentSlots.push_back(slot);
+    }
+
+    if (!keyframe && !truncated) {
+        for (unsigned int slot : previousSlots) {
+            if (seen[slot] != generation) {
+                if (!hasSpace(5)) {
+                    truncated = true;
+                    break;
+                }
+                put8(SIM_REPORT_ITEM_REMOVED);
+                put32(previousID[slot]);
+                records++;
+            }
+        }
+    }
+    previousSlots.swap(currentSlots);
+
+    buffer[3] = (keyframe ? SIM_REPORT_FLAG_KEYFRAME : 0) | (truncated ? SIM_REPORT_FLAG_TRUNCATED : 0);
+    buffer[18] = (uint8_t) records;
+    buffer[19] = (uint8_t) (records >> 8);
+
+    sequence++;
+    if (truncated) {
+        framesToKeyframe = 0;   // receiver has to resynchronize
+    } else if (keyframe) {
+        framesToKeyframe = keyframeInterval - 1;
+    } else {
+        framesToKeyframe--;
+    }
+    return size;
+}
+
+bool SimReportDecoder::decode(const uint8_t *report, unsigned int size) {
+    if (size < SIM_REPORT_HEADER_SIZE || report[0] != SIM_REPORT_MAGIC0
+            || report[1] != SIM_REPORT_MAGIC1 || report[2] != SIM_REPORT_VERSION) {
+        return false;
+    }
+    uint8_t flags = report[3];
+    uint16_t reportSequence = get16(report + 6);
+    bool keyframe = (flags & SIM_REPORT_FLAG_KEYFRAME) != 0;
+    bool inSequence = synchronized && (reportSequence == (uint16_t) (sequence + 1));
+
+    systemId = (char) report[4];
+    configuration = (char) report[5];
+    sequence = reportSequence;
+    simTime = get32(report + 8);
+    actuators = get16(report + 12);
+    sensors = get16(report + 14);
+    analog = get16(report + 16);
+
+    if (!keyframe && !inSequence) {
+        synchronized = false;   // wait for next keyframe
+        return false;
+    }
+    if (keyframe) {
+        items.clear();
+    }
+    synchronized = true;
+
+    unsigned int records = get16(report + 18);
+    unsigned int pos = SIM_REPORT_HEADER_SIZE;
+    for (unsigned int i = 0; i < records && synchronized; i++) {
+        if (pos + 5 > size) {
+            synchronized = false;
+            break;
+        }
+        uint8_t tag = report[pos];
+        uint32_t id = get32(report + pos + 1);
+        pos += 5;
+        if (tag == SIM_REPORT_ITEM_FULL && pos + 5 <= size) {
+            items[id] = Item{(ItemKinds) report[pos], (int16_t) get16(report + pos + 1),
+                (int16_t) get16(report + pos + 3)};
+            pos += 5;
+        } else if (tag == SIM_REPORT_ITEM_MOVED && pos + 2 <= size && items.count(id) > 0) {
+            items[id].x += (int8_t) report[pos];
+            items[id].y += (int8_t) report[pos + 1];
+            pos += 2;
+        } else if (tag == SIM_REPORT_ITEM_REMOVED) {
+            items.erase(id);
+        } else {
+            synchronized = false;
+        }
+    }
+    if (flags & SIM_REPORT_FLAG_TRUNCATED) {
+        synchronized = false;
+    }
+    return synchronized || (flags & SIM_REPORT_FLAG_TRUNCATED);
+}
+
+string SimReportDecoder::toJSON() const {
+    stringstream json;
+    json << "{";
+    json << "\"id\": \"" << systemId << "\", ";
+    json << "\"C\": \"" << configuration << "\", ";
+    json << "\"T\": " << simTime;
+    json << ", \"actors\": " << actuators;
+    json << ", \"sensors\": " << sensors;
+    json << ", \"analog\": " << analog;
+    json << ",  \"items\": [";
+    for (auto it = items.begin(); it != items.end(); ++it) {
+        if (it != items.begin()) {
+            json << ", ";
+        }
+        json << "{\"ID\": " << it->first;
+        json << ", \"T\": \"" << SimItem::shortTypeName(it->second.kind) << "\"";
+        json << ", \"x\": " << it->second.x / 10.0;
+        json << ", \"y\": " << it->second.y / 10.0;
+        json << "}";
+    }
+    json << "]}";
+    return json.str();
+}
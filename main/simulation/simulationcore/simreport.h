@@ -0,0 +1,150 @@
+/*
+ * File:   simreport.h
+ * @date 19. Oktober 2026
+ */
+
+#ifndef SIMREPORT_H
+#define SIMREPORT_H
+
+#include "simioimage.h"
+#include "simitem.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Binary status report, all values little endian.
+ *
+ * Header (20 bytes):
+ *   0  'S', 'R'      magic
+ *   2  uint8         version
+ *   3  uint8         flags (SIM_REPORT_FLAG_*)
+ *   4  char          system id ('A', 'B')
+ *   5  char          configuration ('F' feed separator, 'P' pusher)
+ *   6  uint16        sequence number
+ *   8  uint32        simulation time [ms]
+ *  12  uint16        actuators
+ *  14  uint16        sensors
+ *  16  uint16        analog
+ *  18  uint16        number of records
+ *
+ * Records, positions in 1/10 mm:
+ *   SIM_REPORT_ITEM_FULL     uint32 ID, uint8 kind, int16 x, int16 y
+ *   SIM_REPORT_ITEM_MOVED    uint32 ID, int8 dx, int8 dy
+ *   SIM_REPORT_ITEM_REMOVED  uint32 ID
+ *
+ * A keyframe contains all items as full records. Other reports only contain
+ * the items changed since the previous report; unchanged items are omitted.
+ */
+#define SIM_REPORT_MAGIC0  'S'
+#define SIM_REPORT_MAGIC1  'R'
+#define SIM_REPORT_VERSION 1
+
+#define SIM_REPORT_FLAG_KEYFRAME  0x01
+#define SIM_REPORT_FLAG_TRUNCATED 0x02   // buffer full, not all items reported
+
+#define SIM_REPORT_ITEM_FULL    0x01
+#define SIM_REPORT_ITEM_MOVED   0x02
+#define SIM_REPORT_ITEM_REMOVED 0x03
+
+#define SIM_REPORT_HEADER_SIZE  20
+#define SIM_REPORT_MAX_SIZE     65507    // max. UDP payload
+#define SIM_REPORT_KEYFRAME_INTERVAL 50  // 1 s with the default timeslice
+
+/**
+ * Writes the binary report of a cycle into a preallocated buffer. The state
+ * of the previous report is kept per item store slot, so encoding does not
+ * allocate memory.
+ */
+class SimReportEncoder {
+private:
+    vector<uint8_t> buffer;
+    unsigned int size;
+    char systemId;
+    char configuration;
+    unsigned int keyframeInterval;
+    unsigned int framesToKeyframe;
+    uint16_t sequence;
+    uint32_t generation;
+    // previous report per item store slot
+    vector<uint32_t> previousID;
+    vector<uint8_t> previousKind;
+    vector<int16_t> previousX;
+    vector<int16_t> previousY;
+    vector<uint32_t> seen;              // generation the slot was reported last
+    vector<unsigned int> previousSlots; // slots of the previous report
+    vector<unsigned int> currentSlots;
+public:
+    SimReportEncoder(char systemId, char configuration, unsigned int capacity,
+            unsigned int keyframeInterval = SIM_REPORT_KEYFRAME_INTERVAL);
+    /**
+     * Next report is a keyframe (e.g. after the simulation has been reset).
+     */
+    void reset();
+    /**
+     * Encodes the report of the given cycle.
+     * @return size of the report in bytes
+     */
+    unsigned int encode(unsigned long simTime, const SimulationIOImage &image,
+            const vector<SimItem *> &items);
+    const uint8_t* data() const {
+        return buffer.data();
+    };
+    unsigned int getSize() const {
+        return size;
+    };
+private:
+    void put8(uint8_t value);
+    void put16(uint16_t value);
+    void put32(uint32_t value);
+    bool hasSpace(unsigned int bytes) const;
+};
+
+/**
+ * Rebuilds the state of the simulation from the binary reports, e.g. to
+ * convert them back to the JSON report for debugging.
+ */
+class SimReportDecoder {
+public:
+    struct Item {
+        ItemKinds kind;
+        int16_t x;   // [1/10 mm]
+        int16_t y;
+    };
+private:
+    char systemId = 'A';
+    char configuration = 'F';
+    unsigned long simTime = 0;
+    unsigned short actuators = 0;
+    unsigned short sensors = 0;
+    unsigned short analog = 0;
+    uint16_t sequence = 0;
+    bool synchronized = false;
+    map<uint32_t, Item> items;   // ID is increasing, same order as in the simulation
+public:
+    /**
+     * @return false if the report is invalid or the previous report is
+     * missing (the state is valid again with the next keyframe)
+     */
+    bool decode(const uint8_t *report, unsigned int size);
+    /**
+     * @return state in the format of the former JSON report
+     */
+    string toJSON() const;
+    const map<uint32_t, Item>& getItems() const {
+        return items;
+    };
+    unsigned long getSimTime() const {
+        return simTime;
+    };
+    unsigned short getSensors() const {
+        return sensors;
+    };
+};
+
+#endif /* SIMREPORT_H */
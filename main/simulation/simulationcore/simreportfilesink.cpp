@@ -0,0 +1,31 @@
+/*
+ * File:   simreportfilesink.cpp
+ * @date 19. Oktober 2026
+ */
+
+#include "simreportfilesink.h"
+
+#include <iostream>
+
+using namespace std;
+
+SimReportFileSink::SimReportFileSink(const std::string &filename) {
+    file = fopen(filename.c_str(), "wb");
+    if (file == nullptr) {
+        cout << "<SIM> Error, report file " << filename << " cannot be opened" << endl;
+    }
+}
+
+SimReportFileSink::~SimReportFileSink() {
+    if (file != nullptr) {
+        fclose(file);
+    }
+}
+
+void SimReportFileSink::handlereport(const uint8_t *report, unsigned int size) {
+    if (file != nullptr) {
+        uint8_t length[2] = {(uint8_t) size, (uint8_t) (size >> 8)};
+        fwrite(length, 1, sizeof(length), file);
+        fwrite(report, 1, size, file);
+    }
+}
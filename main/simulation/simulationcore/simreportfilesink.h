@@ -0,0 +1,32 @@
+/*
+ * File:   simreportfilesink.h
+ * @date 19. Oktober 2026
+ */
+
+#ifndef SIMREPORTFILESINK_H
+#define SIMREPORTFILESINK_H
+
+#include "isimulationreporthandler.h"
+
+#include <cstdio>
+#include <string>
+
+/**
+ * Writes the binary reports into a local file. Each report is preceded by its
+ * size as uint16 (little endian), see utils/status/simreportdecoder.py.
+ */
+class SimReportFileSink : public ISimulationReportHandler {
+private:
+    FILE *file;
+public:
+    SimReportFileSink(const std::string &filename);
+    SimReportFileSink(const SimReportFileSink&) = delete;
+    SimReportFileSink& operator=(const SimReportFileSink&) = delete;
+    virtual ~SimReportFileSink();
+    bool isOpen() {
+        return file != nullptr;
+    };
+    void handlereport(const uint8_t *report, unsigned int size) override;
+};
+
+#endif /* SIMREPORTFILESINK_H */
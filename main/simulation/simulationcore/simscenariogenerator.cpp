@@ -0,0 +1,207 @@
+/*
+ * File:   simscenariogenerator.cpp
+ * @date 19. Oktober 2026
+ */
+
+#include "simscenariogenerator.h"
+#include "simhciaction.h"
+
+#include <sstream>
+
+namespace {
+
+// Nothing left but white space
+bool atEnd(istream &words) {
+    return words.eof() || (words >> ws).eof();
+}
+
+// Optional value at the end of the statement, false if there is something
+// else than the value
+template<typename T>
+bool readOptional(istream &words, T &value) {
+    return atEnd(words) || static_cast<bool>(words >> value);
+}
+
+}
+
+constexpr unsigned int SimScenarioGenerator::defaultMinGap;
+
+SimScenarioGenerator::SimScenarioGenerator() : cursor(1000), flipProbability(0.0), stickyProbability(0.0),
+        clearAt(0), clearPeriod(0) {
+}
+
+bool SimScenarioGenerator::generate(const string &description, unsigned int seed, SimScenario &scenario) {
+    generator.seed(seed);
+    cursor = 1000;
+    // same kinds as SimScenario::random()
+    kinds = {ItemKinds::flat, ItemKinds::holeup, ItemKinds::holedown, ItemKinds::metalup,
+        ItemKinds::metaldown, ItemKinds::codeA, ItemKinds::codeB, ItemKinds::codeC};
+    weights.assign(kinds.size(), 1.0);
+    flipProbability = 0.0;
+    stickyProbability = 0.0;
+    clearAt = 0;
+    clearPeriod = 0;
+    errorText.clear();
+    scenario.seed = seed;
+
+    istringstream lines(description);
+    string line;
+    unsigned int lineNumber = 0;
+    while (getline(lines, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != string::npos) {
+            line.erase(comment);
+        }
+        if (!statement(line, scenario)) {
+            errorText = "line " + to_string(lineNumber) + ": " + errorText;
+            return false;
+        }
+    }
+    if (scenario.duration == 0) {
+        scenario.duration = cursor + 10000;   // last item has passed the belt
+    }
+    // operator empties the slide regularly
+    for (unsigned int at = clearAt + clearPeriod; clearPeriod > 0 && at < scenario.duration; at += clearPeriod) {
+        scenario.script.push_back(SimItemHandlingAction(at, SimItemHandlingActionKind::removeallslide));
+    }
+    return true;
+}
+
+bool SimScenarioGenerator::statement(const string &line, SimScenario &scenario) {
+    istringstream words(line);
+    string keyword;
+    if (!(words >> keyword)) {
+        return true;   // empty line
+    }
+
+    if (keyword == "duration") {
+        words >> scenario.duration;
+    } else if (keyword == "at") {
+        words >> cursor;
+    } else if (keyword == "mix") {
+        kinds.clear();
+        weights.clear();
+        string name;
+        double weight;
+        while (words && !atEnd(words)) {
+            ItemKinds kind;
+            if (!(words >> name >> weight)) {
+                break;   // reported below
+            }
+            if (!SimItemHandlingAction::kindOf(SimJSONView(name.c_str()), kind) || weight < 0) {
+                errorText = "unknown kind " + name;
+                return false;
+            }
+            kinds.push_back(kind);
+            weights.push_back(weight);
+        }
+        if (kinds.empty() && !words.fail()) {
+            errorText = "mix without kinds";
+            return false;
+        }
+    } else if (keyword == "flip" || keyword == "sticky") {
+        double probability = -1.0;
+        words >> probability;
+        if (probability < 0.0 || probability > 1.0) {
+            errorText = "probability of " + keyword + " has to be within 0..1";
+            return false;
+        }
+        (keyword == "flip" ? flipProbability : stickyProbability) = probability;
+    } else if (keyword == "periodic") {
+        unsigned int items = 0, gap = 0;
+        words >> items >> gap;
+        for (unsigned int i = 0; words && i < items; i++) {
+            addItem(scenario, cursor);
+            cursor += gap;
+        }
+    } else if (keyword == "poisson") {
+        unsigned int items = 0, minGap = defaultMinGap;
+        double mean = 0.0;
+        if (!(words >> items >> mean) || !readOptional(words, minGap)) {
+            errorText = "missing or invalid value for " + keyword;
+            return false;
+        }
+        if (mean <= minGap) {
+            errorText = "mean gap has to be greater than the min. gap";
+            return false;
+        }
+        // shifted exponential distribution, mean stays the given one
+        exponential_distribution<double> gaps(1.0 / (mean - minGap));
+        for (unsigned int i = 0; i < items; i++) {
+            addItem(scenario, cursor);
+            cursor += minGap + (unsigned int) gaps(generator);
+        }
+    } else if (keyword == "burst") {
+        unsigned int bursts = 0, items = 0, gap = 0, pause = 0;
+        words >> bursts >> items >> gap >> pause;
+        for (unsigned int b = 0; words && b < bursts; b++) {
+            for (unsigned int i = 0; i < items; i++) {
+                addItem(scenario, cursor);
+                cursor += gap;
+            }
+            cursor += pause;
+        }
+    } else if (keyword == "estop") {
+        unsigned int at = 0, hold = 0;
+        if (words >> at >> hold) {
+            scenario.hciScript.push_back(SimHCIAction(at, SimHCIActionKind::pressEStopOnly));
+            scenario.hciScript.push_back(SimHCIAction(at + hold, SimHCIActionKind::pressResetOnly));
+            scenario.hciScript.push_back(SimHCIAction(at + hold + 500, SimHCIActionKind::releaseAll));
+        }
+    } else if (keyword == "rampfull") {
+        unsigned int at = 0;
+        string name = "flat";
+        words >> at;
+        readOptional(words, name);
+        SimItemHandlingAction action(at, SimItemHandlingActionKind::fillslide);
+        if (words && !SimItemHandlingAction::kindOf(SimJSONView(name.c_str()), action.kind)) {
+            errorText = "unknown kind " + name;
+            return false;
+        }
+        if (words) {
+            scenario.script.push_back(action);
+        }
+    } else if (keyword == "rampclear") {
+        unsigned int at = 0, period = 0;
+        if (words >> at && readOptional(words, period)) {
+            clearAt = at;
+            clearPeriod = period;
+            scenario.script.push_back(SimItemHandlingAction(at, SimItemHandlingActionKind::removeallslide));
+        }
+    } else if (keyword == "sortout" || keyword == "order") {
+        vector<ItemKinds> &list = keyword == "sortout" ? scenario.sortOrder.sortOut : scenario.sortOrder.order;
+        list.clear();
+        string name;
+        while (words >> name) {
+            ItemKinds kind;
+            if (!SimItemHandlingAction::kindOf(SimJSONView(name.c_str()), kind)) {
+                errorText = "unknown kind " + name;
+                return false;
+            }
+            list.push_back(kind);
+        }
+        if (list.empty()) {
+            errorText = keyword + " without kinds";
+            return false;
+        }
+        return true;
+    } else {
+        errorText = "unknown statement " + keyword;
+        return false;
+    }
+
+    if (words.fail()) {
+        errorText = "missing or invalid value for " + keyword;
+        return false;
+    }
+    return true;
+}
+
+void SimScenarioGenerator::addItem(SimScenario &scenario, unsigned int atTime) {
+    discrete_distribution<unsigned int> kind(weights.begin(), weights.end());
+    bernoulli_distribution flip(flipProbability);
+    bernoulli_distribution sticky(stickyProbability);
+    scenario.script.push_back(SimItemHandlingAction(atTime, kinds[kind(generator)],
+            flip(generator), sticky(generator)));
+}
@@ -0,0 +1,74 @@
+/*
+ * File:   simscenariogenerator.h
+ * @date 19. Oktober 2026
+ */
+
+#ifndef SIMSCENARIOGENERATOR_H
+#define SIMSCENARIOGENERATOR_H
+
+#include "simscenariorunner.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Compiles a scenario description into the item and HCI action lists of a
+ * SimScenario. One statement per line, '#' starts a comment, times in ms:
+ *
+ *   duration <ms>                      simulated time
+ *   at <ms>                            time of the next arrival (default 1000)
+ *   mix <kind> <weight> ...            kinds of the following items, names as in the
+ *                                      item actions (flat, holeup, metalup, ...)
+ *   flip <probability>                 following items are turned over when passed
+ *                                      to the partner system
+ *   sticky <probability>               following items leave the belt to the slide
+ *                                      at half speed
+ *   periodic <items> <gap>             one item every gap ms
+ *   poisson <items> <mean> [<min>]     random arrivals, exponential gaps of the given
+ *                                      mean, but at least min ms (default 800)
+ *   burst <bursts> <items> <gap> <pause>  groups of items gap ms apart, pause
+ *                                      ms between the groups
+ *   estop <at> <hold>                  E-Stop pressed for hold ms, then reset
+ *   rampfull <at> [<kind>]             slide filled with items
+ *   rampclear <at> [<period>]          slide emptied, repeated each period ms
+ *                                      until the end of the scenario
+ *   sortout <kind> ...                 kinds which belong on the slide
+ *   order <kind> ...                   order of the kinds at the end of the belt,
+ *                                      see SimSortOrder
+ *
+ * Arrival statements continue at the time the previous one ended. The same
+ * description and seed always result in the same scenario.
+ */
+class SimScenarioGenerator {
+private:
+    mt19937 generator;
+    unsigned int cursor;    // [ms] time of the next arrival
+    vector<ItemKinds> kinds;
+    vector<double> weights;
+    double flipProbability;
+    double stickyProbability;
+    unsigned int clearAt;       // [ms] slide emptied first
+    unsigned int clearPeriod;   // [ms] and then each period, 0: once
+    string errorText;
+public:
+    static constexpr unsigned int defaultMinGap = 800;   // item clears the entry light barrier
+
+    SimScenarioGenerator();
+    /**
+     * @param scenario Result, seed and duration are set, actions are added
+     * @return false on syntax errors, see error()
+     */
+    bool generate(const string &description, unsigned int seed, SimScenario &scenario);
+    const string& error() const {
+        return errorText;
+    };
+private:
+    bool statement(const string &line, SimScenario &scenario);
+    void addItem(SimScenario &scenario, unsigned int atTime);
+};
+
+#endif /* SIMSCENARIOGENERATOR_H */
+
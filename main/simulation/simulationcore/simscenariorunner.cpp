@@ -0,0 +1,184 @@
+/* 
+ * File:   simscenariorunner.cpp
+ * @date 19. Oktober 2026
+ */
+
+#include "simscenariorunner.h"
+#include "isimdrophandler.h"
+#include "simitemhandling.h"
+#include "simhci.h"
+#include "simmasks.h"
+#include "simconf.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <random>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+// Simulation time each item has been seen on the belt the first time
+typedef map<unsigned int, unsigned long> SimScenarioEntries;
+
+class SimScenarioDropCounter : public ISimDropHandler {
+private:
+    SimScenarioSortJudge *judge;
+    SimScenarioResult *result;
+    Simulation *sim;
+    SimScenarioEntries *entries;
+public:
+    SimScenarioDropCounter(SimScenarioSortJudge *judge, SimScenarioResult *result, Simulation *sim,
+            SimScenarioEntries *entries) : judge(judge), result(result), sim(sim), entries(entries) {};
+    void dropEnd(SimItem *droppeditem) override {
+        result->passed++;
+        if (judge->left(droppeditem->kind, true)) {
+            result->asOrdered++;
+        }
+        auto entry = entries->find(droppeditem->ID);
+        if (entry != entries->end()) {
+            result->transitTimes.push_back(sim->currentSimTime() - entry->second);
+        }
+        result->lastExit = sim->currentSimTime();
+    };
+};
+
+unsigned int percentile(const vector<unsigned int> &sorted, unsigned int percent) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    // nearest rank
+    size_t rank = (sorted.size() * percent + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+}
+
+SimScenario SimScenario::random(unsigned int seed, unsigned int nItems, unsigned int gap, unsigned int duration) {
+    static const ItemKinds kinds[] = {ItemKinds::flat, ItemKinds::holeup, ItemKinds::holedown,
+            ItemKinds::metalup, ItemKinds::metaldown, ItemKinds::codeA, ItemKinds::codeB, ItemKinds::codeC};
+    mt19937 generator(seed);
+    uniform_int_distribution<unsigned int> kind(0, sizeof(kinds) / sizeof(kinds[0]) - 1);
+
+    SimScenario scenario;
+    scenario.seed = seed;
+    scenario.duration = duration;
+    for (unsigned int i = 0; i < nItems; i++) {
+        scenario.script.push_back(SimItemHandlingAction(1000 + i * gap, kinds[kind(generator)]));
+    }
+    return scenario;
+}
+
+SimScenarioRunner::SimScenarioRunner(StrategyFactory factory, unsigned int nThreads) : factory(factory), nThreads(nThreads) {
+    if (this->nThreads == 0) {
+        this->nThreads = max(1u, thread::hardware_concurrency());
+    }
+}
+
+vector<SimScenarioResult> SimScenarioRunner::run(const vector<SimScenario> &scenarios) {
+    vector<SimScenarioResult> results(scenarios.size());
+    atomic<size_t> next(0);
+
+    auto worker = [&]() {
+        // the scenarios run side by side, their console output is useless
+        bool quiet = SimConfiguration::isQuiet();
+        SimConfiguration::setQuiet(true);
+        size_t index;
+        while ((index = next++) < scenarios.size()) {
+            results[index] = runScenario(scenarios[index]);
+        }
+        SimConfiguration::setQuiet(quiet);
+    };
+    vector<thread> workers;
+    for (unsigned int i = 1; i < min<size_t>(nThreads, scenarios.size()); i++) {
+        workers.push_back(thread(worker));
+    }
+    worker();
+    for (auto &w : workers) {
+        w.join();
+    }
+    return results;
+}
+
+SimScenarioResult SimScenarioRunner::runScenario(const SimScenario &scenario) {
+    SimScenarioResult result;
+    result.seed = scenario.seed;
+
+    unique_ptr<ISimScenarioStrategy> strategy = factory();
+    SimItemHandling handling;
+    for (const auto &action : scenario.script) {
+        handling.addAction(action);
+        if (action.actionkind == SimItemHandlingActionKind::add) {
+            result.added++;
+        }
+    }
+    SimHCI hci;
+    for (const auto &action : scenario.hciScript) {
+        hci.addAction(action);
+    }
+    Simulation sim(&handling, &hci);
+    SimScenarioEntries entries;
+    SimScenarioSortJudge judge(scenario.sortOrder);
+    SimScenarioDropCounter dropCounter(&judge, &result, &sim, &entries);
+    sim.setDropHandler(&dropCounter);
+
+    set<unsigned int> slide;
+    bool red = false;
+    while (sim.currentSimTime() < scenario.duration) {
+        sim.simulateTime(sim.getTimeslice());
+        strategy->control(sim);
+        for (const auto &item : sim.getItems()) {
+            if (item->state == ItemState::onBelt) {
+                entries.insert(make_pair(item->ID, sim.currentSimTime()));
+            } else if (item->state == ItemState::onSlide && slide.insert(item->ID).second) {
+                // items put on the slide by the scenario have never been on the belt
+                auto entry = entries.find(item->ID);
+                if (entry != entries.end()) {
+                    result.sortedOut++;
+                    if (judge.left(item->kind, false)) {
+                        result.asOrdered++;
+                    }
+                    result.transitTimes.push_back(sim.currentSimTime() - entry->second);
+                    result.lastExit = sim.currentSimTime();
+                }
+            }
+        }
+        bool lamp = (sim.readOut() & SIM_ALARM_LAMP_RED) != 0;
+        if (lamp && !red) {
+            result.errorStops++;
+        }
+        red = lamp;
+    }
+    result.simTime = sim.currentSimTime();
+    return result;
+}
+
+SimScenarioSummary SimScenarioRunner::summarize(const vector<SimScenarioResult> &results) {
+    SimScenarioSummary summary;
+    unsigned long simTime = 0;
+    vector<unsigned int> transitTimes;
+    for (const auto &result : results) {
+        summary.runs++;
+        summary.errorStops += result.errorStops;
+        transitTimes.insert(transitTimes.end(), result.transitTimes.begin(), result.transitTimes.end());
+        summary.added += result.added;
+        summary.passed += result.passed;
+        summary.sortedOut += result.sortedOut;
+        summary.asOrdered += result.asOrdered;
+        simTime += result.lastExit > 0 ? result.lastExit : result.simTime;
+    }
+    if (simTime > 0) {
+        summary.itemsPerMinute = (summary.passed + summary.sortedOut) * 60000.0 / simTime;
+    }
+    if (summary.passed + summary.sortedOut > 0) {
+        summary.orderAccuracy = (double) summary.asOrdered / (summary.passed + summary.sortedOut);
+    }
+    sort(transitTimes.begin(), transitTimes.end());
+    summary.transitP50 = percentile(transitTimes, 50);
+    summary.transitP90 = percentile(transitTimes, 90);
+    summary.transitP99 = percentile(transitTimes, 99);
+    return summary;
+}
@@ -0,0 +1,139 @@
+/* 
+ * File:   simscenariorunner.h
+ * @date 19. Oktober 2026
+ */
+
+#ifndef SIMSCENARIORUNNER_H
+#define SIMSCENARIORUNNER_H
+
+#include "simulation.h"
+#include "simitemhandlingaction.h"
+#include "simhciaction.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Where the items belong, configured like the sorting of the application and
+ * independent of the strategy under test. Kinds in sortOut always belong on
+ * the slide. The other kinds have to leave the end of the belt in the given
+ * order (repeated), an item which is not the next kind of the order belongs
+ * on the slide. Without order all other kinds belong to the end of the belt.
+ */
+struct SimSortOrder {
+    vector<ItemKinds> sortOut;
+    vector<ItemKinds> order;
+};
+
+/**
+ * Grades the items in the order they leave the belt, or the line of both
+ * systems.
+ */
+class SimScenarioSortJudge {
+private:
+    const SimSortOrder &sortOrder;
+    size_t next = 0;   // index of the next kind of the order
+public:
+    SimScenarioSortJudge(const SimSortOrder &sortOrder) : sortOrder(sortOrder) {};
+    /**
+     * @return true if the item left the belt where it belongs
+     */
+    bool left(ItemKinds kind, bool passed) {
+        bool belongsToEnd = find(sortOrder.sortOut.begin(), sortOrder.sortOut.end(), kind) == sortOrder.sortOut.end()
+                && (sortOrder.order.empty() || sortOrder.order[next] == kind);
+        if (belongsToEnd && passed && !sortOrder.order.empty()) {
+            next = (next + 1) % sortOrder.order.size();
+        }
+        return belongsToEnd == passed;
+    };
+};
+
+/**
+ * One independent run: an item script, the buttons pressed and the simulated
+ * duration. See SimScenarioGenerator for scenarios described as text.
+ */
+class SimScenario {
+public:
+    unsigned int seed = 0;
+    unsigned int duration = 0; // [ms] simulated time
+    vector<SimItemHandlingAction> script;
+    vector<SimHCIAction> hciScript;
+    SimSortOrder sortOrder;
+
+    /**
+     * Script with nItems random items, one every gap ms.
+     */
+    static SimScenario random(unsigned int seed, unsigned int nItems, unsigned int gap, unsigned int duration);
+};
+
+/**
+ * Sort strategy under test, replaces the control software of the real system.
+ * One instance per run.
+ */
+class ISimScenarioStrategy {
+public:
+    virtual ~ISimScenarioStrategy(){};
+    /**
+     * Called after each simulation cycle, reads the sensors and writes the
+     * actuators of the simulation.
+     */
+    virtual void control(Simulation &sim) = 0;
+};
+
+struct SimScenarioResult {
+    unsigned int seed = 0;
+    unsigned long simTime = 0;  // [ms]
+    unsigned long lastExit = 0; // [ms] last item left the belt
+    unsigned int added = 0;     // items of the script
+    unsigned int passed = 0;    // dropped at the end of the belt
+    unsigned int sortedOut = 0; // ended on the slide
+    unsigned int asOrdered = 0; // passed or sorted out as the sort order of the scenario requires
+    unsigned int errorStops = 0;         // red lamp switched on by the strategy
+    vector<unsigned int> transitTimes;   // [ms] entry to end of belt or slide, per item
+};
+
+struct SimScenarioSummary {
+    unsigned int runs = 0;
+    unsigned int added = 0;
+    unsigned int passed = 0;
+    unsigned int sortedOut = 0;
+    unsigned int asOrdered = 0;
+    double itemsPerMinute = 0.0;   // per run, until the last item left the belt
+    double orderAccuracy = 0.0;    // asOrdered / (passed + sortedOut)
+    unsigned int errorStops = 0;
+    unsigned int transitP50 = 0;   // [ms] percentiles of the transit time over the belt
+    unsigned int transitP90 = 0;
+    unsigned int transitP99 = 0;
+};
+
+/**
+ * Executes many scenarios with independent Simulation instances on all
+ * cores. Workers take the next scenario as soon as they are done with the
+ * previous one, so long and short runs are balanced.
+ */
+class SimScenarioRunner {
+public:
+    typedef function<unique_ptr<ISimScenarioStrategy>()> StrategyFactory;
+private:
+    StrategyFactory factory;
+    unsigned int nThreads;
+public:
+    /**
+     * @param nThreads number of worker threads, 0: one per core
+     */
+    SimScenarioRunner(StrategyFactory factory, unsigned int nThreads = 0);
+    /**
+     * Runs the scenarios on the worker threads, quiet: the console output of
+     * the simulations is switched off (SimConfiguration::setQuiet()).
+     */
+    vector<SimScenarioResult> run(const vector<SimScenario> &scenarios);
+    SimScenarioResult runScenario(const SimScenario &scenario);
+    static SimScenarioSummary summarize(const vector<SimScenarioResult> &results);
+};
+
+#endif /* SIMSCENARIORUNNER_H */
+
@@ -8,22 +8,20 @@
 
 #include <iostream>
 
-SimSlide::SimSlide(vector<shared_ptr<SimItem>> *items) : items(items), speedY(0.0), displayCounter(0) {
-    speedY = 80 * SimulationBase::timeslice / 1000.0;
-    ; // 80 mm/s * sim cycle time/step --> mm / step
+SimSlide::SimSlide(vector<SimItem *> *items) : items(items), speedY(0.0), displayCounter(0) {
+    speedY = 80 / 1000.0; // 80 mm/s --> mm / ms, multiplied with the step duration
 };
 
-void SimSlide::addItem(const shared_ptr<SimItem> &item) {
+void SimSlide::addItem(SimItem *item) {
     item->state = ItemState::onSlide;
     if (items != nullptr) {
         items->push_back(item);
     }
 }
 
-void SimSlide::evalTimeStep(unsigned int simTime) {
+void SimSlide::housekeeping() {
     if (items != nullptr) {
-        // housekeeping
-        vector<shared_ptr<SimItem>>::iterator it = items->begin();
+        vector<SimItem *>::iterator it = items->begin();
         while (it != items->end()) {
             // check if removed from system
             if ((*it)->state != ItemState::onSlide) {
@@ -32,12 +30,18 @@ void SimSlide::evalTimeStep(unsigned int simTime) {
                 ++it;
             }
         }
+    }
+}
+
+void SimSlide::evalTimeStep(unsigned int simTime, unsigned int duration) {
+    if (items != nullptr) {
+        housekeeping();
 
         // move remaining items
         for (unsigned int index = 0; index < items->size(); ++index) {
-            shared_ptr<SimItem> item = (*items)[index];
+            SimItem *item = (*items)[index];
             double maxY = 80 + slideDepth - 20 - index * 40;
-            item->y = item->y + speedY;
+            item->y = item->y + speedY * duration;
             if (item->y > maxY) {
                 item->y = maxY;
             }
@@ -57,7 +61,7 @@ void SimSlide::evalTimeStep(unsigned int simTime) {
 
 void SimSlide::removeFirst() {
     if (items != nullptr) {
-        vector<shared_ptr<SimItem>>::iterator it = items->begin();
+        vector<SimItem *>::iterator it = items->begin();
         while (it != items->end()) {
             // check if still in system an not taged as removed yet
             if ((*it)->state == ItemState::onSlide) {
@@ -73,7 +77,7 @@ void SimSlide::removeFirst() {
 
 void SimSlide::removeAll() {
     if (items != nullptr) {
-        vector<shared_ptr<SimItem>>::iterator it = items->begin();
+        vector<SimItem *>::iterator it = items->begin();
         while (it != items->end()) {
             // housekeeping removes item later
             (*it)->state = ItemState::removed;
@@ -81,3 +85,15 @@ void SimSlide::removeAll() {
         }
     }
 }
+
+unsigned int SimSlide::size() {
+    unsigned int result = 0;
+    if (items != nullptr) {
+        for (const auto &item : *items) {
+            if (item->state == ItemState::onSlide) {
+                result++;
+            }
+        }
+    }
+    return result;
+}
@@ -18,16 +18,20 @@ using namespace std;
 class SimSlide{
 public:
     static constexpr double slideDepth = 130;    // three items of 40 mm
+    static constexpr unsigned int capacity = 3;  // items until the slide is full
+    static constexpr double entryX = 415;        // items enter the slide at the feed separator
 private:
-    vector<shared_ptr<SimItem>> *items;
+    vector<SimItem *> *items;
     double speedY;
     int displayCounter;
 public:
-    SimSlide(vector<shared_ptr<SimItem>> *items);
-    void addItem(const shared_ptr<SimItem> &item);
-    void evalTimeStep(unsigned int simTime); 
+    SimSlide(vector<SimItem *> *items);
+    void addItem(SimItem *item);
+    void evalTimeStep(unsigned int simTime, unsigned int duration);
+    void housekeeping();   // drops items no longer on the slide from the list
     void removeFirst();
     void removeAll();
+    unsigned int size();   // items on the slide
 };
 
 #endif /* SIMSLIDE_H */
@@ -8,12 +8,29 @@
 #include "simitemhandling.h"
 #include "simbase.h"
 #include "simconfquery.h"
+#include "simitemindex.h"
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 using namespace std;
 
-unsigned int Simulation::instancecounter = 0;
+#ifndef SIM_TWIN_B
+#define SIM_REPORT_SYSTEM_ID 'A'
+#else
+#define SIM_REPORT_SYSTEM_ID 'B'
+#endif
+#ifndef SIM_PUSHER
+#define SIM_REPORT_CONFIGURATION 'F'
+#else
+#define SIM_REPORT_CONFIGURATION 'P'
+#endif
+
+// Distance of an item (center) to a sensor to switch to sub-steps [mm]
+#define SIM_SUBSTEP_WINDOW 32.0
+
+std::atomic<unsigned int> Simulation::instancecounter(0);
 
 #ifdef SIM_PUSHER
 Simulation::Simulation(SimItemHandling* itemhandling, SimHCI *hci, SimConfHandler *confhandler, ISimInitCompleteObserver *ich) : feedpusher(&shadow), drive(&shadow), siminitobserver(ich) {
@@ -21,6 +38,7 @@ Simulation::Simulation(SimItemHandling* itemhandling, SimHCI *hci, SimConfHandle
 Simulation::Simulation(SimItemHandling* itemhandling, SimHCI *hci, SimConfHandler *confhandler, ISimInitCompleteObserver *ich) : feedseparator(&shadow), drive(&shadow), siminitobserver(ich) {
 #endif
     instancenumber = instancecounter++;
+    itemstore = shared_ptr<SimItemStore>(new SimItemStore(SimulationBase::itemCapacity));
 
     this->confhandler = confhandler;
 
@@ -30,11 +48,11 @@ Simulation::Simulation(SimItemHandling* itemhandling, SimHCI *hci, SimConfHandle
 
     slide = new SimSlide(&slideitems);
 #ifdef SIM_PUSHER
-    conveyor = new SimConveyorBelt(&conveyoritems, slide, &drive, &feedpusher);
+    conveyor = new SimConveyorBelt(&conveyoritems, itemstore.get(), slide, &drive, &feedpusher);
 #else
-    conveyor = new SimConveyorBelt(&conveyoritems, slide, &drive, &feedseparator);
+    conveyor = new SimConveyorBelt(&conveyoritems, itemstore.get(), slide, &drive, &feedseparator);
 #endif    
-    manager = new SimItemManager(&allitems, conveyor, slide);
+    manager = new SimItemManager(&allitems, itemstore, conveyor, slide);
 
     lBBegin = new SimLightBarrier(&conveyoritems, 20.0, &shadow, 0x0001);
     lBHight = new SimLightBarrier(&conveyoritems, 290.0, &shadow, 0x0002);
@@ -44,6 +62,8 @@ Simulation::Simulation(SimItemHandling* itemhandling, SimHCI *hci, SimConfHandle
 
     magnetSensor = new SimMagneticSensor(&conveyoritems, 395.0, &shadow, 0x0010);
     heightSensor = new SimHeightSensor(&conveyoritems, 270, &shadow, 0x0004);
+    sensorpositions = {lBBegin->getPosition(), heightSensor->getPosition(), lBHight->getPosition(),
+        magnetSensor->getPosition(), lBFeedseparator->getPosition(), lbEnd->getPosition()};
 
     this->itemhandling = itemhandling;
     if (this->itemhandling != nullptr) {
@@ -103,16 +123,10 @@ void Simulation::init() {
     manager->checkRoI();
     show_in();
 
-    if (reporthandler.size() > 0) {
-        string report = generateJSONStatusReport() + std::string("\n");
-        for (const auto& rh : reporthandler) {
-            rh->handlereport(report);
-        }
-
-        if (SIMCONFQUERRY_ISACTIVE(showreport)){
-        	std::cout << "<Sim> state:" << report << std::endl;
-        }
+    if (reportencoder) {
+        reportencoder->reset();
     }
+    report();
 
     if (simreleased) { // init only completed if released, so maybe called twice
         last_update_time_high = std::chrono::high_resolution_clock::now();
@@ -154,7 +168,7 @@ unsigned short Simulation::readIn() {
     return result;
 };
 
-void Simulation::doSimulationCycle() {
+void Simulation::doSimulationCycle(unsigned int duration) {
     std::chrono::time_point<std::chrono::high_resolution_clock> now_high_start;
     now_high_start = std::chrono::high_resolution_clock::now();
 
@@ -188,8 +202,8 @@ void Simulation::doSimulationCycle() {
         }
 
         // update actuators
-        conveyor->evalTimeStep(simTime);
-        slide->evalTimeStep(simTime);
+        conveyor->evalTimeStep(simTime, duration);
+        slide->evalTimeStep(simTime, duration);
 
         manager->housekeeping();
 
@@ -214,16 +228,7 @@ void Simulation::doSimulationCycle() {
         manager->checkRoI();
         show_in();
 
-        if (reporthandler.size() > 0) {
-            string report = generateJSONStatusReport() + std::string("\n");
-            for (const auto& rh : reporthandler) {
-                rh->handlereport(report);
-            }
-
-            if (SIMCONFQUERRY_ISACTIVE(showreport)){
-            	std::cout << "<Sim> state:" << report << std::endl;
-            }
-        }
+        report();
         oneCycleHasBeenExecuted = true;
 
         if(SIMCONFQUERRY_ISACTIVE(showcycleduration)){
@@ -235,6 +240,19 @@ void Simulation::doSimulationCycle() {
     }
 };
 
+void Simulation::report() {
+    if (reporthandler.size() > 0) {
+        unsigned int size = reportencoder->encode(simTime, shadow, allitems);
+        for (const auto& rh : reporthandler) {
+            rh->handlereport(reportencoder->data(), size);
+        }
+
+        if (SIMCONFQUERRY_ISACTIVE(showreport)){
+        	std::cout << "<Sim> state:" << generateJSONStatusReport() << std::endl;
+        }
+    }
+}
+
 void Simulation::show_out() {
     display->showDiffOut();
 };
@@ -249,9 +267,9 @@ void Simulation::evaluateRealTimeStep() {
 
     std::chrono::milliseconds elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds> (now_high - last_update_time_high);
 
-    if (elapsed_milliseconds.count() >= SimulationBase::realTimeSlice) {
+    if (elapsed_milliseconds >= std::chrono::milliseconds(timeslice)) {
         last_update_time_high = now_high;
-        simulateTime(SimulationBase::realTimeSlice); // should be elapsed_milleseconds to be more sync to real time.
+        simulateTime(elapsed_milliseconds.count());
     }
 };
 
@@ -262,14 +280,59 @@ void Simulation::evaluateRealTimeStep() {
 void Simulation::simulateTime(unsigned int duration) {
     if (simreleased) {
         simLack = simLack + duration;
-        while (simLack >= SimulationBase::timeslice) {
-            simLack = simLack - SimulationBase::timeslice;
-            simTime = simTime + SimulationBase::timeslice;
-            doSimulationCycle();
+        while (simLack >= timeslice) {
+            simLack = simLack - timeslice;
+            if (substep > 0 && substep < timeslice && itemNearSensor()) {
+                // only the last timeslice is paced, a lack is caught up at once
+                bool paced = realtime && simLack < timeslice;
+                std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+                unsigned int done = 0;
+                while (done < timeslice) {
+                    if (paced && done > 0) {
+                        std::this_thread::sleep_until(begin + std::chrono::milliseconds(done));
+                    }
+                    unsigned int step = std::min(substep, timeslice - done);
+                    done = done + step;
+                    simTime = simTime + step;
+                    doSimulationCycle(step);
+                }
+            } else {
+                simTime = simTime + timeslice;
+                doSimulationCycle(timeslice);
+            }
         }
     }
 }
 
+/**
+ * Checks whether an item may reach or leave the detection range of a sensor
+ * within the next timeslice.
+ */
+bool Simulation::itemNearSensor() {
+    double distance = SIM_SUBSTEP_WINDOW + SPEED_X_NORMAL * timeslice / 1000.0;
+    for (double position : sensorpositions) {
+        SimItemIndex::Range range = SimItemIndex::inRange(&conveyoritems, position, distance);
+        if (range.first != range.second) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Simulation::setTimeslice(unsigned int ms) {
+    if (ms > 0) {
+        timeslice = ms;
+    }
+}
+
+void Simulation::setSubstep(unsigned int ms) {
+    substep = ms;
+}
+
+void Simulation::setRealTime(bool enable) {
+    realtime = enable;
+}
+
 void Simulation::addCycleEndHandler(ISimulationCycleEndHandler* ehd) {
     cylceendhandler.push_back(ehd);
 
@@ -278,6 +341,10 @@ void Simulation::addCycleEndHandler(ISimulationCycleEndHandler* ehd) {
 }
 
 void Simulation::addReportHandler(ISimulationReportHandler* rh) {
+    if (!reportencoder) {
+        reportencoder.reset(new SimReportEncoder(SIM_REPORT_SYSTEM_ID, SIM_REPORT_CONFIGURATION,
+                SimulationBase::itemCapacity));
+    }
     reporthandler.push_back(rh);
 }
 
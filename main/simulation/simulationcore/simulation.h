@@ -27,6 +27,8 @@
 #include "simfeedseparator.h"
 #include "simfeedpusher.h"
 #include "simbase.h"
+#include "simreport.h"
+#include <atomic>
 #include <chrono>
 #include <mutex>
 
@@ -40,6 +42,9 @@ private:
 private:
     unsigned long simTime = 0; // [ms]
     unsigned long simLack = 0; // [ms]
+    unsigned int timeslice = SimulationBase::timeslice; // [ms]
+    unsigned int substep = 0; // [ms], 0: no sub-stepping
+    bool realtime = false;    // sub-steps are paced in real time
     std::chrono::time_point<std::chrono::high_resolution_clock> last_update_time_high;
     int displayCounter = SimulationBase::displayEachNCycle - 1;
 private:
@@ -63,18 +68,21 @@ private:
     SimLightBarrierSlide *lbSlide;
     SimMagneticSensor *magnetSensor;
     SimHeightSensor *heightSensor;
+    vector<double> sensorpositions;   // x of all sensors along the belt
     SimItemHandling *itemhandling;
     SimHCI* hci;
     SimConfHandler *confhandler;
-    vector<shared_ptr < SimItem>> allitems;
-    vector<shared_ptr < SimItem>> conveyoritems;
-    vector<shared_ptr < SimItem>> slideitems;
+    shared_ptr<SimItemStore> itemstore;
+    vector<SimItem *> allitems;
+    vector<SimItem *> conveyoritems;
+    vector<SimItem *> slideitems;
     vector< ISimulationCycleEndHandler*> cylceendhandler;
     vector< ISimulationReportHandler*> reporthandler;
+    unique_ptr<SimReportEncoder> reportencoder;   // created with the first report handler
     ISimInitCompleteObserver *siminitobserver;
     std::mutex buffermutex;
     unsigned int instancenumber;
-    static unsigned int instancecounter;
+    static std::atomic<unsigned int> instancecounter;
     bool oneCycleHasBeenExecuted;
 public:
     Simulation(SimItemHandling* itemhandling = nullptr, SimHCI *hci = nullptr, SimConfHandler *confhandler=nullptr, ISimInitCompleteObserver *ich = nullptr);
@@ -96,6 +104,37 @@ public:
      */
     void simulateTime(unsigned int duration) override; // simulate given time in ms
 
+    /**
+     * Sets the duration of one simulation cycle, default is
+     * SimulationBase::timeslice. Has to be set before the simulation runs.
+     * @param ms Timeslice in ms, must be > 0
+     */
+    void setTimeslice(unsigned int ms);
+    unsigned int getTimeslice() {
+        return timeslice;
+    };
+
+    /**
+     * Enables sub-stepping: while an item is close to a sensor, a timeslice
+     * is split into cycles of the given duration. Each sub-step completes a
+     * full cycle, so sensor edges and ADC samples carry the time of the
+     * sub-step instead of the end of the timeslice.
+     * @param ms Sub-step in ms, 0 or >= timeslice disables sub-stepping
+     */
+    void setSubstep(unsigned int ms);
+    unsigned int getSubstep() {
+        return substep;
+    };
+
+    /**
+     * Real time mode: the sub-steps of the last timeslice of a call of
+     * simulateTime() are spread over the real duration of the timeslice, so
+     * the application sees the sensor edges at the real distance. Timeslices
+     * which catch up a lack are executed at once.
+     * @param enable true if simulateTime() is called in real time
+     */
+    void setRealTime(bool enable);
+
     // I/O-Interfaces
     void writeOut(unsigned short value) override; // write to output 'register'
     unsigned short readOut() override; // read back from output 'register'
@@ -118,10 +157,19 @@ public:
     unsigned long currentSimTime() {
         return simTime;
     };
+
+    // all items in the system (belt and slide), only valid in the simulation thread
+    const vector<SimItem *>& getItems() {
+        return allitems;
+    };
+
+    // state of the current cycle as JSON (console output and debugging)
+    std::string generateJSONStatusReport();
 private:
     //void updateSimTime();
-    void doSimulationCycle(); // timer expired, so update all elements
-    std::string generateJSONStatusReport();
+    void doSimulationCycle(unsigned int duration); // timer expired, so update all elements
+    bool itemNearSensor();
+    void report();
 };
 
 #endif /* SIMULATION_H */
@@ -0,0 +1,49 @@
+/*
+ * UDPIOThread.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "UDPIOThread.h"
+#include <poll.h>
+
+UDPIOThread::UDPIOThread(int timeout) :
+        run(true), timeout(timeout) {
+}
+
+void UDPIOThread::addEndpoint(UDPIOEndpoint *endpoint) {
+    std::lock_guard<std::mutex> lock(endpointsMutex);
+    endpoints.push_back(endpoint);
+}
+
+void UDPIOThread::stop() {
+    run = false;
+}
+
+void UDPIOThread::operator()() {
+    std::vector<struct pollfd> fds;
+    std::vector<UDPIOEndpoint *> served;
+    while (run) {
+        {
+            std::lock_guard<std::mutex> lock(endpointsMutex);
+            if (served.size() != endpoints.size()) {
+                served = endpoints;
+                fds.resize(served.size());
+                for (unsigned int i = 0; i < served.size(); i++) {
+                    fds[i].fd = served[i]->getSocket();
+                    fds[i].events = POLLIN;
+                }
+            }
+        }
+        int ready = poll(fds.data(), fds.size(), timeout);
+        if (ready <= 0) {
+            continue;   // timeout or interrupted
+        }
+        wakeups++;
+        for (unsigned int i = 0; i < fds.size(); i++) {
+            if (fds[i].revents & POLLIN) {
+                served[i]->readable();
+            }
+        }
+    }
+}
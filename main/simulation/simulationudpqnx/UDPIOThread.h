@@ -0,0 +1,51 @@
+/*
+ * UDPIOThread.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef SRC_UDP_UDPIOTHREAD_H_
+#define SRC_UDP_UDPIOTHREAD_H_
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/**
+ * Socket served by the UDPIOThread.
+ */
+class UDPIOEndpoint {
+public:
+    virtual ~UDPIOEndpoint() {};
+    virtual int getSocket() = 0;
+    /**
+     * Called by the I/O thread if messages are waiting at the socket, must not
+     * block.
+     */
+    virtual void readable() = 0;
+};
+
+/**
+ * One thread waiting on all sockets of the simulation instead of one blocking
+ * receiver thread per socket. QNX has no epoll, poll() is used, which is
+ * equivalent for the few sockets of the simulation.
+ */
+class UDPIOThread {
+private:
+    std::vector<UDPIOEndpoint *> endpoints;
+    std::mutex endpointsMutex;
+    std::atomic<bool> run;
+    int timeout;
+public:
+    unsigned long wakeups = 0;
+    /**
+     * @param timeout Max. time in ms to react on stop() and new endpoints
+     */
+    UDPIOThread(int timeout = 100);
+    virtual ~UDPIOThread() {};
+    void addEndpoint(UDPIOEndpoint *endpoint);
+    void stop();
+    void operator()();
+};
+
+#endif /* SRC_UDP_UDPIOTHREAD_H_ */
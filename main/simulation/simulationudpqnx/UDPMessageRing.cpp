@@ -0,0 +1,121 @@
+/*
+ * UDPMessageRing.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "UDPMessageRing.h"
+#include <cstring>
+#include <poll.h>
+
+UDPReceiveRing::UDPReceiveRing() {
+    memset(sources, 0, sizeof(sources));
+    for (unsigned int i = 0; i < SIM_UDP_BATCH; i++) {
+        // one byte left for the zero-termination
+        vectors[i].iov_base = buffers[i];
+        vectors[i].iov_len = SIM_UDP_MESSAGE_SIZE - 1;
+        sizes[i] = 0;
+#ifdef SIM_UDP_MMSG_AVAILABLE
+        memset(&headers[i], 0, sizeof(headers[i]));
+        headers[i].msg_hdr.msg_iov = &vectors[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+        headers[i].msg_hdr.msg_name = &sources[i];
+#endif
+    }
+}
+
+unsigned int UDPReceiveRing::receive(int socket, bool wait) {
+    received = 0;
+#ifdef SIM_UDP_MMSG_AVAILABLE
+    int flags = MSG_DONTWAIT;
+    if (wait) {
+#ifdef MSG_WAITFORONE
+        flags = MSG_WAITFORONE;
+#else
+        struct pollfd readable = { socket, POLLIN, 0 };
+        poll(&readable, 1, -1);
+#endif
+    }
+    for (unsigned int i = 0; i < SIM_UDP_BATCH; i++) {
+        headers[i].msg_hdr.msg_namelen = sizeof(sources[i]);
+    }
+    int result = recvmmsg(socket, headers, SIM_UDP_BATCH, flags, nullptr);
+    calls++;
+    if (result > 0) {
+        received = (unsigned int) result;
+        for (unsigned int i = 0; i < received; i++) {
+            sizes[i] = headers[i].msg_len;
+        }
+    }
+#else
+    int flags = wait ? 0 : MSG_DONTWAIT;
+    while (received < SIM_UDP_BATCH) {
+        socklen_t sourcelen = sizeof(sources[received]);
+        ssize_t result = recvfrom(socket, buffers[received], SIM_UDP_MESSAGE_SIZE - 1, flags,
+                (struct sockaddr *) &sources[received], &sourcelen);
+        calls++;
+        if (result < 0) {
+            break;
+        }
+        sizes[received++] = (unsigned int) result;
+        flags = MSG_DONTWAIT;   // only the first one is waited for
+    }
+#endif
+    for (unsigned int i = 0; i < received; i++) {
+        buffers[i][sizes[i]] = 0;
+    }
+    messages += received;
+    return received;
+}
+
+UDPSendBatch::UDPSendBatch() {
+    memset(targets, 0, sizeof(targets));
+    memset(vectors, 0, sizeof(vectors));
+#ifdef SIM_UDP_MMSG_AVAILABLE
+    for (unsigned int i = 0; i < SIM_UDP_BATCH; i++) {
+        memset(&headers[i], 0, sizeof(headers[i]));
+        headers[i].msg_hdr.msg_iov = &vectors[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+        headers[i].msg_hdr.msg_name = &targets[i];
+        headers[i].msg_hdr.msg_namelen = sizeof(targets[i]);
+    }
+#endif
+}
+
+void UDPSendBatch::add(int socket, const void *data, size_t size, const struct sockaddr_in &target) {
+    if (pending == SIM_UDP_BATCH) {
+        flush(socket);
+    }
+    targets[pending] = target;
+    vectors[pending].iov_base = const_cast<void *>(data);
+    vectors[pending].iov_len = size;
+    pending++;
+}
+
+unsigned int UDPSendBatch::flush(int socket) {
+    unsigned long before = messages;
+    unsigned int sent = 0;
+#ifdef SIM_UDP_MMSG_AVAILABLE
+    while (sent < pending) {
+        int result = sendmmsg(socket, headers + sent, pending - sent, 0);
+        calls++;
+        if (result <= 0) {
+            sent++;   // message is lost as with sendto(), go on with the next one
+        } else {
+            sent += result;
+            messages += result;
+        }
+    }
+#else
+    for (; sent < pending; sent++) {
+        ssize_t result = sendto(socket, vectors[sent].iov_base, vectors[sent].iov_len, 0,
+                (struct sockaddr *) &targets[sent], sizeof(targets[sent]));
+        calls++;
+        if (result >= 0) {
+            messages++;
+        }
+    }
+#endif
+    pending = 0;
+    return (unsigned int) (messages - before);
+}
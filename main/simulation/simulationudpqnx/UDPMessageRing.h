@@ -0,0 +1,104 @@
+/*
+ * UDPMessageRing.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef SRC_UDP_UDPMESSAGERING_H_
+#define SRC_UDP_UDPMESSAGERING_H_
+
+extern "C" {
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+}
+#include <cstddef>
+
+// Number of messages received or sent with one system call
+#ifndef SIM_UDP_BATCH
+#define SIM_UDP_BATCH 16
+#endif
+
+// Max. size of a received message, the largest message of the twin link
+// fits into one ethernet frame
+#define SIM_UDP_MESSAGE_SIZE 1500
+
+// recvmmsg()/sendmmsg() are available with QNX 7 and Linux. With
+// SIM_UDP_NO_MMSG the batches are transferred message by message.
+#ifndef SIM_UDP_NO_MMSG
+#define SIM_UDP_MMSG_AVAILABLE
+#endif
+
+/**
+ * Preallocated receive buffers for a batch of messages. All messages waiting
+ * at the socket (up to SIM_UDP_BATCH) are fetched with one recvmmsg().
+ */
+class UDPReceiveRing {
+private:
+    char buffers[SIM_UDP_BATCH][SIM_UDP_MESSAGE_SIZE];
+    struct sockaddr_in sources[SIM_UDP_BATCH];
+    struct iovec vectors[SIM_UDP_BATCH];
+#ifdef SIM_UDP_MMSG_AVAILABLE
+    struct mmsghdr headers[SIM_UDP_BATCH];
+#endif
+    unsigned int sizes[SIM_UDP_BATCH];
+    unsigned int received = 0;
+public:
+    unsigned long calls = 0;     // system calls
+    unsigned long messages = 0;  // messages received
+    UDPReceiveRing();
+    /**
+     * Receives the messages waiting at the socket.
+     * @param wait Blocks until at least one message is available
+     * @return Number of received messages, 0 on error or nothing available
+     */
+    unsigned int receive(int socket, bool wait);
+    unsigned int size() const {
+        return received;
+    }
+    /**
+     * @return Message i of the last receive(), zero-terminated
+     */
+    char *message(unsigned int i) {
+        return buffers[i];
+    }
+    unsigned int length(unsigned int i) const {
+        return sizes[i];
+    }
+    const struct sockaddr_in &source(unsigned int i) const {
+        return sources[i];
+    }
+};
+
+/**
+ * Batch of messages to send with one sendmmsg(). The messages are not copied,
+ * they have to stay valid until flush().
+ */
+class UDPSendBatch {
+private:
+    struct sockaddr_in targets[SIM_UDP_BATCH];
+    struct iovec vectors[SIM_UDP_BATCH];
+#ifdef SIM_UDP_MMSG_AVAILABLE
+    struct mmsghdr headers[SIM_UDP_BATCH];
+#endif
+    unsigned int pending = 0;
+public:
+    unsigned long calls = 0;     // system calls
+    unsigned long messages = 0;  // messages sent
+    UDPSendBatch();
+    /**
+     * Adds a message to the batch. A full batch is sent before.
+     */
+    void add(int socket, const void *data, size_t size, const struct sockaddr_in &target);
+    /**
+     * Sends all pending messages.
+     * @return Number of messages sent
+     */
+    unsigned int flush(int socket);
+    unsigned int size() const {
+        return pending;
+    }
+};
+
+#endif /* SRC_UDP_UDPMESSAGERING_H_ */
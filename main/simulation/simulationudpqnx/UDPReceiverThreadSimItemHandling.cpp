@@ -10,6 +10,8 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <arpa/inet.h>
+#include <unistd.h>
+#include <cstring>
 #include <iostream>
 
 using namespace std;
@@ -29,7 +31,7 @@ void UDPReceiverThreadSimItemHandling::operator()() {
     receive();
 }
 
-void UDPReceiverThreadSimItemHandling::receive() {
+int UDPReceiverThreadSimItemHandling::open() {
     receiverSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
 
     struct sockaddr_in local_address;
@@ -44,38 +46,48 @@ void UDPReceiverThreadSimItemHandling::receive() {
             local_address_len);
     if (rc < 0) {
         cout << "<SIM> Error, socket binding error: " << errno << endl;
-    } else {
-        char buffer[1500];
-        uint16_t value = 0;
-        SimItemHandlingAction action;
-
-        while (run) {
-            buffer[0]=0;
-            int recv_len = recvfrom(receiverSocket, buffer, sizeof(buffer), 0,
-                    (struct sockaddr *) &local_address, &local_address_len);
-            buffer[recv_len] = 0; // force zero-termination.
+        close(receiverSocket);
+        receiverSocket = 0;
+        return -1;
+    }
+    return receiverSocket;
+}
 
-            value = 0;
-            if(SIMCONFQUERRY_ISACTIVE(showactions)){
-            	cout << "<Sim> recv action:" << buffer << endl;
-            }
-            if(!initialMessageReceived){
-                initialMessageReceived = true;
+int UDPReceiverThreadSimItemHandling::getSocket() {
+    return receiverSocket;
+}
 
-            }
-            // handover to message handling
-            if(msghandler!=nullptr){
-                msghandler->dispatchMessage(std::string(buffer));
-            }
+void UDPReceiverThreadSimItemHandling::readable() {
+    if (ring.receive(receiverSocket, false) > 0) {
+        dispatchReceived();
+    }
+}
 
-            if (value == 0xFFFF) {
-                run = false;
+void UDPReceiverThreadSimItemHandling::receive() {
+    if (open() >= 0) {
+        while (run) {
+            // all waiting messages with one call
+            if (ring.receive(receiverSocket, true) > 0) {
+                dispatchReceived();
             }
         }
+        close(receiverSocket);
+        receiverSocket = 0;
     }
-    close(receiverSocket);
-    receiverSocket = 0;
 }
 
-
-
+void UDPReceiverThreadSimItemHandling::dispatchReceived() {
+    for (unsigned int i = 0; i < ring.size(); i++) {
+        char *buffer = ring.message(i);
+        if (SIMCONFQUERRY_ISACTIVE(showactions)) {
+            cout << "<Sim> recv action:" << buffer << endl;
+        }
+        if (!initialMessageReceived) {
+            initialMessageReceived = true;
+        }
+        // handover to message handling
+        if (msghandler != nullptr) {
+            msghandler->dispatchMessage(buffer, ring.length(i));
+        }
+    }
+}
@@ -10,9 +10,15 @@
 
 
 #include "UDPConfiguration.h"
+#include "UDPIOThread.h"
+#include "UDPMessageRing.h"
 #include "../simulationcore/simjsonmessagehandler.h"
 
-class UDPReceiverThreadSimItemHandling {
+/**
+ * Receives the messages of the partner system. Runs as own thread (operator())
+ * or is served by an UDPIOThread after open().
+ */
+class UDPReceiverThreadSimItemHandling : public UDPIOEndpoint {
 private:
     UDPConfiguration &conf;
 private:
@@ -20,13 +26,22 @@ private:
     bool run;
     bool initialMessageReceived;
     SimJSONMessageHandler *msghandler;
+    UDPReceiveRing ring;
 public:
     UDPReceiverThreadSimItemHandling(UDPConfiguration &conf, SimJSONMessageHandler *msghandler=nullptr);
     virtual ~UDPReceiverThreadSimItemHandling();
 
     void operator()();
+    /**
+     * Creates and binds the socket.
+     * @return Socket, negative on error
+     */
+    int open();
+    int getSocket() override;
+    void readable() override;
 private:
     void receive();
+    void dispatchReceived();
 };
 
 
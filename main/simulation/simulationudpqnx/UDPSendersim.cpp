@@ -10,6 +10,8 @@
 #include "simconfquery.h"
 #include "UDPSendersim.h"
 #include <iostream>
+#include <cstring>
+#include <unistd.h>
 
 using namespace std;
 
@@ -20,6 +22,7 @@ UDPSenderSim::UDPSenderSim(UDPConfiguration &simudpconf) :
 }
 
 UDPSenderSim::~UDPSenderSim() {
+    flush();
     close(senderSocket);
 }
 int UDPSenderSim::init() {
@@ -35,32 +38,47 @@ int UDPSenderSim::init() {
     return senderSocket;
 }
 
-void UDPSenderSim::dropEnd(shared_ptr<SimItem> dropeditem) {
+void UDPSenderSim::dropEnd(SimItem *dropeditem) {
     if (senderSocket >= 0) {
     	dropeditem->evalFlip();
         SimItemHandlingAction action(0, dropeditem->kind);
         action.x = 0.0;
         action.y = dropeditem->y;
-        string message = action.toJSONString();
-        if(SIMCONFQUERRY_ISACTIVE(showactions)){
-        	std::cout << "<Sim> send action:" << message << std::endl;
-        }
-        int target_address_len = sizeof(struct sockaddr_in);
-
-        sendto(senderSocket, message.c_str(), message.size(), 0,
-                (struct sockaddr *) &fullTargetAddress, target_address_len);
+        send(action.toJSONString(), false);
     }
 }
 void UDPSenderSim::initCompleted(){
     if (senderSocket >= 0) {
         SimCtrlAction action("start");
-        string message = action.toJSONString();
-        if(SIMCONFQUERRY_ISACTIVE(showactions)){
-        	std::cout << "<Sim> send action:" << message << std::endl;
-        }
-        int target_address_len = sizeof(struct sockaddr_in);
+        // the twin waits for it, the cycles may not run before it is released
+        send(action.toJSONString(), true);
+    }
+}
+
+void UDPSenderSim::cycleCompletedWith(unsigned long simulationtime, const SimulationIOImage &result, unsigned short ADCRaw) {
+    flush();
+}
+
+void UDPSenderSim::send(const string &message, bool now) {
+    if(SIMCONFQUERRY_ISACTIVE(showactions)){
+    	std::cout << "<Sim> send action:" << message << std::endl;
+    }
+    std::lock_guard<std::mutex> lk(batchmutex);
+    if (batch.size() == 0) {
+        pending.clear();   // sent with the last batch (a full batch is sent by add())
+    }
+    pending.push_back(message);
+    batch.add(senderSocket, pending.back().c_str(), pending.back().size(), fullTargetAddress);
+    if (now) {
+        batch.flush(senderSocket);
+        pending.clear();
+    }
+}
 
-        sendto(senderSocket, message.c_str(), message.size(), 0,
-                (struct sockaddr *) &fullTargetAddress, target_address_len);
+void UDPSenderSim::flush() {
+    std::lock_guard<std::mutex> lk(batchmutex);
+    if (batch.size() > 0) {
+        batch.flush(senderSocket);
     }
+    pending.clear();
 }
@@ -10,20 +10,34 @@
 
 #include "isimdrophandler.h"
 #include "isiminitcompleteobserver.h"
+#include "isimulationcycleendhandler.h"
 #include "UDPConfiguration.h"
+#include "UDPMessageRing.h"
+#include <deque>
 #include <memory>
+#include <mutex>
 
-class UDPSenderSim: public ISimDropHandler, public ISimInitCompleteObserver {
+/**
+ * Sends the dropped items to the twin. The items dropped in one cycle are
+ * sent with one call at the end of the cycle.
+ */
+class UDPSenderSim: public ISimDropHandler, public ISimInitCompleteObserver, public ISimulationCycleEndHandler {
 private:
     UDPConfiguration &conf;
     int senderSocket = 0;
     struct sockaddr_in fullTargetAddress;
+    std::mutex batchmutex;
+    UDPSendBatch batch;
+    deque<string> pending;   // messages of the batch, must stay valid until flushed
+    void send(const string &message, bool now);
+    void flush();
 public:
     UDPSenderSim(UDPConfiguration &conf);
     virtual ~UDPSenderSim();
     int init();
-    void dropEnd(shared_ptr<SimItem> dropeditem) override;
+    void dropEnd(SimItem *dropeditem) override;
     void initCompleted() override;
+    void cycleCompletedWith(unsigned long simulationtime, const SimulationIOImage &result, unsigned short ADCRaw) override;
 };
 
 #endif /* SRC_SIMULATIONCORE_SIMDROPHANDLER_H_ */
@@ -6,6 +6,8 @@
  */
 
 #include <iostream>
+#include <cstring>
+#include <unistd.h>
 
 #include "UDPSendersimreport.h"
 
@@ -33,25 +35,21 @@ int UDPSenderSimReport::init() {
     return senderSocket;
 }
 
-void UDPSenderSimReport::handlereport(std::string report) {
+void UDPSenderSimReport::handlereport(const uint8_t *report, unsigned int size) {
     if (senderSocket >= 0) {
-        int target_address_len = sizeof (struct sockaddr_in);
-        
         // Send to first target
         fullTargetAddress.sin_addr = conf.getReportHostIP();
         fullTargetAddress.sin_port = conf.getReportHostPort();
+        batch.add(senderSocket, report, size, fullTargetAddress);
 
-        sendto(senderSocket, report.c_str(), report.size(), 0,
-                (struct sockaddr *) &fullTargetAddress, target_address_len);
-        
         // Send to additional targets
         for (unsigned int i = 1; i < conf.getNumberReportHosts(); i++) {
             fullTargetAddress.sin_addr = conf.getNextReportHostIP();
             fullTargetAddress.sin_port = conf.getNextReportHostPort();
-
-            sendto(senderSocket, report.c_str(), report.size(), 0,
-                    (struct sockaddr *) &fullTargetAddress, target_address_len);
-
+            batch.add(senderSocket, report, size, fullTargetAddress);
         }
+
+        // one call for all targets, the report is only valid during this call
+        batch.flush(senderSocket);
     }
 }
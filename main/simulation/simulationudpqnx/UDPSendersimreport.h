@@ -10,17 +10,19 @@
 
 #include "isimulationreporthandler.h"
 #include "UDPConfigFileReader.h"
+#include "UDPMessageRing.h"
 
 class UDPSenderSimReport: public ISimulationReportHandler {
 private:
     UDPConfigFileReader &conf;
     int senderSocket = 0;
     struct sockaddr_in fullTargetAddress;
+    UDPSendBatch batch;
 public:
     UDPSenderSimReport(UDPConfigFileReader &conf);
     virtual ~UDPSenderSimReport();
     int init();
-    void handlereport(const std::string jsonreport) override;
+    void handlereport(const uint8_t *report, unsigned int size) override;
 };
 
 #endif
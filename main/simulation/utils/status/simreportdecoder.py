@@ -0,0 +1,139 @@
+#! python3
+"""Python > 3.4
+Decoder for the binary status report of the simulation (see
+simulationcore/simreport.h). The decoder mirrors the items of the simulation
+and returns the state in the format of the former JSON report.
+
+Started as script, it prints the reports as JSON lines, received by UDP or
+read from a file written by the simulation (SIM_REPORT_FILE).
+"""
+import argparse
+import json
+import socket
+import struct
+import sys
+
+REPORT_MAGIC = b'SR'
+REPORT_VERSION = 1
+FLAG_KEYFRAME = 0x01
+FLAG_TRUNCATED = 0x02
+ITEM_FULL = 0x01
+ITEM_MOVED = 0x02
+ITEM_REMOVED = 0x03
+
+HEADER = struct.Struct('<2sBBccHIHHHH')
+FULL = struct.Struct('<IBhh')
+MOVED = struct.Struct('<Ibb')
+REMOVED = struct.Struct('<I')
+
+# same order as ItemKinds in simitemstore.h
+ITEM_KINDS = ['f', 'HU', 'HD', 'MU', 'MD', 'cA', 'cB', 'cC', 'cD', 'cE', 'cF', 'cG', 'cH', 'l1', 'l2', 'l3']
+
+
+def is_binary_report(data):
+    """ True if the data is a binary report, False for JSON. """
+    return data[0:2] == REPORT_MAGIC
+
+
+class SimReportDecoder():
+    """
+    Rebuilds the state of the simulation from the binary reports. Reports
+    following a lost report are dropped until the next keyframe.
+    """
+    def __init__(self):
+        self.items = {}     # ID -> [kind, x, y], x and y in 1/10 mm
+        self.sequence = 0
+        self.synchronized = False
+
+    def decode(self, data):
+        """
+        Applies the report to the mirrored state.
+
+        return: Dictionary like the JSON report, None if the state is not valid.
+        """
+        if len(data) < HEADER.size:
+            return None
+        magic, version, flags, system_id, conf, sequence, sim_time, actors, sensors, analog, records = HEADER.unpack_from(data)
+        if magic != REPORT_MAGIC or version != REPORT_VERSION:
+            return None
+        keyframe = (flags & FLAG_KEYFRAME) != 0
+        in_sequence = self.synchronized and sequence == (self.sequence + 1) & 0xFFFF
+        self.sequence = sequence
+        if not keyframe and not in_sequence:
+            self.synchronized = False
+            return None
+        if keyframe:
+            self.items = {}
+        self.synchronized = True
+
+        pos = HEADER.size
+        try:
+            for _ in range(records):
+                tag = data[pos]
+                pos += 1
+                if tag == ITEM_FULL:
+                    item_id, kind, x, y = FULL.unpack_from(data, pos)
+                    self.items[item_id] = [kind, x, y]
+                    pos += FULL.size
+                elif tag == ITEM_MOVED:
+                    item_id, dx, dy = MOVED.unpack_from(data, pos)
+                    self.items[item_id][1] += dx
+                    self.items[item_id][2] += dy
+                    pos += MOVED.size
+                elif tag == ITEM_REMOVED:
+                    item_id, = REMOVED.unpack_from(data, pos)
+                    self.items.pop(item_id, None)
+                    pos += REMOVED.size
+                else:
+                    raise ValueError("unknown record " + str(tag))
+        except (IndexError, KeyError, ValueError, struct.error):
+            self.synchronized = False
+            return None
+        if flags & FLAG_TRUNCATED:
+            self.synchronized = False
+
+        items = []
+        for item_id in sorted(self.items.keys()):
+            kind, x, y = self.items[item_id]
+            items.append({"ID": item_id, "T": ITEM_KINDS[kind] if kind < len(ITEM_KINDS) else "",
+                          "x": x / 10.0, "y": y / 10.0})
+        return {"id": system_id.decode(), "C": conf.decode(), "T": sim_time,
+                "actors": actors, "sensors": sensors, "analog": analog, "items": items}
+
+
+def read_report_file(filename):
+    """ Generator for the reports of a file written by SIM_REPORT_FILE. """
+    with open(filename, "rb") as file:
+        while True:
+            length = file.read(2)
+            if len(length) < 2:
+                break
+            data = file.read(struct.unpack('<H', length)[0])
+            yield data
+
+
+def receive_reports(ip, port):
+    """ Generator for the reports received by UDP. """
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind((ip, port))
+    while True:
+        data, addr = sock.recvfrom(65535)
+        yield data
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Converts binary simulation reports to JSON lines')
+    parser.add_argument('file', nargs='?', help='report file written by the simulation')
+    parser.add_argument('-ip', default='0.0.0.0', help='local IP address to receive reports on')
+    parser.add_argument('-p', type=int, default=41010, help='port to receive reports on')
+    args = parser.parse_args()
+
+    decoder = SimReportDecoder()
+    reports = read_report_file(args.file) if args.file else receive_reports(args.ip, args.p)
+    try:
+        for report in reports:
+            state = decoder.decode(report)
+            if state is not None:
+                print(json.dumps(state), flush=True)
+    except KeyboardInterrupt:
+        sys.exit(0)
@@ -12,6 +12,7 @@ import threading
 import logging
 import json
 import time
+import simreportdecoder
 
 class StatusReceiverUDP(threading.Thread):
     """
@@ -25,6 +26,7 @@ class StatusReceiverUDP(threading.Thread):
         self.running = True
         self.logger = logger
         self.msg_rec_handler = None
+        self.decoder = simreportdecoder.SimReportDecoder()
         self.set_msg_reception_handler(msg_reception_handler)
         #self.start()   # maybe that is critical...
     def set_msg_reception_handler(self, handler):
@@ -43,9 +45,13 @@ class StatusReceiverUDP(threading.Thread):
         self.socket.bind((self.listening_IP, self.listening_port))
         print(f"UDP listening on {self.listening_IP} : {self.listening_port}", flush=True)
         while self.running:
-            data, addr = self.socket.recvfrom(1024) # buffer size is 1024 bytes
+            data, addr = self.socket.recvfrom(65535) # max. UDP datagram
             #print(addr, data)
-            if data != b'':
+            if simreportdecoder.is_binary_report(data):
+                datastruct = self.decoder.decode(data)
+                if datastruct is not None and self.msg_rec_handler != None:
+                    self.msg_rec_handler.handle_status_msg(datastruct)
+            elif data != b'':
                 datastring = data.decode('utf-8')
                 if datastring != u"" and datastring != "\n":
                         datastruct = json.loads(datastring)
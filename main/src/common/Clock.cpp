@@ -0,0 +1,129 @@
+/*
+ * Clock.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "Clock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
+
+using namespace std::chrono;
+
+static Clock &systemClock() {
+    static Clock clock;
+    return clock;
+}
+
+static std::atomic<Clock *> &currentClock() {
+    static std::atomic<Clock *> current{&systemClock()};
+    return current;
+}
+
+namespace {
+
+struct ChangeHandlers {
+    std::mutex mtx;
+    int nextId = 1;
+    std::map<int, Clock::ChangeHandler> handlers;
+};
+
+ChangeHandlers &changeHandlers() {
+    static ChangeHandlers handlers;
+    return handlers;
+}
+
+}
+
+Clock &Clock::getInstance() { return *currentClock(); }
+
+void Clock::setInstance(Clock *clock) {
+    ChangeHandlers &registry = changeHandlers();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    currentClock() = clock != nullptr ? clock : &systemClock();
+    for (auto &handler : registry.handlers) {
+        handler.second();
+    }
+}
+
+int Clock::addChangeHandler(ChangeHandler handler) {
+    ChangeHandlers &registry = changeHandlers();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    int id = registry.nextId++;
+    registry.handlers[id] = handler;
+    return id;
+}
+
+void Clock::removeChangeHandler(int id) {
+    ChangeHandlers &registry = changeHandlers();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    registry.handlers.erase(id);
+}
+
+Clock::time_point Clock::now() { return steady_clock::now(); }
+
+void Clock::sleepFor(int ms) { std::this_thread::sleep_for(milliseconds(ms)); }
+
+void Clock::waitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &cv,
+                      time_point deadline) {
+    cv.wait_until(lock, deadline);
+}
+
+int64_t Clock::millisSince(time_point start) {
+    return duration_cast<milliseconds>(now() - start).count();
+}
+
+VirtualClock::VirtualClock() : start(steady_clock::now()), elapsedMs(0) {}
+
+Clock::time_point VirtualClock::now() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return start + milliseconds(elapsedMs);
+}
+
+void VirtualClock::sleepFor(int ms) {
+    std::unique_lock<std::mutex> lock(mtx);
+    uint64_t wakeup = elapsedMs + std::max(ms, 0);
+    cvAdvanced.wait(lock, [this, wakeup] { return elapsedMs >= wakeup; });
+}
+
+void VirtualClock::waitUntil(std::unique_lock<std::mutex> &lock,
+                             std::condition_variable &cv, time_point deadline) {
+    // The caller holds 'lock' until it waits, advance() has to acquire it
+    // before notifying -> no wakeup is lost
+    {
+        std::lock_guard<std::mutex> guard(mtx);
+        if (start + milliseconds(elapsedMs) >= deadline) {
+            return;
+        }
+        waiters.push_back(Waiter{lock.mutex(), &cv});
+    }
+    cv.wait(lock);
+    std::lock_guard<std::mutex> guard(mtx);
+    auto it = std::find_if(waiters.begin(), waiters.end(),
+                           [&cv](const Waiter &w) { return w.cv == &cv; });
+    if (it != waiters.end()) {
+        waiters.erase(it);
+    }
+}
+
+void VirtualClock::advance(int ms) {
+    std::vector<Waiter> toNotify;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        elapsedMs += std::max(ms, 0);
+        toNotify = waiters;
+    }
+    cvAdvanced.notify_all();
+    for (Waiter &w : toNotify) {
+        std::lock_guard<std::mutex> lock(*w.mtx);
+        w.cv->notify_all();
+    }
+}
+
+uint64_t VirtualClock::getElapsedMs() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return elapsedMs;
+}
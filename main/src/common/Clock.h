@@ -0,0 +1,106 @@
+/*
+ * Clock.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * Source of time for all timers and sleeps of the application (TimerService,
+ * Watchdog, handover timing). By default it is the steady system clock, a
+ * headless simulation replaces it with a VirtualClock to run faster than real
+ * time.
+ */
+class Clock {
+  public:
+    using time_point = std::chrono::steady_clock::time_point;
+    using ChangeHandler = std::function<void()>;
+
+    /**
+     * @return Clock injected with setInstance(), the system clock otherwise
+     */
+    static Clock &getInstance();
+
+    /**
+     * Replaces the clock of the application. Must be called before any
+     * component is started (e.g. during static initialization of the
+     * simulation).
+     *
+     * @param clock New clock, nullptr to restore the system clock
+     */
+    static void setInstance(Clock *clock);
+
+    /**
+     * Registers a handler called by setInstance() after the clock has been
+     * replaced, for components which keep waiting on the clock (TimerService).
+     * The old clock must still be valid while the handlers are called.
+     *
+     * @return ID to remove the handler
+     */
+    static int addChangeHandler(ChangeHandler handler);
+    static void removeChangeHandler(int id);
+
+    virtual ~Clock() {}
+
+    virtual time_point now();
+
+    /**
+     * Blocks the calling thread for the given time.
+     */
+    virtual void sleepFor(int ms);
+
+    /**
+     * Waits on the condition variable until it is notified or the clock
+     * reached the deadline (like cv.wait_until()).
+     */
+    virtual void waitUntil(std::unique_lock<std::mutex> &lock,
+                           std::condition_variable &cv, time_point deadline);
+
+    /**
+     * @return Milliseconds elapsed since the given time point
+     */
+    int64_t millisSince(time_point start);
+};
+
+/**
+ * Clock which only advances when advance() is called. Waiting threads are woken
+ * up as soon as their deadline has been reached.
+ */
+class VirtualClock : public Clock {
+  public:
+    VirtualClock();
+
+    time_point now() override;
+    void sleepFor(int ms) override;
+    void waitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &cv,
+                   time_point deadline) override;
+
+    /**
+     * Advances the virtual time and wakes up all waiting threads.
+     */
+    void advance(int ms);
+
+    /**
+     * @return Virtual milliseconds since construction
+     */
+    uint64_t getElapsedMs();
+
+  private:
+    struct Waiter {
+        std::mutex *mtx;
+        std::condition_variable *cv;
+    };
+
+    time_point start;
+    uint64_t elapsedMs;
+    std::mutex mtx;
+    std::condition_variable cvAdvanced;
+    std::vector<Waiter> waiters;
+};
@@ -0,0 +1,110 @@
+/*
+ * Quiescence.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Work in progress of the application, used by the headless simulation as a
+ * quiescence barrier: the virtual clock is only advanced after the
+ * application has handled everything of the last cycle, so the belt never
+ * runs ahead of the control logic.
+ *
+ * Work is counted from its creation until it is handled, e.g. an event from
+ * EventSender::sendEvent() until the EventManager has dispatched it, or an
+ * interrupt pulse from the (simulated) interrupt controller until the driver
+ * thread has handled it. Handling may create new work, it has to be counted
+ * before the work is finished. Work that is not counted (e.g. timers which
+ * are due) is checked by probes.
+ *
+ * Counting is off unless enabled (headless simulation).
+ */
+class Quiescence {
+  public:
+    // @return true if the component is idle
+    using Probe = std::function<bool()>;
+
+    static Quiescence &getInstance() {
+        static Quiescence instance;
+        return instance;
+    }
+
+    Quiescence() {}
+
+    /**
+     * Must be called before any work is counted (static initialization of
+     * the simulation).
+     */
+    void setEnabled(bool enable) { enabled = enable; }
+    bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    void begin() {
+        if (isEnabled()) {
+            pending++;
+        }
+    }
+
+    void end() {
+        if (isEnabled()) {
+            pending--;
+        }
+    }
+
+    /**
+     * Both systems run in this process (line benchmark): events sent to the
+     * partner are counted until the partner has dispatched them.
+     */
+    void setLinkCounted(bool counted) { linkCounted = counted; }
+    bool isLinkCounted() { return isEnabled() && linkCounted.load(std::memory_order_relaxed); }
+
+    int getPending() { return pending; }
+
+    void addProbe(Probe probe) {
+        std::lock_guard<std::mutex> lock(mtx);
+        probes.push_back(probe);
+    }
+
+    /**
+     * Blocks until no work is pending and all probes report idle. Probes are
+     * checked before and after the counter: work which was created by the
+     * handled work (e.g. a timer which is due immediately) is found as well.
+     *
+     * @param timeoutMs Maximum time to wait (wall clock)
+     * @return false if the application was still busy after the timeout
+     */
+    bool waitIdle(int timeoutMs) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (!(probesIdle() && pending <= 0 && probesIdle())) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        }
+        return true;
+    }
+
+  private:
+    bool probesIdle() {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (const Probe &probe : probes) {
+            if (!probe()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::atomic<bool> enabled{false};
+    std::atomic<bool> linkCounted{false};
+    std::atomic<int> pending{0};
+    std::mutex mtx;
+    std::vector<Probe> probes;
+};
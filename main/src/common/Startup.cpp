@@ -0,0 +1,65 @@
+/*
+ * Startup.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "Startup.h"
+#include "logger/logger.hpp"
+#include "metrics/Metrics.h"
+
+using namespace std::chrono;
+
+Startup &Startup::getInstance() {
+    static Startup instance;
+    return instance;
+}
+
+Startup::Startup() : begun(steady_clock::now()) {}
+
+void Startup::begin() {
+    std::lock_guard<std::mutex> lock(mtx);
+    begun = steady_clock::now();
+    readyMs.clear();
+}
+
+void Startup::ready(const std::string &component) {
+    int64_t ms;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (readyMs.count(component) > 0) {
+            return;
+        }
+        ms = duration_cast<milliseconds>(steady_clock::now() - begun).count();
+        readyMs[component] = ms;
+    }
+    cv.notify_all();
+    MetricsRegistry::getInstance()
+        .gauge("esep_startup_ready_ms{component=\"" + component + "\"}")
+        .set(ms);
+    Logger::debug("[Startup] " + component + " ready after " + std::to_string(ms) + " ms");
+}
+
+bool Startup::isReady(const std::string &component) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return readyMs.count(component) > 0;
+}
+
+bool Startup::waitFor(const std::string &component, int timeoutMs) {
+    std::unique_lock<std::mutex> lock(mtx);
+    auto isReady = [&]() { return readyMs.count(component) > 0; };
+    if (timeoutMs < 0) {
+        cv.wait(lock, isReady);
+        return true;
+    }
+    return cv.wait_for(lock, milliseconds(timeoutMs), isReady);
+}
+
+int64_t Startup::elapsedMs() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return duration_cast<milliseconds>(steady_clock::now() - begun).count();
+}
+
+std::map<std::string, int64_t> Startup::readyTimes() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return readyMs;
+}
@@ -0,0 +1,60 @@
+/*
+ * Startup.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+ * Readiness of the components during startup. A component reports ready()
+ * as soon as it can handle events (e.g. the EventManager when it is
+ * connected to the partner system), main waits for the components it depends
+ * on instead of fixed sleeps.
+ *
+ * The time from begin() to the first ready() of each component is exported
+ * as esep_startup_ready_ms{component="<name>"}.
+ */
+class Startup {
+  public:
+    static Startup &getInstance();
+
+    /**
+     * Starts the time measurement and forgets all ready components (start of
+     * main)
+     */
+    void begin();
+
+    void ready(const std::string &component);
+    bool isReady(const std::string &component);
+
+    /**
+     * @param timeoutMs -1: no timeout
+     * @return false if the component was not ready within the timeout
+     */
+    bool waitFor(const std::string &component, int timeoutMs = -1);
+
+    /**
+     * @return ms since begin()
+     */
+    int64_t elapsedMs();
+
+    /**
+     * @return component -> ms from begin() to ready()
+     */
+    std::map<std::string, int64_t> readyTimes();
+
+  private:
+    Startup();
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::chrono::steady_clock::time_point begun;
+    std::map<std::string, int64_t> readyMs;
+};
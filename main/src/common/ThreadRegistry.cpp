@@ -0,0 +1,213 @@
+/*
+ * ThreadRegistry.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "ThreadRegistry.h"
+#include "logger/logger.hpp"
+#include "metrics/Metrics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#ifdef __QNXNTO__
+#include <sys/neutrino.h>
+#endif
+
+namespace {
+
+// Highest priorities for the threads reacting to the hardware, then event
+// distribution and timers. Logging, simulation and diagnosis stay at OTHER.
+const std::map<std::string, ThreadPolicy> DEFAULT_POLICIES = {
+    {"sensors", {SchedPolicy::FIFO, 40, -1}},        // GPIO interrupts
+    {"adc", {SchedPolicy::FIFO, 38, -1}},            // HeightSensor samples
+    {"evm-internal", {SchedPolicy::FIFO, 35, -1}},   // pulses of the components
+    {"evm-dispatch", {SchedPolicy::FIFO, 34, -1}},
+    {"evm-external", {SchedPolicy::FIFO, 33, -1}},   // events of the partner
+    {"timers", {SchedPolicy::FIFO, 32, -1}},         // watchdog deadlines, blinking
+    {"wd-send", {SchedPolicy::FIFO, 30, -1}},        // heartbeats
+    {"config-watch", {SchedPolicy::OTHER, 0, -1}},
+    {"metrics", {SchedPolicy::OTHER, 0, -1}},
+};
+
+const char *policyName(SchedPolicy policy) {
+    switch (policy) {
+    case SchedPolicy::FIFO:
+        return "fifo";
+    case SchedPolicy::RR:
+        return "rr";
+    default:
+        return "other";
+    }
+}
+
+void setName(const std::string &name) {
+    // Linux limits thread names to 15 characters
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+}
+
+bool setAffinity(int cpu) {
+#ifdef __QNXNTO__
+    return ThreadCtl(_NTO_TCTL_RUNMASK, (void *) (uintptr_t) (1u << cpu)) != -1;
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#endif
+}
+
+}
+
+std::string ThreadPolicy::toString() const {
+    std::stringstream ss;
+    ss << policyName(policy) << ':' << priority;
+    if (cpu >= 0) {
+        ss << ':' << cpu;
+    }
+    return ss.str();
+}
+
+bool ThreadPolicy::parse(const std::string &text, ThreadPolicy &policy) {
+    std::istringstream in(text);
+    std::string name, priority, cpu;
+    if (!std::getline(in, name, ':') || !std::getline(in, priority, ':')) {
+        return false;
+    }
+    std::getline(in, cpu);
+    ThreadPolicy parsed{SchedPolicy::OTHER, 0, -1};
+    if (name == "fifo") {
+        parsed.policy = SchedPolicy::FIFO;
+    } else if (name == "rr") {
+        parsed.policy = SchedPolicy::RR;
+    } else if (name != "other") {
+        return false;
+    }
+    try {
+        size_t end;
+        parsed.priority = std::stoi(priority, &end);
+        if (end != priority.size()) {
+            return false;
+        }
+        if (!cpu.empty()) {
+            parsed.cpu = std::stoi(cpu, &end);
+            if (end != cpu.size()) {
+                return false;
+            }
+        }
+    } catch (const std::exception &e) {
+        return false;
+    }
+    if (parsed.priority < 0 || parsed.cpu < -1 || parsed.cpu >= 32
+        || (parsed.policy != SchedPolicy::OTHER && parsed.priority == 0)) {
+        return false;
+    }
+    policy = parsed;
+    return true;
+}
+
+ThreadRegistry &ThreadRegistry::getInstance() {
+    // Never destroyed: threads of static objects (e.g. the ConfigWatcher of
+    // main) unregister during static destruction
+    static ThreadRegistry *instance = new ThreadRegistry();
+    return *instance;
+}
+
+ThreadRegistry::ThreadRegistry() : policies(DEFAULT_POLICIES) {}
+
+void ThreadRegistry::setEnabled(bool enable) {
+    std::lock_guard<std::mutex> lock(mtx);
+    enabled = enable;
+}
+
+bool ThreadRegistry::isEnabled() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return enabled;
+}
+
+void ThreadRegistry::setPolicy(const std::string &name, ThreadPolicy policy) {
+    std::lock_guard<std::mutex> lock(mtx);
+    policies[name] = policy;
+}
+
+ThreadPolicy ThreadRegistry::getPolicy(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto policy = policies.find(name);
+    return policy != policies.end() ? policy->second : ThreadPolicy{SchedPolicy::OTHER, 0, -1};
+}
+
+std::vector<ThreadInfo> ThreadRegistry::threads() {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<ThreadInfo> result;
+    for (const auto &thread : running) {
+        result.push_back(thread.second);
+    }
+    return result;
+}
+
+bool ThreadRegistry::applyToCurrentThread(const std::string &name, const ThreadPolicy &policy) {
+    setName(name);
+    bool applied = true;
+    if (policy.policy != SchedPolicy::OTHER) {
+        struct sched_param param = {};
+        param.sched_priority = policy.priority;
+        int schedPolicy = policy.policy == SchedPolicy::FIFO ? SCHED_FIFO : SCHED_RR;
+        int error = pthread_setschedparam(pthread_self(), schedPolicy, &param);
+        if (error != 0) {
+            Logger::warn("[ThreadRegistry] Cannot set " + policy.toString() + " for " + name
+                         + ": error " + std::to_string(error));
+            applied = false;
+        }
+    }
+    if (policy.cpu >= 0 && !setAffinity(policy.cpu)) {
+        Logger::warn("[ThreadRegistry] Cannot bind " + name + " to CPU "
+                     + std::to_string(policy.cpu));
+        applied = false;
+    }
+    return applied;
+}
+
+ThreadRegistry::Registration::Registration(ThreadRegistry &registry, const std::string &name)
+    : registry(registry) {
+    ThreadPolicy policy = registry.getPolicy(name);
+    bool applied = false;
+    if (registry.isEnabled()) {
+        applied = applyToCurrentThread(name, policy);
+    } else {
+        setName(name);
+    }
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    registry.running[std::this_thread::get_id()] = ThreadInfo{name, policy, applied};
+}
+
+ThreadRegistry::Registration::~Registration() {
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    registry.running.erase(std::this_thread::get_id());
+}
+
+Histogram &ThreadRegistry::measureWakeupLatency(const std::string &name, int periodUs,
+                                                int samples) {
+    Histogram &latency = MetricsRegistry::getInstance().histogram(
+        "esep_thread_wakeup_latency_us{thread=\"" + name + "\"}");
+    ThreadPolicy policy = getPolicy(name);
+    std::thread probe([&]() {
+        using namespace std::chrono;
+        applyToCurrentThread(name + "-probe", policy);
+        steady_clock::time_point deadline = steady_clock::now();
+        for (int i = 0; i < samples; i++) {
+            deadline += microseconds(periodUs);
+            std::this_thread::sleep_until(deadline);
+            steady_clock::time_point woken = steady_clock::now();
+            int64_t lateUs = duration_cast<microseconds>(woken - deadline).count();
+            latency.record(std::max<int64_t>(0, lateUs));
+            // a late wake-up must not shorten the next period
+            if (woken > deadline) {
+                deadline = woken;
+            }
+        }
+    });
+    probe.join();
+    return latency;
+}
@@ -0,0 +1,134 @@
+/*
+ * ThreadRegistry.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class Histogram;
+
+enum class SchedPolicy { OTHER, FIFO, RR };
+
+/**
+ * Scheduling of a thread. FIFO/RR priorities are 1..63 on QNX and 1..99 on
+ * Linux, OTHER keeps the scheduling inherited from the creating thread.
+ */
+struct ThreadPolicy {
+    SchedPolicy policy;
+    int priority;
+    int cpu;   // -1: any CPU
+
+    bool operator==(const ThreadPolicy &other) const {
+        return policy == other.policy && priority == other.priority && cpu == other.cpu;
+    }
+    bool operator!=(const ThreadPolicy &other) const { return !(*this == other); }
+
+    /**
+     * @return e.g. "fifo:40:0" (cpu omitted if any)
+     */
+    std::string toString() const;
+
+    /**
+     * @param text <other|fifo|rr>:<priority>[:<cpu>]
+     * @return false if text is invalid, policy is unchanged
+     */
+    static bool parse(const std::string &text, ThreadPolicy &policy);
+};
+
+/**
+ * A running thread started by the ThreadRegistry
+ */
+struct ThreadInfo {
+    std::string name;
+    ThreadPolicy policy;
+    bool applied;   // false if the policy was not set (disabled or no permission)
+};
+
+/**
+ * Names the threads of the application and assigns their scheduling policy,
+ * priority and CPU affinity, so that the handling of GPIO interrupts and
+ * events is not delayed by logging or simulation work.
+ *
+ * Threads are started by spawn() with their name. The policy of a name comes
+ * from a built-in table, which can be changed by setPolicy() (e.g. from the
+ * THREAD lines of the config file). A policy is set by the thread itself when
+ * it starts, changes apply to threads started afterwards.
+ *
+ * Policies are only set after setEnabled(true) (done by main), tests and
+ * benchmarks keep the default scheduling.
+ */
+class ThreadRegistry {
+  public:
+    static ThreadRegistry &getInstance();
+
+    void setEnabled(bool enable);
+    bool isEnabled();
+
+    void setPolicy(const std::string &name, ThreadPolicy policy);
+
+    /**
+     * @return policy of the name, OTHER if there is none
+     */
+    ThreadPolicy getPolicy(const std::string &name);
+
+    /**
+     * Starts a thread (arguments as std::thread) which sets its name and
+     * policy before calling f.
+     */
+    template <typename F, typename... Args>
+    std::thread spawn(const std::string &name, F &&f, Args &&... args) {
+        auto task = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+        return std::thread([this, name, task]() mutable {
+            Registration registration(*this, name);
+            task();
+        });
+    }
+
+    /**
+     * @return all running threads started by spawn()
+     */
+    std::vector<ThreadInfo> threads();
+
+    /**
+     * Measures the wake-up latency of a thread with the policy of the name:
+     * a probe thread sleeps until periodic deadlines and records how late it
+     * wakes up in esep_thread_wakeup_latency_us{thread="<name>"}. Blocks
+     * until all samples are recorded.
+     *
+     * @return the histogram [us]
+     */
+    Histogram &measureWakeupLatency(const std::string &name, int periodUs, int samples);
+
+    /**
+     * Sets name, policy and affinity of the calling thread
+     *
+     * @return false if the policy or affinity cannot be set
+     */
+    static bool applyToCurrentThread(const std::string &name, const ThreadPolicy &policy);
+
+  private:
+    ThreadRegistry();
+
+    // Registers the calling thread for its lifetime
+    class Registration {
+      public:
+        Registration(ThreadRegistry &registry, const std::string &name);
+        ~Registration();
+
+      private:
+        ThreadRegistry &registry;
+    };
+
+    std::mutex mtx;
+    bool enabled{false};
+    std::map<std::string, ThreadPolicy> policies;
+    std::map<std::thread::id, ThreadInfo> running;
+};
@@ -0,0 +1,255 @@
+/*
+ * TimerService.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "TimerService.h"
+#include "ThreadRegistry.h"
+
+#define L0_SIZE (1 << TIMER_WHEEL_BITS_L0)
+#define L0_MASK (L0_SIZE - 1)
+#define LN_MASK ((1 << TIMER_WHEEL_BITS_LN) - 1)
+#define L1_SPAN ((uint64_t) L0_SIZE << TIMER_WHEEL_BITS_LN)
+#define L2_SPAN (L1_SPAN << TIMER_WHEEL_BITS_LN)
+
+using namespace std::chrono;
+
+TimerService::TimerService()
+    : clock(&Clock::getInstance()), followClock(true), clockHandler(0), processedTick(0),
+      nextId(1), executingId(0), running(true), wakeups(0), executed(0) {
+    clockHandler = Clock::addChangeHandler([this]() { clockChanged(); });
+    start();
+}
+
+TimerService::TimerService(Clock &clock)
+    : clock(&clock), followClock(false), clockHandler(0), processedTick(0), nextId(1),
+      executingId(0), running(true), wakeups(0), executed(0) {
+    start();
+}
+
+TimerService::~TimerService() {
+    if (followClock) {
+        Clock::removeChangeHandler(clockHandler);
+    }
+    stop();
+}
+
+void TimerService::start() {
+    epoch = clock->now();
+    thTimer = ThreadRegistry::getInstance().spawn("timers", &TimerService::timerThread, this);
+}
+
+void TimerService::clockChanged() {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.notify_all();
+    // The timer thread may wait on the old clock, which may be destroyed
+    // after setInstance() has returned
+    cvExecuted.wait(lock, [this] { return !running || !clockOutdated(); });
+}
+
+bool TimerService::clockOutdated() { return followClock && clock != &Clock::getInstance(); }
+
+void TimerService::rebindClock() {
+    // The ticks continue where the old clock stopped
+    Clock::time_point::duration elapsed = clock->now() - epoch;
+    clock = &Clock::getInstance();
+    epoch = clock->now() - elapsed;
+    cvExecuted.notify_all();
+}
+
+TimerId TimerService::scheduleOnce(int delayMs, Callback callback) {
+    return add(delayMs, 0, callback);
+}
+
+TimerId TimerService::schedulePeriodic(int periodMs, Callback callback) {
+    return add(periodMs, periodMs, callback);
+}
+
+bool TimerService::cancel(TimerId id) {
+    if (id == 0) {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(mtx);
+    bool active = timers.erase(id) > 0;
+    if (std::this_thread::get_id() != thTimer.get_id()) {
+        // Callback may still be running -> wait for it
+        cvExecuted.wait(lock, [this, id] { return executingId != id; });
+    }
+    return active;
+}
+
+void TimerService::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        running = false;
+    }
+    cv.notify_all();
+    cvExecuted.notify_all();
+    if (thTimer.joinable() && std::this_thread::get_id() != thTimer.get_id()) {
+        thTimer.join();
+    }
+}
+
+int TimerService::getActiveTimers() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return timers.size();
+}
+
+bool TimerService::isIdle() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (executingId != 0) {
+        return false;
+    }
+    uint64_t now = currentTick();
+    for (const auto &timer : timers) {
+        if (timer.second.expiryTick <= now) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TimerId TimerService::add(int delayMs, int periodMs, Callback callback) {
+    std::lock_guard<std::mutex> lock(mtx);
+    // Microseconds: whole milliseconds would lose up to 1 ms of the delay
+    uint64_t nowUs = duration_cast<microseconds>(clock->now() - epoch).count();
+    if (timers.empty()) {
+        // Wheel was idle -> continue at the current time
+        processedTick = std::max(processedTick, nowUs / (TIMER_TICK_MS * 1000));
+    }
+    // Round up, the callback is never called too early
+    uint64_t expiryTick = (nowUs + delayMs * 1000ull + TIMER_TICK_MS * 1000 - 1)
+                          / (TIMER_TICK_MS * 1000);
+    uint64_t periodTicks = (periodMs + TIMER_TICK_MS - 1) / TIMER_TICK_MS;
+    if (periodMs > 0 && periodTicks == 0) {
+        periodTicks = 1;
+    }
+
+    TimerId id = nextId++;
+    timers[id] = Timer{expiryTick, periodTicks, callback};
+    insert(id, expiryTick);
+    cv.notify_one();
+    return id;
+}
+
+void TimerService::insert(TimerId id, uint64_t expiryTick) {
+    if (expiryTick <= processedTick) {
+        expiryTick = processedTick + 1;
+    }
+    uint64_t delta = expiryTick - processedTick;
+    if (delta < L0_SIZE) {
+        level0[expiryTick & L0_MASK].push_back(id);
+    } else if (delta < L1_SPAN) {
+        level1[(expiryTick >> TIMER_WHEEL_BITS_L0) & LN_MASK].push_back(id);
+    } else {
+        if (delta >= L2_SPAN) {
+            // Too far away -> cascaded again later
+            expiryTick = processedTick + L2_SPAN - 1;
+        }
+        level2[(expiryTick >> (TIMER_WHEEL_BITS_L0 + TIMER_WHEEL_BITS_LN)) & LN_MASK]
+            .push_back(id);
+    }
+}
+
+void TimerService::cascade(Slot &slot) {
+    Slot ids;
+    ids.swap(slot);
+    for (TimerId id : ids) {
+        auto it = timers.find(id);
+        if (it != timers.end()) {
+            insert(id, it->second.expiryTick);
+        }
+    }
+}
+
+uint64_t TimerService::currentTick() {
+    return clock->millisSince(epoch) / TIMER_TICK_MS;
+}
+
+uint64_t TimerService::nextWakeupTick() {
+    // Next occupied slot of level 0, at the latest when level 0 wraps around
+    uint64_t boundary = ((processedTick >> TIMER_WHEEL_BITS_L0) + 1) << TIMER_WHEEL_BITS_L0;
+    for (uint64_t tick = processedTick + 1; tick < boundary; tick++) {
+        if (!level0[tick & L0_MASK].empty()) {
+            return tick;
+        }
+    }
+    return boundary;
+}
+
+void TimerService::expire(uint64_t tick, std::vector<TimerId> &due) {
+    Slot ids;
+    ids.swap(level0[tick & L0_MASK]);
+    for (TimerId id : ids) {
+        auto it = timers.find(id);
+        if (it == timers.end()) {
+            continue;   // cancelled
+        }
+        Timer &timer = it->second;
+        if (timer.expiryTick > tick) {
+            insert(id, timer.expiryTick);
+            continue;
+        }
+        due.push_back(id);
+        if (timer.periodTicks > 0) {
+            timer.expiryTick += timer.periodTicks;
+            insert(id, timer.expiryTick);
+        }
+    }
+}
+
+void TimerService::timerThread() {
+    std::unique_lock<std::mutex> lock(mtx);
+    std::vector<TimerId> due;
+    while (running) {
+        if (clockOutdated()) {
+            rebindClock();
+        }
+        if (timers.empty()) {
+            cv.wait(lock, [this] { return !running || !timers.empty() || clockOutdated(); });
+            continue;
+        }
+        uint64_t wakeupTick = nextWakeupTick();
+        clock->waitUntil(lock, cv, epoch + milliseconds(wakeupTick * TIMER_TICK_MS));
+        if (!running) {
+            break;
+        }
+        wakeups++;
+
+        uint64_t now = currentTick();
+        while (processedTick < now) {
+            processedTick++;
+            if ((processedTick & L0_MASK) == 0) {
+                // Level 0 wrapped around -> move timers down from upper levels
+                uint64_t index1 = (processedTick >> TIMER_WHEEL_BITS_L0) & LN_MASK;
+                if (index1 == 0) {
+                    cascade(level2[(processedTick >> (TIMER_WHEEL_BITS_L0 +
+                                                      TIMER_WHEEL_BITS_LN)) &
+                                   LN_MASK]);
+                }
+                cascade(level1[index1]);
+            }
+            expire(processedTick, due);
+        }
+
+        for (TimerId id : due) {
+            auto it = timers.find(id);
+            if (it == timers.end()) {
+                continue;   // cancelled in the meantime
+            }
+            Callback callback = it->second.callback;
+            if (it->second.periodTicks == 0) {
+                timers.erase(it);
+            }
+            executingId = id;
+            lock.unlock();
+            callback();
+            lock.lock();
+            executingId = 0;
+            executed++;
+            cvExecuted.notify_all();
+        }
+        due.clear();
+    }
+}
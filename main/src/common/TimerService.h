@@ -0,0 +1,132 @@
+/*
+ * TimerService.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "Clock.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Resolution of the timer wheel
+#define TIMER_TICK_MS 10
+// Slots per level: 256 ticks (2.56 s), 64 * 256 ticks (~164 s),
+// 64 * 64 * 256 ticks (~2.9 h)
+#define TIMER_WHEEL_BITS_L0 8
+#define TIMER_WHEEL_BITS_LN 6
+
+using TimerId = uint32_t;
+
+/**
+ * One thread which executes one-shot and periodic callbacks of all
+ * components. Timers are kept in a hierarchical timer wheel, the thread
+ * only wakes up when a timer expires (or a wheel level has to be
+ * cascaded), instead of one sleeping/polling thread per timer.
+ *
+ * Callbacks are executed in the timer thread and must not block.
+ * Time is taken from the clock of the application (Clock::getInstance()), also
+ * when it is replaced later, so timers follow a VirtualClock in headless
+ * simulation. A clock given at construction is used instead (tests).
+ */
+class TimerService {
+  public:
+    using Callback = std::function<void()>;
+
+    static TimerService &getInstance() {
+        static TimerService instance;
+        return instance;
+    }
+
+    TimerService();
+    explicit TimerService(Clock &clock);
+    virtual ~TimerService();
+
+    /**
+     * Calls the callback once after the delay.
+     *
+     * @param delayMs Delay in ms (rounded up to TIMER_TICK_MS)
+     * @return ID to cancel the timer
+     */
+    TimerId scheduleOnce(int delayMs, Callback callback);
+
+    /**
+     * Calls the callback every periodMs, the first time after periodMs.
+     *
+     * @return ID to cancel the timer
+     */
+    TimerId schedulePeriodic(int periodMs, Callback callback);
+
+    /**
+     * Cancels a timer. If its callback is being executed at the moment, waits
+     * until it has finished (except when called from a callback).
+     *
+     * @return true if the timer was still active
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * Stops the timer thread. Pending timers are not executed anymore.
+     */
+    void stop();
+
+    int getActiveTimers();
+
+    /**
+     * @return false if a callback is executed or a timer is due but not
+     *         executed yet (e.g. right after a VirtualClock was advanced)
+     */
+    bool isIdle();
+    uint64_t getWakeups() { return wakeups; }
+    uint64_t getExecutedCallbacks() { return executed; }
+
+  private:
+    struct Timer {
+        uint64_t expiryTick;
+        uint64_t periodTicks;   // 0: one-shot
+        Callback callback;
+    };
+    using Slot = std::vector<TimerId>;
+
+    std::array<Slot, 1 << TIMER_WHEEL_BITS_L0> level0;
+    std::array<Slot, 1 << TIMER_WHEEL_BITS_LN> level1;
+    std::array<Slot, 1 << TIMER_WHEEL_BITS_LN> level2;
+    std::unordered_map<TimerId, Timer> timers;
+
+    Clock *clock;
+    bool followClock;      // clock of the application, rebound when replaced
+    int clockHandler;
+    Clock::time_point epoch;
+    uint64_t processedTick;
+    TimerId nextId;
+    TimerId executingId;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::condition_variable cvExecuted;
+    std::thread thTimer;
+    std::atomic<bool> running;
+    std::atomic<uint64_t> wakeups;
+    std::atomic<uint64_t> executed;
+
+    void start();
+    void clockChanged();
+    bool clockOutdated();
+    void rebindClock();
+    TimerId add(int delayMs, int periodMs, Callback callback);
+    void insert(TimerId id, uint64_t expiryTick);
+    void cascade(Slot &slot);
+    uint64_t currentTick();
+    uint64_t nextWakeupTick();
+    void expire(uint64_t tick, std::vector<TimerId> &due);
+    void timerThread();
+};
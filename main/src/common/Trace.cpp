@@ -0,0 +1,235 @@
+/*
+ * Trace.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "Trace.h"
+#include "common/macros.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace {
+
+thread_local uint32_t currentTrace = 0;
+thread_local TraceRing *ring = nullptr;
+
+// Chrome trace timestamps are microseconds
+std::string micros(uint64_t ns) {
+    std::stringstream ss;
+    ss << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000;
+    return ss.str();
+}
+
+}
+
+bool TraceRing::push(const TraceRecord &record) {
+    uint64_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= TRACE_RING_CAPACITY) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    records[h % TRACE_RING_CAPACITY] = record;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+void TraceRing::drain(std::vector<TraceRecord> &out) {
+    uint64_t t = tail.load(std::memory_order_relaxed);
+    uint64_t h = head.load(std::memory_order_acquire);
+    for (; t != h; t++) {
+        out.push_back(records[t % TRACE_RING_CAPACITY]);
+    }
+    tail.store(t, std::memory_order_release);
+}
+
+Tracer &Tracer::getInstance() {
+    static Tracer instance;
+    return instance;
+}
+
+Tracer::Tracer() : epoch(std::chrono::steady_clock::now()) {
+    for (auto &slot : pending) {
+        slot.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint32_t Tracer::newTrace() {
+    if (!isEnabled()) {
+        return 0;
+    }
+    uint32_t id = nextTrace.fetch_add(1, std::memory_order_relaxed);
+    return id != 0 ? id : nextTrace.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t Tracer::current() { return currentTrace; }
+
+uint64_t Tracer::nowNs() const {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now() - epoch).count();
+}
+
+TraceRing &Tracer::threadRing() {
+    if (ring == nullptr) {
+        std::lock_guard<std::mutex> lock(ringsMtx);
+        rings.emplace_back(new TraceRing((uint32_t) rings.size() + 1));
+        ring = rings.back().get();
+    }
+    return *ring;
+}
+
+void Tracer::record(const char *name, uint32_t traceId, int event, uint64_t beginNs,
+                    uint64_t endNs) {
+    TraceRing &r = threadRing();
+    r.push(TraceRecord{name, traceId, r.getThread(), event, beginNs, endNs});
+}
+
+void Tracer::attach(const Event &event) {
+    uint32_t id = event.traceId != 0 ? event.traceId : currentTrace;
+    if (id != 0 && isEnabled()) {
+        pending[(uint8_t) event.type].store(id, std::memory_order_release);
+    }
+}
+
+uint32_t Tracer::take(EventType type) {
+    if (!isEnabled()) {
+        return 0;
+    }
+    return pending[(uint8_t) type].exchange(0, std::memory_order_acq_rel);
+}
+
+void Tracer::collect() {
+    std::vector<TraceRecord> collected;
+    {
+        std::lock_guard<std::mutex> lock(ringsMtx);
+        for (auto &r : rings) {
+            r->drain(collected);
+        }
+    }
+    std::lock_guard<std::mutex> lock(storeMtx);
+    store.insert(store.end(), collected.begin(), collected.end());
+    if (store.size() > TRACE_STORE_CAPACITY) {
+        size_t excess = store.size() - TRACE_STORE_CAPACITY;
+        store.erase(store.begin(), store.begin() + excess);
+    }
+}
+
+std::vector<TraceRecord> Tracer::getRecords() {
+    collect();
+    std::lock_guard<std::mutex> lock(storeMtx);
+    return store;
+}
+
+uint64_t Tracer::getDropped() {
+    std::lock_guard<std::mutex> lock(ringsMtx);
+    uint64_t dropped = 0;
+    for (auto &r : rings) {
+        dropped += r->getDropped();
+    }
+    return dropped;
+}
+
+void Tracer::clear() {
+    collect();
+    std::lock_guard<std::mutex> lock(storeMtx);
+    store.clear();
+}
+
+bool Tracer::exportChromeTrace(const std::string &path) {
+    std::vector<TraceRecord> records = getRecords();
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        return false;
+    }
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    std::vector<uint32_t> threads;
+    for (const TraceRecord &r : records) {
+        if (std::find(threads.begin(), threads.end(), r.thread) == threads.end()) {
+            threads.push_back(r.thread);
+        }
+    }
+    for (uint32_t thread : threads) {
+        out << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread
+            << ", \"args\": {\"name\": \"thread " << thread << "\"}},\n";
+    }
+    for (size_t i = 0; i < records.size(); i++) {
+        const TraceRecord &r = records[i];
+        out << "{\"name\": \"" << r.name << "\", \"cat\": \"esep\", \"pid\": 1, \"tid\": "
+            << r.thread << ", \"ts\": " << micros(r.beginNs);
+        if (r.endNs > r.beginNs) {
+            out << ", \"ph\": \"X\", \"dur\": " << micros(r.endNs - r.beginNs);
+        } else {
+            out << ", \"ph\": \"i\", \"s\": \"t\"";
+        }
+        out << ", \"args\": {\"trace\": " << r.traceId;
+        if (r.event >= 0 && r.event < (int) EVENT_TYPE_COUNT) {
+            out << ", \"event\": \"" << EVENT_TO_STRING(r.event) << "\"";
+        }
+        out << "}}" << (i + 1 < records.size() ? ",\n" : "\n");
+    }
+    out << "]}\n";
+    return out.good();
+}
+
+std::vector<uint64_t> Tracer::latencies(const std::string &from, const std::string &to) {
+    std::vector<TraceRecord> records = getRecords();
+    std::sort(records.begin(), records.end(), [](const TraceRecord &a, const TraceRecord &b) {
+        return a.beginNs < b.beginNs;
+    });
+    std::map<uint32_t, uint64_t> starts;   // trace -> begin of from
+    std::vector<uint64_t> result;
+    for (const TraceRecord &r : records) {
+        if (from == r.name && starts.count(r.traceId) == 0) {
+            starts[r.traceId] = r.beginNs;
+        } else if (to == r.name) {
+            auto start = starts.find(r.traceId);
+            if (start != starts.end()) {
+                result.push_back((r.endNs - start->second) / 1000);
+                starts.erase(start);
+            }
+        }
+    }
+    return result;
+}
+
+std::string Tracer::histogram(std::vector<uint64_t> latenciesUs) {
+    std::stringstream ss;
+    if (latenciesUs.empty()) {
+        ss << "no latencies recorded" << std::endl;
+        return ss.str();
+    }
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    auto percentile = [&](unsigned int percent) {
+        // nearest rank
+        size_t rank = (latenciesUs.size() * percent + 99) / 100;
+        return latenciesUs[rank > 0 ? rank - 1 : 0];
+    };
+    ss << latenciesUs.size() << " traces, p50 " << percentile(50) << " us, p90 "
+       << percentile(90) << " us, p99 " << percentile(99) << " us, max "
+       << latenciesUs.back() << " us" << std::endl;
+
+    std::map<uint64_t, size_t> buckets;   // upper bound -> count
+    for (uint64_t latency : latenciesUs) {
+        uint64_t bound = 1;
+        while (bound < latency) {
+            bound <<= 1;
+        }
+        buckets[bound]++;
+    }
+    size_t largest = 0;
+    for (const auto &bucket : buckets) {
+        largest = std::max(largest, bucket.second);
+    }
+    for (const auto &bucket : buckets) {
+        ss << "<= " << std::setw(8) << bucket.first << " us " << std::setw(7) << bucket.second
+           << ' ' << std::string((bucket.second * 40 + largest - 1) / largest, '#') << std::endl;
+    }
+    return ss.str();
+}
+
+TraceScope::TraceScope(uint32_t traceId) : previous(currentTrace) { currentTrace = traceId; }
+
+TraceScope::~TraceScope() { currentTrace = previous; }
@@ -0,0 +1,213 @@
+/*
+ * Trace.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "events/events.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Records per thread until the next collect(), further records are dropped
+#define TRACE_RING_CAPACITY 4096
+// Records kept by the Tracer, the oldest are discarded
+#define TRACE_STORE_CAPACITY (1u << 20)
+
+/**
+ * One span (begin < end) or instant (begin == end) of a trace
+ */
+struct TraceRecord {
+    const char *name;   // static string
+    uint32_t traceId;
+    uint32_t thread;    // index of the recording thread
+    int event;          // EventType or -1
+    uint64_t beginNs;   // since start of the Tracer
+    uint64_t endNs;
+};
+
+/**
+ * Records of one thread. Single producer (the thread), single consumer
+ * (Tracer::collect()), no locks.
+ */
+class TraceRing {
+  public:
+    explicit TraceRing(uint32_t thread) : thread(thread) {}
+
+    uint32_t getThread() const { return thread; }
+
+    /**
+     * @return false if the ring is full, the record is dropped
+     */
+    bool push(const TraceRecord &record);
+
+    /**
+     * Moves all records to out
+     */
+    void drain(std::vector<TraceRecord> &out);
+
+    uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+  private:
+    const uint32_t thread;
+    std::array<TraceRecord, TRACE_RING_CAPACITY> records;
+    std::atomic<uint64_t> head{0};   // written by the producer
+    std::atomic<uint64_t> tail{0};   // written by the consumer
+    std::atomic<uint64_t> dropped{0};
+};
+
+/**
+ * Latency tracing of the event chains, e.g. from a light barrier edge in
+ * Sensors to the switch in Actuators.
+ *
+ * A trace is started for an event (newTrace()) and its ID is carried by the
+ * Event. A pulse only transports type and data, so EventSender hands the ID
+ * over to the EventManager by the type of the event (attach()/take()).
+ * While an event is dispatched, its trace is the current trace of the
+ * dispatcher thread (TraceScope): spans of the handlers and events sent by
+ * them belong to the same trace.
+ *
+ * Disabled by default, then spans cost one atomic load. Records are only
+ * kept for traced events (trace ID != 0).
+ */
+class Tracer {
+  public:
+    static Tracer &getInstance();
+
+    void setEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @return new trace ID, 0 (not traced) if disabled
+     */
+    uint32_t newTrace();
+
+    /**
+     * @return trace of the event dispatched by the calling thread, 0 if none
+     */
+    static uint32_t current();
+
+    uint64_t nowNs() const;
+
+    void record(const char *name, uint32_t traceId, int event, uint64_t beginNs, uint64_t endNs);
+
+    void instant(const char *name, uint32_t traceId, int event = -1) {
+        if (traceId != 0 && isEnabled()) {
+            uint64_t now = nowNs();
+            record(name, traceId, event, now, now);
+        }
+    }
+
+    /**
+     * Hands the trace of an event over to the receiver of its pulse. Only
+     * the latest trace of each event type is kept.
+     */
+    void attach(const Event &event);
+
+    /**
+     * @return trace attached to the event type (once), 0 if none
+     */
+    uint32_t take(EventType type);
+
+    /**
+     * Moves the records of all threads to the Tracer. Called regularly by
+     * one thread, at least before the rings are full.
+     */
+    void collect();
+
+    std::vector<TraceRecord> getRecords();
+
+    /**
+     * Records dropped because the ring of a thread was full
+     */
+    uint64_t getDropped();
+
+    void clear();
+
+    /**
+     * Writes all collected records in the Chrome trace event format (JSON),
+     * which is also read by Perfetto (ui.perfetto.dev).
+     */
+    bool exportChromeTrace(const std::string &path);
+
+    /**
+     * Latency of each trace from the begin of the first record named from
+     * to the end of the first following record named to [us]
+     */
+    std::vector<uint64_t> latencies(const std::string &from, const std::string &to);
+
+    /**
+     * Histogram with power of two buckets and percentiles
+     */
+    static std::string histogram(std::vector<uint64_t> latenciesUs);
+
+  private:
+    Tracer();
+
+    TraceRing &threadRing();
+
+    std::atomic<bool> enabled{false};
+    std::atomic<uint32_t> nextTrace{1};
+    std::array<std::atomic<uint32_t>, 256> pending;
+    const std::chrono::steady_clock::time_point epoch;
+
+    std::mutex ringsMtx;
+    std::vector<std::unique_ptr<TraceRing>> rings;
+
+    std::mutex storeMtx;
+    std::vector<TraceRecord> store;
+};
+
+/**
+ * Sets the current trace of the thread for its lifetime
+ */
+class TraceScope {
+  public:
+    explicit TraceScope(uint32_t traceId);
+    ~TraceScope();
+
+  private:
+    uint32_t previous;
+};
+
+/**
+ * Records a span from construction to destruction, by default in the
+ * current trace of the thread
+ */
+class TraceSpan {
+  public:
+    TraceSpan(const char *name, int event = -1) : TraceSpan(name, Tracer::current(), event) {}
+
+    TraceSpan(const char *name, uint32_t traceId, int event)
+        : name(name), traceId(traceId), event(event) {
+        if (Tracer::getInstance().isEnabled()) {
+            beginNs = Tracer::getInstance().nowNs();
+        }
+    }
+
+    ~TraceSpan() {
+        Tracer &tracer = Tracer::getInstance();
+        if (traceId != 0 && tracer.isEnabled()) {
+            tracer.record(name, traceId, event, beginNs, tracer.nowNs());
+        }
+    }
+
+    // A trace started within the span, e.g. for the event of a sensor edge
+    void setTrace(uint32_t id, int ev) {
+        traceId = id;
+        event = ev;
+    }
+
+  private:
+    const char *name;
+    uint32_t traceId;
+    int event;
+    uint64_t beginNs = 0;
+};
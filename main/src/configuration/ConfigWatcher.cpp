@@ -0,0 +1,97 @@
+/*
+ * ConfigWatcher.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "ConfigWatcher.h"
+#include "common/ThreadRegistry.h"
+#include "logger/logger.hpp"
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#define CONFIG_WATCH_MASK (IN_CLOSE_WRITE | IN_MOVED_TO)
+
+ConfigWatcher::ConfigWatcher(Configuration &conf)
+    : conf(conf), inotifyFd(-1), stopPipe{-1, -1}, nReloads(0) {}
+
+ConfigWatcher::~ConfigWatcher() { stop(); }
+
+bool ConfigWatcher::start() {
+    if (watchThread.joinable()) {
+        return true;
+    }
+    std::string path = conf.getConfigFilePath();
+    size_t slash = path.find_last_of('/');
+    std::string dir = (slash == std::string::npos) ? "." : path.substr(0, slash + 1);
+    std::string fileName = (slash == std::string::npos) ? path : path.substr(slash + 1);
+
+    inotifyFd = inotify_init();
+    if (inotifyFd < 0) {
+        Logger::warn("[ConfigWatcher] inotify not available - no hot reload of " + path);
+        return false;
+    }
+    // The directory is watched, an atomic rename replaces the file itself
+    if (inotify_add_watch(inotifyFd, dir.c_str(), CONFIG_WATCH_MASK) < 0
+        || pipe(stopPipe) != 0) {
+        Logger::warn("[ConfigWatcher] Cannot watch " + dir + " - no hot reload of " + path);
+        close(inotifyFd);
+        inotifyFd = -1;
+        return false;
+    }
+    watchThread = ThreadRegistry::getInstance().spawn("config-watch", &ConfigWatcher::watch, this,
+                                                        fileName);
+    Logger::debug("[ConfigWatcher] Watching " + path);
+    return true;
+}
+
+void ConfigWatcher::stop() {
+    if (watchThread.joinable()) {
+        char stopByte = 0;
+        if (write(stopPipe[1], &stopByte, 1) != 1) {
+            Logger::error("[ConfigWatcher] Cannot stop watch thread");
+        }
+        watchThread.join();
+    }
+    for (int fd : {inotifyFd, stopPipe[0], stopPipe[1]}) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    inotifyFd = -1;
+    stopPipe[0] = stopPipe[1] = -1;
+}
+
+void ConfigWatcher::watch(std::string fileName) {
+    // aligned for struct inotify_event
+    alignas(struct inotify_event) char buffer[4096];
+    struct pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {stopPipe[0], POLLIN, 0}};
+    while (true) {
+        if (poll(fds, 2, -1) < 0) {
+            continue;
+        }
+        if (fds[1].revents & POLLIN) {
+            break;
+        }
+        ssize_t len = read(inotifyFd, buffer, sizeof(buffer));
+        if (len <= 0) {
+            continue;
+        }
+        // Several events of one write (e.g. by an editor) cause one reload
+        bool changed = false;
+        for (char *ptr = buffer; ptr < buffer + len;) {
+            struct inotify_event *event = (struct inotify_event *) ptr;
+            if (event->len > 0 && (event->mask & CONFIG_WATCH_MASK)
+                && fileName == event->name) {
+                changed = true;
+            }
+            ptr += sizeof(struct inotify_event) + event->len;
+        }
+        if (changed) {
+            conf.reloadConfigFromFile();
+            nReloads++;
+        }
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ * ConfigWatcher.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "configuration/Configuration.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+/**
+ * Hot reload of the config file. Watches the directory of the file with
+ * inotify (on QNX provided by fsevmgr) and calls
+ * Configuration::reloadConfigFromFile() if the file was written or replaced
+ * by a rename. Files saved by the Configuration itself are reloaded as well,
+ * but publish no new snapshot as the values are unchanged.
+ */
+class ConfigWatcher {
+  public:
+    ConfigWatcher(Configuration &conf = Configuration::getInstance());
+    virtual ~ConfigWatcher();
+
+    /**
+     * Starts watching the current config file path.
+     *
+     * @return false if inotify is not available
+     */
+    bool start();
+    void stop();
+
+    uint64_t getReloads() { return nReloads; }
+
+  private:
+    Configuration &conf;
+    int inotifyFd;
+    int stopPipe[2];
+    std::thread watchThread;
+    std::atomic<uint64_t> nReloads;
+    void watch(std::string fileName);
+};
@@ -9,170 +9,319 @@
 #include "hal/IHeightSensor.h"
 #include "logger/logger.hpp"
 
+#include <fcntl.h>
+#include <unistd.h>
 
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
 
 Configuration::Configuration() {
-    this->cal = Calibration{.calOffset = ADC_DEFAULT_OFFSET,
-                            .calRef = ADC_DEFAULT_HIGH};
     this->configFilePath = std::string(DEFAULT_CONFIG_FILE_PATH);
-    this->order = {WS_F, WS_BUM, WS_OB };
+    ConfigSnapshot initial;
+    initial.version = 1;
+    initial.order = {WS_F, WS_BUM, WS_OB };
+    initial.cal = Calibration{.calOffset = ADC_DEFAULT_OFFSET,
+                              .calRef = ADC_DEFAULT_HIGH};
+    initial.isMaster = true;
+    initial.hasPusher = false;
+    std::atomic_store_explicit(&current, std::make_shared<const ConfigSnapshot>(initial),
+                               std::memory_order_release);
 }
 
 Configuration::~Configuration() {}
 
 void Configuration::setConfigFilePath(std::string filePath) {
+    std::lock_guard<std::mutex> lock(writeMtx);
     this->configFilePath = filePath;
 }
 
-bool Configuration::readConfigFromFile() {
-    bool readResult = false;
+std::string Configuration::getConfigFilePath() {
+    std::lock_guard<std::mutex> lock(writeMtx);
+    return configFilePath;
+}
 
-    std::vector<std::string> errors;
-    std::ifstream fileStream(configFilePath);
-    if (fileStream.is_open()) {
-        Logger::info("Read config from file: " + configFilePath);
-        std::vector<WorkpieceType> workpieceOrder;
-        std::string line;
-        while (std::getline(fileStream, line)) {
-            std::istringstream iss(line);
-            std::string key;
-            if (std::getline(iss, key, '=')) {
-                std::string value;
-                if (std::getline(iss, value)) {
-                    if (key == "ORDER") {
-                        std::string wpType;
-                        std::istringstream tokenStream(value);
-                        while (std::getline(tokenStream, wpType, ',')) {
-                            if (wpType == "F") {
-                                workpieceOrder.push_back(WorkpieceType::WS_F);
-                            } else if (wpType == "BOM") {
-                                workpieceOrder.push_back(WorkpieceType::WS_BOM);
-                            } else if (wpType == "BUM") {
-                                workpieceOrder.push_back(WorkpieceType::WS_BUM);
-                            } else if (wpType == "OB") {
-                                workpieceOrder.push_back(WorkpieceType::WS_OB);
-                            } else {
-                                errors.push_back(
-                                    "Unknown workpiece type in config: " +
-                                    wpType);
-                            }
+template <typename Change> void Configuration::update(Change change) {
+    std::lock_guard<std::mutex> lock(writeMtx);
+    ConfigSnapshot next = *snapshot();
+    change(next);
+    publish(next);
+}
+
+void Configuration::publish(const ConfigSnapshot &next) {
+    // writeMtx is held by the caller
+    std::shared_ptr<const ConfigSnapshot> old = snapshot();
+    if (next.sameValues(*old)) {
+        return;
+    }
+    auto published = std::make_shared<ConfigSnapshot>(next);
+    published->version = old->version + 1;
+    std::atomic_store_explicit(&current, std::shared_ptr<const ConfigSnapshot>(published),
+                               std::memory_order_release);
+}
+
+bool Configuration::parseConfig(std::istream &in, ConfigSnapshot &config,
+                                std::vector<std::string> &errors) {
+    std::vector<WorkpieceType> workpieceOrder;
+    std::map<std::string, ThreadPolicy> threads;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream iss(line);
+        std::string key;
+        if (std::getline(iss, key, '=')) {
+            std::string value;
+            if (std::getline(iss, value)) {
+                if (key == "ORDER") {
+                    std::string wpType;
+                    std::istringstream tokenStream(value);
+                    while (std::getline(tokenStream, wpType, ',')) {
+                        if (wpType == "F") {
+                            workpieceOrder.push_back(WorkpieceType::WS_F);
+                        } else if (wpType == "BOM") {
+                            workpieceOrder.push_back(WorkpieceType::WS_BOM);
+                        } else if (wpType == "BUM") {
+                            workpieceOrder.push_back(WorkpieceType::WS_BUM);
+                        } else if (wpType == "OB") {
+                            workpieceOrder.push_back(WorkpieceType::WS_OB);
+                        } else {
+                            errors.push_back(
+                                "Unknown workpiece type in config: " +
+                                wpType);
                         }
-                    } else if (key == "CAL_OFFSET") {
-                        cal.calOffset = std::stoi(value);
-                    } else if (key == "CAL_REF") {
-                        cal.calRef = std::stoi(value);
                     }
+                } else if (key == "CAL_OFFSET" || key == "CAL_REF") {
+                    int number;
+                    try {
+                        number = std::stoi(value);
+                    } catch (const std::exception &e) {
+                        errors.push_back("Invalid number for " + key + ": " + value);
+                        continue;
+                    }
+                    if (key == "CAL_OFFSET") {
+                        config.cal.calOffset = number;
+                    } else {
+                        config.cal.calRef = number;
+                    }
+                } else if (key == "THREAD") {
+                    size_t colon = value.find(':');
+                    ThreadPolicy policy{SchedPolicy::OTHER, 0, -1};
+                    if (colon == std::string::npos || colon == 0
+                        || !ThreadPolicy::parse(value.substr(colon + 1), policy)) {
+                        errors.push_back("Invalid thread policy: " + value);
+                        continue;
+                    }
+                    threads[value.substr(0, colon)] = policy;
                 }
             }
         }
+    }
 
-        if (workpieceOrder.size() != 3) {
-            errors.push_back("Configured workpiece order must contain exactly "
-                             "3 types (e.g.: F,BOM,OB)");
-        } else {
-            order = std::move(workpieceOrder);
-        }
-        Logger::debug("Cal. Offset: " + std::to_string(cal.calOffset));
-        Logger::debug("Cal. Ref: " + std::to_string(cal.calRef));
-        readResult = true;
+    if (workpieceOrder.size() != 3) {
+        errors.push_back("Configured workpiece order must contain exactly "
+                         "3 types (e.g.: F,BOM,OB)");
     } else {
-        Logger::warn("Config file " + configFilePath +
-                     " does not exist -> create new and write default values");
-        Logger::warn("Please perform a calibration of the HeightSensor!");
-        std::ofstream fileStream;
-        fileStream.open(configFilePath);
-        fileStream << "ORDER=F,BUM,OB\n";
-        fileStream << "CAL_OFFSET=" << ADC_DEFAULT_OFFSET << "\n";
-        fileStream << "CAL_REF=" << ADC_DEFAULT_HIGH << "\n";
-        fileStream.close();
-        readResult = true;
+        config.order = std::move(workpieceOrder);
     }
+    config.threads = std::move(threads);
+    return errors.empty();
+}
 
-    if (!errors.empty()) {
-        Logger::error("Config file contains errors. Please fix them:");
-        for (const auto &msg : errors) {
-            Logger::error("- " + msg);
+std::string Configuration::formatConfig(const ConfigSnapshot &config) {
+    std::stringstream ss;
+    ss << "ORDER=";
+    for (size_t i = 0; i < config.order.size(); ++i) {
+        if (config.order[i] == WorkpieceType::WS_F) {
+            ss << "F";
+        } else if (config.order[i] == WorkpieceType::WS_BOM) {
+            ss << "BOM";
+        } else if (config.order[i] == WorkpieceType::WS_BUM) {
+            ss << "BUM";
+        } else if (config.order[i] == WorkpieceType::WS_OB) {
+            ss << "OB";
         }
+
+        if (i < config.order.size() - 1) {
+            ss << ",";
+        }
+    }
+    ss << "\n";
+    ss << "CAL_OFFSET=" << config.cal.calOffset << "\n";
+    ss << "CAL_REF=" << config.cal.calRef << "\n";
+    for (const auto &thread : config.threads) {
+        ss << "THREAD=" << thread.first << ':' << thread.second.toString() << "\n";
+    }
+    return ss.str();
+}
+
+bool Configuration::writeFileAtomically(const std::string &path,
+                                        const std::string &content) {
+    const std::string tempFilePath = path + ".tmp";
+    int fd = open(tempFilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        Logger::error("Error opening temporary file: " + tempFilePath);
+        return false;
+    }
+    const char *data = content.data();
+    size_t remaining = content.size();
+    while (remaining > 0) {
+        ssize_t written = write(fd, data, remaining);
+        if (written < 0) {
+            Logger::error("Error writing temporary file: " + tempFilePath);
+            close(fd);
+            std::remove(tempFilePath.c_str());
+            return false;
+        }
+        data += written;
+        remaining -= written;
+    }
+    // Content must be on disk before the rename makes it visible
+    if (fsync(fd) != 0 || close(fd) != 0) {
+        Logger::error("Error syncing temporary file: " + tempFilePath);
+        std::remove(tempFilePath.c_str());
+        return false;
+    }
+
+    if (std::rename(tempFilePath.c_str(), path.c_str()) != 0) {
+        Logger::error("Error renaming temporary file: " + tempFilePath +
+                      " -> " + path);
+        std::remove(tempFilePath.c_str());
         return false;
     }
 
+    // Persist the rename itself
+    size_t slash = path.find_last_of('/');
+    std::string dir = (slash == std::string::npos) ? "." : path.substr(0, slash + 1);
+    int dirFd = open(dir.c_str(), O_RDONLY);
+    if (dirFd >= 0) {
+        fsync(dirFd);
+        close(dirFd);
+    }
+    return true;
+}
+
+bool Configuration::readConfigFromFile() {
+    std::string filePath = getConfigFilePath();
+    std::ifstream fileStream(filePath);
+    if (!fileStream.is_open()) {
+        Logger::warn("Config file " + filePath +
+                     " does not exist -> create new and write default values");
+        Logger::warn("Please perform a calibration of the HeightSensor!");
+        update([](ConfigSnapshot &config) {
+            config.order = {WS_F, WS_BUM, WS_OB};
+            config.cal = Calibration{.calOffset = ADC_DEFAULT_OFFSET,
+                                     .calRef = ADC_DEFAULT_HIGH};
+        });
+        saveCurrentConfigToFile();
+        return true;
+    }
+    fileStream.close();
+    Logger::info("Read config from file: " + filePath);
+    if (!loadFromFile()) {
+        return false;
+    }
+
+    std::shared_ptr<const ConfigSnapshot> read = snapshot();
+    const ConfigSnapshot &config = *read;
+    Logger::debug("Cal. Offset: " + std::to_string(config.cal.calOffset));
+    Logger::debug("Cal. Ref: " + std::to_string(config.cal.calRef));
     std::stringstream ss;
-    for (size_t i = 0; i < order.size(); ++i) {
-        ss << WP_TYPE_TO_STRING(order[i]);
-        if (i < order.size() - 1) {
+    for (size_t i = 0; i < config.order.size(); ++i) {
+        ss << WP_TYPE_TO_STRING(config.order[i]);
+        if (i < config.order.size() - 1) {
             ss << " -> ";
         }
     }
     Logger::info("Configured workpiece order: " + ss.str());
+    return true;
+}
 
-    return readResult;
+bool Configuration::reloadConfigFromFile() {
+    uint64_t before = getVersion();
+    if (!loadFromFile()) {
+        Logger::warn("Keeping the current configuration (version " +
+                     std::to_string(before) + ")");
+        return false;
+    }
+    uint64_t after = getVersion();
+    if (after != before) {
+        Logger::info("Config file reloaded -> version " + std::to_string(after));
+    }
+    return true;
 }
 
-void Configuration::setMaster(bool isMaster) { this->isMaster = isMaster; }
+bool Configuration::loadFromFile() {
+    std::lock_guard<std::mutex> lock(writeMtx);
+    std::ifstream fileStream(configFilePath);
+    if (!fileStream.is_open()) {
+        Logger::error("Error opening config file: " + configFilePath);
+        return false;
+    }
+    ConfigSnapshot next = *snapshot();
+    std::vector<std::string> errors;
+    if (!parseConfig(fileStream, next, errors)) {
+        Logger::error("Config file contains errors. Please fix them:");
+        for (const auto &msg : errors) {
+            Logger::error("- " + msg);
+        }
+        return false;
+    }
+    publish(next);
+    return true;
+}
 
-bool Configuration::systemIsMaster() { return isMaster; }
+void Configuration::setMaster(bool isMaster) {
+    update([=](ConfigSnapshot &config) { config.isMaster = isMaster; });
+}
+
+bool Configuration::systemIsMaster() { return snapshot()->isMaster; }
 
 void Configuration::setPusherMounted(bool pusherIsMounted) {
-    this->hasPusher = pusherIsMounted;
+    update([=](ConfigSnapshot &config) { config.hasPusher = pusherIsMounted; });
 }
 
-bool Configuration::pusherMounted() { return hasPusher; }
+bool Configuration::pusherMounted() { return snapshot()->hasPusher; }
+
+std::map<std::string, ThreadPolicy> Configuration::getThreadPolicies() {
+    return snapshot()->threads;
+}
 
 void Configuration::setDesiredWorkpieceOrder(std::vector<WorkpieceType> order) {
-    this->order = order;
+    update([&](ConfigSnapshot &config) { config.order = order; });
 }
 
-std::vector<WorkpieceType> Configuration::getDesiredOrder() { return order; }
+std::vector<WorkpieceType> Configuration::getDesiredOrder() {
+    return snapshot()->order;
+}
 
-void Configuration::setOffsetCalibration(int offset) { cal.calOffset = offset; }
+void Configuration::setOffsetCalibration(int offset) {
+    update([=](ConfigSnapshot &config) { config.cal.calOffset = offset; });
+}
 
 void Configuration::setReferenceCalibration(int refHigh) {
-    cal.calRef = refHigh;
+    update([=](ConfigSnapshot &config) { config.cal.calRef = refHigh; });
 }
 
-Calibration Configuration::getCalibration() { return cal; }
+Calibration Configuration::getCalibration() { return snapshot()->cal; }
 
 void Configuration::saveCurrentConfigToFile() {
-    std::stringstream ss;
-    for (size_t i = 0; i < order.size(); ++i) {
-        if (order[i] == WorkpieceType::WS_F) {
-            ss << "F";
-        } else if (order[i] == WorkpieceType::WS_BOM) {
-            ss << "BOM";
-        } else if (order[i] == WorkpieceType::WS_BUM) {
-            ss << "BUM";
-        } else if (order[i] == WorkpieceType::WS_OB) {
-            ss << "OB";
-        }
-
-        if (i < order.size() - 1) {
-            ss << ",";
-        }
-    }
-    const std::string &order = "ORDER=" + ss.str();
-    const std::string &offset = "CAL_OFFSET=" + std::to_string(cal.calOffset);
-    const std::string &ref = "CAL_REF=" + std::to_string(cal.calRef);
-
-    std::ofstream outputFile(configFilePath);
-    if (!outputFile) {
-        Logger::error("Error opening config file for writing");
+    std::string filePath = getConfigFilePath();
+    std::lock_guard<std::mutex> lock(fileMtx);
+    // Latest snapshot at the time of writing, no lost update of a concurrent
+    // calibration
+    if (!writeFileAtomically(filePath, formatConfig(*snapshot()))) {
+        Logger::error("Error writing config file");
         return;
     }
 
-    outputFile << order << std::endl;
-    outputFile << offset << std::endl;
-    outputFile << ref << std::endl;
-    outputFile.close();
-
     Logger::info("Config file was saved");
 }
 
 bool Configuration::calibrationValid() {
+	Calibration cal = getCalibration();
 	if(cal.calOffset == ADC_DEFAULT_OFFSET && cal.calRef == ADC_DEFAULT_HIGH)
 		return false;
 	if(cal.calOffset > 4000 || cal.calOffset < 3000)
@@ -183,50 +332,3 @@ bool Configuration::calibrationValid() {
 		return false;
 	return true;
 }
-
-void Configuration::writeLineToConfigFile(int lineNumber,
-                                          const std::string &newContent) {
-    std::ifstream inputFile(configFilePath);
-    if (!inputFile) {
-        Logger::error("Error opening config file.");
-        return;
-    }
-
-    const std::string &tempFilePath = configFilePath + ".tmp";
-
-    std::ofstream tempFile(tempFilePath);
-    if (!tempFile) {
-        Logger::error("Error opening temporary file.");
-        inputFile.close();
-        return;
-    }
-
-    std::string line;
-    int currentLine = 1;
-    while (std::getline(inputFile, line)) {
-        if (currentLine == lineNumber) {
-            tempFile << newContent << std::endl;
-        } else {
-            tempFile << line << std::endl;
-        }
-        currentLine++;
-    }
-
-    inputFile.close();
-    tempFile.close();
-
-    if (std::remove(configFilePath.c_str()) != 0) {
-        Logger::error("Error deleting input file.");
-        return;
-    }
-
-    if (std::rename(tempFilePath.c_str(), configFilePath.c_str()) != 0) {
-        Logger::error("Error renaming temporary file: " + tempFilePath +
-                      " -> " + configFilePath);
-        perror("Error renaming file");
-        return;
-    }
-
-    Logger::info("Updated line " + std::to_string(lineNumber) +
-                 " in config file -> " + newContent);
-}
@@ -6,21 +6,56 @@
  */
 #pragma once
 
+#include "common/ThreadRegistry.h"
 #include "data/Workpiece.h"
+#include <atomic>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 
 #define DEFAULT_CONFIG_FILE_PATH "/tmp/esep_2.1/esep_conf.txt"
-#define LINENUM_ORDER            1
-#define LINENUM_OFFSET           2
-#define LINENUM_REF              3
 
 struct Calibration {
     int calOffset;
     int calRef;
 };
 
+/**
+ * Immutable state of the Configuration. Every change publishes a new snapshot
+ * with the next version.
+ */
+struct ConfigSnapshot {
+    uint64_t version;
+    std::vector<WorkpieceType> order;
+    Calibration cal;
+    bool isMaster;
+    bool hasPusher;
+    std::map<std::string, ThreadPolicy> threads;   // overrides of the ThreadRegistry
+
+    /**
+     * @return true if the values (not the version) are equal
+     */
+    bool sameValues(const ConfigSnapshot &other) const {
+        return order == other.order && cal.calOffset == other.cal.calOffset
+               && cal.calRef == other.cal.calRef && isMaster == other.isMaster
+               && hasPusher == other.hasPusher && threads == other.threads;
+    }
+};
+
+/**
+ * Configuration shared by all threads (RCU-style).
+ *
+ * Readers get the current ConfigSnapshot by one atomic load of a shared
+ * pointer, they never wait for a writer. Writers copy the current snapshot,
+ * change the copy and publish it. A snapshot is freed when the last reader
+ * holding it releases its pointer. Changes are rare (calibration, reload) and
+ * unchanged values publish nothing.
+ */
 class Configuration {
   public:
     static Configuration &getInstance() {
@@ -28,21 +63,46 @@ class Configuration {
         return instance;
     }
     void setConfigFilePath(std::string filePath);
+    std::string getConfigFilePath();
+
+    /**
+     * @return the current snapshot, stays valid while the pointer is held
+     */
+    std::shared_ptr<const ConfigSnapshot> snapshot() {
+        return std::atomic_load_explicit(&current, std::memory_order_acquire);
+    }
+
+    /**
+     * @return version of the current snapshot
+     */
+    uint64_t getVersion() { return snapshot()->version; }
 
     /**
      * Reads the configuration from the set config file path (or default path).
-     * If the file does not exist, a new one will be created with default
-     * values.
+     * If the file does not exist, the default values are published and a new
+     * file is created with them.
      *
      * Structure of the file:
      * 1 | ORDER=[Desired Workpiece Order]
      * 2 | CAL_OFFSET=[Calibrated ADC offset value for HeightSensor]
      * 3 | CAL_REF=[Calibrated ADC reference value (@ 25.0 mm) for HeightSensor]
+     * optional, one line per thread:
+     * THREAD=[thread name]:[other|fifo|rr]:[priority][:CPU]
      *
      * @return true if reading the file was successful.
      */
     bool readConfigFromFile();
 
+    /**
+     * Reads the config file again (hot reload, see ConfigWatcher). ORDER and
+     * calibration are taken from the file, the values given on the command
+     * line are kept. If the file contains errors, the current configuration
+     * stays active.
+     *
+     * @return true if the file was valid
+     */
+    bool reloadConfigFromFile();
+
     /**
      * Sets the type of the system the Configuration is running on.
      *
@@ -109,21 +169,37 @@ class Configuration {
     void setReferenceCalibration(int refHigh);
 
     /**
-     * Saves all currently stored configuration values to config file.
+     * Saves all currently stored configuration values to config file. The
+     * file is written to a temporary file first and renamed atomically, so it
+     * is either complete or unchanged after a crash.
      */
     void saveCurrentConfigToFile();
 
     bool calibrationValid();
 
+    /**
+     * Gets the scheduling of the threads set in the config file, the
+     * ThreadRegistry uses its defaults for all others.
+     *
+     * @return thread name -> policy
+     */
+    std::map<std::string, ThreadPolicy> getThreadPolicies();
+
   private:
     Configuration();
     virtual ~Configuration();
     Configuration(const Configuration &) = delete;
     Configuration &operator=(const Configuration &) = delete;
+    std::shared_ptr<const ConfigSnapshot> current;   // accessed atomically only
+    std::mutex writeMtx;   // serializes the writers
+    std::mutex fileMtx;    // serializes writing the file
     std::string configFilePath;
-    std::vector<WorkpieceType> order;
-    bool isMaster{true};
-    bool hasPusher{false};
-    Calibration cal;
-    void writeLineToConfigFile(int lineNumber, const std::string &newContent);
+
+    template <typename Change> void update(Change change);
+    void publish(const ConfigSnapshot &next);
+    bool loadFromFile();
+    static bool parseConfig(std::istream &in, ConfigSnapshot &config,
+                            std::vector<std::string> &errors);
+    static std::string formatConfig(const ConfigSnapshot &config);
+    static bool writeFileAtomically(const std::string &path, const std::string &content);
 };
@@ -17,6 +17,7 @@ class Options {
   public:
     Mode mode;
     bool pusher;
+    std::string traceFile;   // empty: no tracing
 
     Options(int argc, char **argv) {
         cxxopts::Options options("sorting-machine", "ESEP Sorting Machine");
@@ -24,7 +25,10 @@ class Options {
         options.add_options()("mode", "Mode the system should be started as",
                               cxxopts::value<std::string>())(
             "p,pusher", "Pusher is mounted for sorting out workpieces "
-                        "(Default: switch is used)")
+                        "(Default: switch is used)")(
+            "t,trace", "Record latency traces and write them to the file at exit "
+                       "(Chrome trace format)",
+            cxxopts::value<std::string>())
 
             ("h,help", "Get help for usage");
         ;
@@ -52,5 +56,8 @@ class Options {
         }
 
         pusher = result["pusher"].as<bool>();
+        if (result.count("trace")) {
+            traceFile = result["trace"].as<std::string>();
+        }
     }
 };
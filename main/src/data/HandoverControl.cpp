@@ -0,0 +1,94 @@
+/*
+ * HandoverControl.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "HandoverControl.h"
+#include "logger/logger.hpp"
+
+HandoverControl::HandoverControl(WorkpieceManager *wpManager)
+    : wpManager(wpManager), maxWorkpieces(HANDOVER_MAX_WP_FBM2),
+      minGapMs(HANDOVER_MIN_GAP_MS), beltMoving(false) {
+    reset();
+}
+
+HandoverControl::~HandoverControl() {}
+
+bool HandoverControl::mayAdmit() {
+    int nFBM2 = wpManager->getNumberOfWorkpiecesFBM2();
+    if (nFBM2 == 0) {
+        return true;
+    }
+    if (nFBM2 >= maxWorkpieces) {
+        Logger::debug("[Handover] FBM2 full (" + std::to_string(nFBM2) +
+                      " workpieces)");
+        return false;
+    }
+    // Previous workpiece must have completely entered FBM2
+    if (wpManager->getFirstOnFBM2Before(PositionFBM2::BELT) != nullptr) {
+        Logger::debug("[Handover] Previous workpiece still at start of FBM2");
+        return false;
+    }
+    if (remainingGapMs() > 0) {
+        Logger::debug("[Handover] Minimum gap not reached yet");
+        return false;
+    }
+    return true;
+}
+
+void HandoverControl::workpieceEntered() {
+    gapActive = true;
+    movedMs = 0;
+    movingSince = Clock::getInstance().now();
+}
+
+int HandoverControl::remainingGapMs() {
+    if (!gapActive) {
+        return 0;
+    }
+    int64_t moved = movedMs;
+    if (beltMoving) {
+        moved += Clock::getInstance().millisSince(movingSince);
+    }
+    return moved >= minGapMs ? 0 : minGapMs - (int) moved;
+}
+
+void HandoverControl::setBeltMoving(bool moving) {
+    if (moving == beltMoving) {
+        return;
+    }
+    Clock &clock = Clock::getInstance();
+    if (beltMoving) {
+        movedMs += clock.millisSince(movingSince);
+    }
+    movingSince = clock.now();
+    beltMoving = moving;
+}
+
+bool HandoverControl::isBeltMoving() { return beltMoving; }
+
+void HandoverControl::setWaiting(bool waiting) { this->waiting = waiting; }
+
+bool HandoverControl::isWaiting() { return waiting; }
+
+void HandoverControl::setMaxWorkpieces(int maxWorkpieces) {
+    this->maxWorkpieces = maxWorkpieces;
+}
+
+void HandoverControl::setMinGapMs(int minGapMs) { this->minGapMs = minGapMs; }
+
+int HandoverControl::getPipelinedCount() { return nPipelined; }
+
+void HandoverControl::countAdmitted() {
+    if (wpManager->getNumberOfWorkpiecesFBM2() > 0) {
+        nPipelined++;
+    }
+}
+
+void HandoverControl::reset() {
+    waiting = false;
+    nPipelined = 0;
+    gapActive = false;
+    movedMs = 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * HandoverControl.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "WorkpieceManager.h"
+#include "common/Clock.h"
+
+// Maximum number of workpieces which may be on FBM2 at the same time
+#define HANDOVER_MAX_WP_FBM2 3
+// Minimum time FBM2 has to move between a workpiece leaving the start of FBM2
+// and the next workpiece being admitted (~22 mm at 75 mm/s)
+#define HANDOVER_MIN_GAP_MS 300
+
+/**
+ * Admission control for the handover of workpieces from FBM1 to FBM2.
+ *
+ * Instead of waiting until FBM2 is empty, the next workpiece at the end of
+ * FBM1 is admitted as soon as the previous one has completely entered FBM2
+ * and a minimum gap to it is guaranteed. The positions of the workpieces on
+ * FBM2 are tracked by the WorkpieceManager (see PositionFBM2).
+ *
+ * The gap is measured as time FBM2 was moving, so it stands for a distance
+ * on the belt. Only used by the thread of the MainFSM.
+ */
+class HandoverControl {
+  public:
+    HandoverControl(WorkpieceManager *wpManager);
+    virtual ~HandoverControl();
+
+    /**
+     * Checks if the next workpiece at the end of FBM1 may be passed to FBM2.
+     *
+     * @return true if a safe gap to the workpieces on FBM2 is guaranteed
+     */
+    bool mayAdmit();
+
+    /**
+     * Must be called when a workpiece has completely entered FBM2 (start light
+     * barrier of FBM2 unblocked). Starts the minimum gap.
+     */
+    void workpieceEntered();
+
+    /**
+     * Gets the remaining time FBM2 has to move until the minimum gap to the
+     * last workpiece which entered FBM2 is reached.
+     *
+     * @return remaining time in ms, 0 if gap is already reached
+     */
+    int remainingGapMs();
+
+    /**
+     * Must be called when the motor of FBM2 starts or stops (commands of the
+     * MotorFSM of FBM2). The gap only elapses while FBM2 is moving.
+     */
+    void setBeltMoving(bool moving);
+    bool isBeltMoving();
+
+    /**
+     * Sets if FBM1 was stopped, because a workpiece at the end of FBM1 waits
+     * for admission to FBM2.
+     */
+    void setWaiting(bool waiting);
+    bool isWaiting();
+
+    void setMaxWorkpieces(int maxWorkpieces);
+    void setMinGapMs(int minGapMs);
+
+    /**
+     * Number of workpieces admitted to FBM2 while FBM2 was not empty.
+     */
+    int getPipelinedCount();
+    void countAdmitted();
+
+    /**
+     * Forgets the waiting workpiece and the gap (e.g. after the workpieces
+     * were reset). The state of the motor is kept.
+     */
+    void reset();
+
+  private:
+    WorkpieceManager *wpManager;
+    int maxWorkpieces;
+    int minGapMs;
+    bool waiting;
+    int nPipelined;
+    bool gapActive;          // a workpiece entered FBM2, gap not checked yet
+    int64_t movedMs;         // FBM2 moving since entered, until movingSince
+    bool beltMoving;
+    Clock::time_point movingSince;
+};
@@ -12,6 +12,20 @@
 
 #define WP_TYPE_TO_STRING(wp) std::string(WorkpieceTypeString[wp])
 
+/**
+ * Position of a workpiece on FBM2, updated by the light barriers and sensors
+ * of FBM2. Used to assign sensor events to the right workpiece if more than
+ * one workpiece is on FBM2 at the same time.
+ */
+enum class PositionFBM2 {
+    NONE,       // not on FBM2 yet
+    TRANSFER,   // left end of FBM1, not yet arrived at start of FBM2
+    START,      // blocking the start light barrier of FBM2
+    BELT,       // completely on FBM2, waiting for height measurement
+    MEASURED,   // height was measured at FBM2
+    SWITCH      // passed the switch of FBM2
+};
+
 struct Workpiece {
     /**
      * Workpiece ID
@@ -61,4 +75,9 @@ struct Workpiece {
      * @return Workpiece Type (TYPE_A, TYPE_B, TYPE_C or UNKNOWN (default))
      */
     WorkpieceType S_type{WorkpieceType::WS_UNKNOWN};
+
+    /**
+     * Current position of the workpiece on FBM2
+     */
+    PositionFBM2 posFBM2{PositionFBM2::NONE};
 };
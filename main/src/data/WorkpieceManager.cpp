@@ -12,7 +12,16 @@
 WorkpieceManager::WorkpieceManager() : nextId(1) {
 	ramp_one_B = false;
 	ramp_two_B = false;
-	auto confOrder = Configuration::getInstance().getDesiredOrder();
+	const char *areaNames[] = {"A", "B", "C", "D"};
+	for (int i = 0; i < 4; i++) {
+		occupancy[i] = &MetricsRegistry::getInstance().gauge(
+			std::string("esep_workpieces{area=\"") + areaNames[i] + "\"}");
+	}
+	loadDesiredOrder();
+}
+
+void WorkpieceManager::loadDesiredOrder() {
+	const auto &confOrder = Configuration::getInstance().getDesiredOrder();
 	for (int i = 0; i < 3; i++) {
 		desiredOrder[i] = confOrder.at(i);
 	}
@@ -67,18 +76,19 @@ Workpiece *WorkpieceManager::addWorkpiece() {
 void WorkpieceManager::addToArea(AreaType area, Workpiece *wp) {
     switch (area) {
     case AreaType::AREA_A:
-        Area_A.push(wp);
+        Area_A.push_back(wp);
         break;
     case AreaType::AREA_B:
-        Area_B.push(wp);
+        Area_B.push_back(wp);
         break;
     case AreaType::AREA_C:
-        Area_C.push(wp);
+        Area_C.push_back(wp);
         break;
     case AreaType::AREA_D:
-        Area_D.push(wp);
+        Area_D.push_back(wp);
         break;
     }
+    updateOccupancy(area);
 }
 
 void WorkpieceManager::moveFromAreaToArea(AreaType source,
@@ -90,25 +100,91 @@ void WorkpieceManager::moveFromAreaToArea(AreaType source,
 }
 
 Workpiece *WorkpieceManager::removeFromArea(AreaType area) {
-    std::queue<Workpiece *> &targetArea = getArea(area);
+    std::deque<Workpiece *> &targetArea = getArea(area);
     if (!targetArea.empty()) {
         Workpiece *wp = targetArea.front();
-        targetArea.pop();
+        targetArea.pop_front();
+        updateOccupancy(area);
         return wp;
     }
     return nullptr;
 }
 
+Workpiece *WorkpieceManager::removeFromArea(AreaType area, Workpiece *wp) {
+    std::deque<Workpiece *> &targetArea = getArea(area);
+    for (auto it = targetArea.begin(); it != targetArea.end(); ++it) {
+        if (*it == wp) {
+            targetArea.erase(it);
+            updateOccupancy(area);
+            return wp;
+        }
+    }
+    return nullptr;
+}
+
 Workpiece *WorkpieceManager::getHeadOfArea(AreaType area) {
-    std::queue<Workpiece *> &targetArea = getArea(area);
+    std::deque<Workpiece *> &targetArea = getArea(area);
     if (!targetArea.empty()) {
         return targetArea.front();
     }
     return nullptr;
 }
 
+Workpiece *WorkpieceManager::getTailOfArea(AreaType area) {
+    std::deque<Workpiece *> &targetArea = getArea(area);
+    if (!targetArea.empty()) {
+        return targetArea.back();
+    }
+    return nullptr;
+}
+
+Workpiece *WorkpieceManager::getFirstOnFBM2Before(PositionFBM2 position) {
+    // Workpieces keep their order on the belt, so the first match is the one
+    // closest to the next sensor
+    for (Workpiece *wp : Area_D) {
+        if (wp->posFBM2 < position) {
+            return wp;
+        }
+    }
+    return nullptr;
+}
+
+Workpiece *WorkpieceManager::getFirstOnFBM2At(PositionFBM2 position) {
+    for (Workpiece *wp : Area_D) {
+        if (wp->posFBM2 == position) {
+            return wp;
+        }
+    }
+    return nullptr;
+}
+
+int WorkpieceManager::getNumberOfWorkpiecesFBM2() { return Area_D.size(); }
+
+int WorkpieceManager::getNumberOfWorkpieces(AreaType area) { return getArea(area).size(); }
+
+Workpiece *WorkpieceManager::getFirstOnFBM2(bool sortOut) {
+    for (Workpiece *wp : Area_D) {
+        if (wp->sortOut == sortOut) {
+            return wp;
+        }
+    }
+    return nullptr;
+}
+
+Workpiece *WorkpieceManager::getNextLeavingFBM2(bool sortOut) {
+    for (Workpiece *wp : Area_D) {
+        if (wp->posFBM2 == PositionFBM2::SWITCH && wp->sortOut == sortOut) {
+            return wp;
+        }
+    }
+    return nullptr;
+}
+
 void WorkpieceManager::setHeight(AreaType area, double height) {
-    Workpiece *wp = getHeadOfArea(area);
+    setHeight(getHeadOfArea(area), area, height);
+}
+
+void WorkpieceManager::setHeight(Workpiece *wp, AreaType area, double height) {
     if (wp != nullptr) {
     	if(area == AreaType::AREA_D) {
     		wp->avgHeightFBM2 = height;
@@ -119,6 +195,11 @@ void WorkpieceManager::setHeight(AreaType area, double height) {
 }
 
 void WorkpieceManager::setTypeEvent(EventType event, AreaType area) {
+    setTypeEvent(event, getHeadOfArea(area), area);
+}
+
+void WorkpieceManager::setTypeEvent(EventType event, Workpiece *wp,
+                                    AreaType area) {
     WorkpieceType tmp = WorkpieceType::WS_UNKNOWN;
     if (event == EventType::HM_M_WS_F || event == EventType::HM_S_WS_F) {
         tmp = WorkpieceType::WS_F;
@@ -130,7 +211,6 @@ void WorkpieceManager::setTypeEvent(EventType event, AreaType area) {
         tmp = WorkpieceType::WS_UNKNOWN;
     }
 
-    Workpiece *wp = getHeadOfArea(area);
     if (wp != nullptr) {
         if (area == AreaType::AREA_D) {
             wp->S_type = tmp;
@@ -229,7 +309,7 @@ std::string WorkpieceManager::to_string_Workpiece_FBM2(Workpiece *wp) {
 	return ss.str();
 }
 
-std::queue<Workpiece *> &WorkpieceManager::getArea(AreaType area) {
+std::deque<Workpiece *> &WorkpieceManager::getArea(AreaType area) {
     switch (area) {
     case AreaType::AREA_A:
         return Area_A;
@@ -244,11 +324,20 @@ std::queue<Workpiece *> &WorkpieceManager::getArea(AreaType area) {
     }
 }
 
+void WorkpieceManager::updateOccupancy(AreaType area) {
+    occupancy[(int) area]->set(getArea(area).size());
+}
+
 void WorkpieceManager::reset_wpm(){
-	std::queue<Workpiece*>().swap(Area_A);
-	std::queue<Workpiece*>().swap(Area_B);
-	std::queue<Workpiece*>().swap(Area_C);
-	std::queue<Workpiece*>().swap(Area_D);
+	std::deque<Workpiece*>().swap(Area_A);
+	std::deque<Workpiece*>().swap(Area_B);
+	std::deque<Workpiece*>().swap(Area_C);
+	std::deque<Workpiece*>().swap(Area_D);
+	for (Gauge *gauge : occupancy) {
+		gauge->set(0);
+	}
 	nextId = 1;
+	// order of a reloaded config file takes effect
+	loadDesiredOrder();
 	Logger::info("Workpieces were resetted - start sorting from the beginning");
 }
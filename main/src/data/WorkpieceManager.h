@@ -10,8 +10,10 @@
 
 #include "Workpiece.h"
 #include "events/events.h"
+#include "metrics/Metrics.h"
+#include <array>
 #include <iostream>
-#include <queue>
+#include <deque>
 #include <string>
 
 
@@ -38,12 +40,51 @@ class WorkpieceManager {
     void addToArea(AreaType area, Workpiece *wp);
     void moveFromAreaToArea(AreaType sourceArea, AreaType destinationArea);
     Workpiece *removeFromArea(AreaType area);
+    Workpiece *removeFromArea(AreaType area, Workpiece *wp);
     Workpiece *getHeadOfArea(AreaType area);
+    Workpiece *getTailOfArea(AreaType area);
+
+    /**
+     * Gets the first workpiece on FBM2 which has not reached the given
+     * position yet.
+     *
+     * @param position Position the workpiece must not have reached
+     * @return the workpiece or nullptr if there is none
+     */
+    Workpiece *getFirstOnFBM2Before(PositionFBM2 position);
+
+    /**
+     * Gets the first workpiece on FBM2 which is at the given position.
+     *
+     * @param position Position of the workpiece
+     * @return the workpiece or nullptr if there is none
+     */
+    Workpiece *getFirstOnFBM2At(PositionFBM2 position);
+    int getNumberOfWorkpiecesFBM2();
+    int getNumberOfWorkpieces(AreaType area);
+
+    /**
+     * Gets the oldest workpiece on FBM2 which leaves it at the given exit.
+     *
+     * @param sortOut true: workpiece leaving to the ramp, false: to the end
+     * @return the workpiece or nullptr if there is none
+     */
+    Workpiece *getFirstOnFBM2(bool sortOut);
+
+    /**
+     * Gets the next workpiece which will leave FBM2 after passing the switch.
+     *
+     * @param sortOut true: workpiece leaving to the ramp, false: to the end
+     * @return the workpiece or nullptr if there is none
+     */
+    Workpiece *getNextLeavingFBM2(bool sortOut);
 
     void setHeight(AreaType area, double height);
+    void setHeight(Workpiece *wp, AreaType area, double height);
     void setMetal(AreaType area);
     void setType(AreaType area, WorkpieceType type);
     void setTypeEvent(EventType event, AreaType area);
+    void setTypeEvent(EventType event, Workpiece *wp, AreaType area);
     void setSortOut(AreaType area, bool sortOut);
     void setFlipped(AreaType area);
     void setRamp_one(bool input);
@@ -66,15 +107,18 @@ class WorkpieceManager {
   private:
     int nextId;
     WorkpieceType desiredOrder[3];
-    std::queue<Workpiece*> Area_A;
-    std::queue<Workpiece*> Area_B;
-    std::queue<Workpiece*> Area_C;
-    std::queue<Workpiece*> Area_D;
+    void loadDesiredOrder();
+    std::deque<Workpiece*> Area_A;
+    std::deque<Workpiece*> Area_B;
+    std::deque<Workpiece*> Area_C;
+    std::deque<Workpiece*> Area_D;
     bool ramp_one_B;
     bool ramp_two_B;
+    std::array<Gauge *, 4> occupancy;   // workpieces by area
 
+    void updateOccupancy(AreaType area);
     Workpiece *getQueue(AreaType area);
-    std::queue<Workpiece *> &getArea(AreaType area);
+    std::deque<Workpiece *> &getArea(AreaType area);
 };
 
 #endif /* WORKPIECEMANAGER_H_ */
@@ -6,10 +6,16 @@
  */
 
 #include "EventManager.h"
+#include "common/Quiescence.h"
+#include "common/Startup.h"
+#include "common/ThreadRegistry.h"
+#include "common/Trace.h"
+#include "common/macros.h"
 #include "configuration/Configuration.h"
 #include "events.h"
 #include "logger/logger.hpp"
 
+#include <algorithm>
 #include <errno.h>
 #include <iostream>
 #include <watchdog/Watchdog.h>
@@ -22,7 +28,17 @@
 #define STR_MSG (_IO_MAX + 1)
 #define DATA_MSG (_IO_MAX + 2)
 
-EventManager::EventManager() : internal_chid(-1), internal_coid(-1), server_coid(-1) {
+EventManager::EventManager()
+    : internal_chid(-1), internal_coid(-1), server_coid(-1), liveness(WD_SEND_INTERVAL_MILLIS),
+      linkRecovery(*this, std::bind(&EventManager::linkReestablished, this)),
+      queueDepth(MetricsRegistry::getInstance().gauge("esep_event_queue_depth")),
+      dispatchLatency(MetricsRegistry::getInstance().histogram(
+          std::string("esep_event_dispatch_latency_us{system=\"")
+          + (Configuration::getInstance().systemIsMaster() ? "master" : "slave") + "\"}")) {
+    for (size_t type = 0; type < EVENT_TYPE_COUNT; type++) {
+        eventCounters.push_back(&MetricsRegistry::getInstance().counter(
+            "esep_events_total{type=\"" + EVENT_TO_STRING(type) + "\"}"));
+    }
     isMaster = Configuration::getInstance().systemIsMaster();
     rcvInternalRunning = false;
     rcvExternalRunning = false;
@@ -35,6 +51,9 @@ EventManager::EventManager() : internal_chid(-1), internal_coid(-1), server_coid
 		otherServiceName = ATTACH_POINT_LOCAL_M;
     }
     attachedService = nullptr;
+    // Clients may connect before start(), e.g. while start() waits for the
+    // partner system
+    openInternalChannel();
 }
 
 
@@ -63,16 +82,15 @@ void EventManager::openInternalChannel() {
 }
 
 void EventManager::sendToSelf(Event event) {
-    int res = MsgSendPulse(internal_coid, -1, (int) event.type, event.data);
+    Quiescence::getInstance().begin();
+    int res = MsgSendPulse(internal_coid, pulsePriorityOf(event.type), (int) event.type, event.data);
     if (res < 0) {
+        Quiescence::getInstance().end();
         Logger::error("Failed to send pulse message to self");
     }
 }
 
 int EventManager::connectInternalClient() {
-    if (internal_chid == -1) {
-        openInternalChannel();
-    }
     int coid = ConnectAttach(0, 0, internal_chid, _NTO_SIDE_CHANNEL, 0);
     if (coid == -1) {
         Logger::error("ConnectAttach failed");
@@ -81,7 +99,6 @@ int EventManager::connectInternalClient() {
 }
 
 void EventManager::rcvInternalEventsThread() {
-    openInternalChannel();
     rcvInternalRunning = true;
     Logger::debug("[EventManager] Ready to receive internal events");
     while (rcvInternalRunning) {
@@ -96,41 +113,68 @@ void EventManager::rcvInternalEventsThread() {
             continue;
         }
         Event ev{(EventType) pulse.code, pulse.value.sival_int};
-        if((isMaster && ev.type == EventType::WD_S_HEARTBEAT)
-        || (!isMaster && ev.type == EventType::WD_M_HEARTBEAT)){
-        	Logger::debug("attempted rebound msg");
-        	continue; }
-        handleEvent(ev);
-        if(ev.type == EventType::WD_CONN_LOST){ disconnected = true; }
-        if(ev.type == EventType::WD_CONN_REESTABLISHED){ disconnected = false; }
-        if(disconnected){ continue;  }
-
-        sendExternalEvent(ev);
+        ev.traceId = Tracer::getInstance().take(ev.type);
+        // Dispatched by the dispatcher thread, ordered by priority
+        eventQueue.push(ev);
     }
     Logger::debug("[EventManager] Stopped receiving internal events");
 }
 
+void EventManager::dispatchEventsThread() {
+    Logger::debug("[EventManager] Ready to dispatch events");
+    QueuedEvent next;
+    Quiescence &quiescence = Quiescence::getInstance();
+    while (eventQueue.pop(next)) {
+        queueDepth.set(eventQueue.size());
+        dispatchEvent(next);
+        dispatchLatency.record(std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now() - next.enqueued).count());
+        if (!next.external || quiescence.isLinkCounted()) {
+            quiescence.end();   // counted by the sender
+        }
+    }
+    Logger::debug("[EventManager] Stopped dispatching events");
+}
+
+void EventManager::dispatchEvent(const QueuedEvent &queued) {
+    const Event &ev = queued.event;
+    TraceScope scope(ev.traceId);
+    TraceSpan span("EventManager::dispatch", ev.type);
+    if ((size_t) ev.type < eventCounters.size()) {
+        eventCounters[ev.type]->inc();
+    }
+    handleEvent(ev);
+    if (queued.external || ev.type == SYNC_START || ev.type == SYNC_DIGEST
+        || ev.type == HANDOVER_GAP_ELAPSED) {
+        return;
+    }
+    if(ev.type == EventType::WD_CONN_LOST){ disconnected = true; }
+    if(ev.type == EventType::WD_CONN_REESTABLISHED){
+        // Each system reports its own reconnect, after its resync
+        disconnected = false;
+        return;
+    }
+    if(disconnected){ return; }
+
+    sendExternalEvent(ev);
+}
+
 void EventManager::rcvExternalEventsThread() {
     Logger::debug("[EventManager] Ready to receive external events");
     rcvExternalRunning = true;
     while (rcvExternalRunning) {
-    	if(disconnected){
-    		return;
-    	}
+        // Keeps receiving while disconnected, the partner reconnects to our
+        // service
         // Waiting for a message and read first header
         header_t header;
         int rcvid = MsgReceive(attachedService->chid, &header, sizeof (header_t), NULL);
-        if (rcvid == -1) { // Error occurred
-            Logger::error("[EventManager] MsgReceive @GNS failed");
+        if (rcvid == -1) { // Error occurred or service stopped
+            if (rcvExternalRunning) {
+                Logger::error("[EventManager] MsgReceive @GNS failed");
+            }
             break;
         }
         if (rcvid == 0) {// Pulse was received
-        	//cheat to avoid disconnect
-        	if(isMaster){
-        	handleEvent(Event{WD_S_HEARTBEAT});
-        	}else{
-        		handleEvent(Event{WD_M_HEARTBEAT});
-        	}
         	handle_pulse(header, rcvid);
             continue;
         }
@@ -174,7 +218,15 @@ void EventManager::handle_pulse(header_t hdr, int rcvid){
     	Event ev;
         ev.type = (EventType) hdr.code;
         ev.data = hdr.value.sival_int;
-        handleEvent(ev);
+    	bool heartbeat = ev.type == WD_M_HEARTBEAT || ev.type == WD_S_HEARTBEAT;
+    	// Any event of the partner proves that it is alive
+    	liveness.received(heartbeat);
+    	if (!heartbeat) {
+    	    // Heartbeats are only for the watchdog, they are not dispatched
+    	    eventQueue.push(ev, true);
+    	} else if (Quiescence::getInstance().isLinkCounted()) {
+    	    Quiescence::getInstance().end();
+    	}
     	}
         break;
     }
@@ -185,6 +237,12 @@ void EventManager::handle_ONX_IO_msg(header_t hdr, int rcvid){
         // QNX IO msg _IO_CONNECT was received; answer with EOK
     	Logger::debug("Server received _IO_CONNECT (sync. msg)");
         MsgReply( rcvid, EOK, NULL, 0 );
+        // The partner is started, its service exists
+        {
+            std::lock_guard<std::mutex> lock(partnerMtx);
+            partnerSeen = true;
+        }
+        partnerCv.notify_all();
     } else {
     	// Some other QNX IO message was received; reject it
     	Logger::warn("Server received unexpected (sync.) msg type = " + std::to_string(hdr.type));
@@ -212,7 +270,11 @@ void EventManager::handle_app_msg(header_t hdr, int rcvid){
     	Logger::debug(ss.str());
         MsgReply(rcvid, EOK, "OK", 2); // send reply
 
-        handleEvent(ev);
+        bool heartbeat = ev.type == WD_M_HEARTBEAT || ev.type == WD_S_HEARTBEAT;
+        liveness.received(heartbeat);
+        if (!heartbeat) {
+            eventQueue.push(ev, true);
+        }
     } else { // Wrong msg type
     	Logger::warn("Server: Wrong message type: " + std::to_string(hdr.type));
         MsgError(rcvid,EPERM);
@@ -228,22 +290,32 @@ void EventManager::createService() {
 }
 
 void EventManager::stopService() {
+    if (attachedService == nullptr) {
+        return;
+    }
     if (name_detach(attachedService, 0) == -1) {
         Logger::error("[EventManager] Failed detaching Service");
     } else {
 		Logger::info("[EventManager] GNS Service was stopped");
 		externConnected = false;
     }
+    attachedService = nullptr;
 }
 
 void EventManager::connectToService(const std::string& name) {
     Logger::info("[EventManager] Connecting to service: " + name + " ...");
     externConnected = false;
+    int retryMs = CONNECT_RETRY_MIN_MS;
     while(!externConnected) {
         server_coid = name_open(name.c_str(), NAME_FLAG_ATTACH_GLOBAL);
         externConnected = server_coid != -1;
         if(!externConnected) {
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            // Woken up as soon as the partner connects to our service
+            std::unique_lock<std::mutex> lock(partnerMtx);
+            partnerCv.wait_for(lock, std::chrono::milliseconds(retryMs),
+                               [this]() { return partnerSeen; });
+            partnerSeen = false;
+            retryMs = std::min(2 * retryMs, CONNECT_RETRY_MAX_MS);
         }
     }
     externConnected = true;
@@ -252,44 +324,57 @@ void EventManager::connectToService(const std::string& name) {
 }
 
 void EventManager::disconnectFromService() {
+    if (server_coid == -1) {
+        return;
+    }
     if (name_close(server_coid) == -1) {
         Logger::error("[EventManager] Failed detaching from remote Service");
     } else {
 		Logger::info("[EventManager] Disconnected from remote GNS Service");
     }
+    server_coid = -1;
     externConnected = false;
 }
 
 void EventManager::subscribe(EventType type, EventCallback callback) {
-    if (subscribers.find(type) == subscribers.end()) {
-        // If event doesn't exist yet, create a new list and add it to the map
-        subscribers[type] = std::vector<EventCallback>();
-    }
-    subscribers[type].push_back(callback);
+    subscribers.add(type, callback);
+}
+
+SubscriptionId EventManager::subscribe(const EventMask &mask, EventDelegate handler) {
+    return subscribers.add(mask, handler);
+}
+
+SubscriptionId EventManager::subscribe(const EventMask &mask, EventCallback callback) {
+    return subscribers.add(mask, callback);
 }
 
 int EventManager::subscribeToAllEvents(EventCallback callback) {
-    int nEvents = 0;
-    for (int i = static_cast<int>(EventType::START_M_SHORT);
-         i <= static_cast<int>(EventType::WD_CONN_REESTABLISHED); i++) {
-        EventType eventType = static_cast<EventType>(i);
-        subscribe(eventType, callback);
-        nEvents++;
-    }
-    return nEvents;
+    // One callback for all events instead of one copy per EventType
+    EventMask mask = EventMask::range(EventType::START_M_SHORT, EventType::WD_CONN_REESTABLISHED);
+    subscribe(mask, callback);
+    return mask.count();
 }
 
 void EventManager::unsubscribe(EventType type, EventCallback callback) {
 
 }
 
+void EventManager::unsubscribe(SubscriptionId subscription) {
+    subscribers.remove(subscription);
+}
+
 void EventManager::handleEvent(const Event &event) {
-   if(event.type == EventType::WD_M_HEARTBEAT && isMaster){ return; }
-   if(event.type == EventType::WD_S_HEARTBEAT && !isMaster){ return; }
+   if(event.type == EventType::SYNC_START){
+	   linkRecovery.startResync();
+	   return;
+   }
+   if(event.type == EventType::SYNC_DIGEST){
+	   linkRecovery.digestReceived(event.data);
+	   return;
+   }
    if(event.type == EventType::WD_CONN_LOST){
 	   disconnected = true;
-	   rcvExternalRunning = false;
-	   disconnectFromService();
+	   linkRecovery.connectionLost();
    }
 
     std::stringstream ss;
@@ -298,49 +383,81 @@ void EventManager::handleEvent(const Event &event) {
     if (event.data != -1)
         ss << ", data: " << event.data;
 
-    if (subscribers.find(event.type) != subscribers.end()) {
-        //Logger::debug("[EventManager] Notifiying " + std::to_string(subscribers[event.type].size()) + " subscribers about Event " + EVENT_TO_STRING(event.type));
-        int i = 1;
-        for (const auto &callback : subscribers[event.type]) {
-            callback(event);
-        }
-    } else {
+    // Type and mask subscribers in the order they subscribed
+    if (subscribers.notify(event) == 0) {
         ss << " -> No subscribers for Event!";
     }
-
-
-    if(event.type ==EventType::WD_M_HEARTBEAT || event.type== WD_S_HEARTBEAT){
-    	return;
-    }
     Logger::debug(ss.str());
 }
 
 void EventManager::sendExternalEvent(const Event &event) {
-	if(disconnected || server_coid < 0) {
+	if(disconnected) {
 		return;
 	}
-    // TODO: Send event to other system
-    //int res = MsgSendPulse(this->server_coid, -1, (int) event.type, event.data);
+    send(event);
+}
 
+void EventManager::sendHeartbeat() {
+    sendExternalEvent(Event{isMaster ? WD_M_HEARTBEAT : WD_S_HEARTBEAT});
+}
+
+bool EventManager::open() {
+    server_coid = name_open(otherServiceName.c_str(), NAME_FLAG_ATTACH_GLOBAL);
+    externConnected = server_coid != -1;
+    return externConnected;
+}
 
-    if (-1 == MsgSendPulse(server_coid, -1,event.type, event.data)){
+void EventManager::close() {
+    if (server_coid != -1) {
+        disconnectFromService();
+        server_coid = -1;
+    }
+}
+
+void EventManager::send(const Event &event) {
+    if (server_coid < 0) {
+        return;
+    }
+    // Partner in this process: pending until it has dispatched the event
+    Quiescence &quiescence = Quiescence::getInstance();
+    if (quiescence.isLinkCounted()) {
+        quiescence.begin();
+    }
+    if (-1 == MsgSendPulse(server_coid, pulsePriorityOf(event.type), event.type, event.data)) {
+        if (quiescence.isLinkCounted()) {
+            quiescence.end();
+        }
         perror("Client: MsgSendPulse failed");
+    } else {
+        liveness.sent();
     }
+}
 
-    // Answer form server should be structured, too.
-    //Logger::debug("Client: Answer from server: " + r_msg);
+void EventManager::post(const Event &event) {
+    sendToSelf(event);
+}
 
+// Digests have been exchanged, called by the dispatcher thread
+void EventManager::linkReestablished() {
+    disconnected = false;
+    handleEvent(Event{EventType::WD_CONN_REESTABLISHED});
+    handleEvent(Event{EventType::ERROR_M_SELF_SOLVED});
+    handleEvent(Event{EventType::ERROR_S_SELF_SOLVED});
 }
 
 int EventManager::start() {
     createService();
-    thRcvExternal = std::thread(&EventManager::rcvExternalEventsThread, this);
+    eventQueue.open();
+    ThreadRegistry &threads = ThreadRegistry::getInstance();
+    thDispatch = threads.spawn("evm-dispatch", &EventManager::dispatchEventsThread, this);
+    thRcvExternal = threads.spawn("evm-external", &EventManager::rcvExternalEventsThread, this);
     if(isMaster) {
         connectToService(ATTACH_POINT_LOCAL_S);
     } else {
         connectToService(ATTACH_POINT_LOCAL_M);
     }
-    thRcvInternal = std::thread(&EventManager::rcvInternalEventsThread, this);
+    thRcvInternal = threads.spawn("evm-internal", &EventManager::rcvInternalEventsThread, this);
+    Startup::getInstance().ready("event-manager");
     return 0;
 }
 
@@ -351,8 +468,14 @@ int EventManager::stop() {
                       std::to_string(errno));
     }
     thRcvInternal.join();
+    eventQueue.close();
+    thDispatch.join();
 
     disconnectFromService();
-    stopService();
+    rcvExternalRunning = false;
+    stopService();   // unblocks MsgReceive of the external receiver
+    if (thRcvExternal.joinable()) {
+        thRcvExternal.join();
+    }
     return 0;
 }
@@ -7,13 +7,23 @@
 #pragma once
 
 #include "IEventManager.h"
+#include "LinkRecovery.h"
+#include "metrics/Metrics.h"
+#include "PriorityEventQueue.h"
+#include "watchdog/LivenessTracker.h"
 
 #include <sys/dispatch.h>
 #include <sys/neutrino.h>
 #include <sys/iofunc.h>
 
+#include <condition_variable>
+
 #define ATTACH_POINT_LOCAL_M "EventMgrMaster"
 #define ATTACH_POINT_LOCAL_S "EventMgrSlave"
+// Retries of name_open while the partner is not started yet, the connect of
+// the partner to our service triggers a retry at once
+#define CONNECT_RETRY_MIN_MS 10
+#define CONNECT_RETRY_MAX_MS 500
 
 // qnx message declarations
 typedef struct _pulse header_t;
@@ -27,7 +37,7 @@ typedef struct
 } app_header_t;
 
 
-class EventManager : public IEventManager {
+class EventManager : public IEventManager, public ILinkTransport {
 public:
 	EventManager();
 	~EventManager() override;
@@ -39,12 +49,20 @@ public:
 	 */
 	int connectInternalClient() override;
 
+	using IEventManager::subscribe;
+
 	void subscribe(EventType type, EventCallback callback) override;
 
+	SubscriptionId subscribe(const EventMask &mask, EventDelegate handler) override;
+
+	SubscriptionId subscribe(const EventMask &mask, EventCallback callback) override;
+
 	int subscribeToAllEvents(EventCallback callback) override;
 
 	void unsubscribe(EventType type, EventCallback callback) override;
 
+	void unsubscribe(SubscriptionId subscription) override;
+
 	/**
 	 * Handle a received event
 	 *
@@ -60,7 +78,15 @@ public:
 	void sendExternalEvent(const Event &event) override;
 
 	/**
-	 * Starts the "Receive internal Events" thread
+	 * Sends the heartbeat of this system directly to the partner, it does not
+	 * pass the dispatcher. Called by the sending thread of the Watchdog.
+	 */
+	void sendHeartbeat();
+
+	/**
+	 * Starts the "Receive internal Events" thread. Blocks until the service of
+	 * the partner system is connected, then reports "event-manager" ready
+	 * (see Startup).
 	 *
 	 * @return 0 if start was successful
 	 */
@@ -77,19 +103,46 @@ public:
 	void connectToService(const std::string& name) override;
 	void connectionLost();
 
+	/**
+	 * @return Liveness of the link, updated for each message to and from the
+	 *         partner system
+	 */
+	LivenessTracker &getLiveness() { return liveness; }
+
+	/**
+	 * @return Reconnects after WD_CONN_LOST, participants of the resync have
+	 *         to be added before the connection is lost
+	 */
+	LinkRecovery &getLinkRecovery() { return linkRecovery; }
+
+	// ILinkTransport: connection to the service of the other system
+	bool open() override;
+	void close() override;
+	void send(const Event &event) override;
+	void post(const Event &event) override;
+
 private:
 	bool isMaster;
 	int internal_chid;
 	int internal_coid;
-	int server_coid; // for GNS connection?
+	std::atomic<int> server_coid; // for GNS connection?
 	bool externConnected;
-	bool disconnected = false;
+	std::atomic<bool> disconnected{false};
 	std::atomic<bool> rcvInternalRunning;
 	std::thread thRcvInternal;
     std::atomic<bool> rcvExternalRunning;
     std::thread thRcvExternal;
-	std::map<EventType, std::vector<EventCallback>> subscribers;
+    std::thread thDispatch;
+    PriorityEventQueue eventQueue;
+    LivenessTracker liveness;
+    LinkRecovery linkRecovery;
+    std::vector<Counter *> eventCounters;   // by EventType
+    Gauge &queueDepth;
+    Histogram &dispatchLatency;   // [us] from the queue to the end of the dispatch
 	std::mutex mtx;
+	std::mutex partnerMtx;
+	std::condition_variable partnerCv;
+	bool partnerSeen = false;   // partner connected to our service
 	name_attach_t *attachedService;
 	std::string ownServiceName;
 	std::string otherServiceName;
@@ -100,7 +153,10 @@ private:
 	void disconnectFromService();
 	void rcvInternalEventsThread();
     void rcvExternalEventsThread();
+    void dispatchEventsThread();
+    void dispatchEvent(const QueuedEvent &queued);
     void handle_pulse(header_t hdr, int rcvid);
     void handle_ONX_IO_msg(header_t hdr, int rcvid);
     void handle_app_msg(header_t hdr, int rcvid);
+    void linkReestablished();
 };
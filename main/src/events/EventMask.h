@@ -0,0 +1,119 @@
+/*
+ * EventMask.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "events.h"
+
+#include <bitset>
+#include <initializer_list>
+
+/**
+ * Set of EventTypes a component is interested in. Used to subscribe to many
+ * events with a single call, e.g. all light barrier events of FBM1:
+ *
+ *   EventMask::matching("LB*_M_*")
+ */
+class EventMask {
+  public:
+    EventMask() {}
+    EventMask(std::initializer_list<EventType> types) {
+        for (EventType type : types) {
+            add(type);
+        }
+    }
+
+    /**
+     * Creates a mask containing all events from first to last (both
+     * included) in the order of eventtypes_estrings.h.
+     */
+    static EventMask range(EventType first, EventType last) {
+        EventMask mask;
+        for (int i = first; i <= last; i++) {
+            mask.add(static_cast<EventType>(i));
+        }
+        return mask;
+    }
+
+    /**
+     * Creates a mask containing all events whose name matches the pattern.
+     * '*' matches any number of characters, e.g. "LAMP_*" or "*_M_*".
+     */
+    static EventMask matching(const char *pattern) {
+        EventMask mask;
+        for (std::size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+            if (nameMatches(pattern, EventString[i])) {
+                mask.bits.set(i);
+            }
+        }
+        return mask;
+    }
+
+    static EventMask all() {
+        EventMask mask;
+        mask.bits.set();
+        return mask;
+    }
+
+    EventMask &add(EventType type) {
+        bits.set(type);
+        return *this;
+    }
+
+    EventMask &remove(EventType type) {
+        bits.reset(type);
+        return *this;
+    }
+
+    bool contains(EventType type) const {
+        return type >= 0 && type < (int) EVENT_TYPE_COUNT && bits.test(type);
+    }
+
+    std::size_t count() const { return bits.count(); }
+    bool empty() const { return bits.none(); }
+
+    EventMask operator|(const EventMask &other) const {
+        EventMask mask(*this);
+        mask.bits |= other.bits;
+        return mask;
+    }
+
+    EventMask operator&(const EventMask &other) const {
+        EventMask mask(*this);
+        mask.bits &= other.bits;
+        return mask;
+    }
+
+    EventMask &operator|=(const EventMask &other) {
+        bits |= other.bits;
+        return *this;
+    }
+
+    /**
+     * Calls f(type) for every event contained in the mask.
+     */
+    template <class F> void forEach(F f) const {
+        for (std::size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+            if (bits.test(i)) {
+                f(static_cast<EventType>(i));
+            }
+        }
+    }
+
+  private:
+    std::bitset<EVENT_TYPE_COUNT> bits;
+
+    static bool nameMatches(const char *pattern, const char *name) {
+        if (*pattern == '\0') {
+            return *name == '\0';
+        }
+        if (*pattern == '*') {
+            // '*' matches nothing or consumes one more character
+            return nameMatches(pattern + 1, name) ||
+                   (*name != '\0' && nameMatches(pattern, name + 1));
+        }
+        return *pattern == *name && nameMatches(pattern + 1, name + 1);
+    }
+};
@@ -0,0 +1,83 @@
+/*
+ * EventPriority.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "events.h"
+
+// Pulse priority for safety events, so they also overtake other pulses
+// queued in the QNX channel (-1: priority of the sending thread)
+#define EVENT_PULSE_PRIO_SAFETY 21
+#define EVENT_PULSE_PRIO_DEFAULT -1
+
+/**
+ * Priority class of an event. Events of a higher class are always
+ * dispatched before events of a lower class.
+ */
+enum class EventPriority {
+    SAFETY,      // EStop, errors, connection lost, modes
+    CONTROL,     // Sensors, buttons, motor requests, height/metal results
+    TELEMETRY,   // Lamps, LEDs, heartbeats
+};
+
+#define EVENT_PRIORITY_COUNT 3
+
+/**
+ * @param type EventType to classify
+ * @return Priority class of the event
+ */
+inline EventPriority priorityOf(EventType type) {
+    switch (type) {
+    case ESTOP_M_PRESSED:
+    case ESTOP_M_RELEASED:
+    case ESTOP_S_PRESSED:
+    case ESTOP_S_RELEASED:
+    case ERROR_M_SELF_SOLVABLE:
+    case ERROR_M_MAN_SOLVABLE:
+    case ERROR_M_SELF_SOLVED:
+    case ERROR_S_SELF_SOLVABLE:
+    case ERROR_S_MAN_SOLVABLE:
+    case ERROR_S_SELF_SOLVED:
+    case WD_CONN_LOST:
+    case WD_CONN_REESTABLISHED:   // ordered with the errors it solves
+    // Modes switch the motor of the actuators (MODE_ESTOP/MODE_ERROR stop
+    // it). All modes share the class, otherwise a queued MODE_RUNNING could
+    // be dispatched after a later MODE_ESTOP.
+    case MODE_STANDBY:
+    case MODE_RUNNING:
+    case MODE_SERVICE:
+    case MODE_ESTOP:
+    case MODE_ERROR:
+        return EventPriority::SAFETY;
+    case LAMP_M_GREEN:
+    case LAMP_M_YELLOW:
+    case LAMP_M_RED:
+    case LAMP_S_GREEN:
+    case LAMP_S_YELLOW:
+    case LAMP_S_RED:
+    case LED_M_START:
+    case LED_M_RESET:
+    case LED_M_Q1:
+    case LED_M_Q2:
+    case LED_S_START:
+    case LED_S_RESET:
+    case LED_S_Q1:
+    case LED_S_Q2:
+    case WD_M_HEARTBEAT:
+    case WD_S_HEARTBEAT:
+        return EventPriority::TELEMETRY;
+    default:
+        return EventPriority::CONTROL;
+    }
+}
+
+/**
+ * @param type EventType to send
+ * @return Priority to use for MsgSendPulse()
+ */
+inline int pulsePriorityOf(EventType type) {
+    return priorityOf(type) == EventPriority::SAFETY ? EVENT_PULSE_PRIO_SAFETY
+                                                     : EVENT_PULSE_PRIO_DEFAULT;
+}
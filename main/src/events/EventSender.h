@@ -7,6 +7,9 @@
 #pragma once
 
 #include "IEventSender.h"
+#include "common/Quiescence.h"
+#include "common/Trace.h"
+#include "events/EventPriority.h"
 #include "events/IEventManager.h"
 #include "events/events.h"
 #include "logger/logger.hpp"
@@ -53,8 +56,13 @@ class EventSender : public IEventSender {
             return false;
         }
 
-        int res = MsgSendPulse(this->coid, -1, (int) event.type, event.data);
+        Tracer::getInstance().attach(event);
+        // Pending until dispatched by the EventManager
+        Quiescence::getInstance().begin();
+        int res = MsgSendPulse(this->coid, pulsePriorityOf(event.type),
+                               (int) event.type, event.data);
         if (res < 0) {
+            Quiescence::getInstance().end();
             Logger::error(
                 "Failed to send pulse message to EventManager. errno = " +
                 std::to_string(errno));
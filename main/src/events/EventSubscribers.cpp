@@ -0,0 +1,122 @@
+/*
+ * EventSubscribers.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "EventSubscribers.h"
+
+#include <algorithm>
+
+namespace {
+
+// Notifications running in this thread (of any EventSubscribers)
+thread_local int notifyDepth = 0;
+
+}
+
+EventSubscribers::EventSubscribers() : table(std::make_shared<Table>()) {}
+
+SubscriptionId EventSubscribers::add(EventType type, EventCallback callback) {
+    return add(&type, Subscription{0, EventMask(), EventDelegate{nullptr, nullptr}, callback});
+}
+
+SubscriptionId EventSubscribers::add(const EventMask &mask, EventCallback callback) {
+    return add(nullptr, Subscription{0, mask, EventDelegate{nullptr, nullptr}, callback});
+}
+
+SubscriptionId EventSubscribers::add(const EventMask &mask, EventDelegate handler) {
+    return add(nullptr, Subscription{0, mask, handler, nullptr});
+}
+
+SubscriptionId EventSubscribers::add(const EventType *type, Subscription subscription) {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::shared_ptr<Table> next = std::make_shared<Table>(*table);
+    subscription.id = nextId++;
+    if (type != nullptr) {
+        next->byType[*type].push_back(subscription);
+    } else {
+        next->byMask.push_back(subscription);
+    }
+    table = next;
+    return subscription.id;
+}
+
+bool EventSubscribers::erase(std::vector<Subscription> &subscriptions, SubscriptionId id) {
+    auto it = std::find_if(subscriptions.begin(), subscriptions.end(),
+                           [id](const Subscription &s) { return s.id == id; });
+    if (it == subscriptions.end()) {
+        return false;
+    }
+    subscriptions.erase(it);
+    return true;
+}
+
+bool EventSubscribers::remove(SubscriptionId id) {
+    std::unique_lock<std::mutex> lock(mtx);
+    std::shared_ptr<Table> next = std::make_shared<Table>(*table);
+    bool found = erase(next->byMask, id);
+    for (auto it = next->byType.begin(); !found && it != next->byType.end(); ++it) {
+        found = erase(it->second, id);
+    }
+    if (!found) {
+        return false;
+    }
+    table = next;
+    if (notifyDepth == 0) {
+        // Notification with the previous subscriptions may still be running
+        waiting++;
+        cvNotified.wait(lock, [this] { return notifying == 0; });
+        waiting--;
+    }
+    return true;
+}
+
+int EventSubscribers::notify(const Event &event) {
+    std::shared_ptr<const Table> current;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        current = table;
+        notifying++;
+    }
+    notifyDepth++;
+
+    static const std::vector<Subscription> none;
+    auto typed = current->byType.find(event.type);
+    const std::vector<Subscription> &byType = typed != current->byType.end() ? typed->second : none;
+    const std::vector<Subscription> &byMask = current->byMask;
+    std::size_t t = 0, m = 0;
+    int nNotified = 0;
+    // merge both lists in the order of subscription
+    while (true) {
+        while (m < byMask.size() && !byMask[m].mask.contains(event.type)) {
+            m++;
+        }
+        bool hasType = t < byType.size();
+        bool hasMask = m < byMask.size();
+        if (!hasType && !hasMask) {
+            break;
+        }
+        const Subscription &sub = hasType && (!hasMask || byType[t].id < byMask[m].id)
+                                      ? byType[t++]
+                                      : byMask[m++];
+        if (sub.handler.call != nullptr) {
+            sub.handler.call(sub.handler.object, event);
+        } else {
+            sub.callback(event);
+        }
+        nNotified++;
+    }
+
+    notifyDepth--;
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        notifying--;
+        wake = waiting > 0;
+    }
+    if (wake) {
+        cvNotified.notify_all();
+    }
+    return nNotified;
+}
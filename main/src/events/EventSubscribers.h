@@ -0,0 +1,96 @@
+/*
+ * EventSubscribers.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "EventMask.h"
+#include "IEventHandler.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using SubscriptionId = uint64_t;   // 0: none
+
+/**
+ * Call of handleEvent() of a component without a virtual call. The type of
+ * the component is known where it subscribes:
+ *
+ *   EventDelegate::of(this)
+ */
+struct EventDelegate {
+    void *object;
+    void (*call)(void *object, const Event &event);
+
+    template <class Handler> static EventDelegate of(Handler *handler) {
+        return EventDelegate{handler, &invoke<Handler>};
+    }
+
+    template <class Handler> static void invoke(void *object, const Event &event) {
+        static_cast<Handler *>(object)->Handler::handleEvent(event);
+    }
+};
+
+/**
+ * Subscriptions of an EventManager, by EventType or by EventMask.
+ *
+ * Subscribers of an event are notified in the order they subscribed, no
+ * matter if by type or by mask. The subscriptions are copied on change, so
+ * notify() does not hold the lock while calling the subscribers and a
+ * subscriber may subscribe or unsubscribe while it is notified.
+ */
+class EventSubscribers {
+  public:
+    using EventCallback = std::function<void(const Event &)>;
+
+    EventSubscribers();
+
+    SubscriptionId add(EventType type, EventCallback callback);
+    SubscriptionId add(const EventMask &mask, EventCallback callback);
+    SubscriptionId add(const EventMask &mask, EventDelegate handler);
+
+    /**
+     * Removes a subscription. Waits until notifications running in other
+     * threads have finished, afterwards the subscriber is not called again.
+     * Called by a subscriber while it is notified, it does not wait.
+     *
+     * @return false if there is no such subscription
+     */
+    bool remove(SubscriptionId id);
+
+    /**
+     * Notifies all subscribers of the event.
+     *
+     * @return number of notified subscribers
+     */
+    int notify(const Event &event);
+
+  private:
+    struct Subscription {
+        SubscriptionId id;
+        EventMask mask;   // mask subscriptions only
+        EventDelegate handler;
+        EventCallback callback;
+    };
+
+    struct Table {
+        std::map<EventType, std::vector<Subscription>> byType;
+        std::vector<Subscription> byMask;
+    };
+
+    std::mutex mtx;
+    std::condition_variable cvNotified;
+    std::shared_ptr<const Table> table;
+    SubscriptionId nextId{1};
+    int notifying{0};
+    int waiting{0};   // in remove()
+
+    SubscriptionId add(const EventType *type, Subscription subscription);
+    static bool erase(std::vector<Subscription> &subscriptions, SubscriptionId id);
+};
@@ -10,6 +10,8 @@
 #include "events.h"
 #include "eventtypes_enum.h"
 
+#include <cstdint>
+
 
 // ENum value to attach to event data for controlling lamps
 enum LampState { OFF, ON, FLASHING_SLOW, FLASHING_FAST };
@@ -20,6 +22,7 @@ struct Event {
     Event(EventType evType, int evData) : type(evType), data(evData) {}
     EventType type;
     int data{-1};
+    uint32_t traceId{0};   // latency trace (see Tracer), 0 if not traced
 };
 
 class IEventHandler {
@@ -7,6 +7,8 @@
 #pragma once
 
 #include "events.h"
+#include "EventMask.h"
+#include "EventSubscribers.h"
 #include <functional>
 #include <string>
 #include <map>
@@ -38,6 +40,30 @@ public:
 	 */
 	virtual void subscribe(EventType type, EventCallback callback) = 0;
 
+	/**
+	 * Subscribe a component to all events contained in the mask.
+	 * handleEvent() of the component is called directly (not virtual),
+	 * nothing is stored per EventType.
+	 *
+	 * @param mask Events to subscribe to
+	 * @param handler Component to notify if one of the events has occurred
+	 * @return Subscription to pass to unsubscribe()
+	 */
+	template <class Handler> SubscriptionId subscribe(const EventMask &mask, Handler *handler) {
+		return subscribe(mask, EventDelegate::of(handler));
+	}
+
+	virtual SubscriptionId subscribe(const EventMask &mask, EventDelegate handler) = 0;
+
+	/**
+	 * Subscribe a single callback to all events contained in the mask.
+	 *
+	 * @param mask Events to subscribe to
+	 * @param callback Function to call if one of the events has occurred
+	 * @return Subscription to pass to unsubscribe()
+	 */
+	virtual SubscriptionId subscribe(const EventMask &mask, EventCallback callback) = 0;
+
 	/**
 	 * Subscribe to be notified about all events
 	 *
@@ -53,6 +79,14 @@ public:
 	 */
 	virtual void unsubscribe(EventType type, EventCallback callback) = 0;
 
+	/**
+	 * Removes a mask subscription. After the call the subscriber is not
+	 * notified anymore (see EventSubscribers::remove()).
+	 *
+	 * @param subscription Returned by subscribe()
+	 */
+	virtual void unsubscribe(SubscriptionId subscription) = 0;
+
 	/**
 	 * Handle a received event
 	 *
@@ -85,7 +119,7 @@ public:
 	virtual void connectToService(const std::string& name) = 0;
 
 protected:
-	std::map<EventType, std::vector<EventCallback>> subscribers;
+	EventSubscribers subscribers;
 
 private:
 	bool isMaster;
@@ -0,0 +1,174 @@
+/*
+ * LinkDigest.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+
+/**
+ * Parts of the state which master and slave have to agree on after the link
+ * has been lost. Each section is owned by one of the systems, the other one
+ * only has a belief about it. The slave owns the light barriers of FBM2, the
+ * master owns the state of its FSMs (workpiece areas, ramp of FBM1, main
+ * state).
+ */
+enum class LinkSection {
+    RAMP_FBM2,    // ramp blocked
+    ENTRY_FBM2,   // light barrier at the start of FBM2 (LBA), see linkBarrier()
+    EXIT_FBM2,    // light barrier at the end of FBM2 (LBE)
+    RAMP_FBM1,    // ramp blocked
+    AREAS,        // workpieces per area of the WorkpieceManager, see linkAreas()
+    MAIN_STATE,   // MainState of the main FSM
+};
+
+#define LINK_SECTION_COUNT 6
+#define LINK_SECTION_BIT(section) (1u << (unsigned int) (section))
+// Section values are 24 bit, so section and value fit into the data of one
+// pulse
+#define LINK_VALUE_MASK 0xFFFFFFu
+// Section index of the last word of a digest, carries the owned sections
+#define LINK_DIGEST_END 0x7F
+// Bits per area in the AREAS section (4 areas)
+#define LINK_AREA_BITS 6
+#define LINK_AREA_MAX ((1u << LINK_AREA_BITS) - 1)
+
+/**
+ * Value of a light barrier section: number of workpieces which passed the
+ * barrier, i.e. unblocked edges (upper 23 bits, wrapping) and blocked (bit 0).
+ */
+inline uint32_t linkBarrier(bool blocked, uint32_t passed) {
+    return ((passed << 1) | (blocked ? 1u : 0u)) & LINK_VALUE_MASK;
+}
+
+inline bool linkBarrierBlocked(uint32_t value) {
+    return (value & 1u) != 0;
+}
+
+/**
+ * @return number of passes counted in value but not in belief
+ */
+inline uint32_t linkBarrierPassedSince(uint32_t value, uint32_t belief) {
+    return ((value >> 1) - (belief >> 1)) & (LINK_VALUE_MASK >> 1);
+}
+
+/**
+ * Value of the AREAS section: number of workpieces in the areas A to D,
+ * limited to LINK_AREA_MAX each.
+ */
+inline uint32_t linkAreas(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    uint32_t value = 0;
+    for (uint32_t count : {d, c, b, a}) {
+        value = (value << LINK_AREA_BITS) | (count < LINK_AREA_MAX ? count : LINK_AREA_MAX);
+    }
+    return value;
+}
+
+/**
+ * @param area 0 (A) .. 3 (D)
+ * @return number of workpieces of the area in an AREAS value
+ */
+inline uint32_t linkAreaCount(uint32_t value, int area) {
+    return (value >> (area * LINK_AREA_BITS)) & LINK_AREA_MAX;
+}
+
+/**
+ * Compact digest of the sections, sent as LINK_SECTION_COUNT + 1 SYNC_DIGEST
+ * pulses.
+ */
+class LinkDigest {
+  public:
+    LinkDigest() : owned(0), known(0) {
+        for (int i = 0; i < LINK_SECTION_COUNT; i++) {
+            values[i] = 0;
+        }
+    }
+
+    void set(LinkSection section, uint32_t value, bool isOwned = false) {
+        values[(int) section] = value & LINK_VALUE_MASK;
+        known |= LINK_SECTION_BIT(section);
+        if (isOwned) {
+            owned |= LINK_SECTION_BIT(section);
+        }
+    }
+
+    uint32_t get(LinkSection section) const { return values[(int) section]; }
+    uint32_t getOwned() const { return owned; }
+    uint32_t getKnown() const { return known; }
+
+    /**
+     * @return bit mask of the sections known to both with different values
+     */
+    uint32_t differences(const LinkDigest &other) const {
+        uint32_t diff = 0;
+        for (int i = 0; i < LINK_SECTION_COUNT; i++) {
+            if (values[i] != other.values[i]) {
+                diff |= 1u << i;
+            }
+        }
+        return diff & known & other.known;
+    }
+
+    /**
+     * @param index 0 .. LINK_SECTION_COUNT
+     * @return data of the index-th SYNC_DIGEST pulse
+     */
+    int word(int index) const {
+        if (index < LINK_SECTION_COUNT) {
+            bool isKnown = (known & (1u << index)) != 0;
+            // unknown sections are not sent
+            return isKnown ? (int) ((index << 24) | values[index]) : -1;
+        }
+        return (int) ((LINK_DIGEST_END << 24) | owned);
+    }
+
+    /**
+     * Adds the data of a SYNC_DIGEST pulse.
+     *
+     * @return true if it was the last word of the digest
+     */
+    bool addWord(int data) {
+        uint32_t index = ((uint32_t) data) >> 24;
+        if (index == LINK_DIGEST_END) {
+            owned = data & LINK_VALUE_MASK;
+            return true;
+        }
+        if (index < LINK_SECTION_COUNT) {
+            set((LinkSection) index, data);
+        }
+        return false;
+    }
+
+  private:
+    uint32_t values[LINK_SECTION_COUNT];
+    uint32_t owned;   // bit mask of the sections owned by the sender
+    uint32_t known;
+};
+
+/**
+ * Component which contributes sections to the digest of its system and
+ * adopts the sections owned by the partner system after a reconnect.
+ * Called from the thread dispatching the events.
+ */
+class ISyncParticipant {
+  public:
+    virtual ~ISyncParticipant() {}
+
+    /**
+     * Sets the owned sections and the belief about sections of the partner.
+     */
+    virtual void fill(LinkDigest &digest) = 0;
+
+    /**
+     * A section owned by the partner differs from the belief of this system.
+     */
+    virtual void apply(LinkSection section, uint32_t value) = 0;
+
+    /**
+     * The belief of the partner about a section owned by this system differs,
+     * e.g. to repeat events the partner has missed.
+     */
+    virtual void beliefDiffers(LinkSection section, uint32_t belief) {}
+};
@@ -0,0 +1,226 @@
+/*
+ * LinkRecovery.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "LinkRecovery.h"
+#include "logger/logger.hpp"
+
+#include <algorithm>
+#include <string>
+
+LinkRecovery::LinkRecovery(ILinkTransport &transport, Callback onReestablished,
+                           TimerService &timers, Clock &clock)
+    : transport(transport), onReestablished(onReestablished), timers(timers), clock(clock),
+      state(LinkState::CONNECTED), backoffMs(LINK_BACKOFF_MIN_MS), round(0), timer(0),
+      digestSent(false), digestComplete(false), nAttempts(0), nRecoveries(0), nResynced(0),
+      lastRecoveryMs(0) {
+}
+
+LinkRecovery::~LinkRecovery() {
+    TimerId pending;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        round++;
+        pending = timer;
+    }
+    timers.cancel(pending);
+}
+
+void LinkRecovery::addParticipant(ISyncParticipant *participant) {
+    participants.push_back(participant);
+}
+
+LinkState LinkRecovery::getState() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return state;
+}
+
+void LinkRecovery::connectionLost() {
+    uint64_t forRound;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (state != LinkState::CONNECTED) {
+            return;
+        }
+        state = LinkState::RECONNECTING;
+        round++;
+        backoffMs = LINK_BACKOFF_MIN_MS;
+        digestSent = false;
+        digestComplete = false;
+        incoming = LinkDigest();
+        lostAt = clock.now();
+        forRound = round;
+    }
+    Logger::info("[LinkRecovery] Connection lost - reconnecting...");
+    transport.close();
+    schedule(LINK_BACKOFF_MIN_MS, &LinkRecovery::attempt, forRound);
+}
+
+void LinkRecovery::startResync() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (state != LinkState::RESYNCING || digestSent) {
+            return;
+        }
+        digestSent = true;
+    }
+    sendDigest();
+    std::unique_lock<std::mutex> lock(mtx);
+    finishIfComplete(lock);
+}
+
+void LinkRecovery::digestReceived(int data) {
+    LinkDigest received;
+    LinkState current;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!incoming.addWord(data)) {
+            return;
+        }
+        received = incoming;
+        incoming = LinkDigest();
+        current = state;
+    }
+    applyDifferences(received);
+
+    std::unique_lock<std::mutex> lock(mtx);
+    if (current == LinkState::CONNECTED) {
+        // Partner has reconnected without a loss noticed here -> answer
+        lock.unlock();
+        sendDigest();
+        return;
+    }
+    digestComplete = true;
+    if (state == LinkState::RESYNCING && !digestSent) {
+        digestSent = true;
+        lock.unlock();
+        sendDigest();
+        lock.lock();
+    }
+    // While still reconnecting, the digest is sent after connecting
+    finishIfComplete(lock);
+}
+
+LinkDigest LinkRecovery::digest() {
+    LinkDigest result;
+    for (ISyncParticipant *participant : participants) {
+        participant->fill(result);
+    }
+    return result;
+}
+
+void LinkRecovery::attempt(uint64_t forRound) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (forRound != round || state != LinkState::RECONNECTING) {
+            return;
+        }
+    }
+    nAttempts++;
+    if (!transport.open()) {
+        int delay;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            delay = backoffMs;
+            backoffMs = std::min(backoffMs * 2, LINK_BACKOFF_MAX_MS);
+        }
+        schedule(delay, &LinkRecovery::attempt, forRound);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (forRound != round) {
+            return;
+        }
+        state = LinkState::RESYNCING;
+    }
+    // digest is built in the thread of the FSMs
+    transport.post(Event{SYNC_START});
+    schedule(LINK_RESYNC_TIMEOUT_MS, &LinkRecovery::resyncTimeout, forRound);
+}
+
+void LinkRecovery::resyncTimeout(uint64_t forRound) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (forRound != round || state != LinkState::RESYNCING) {
+            return;
+        }
+        // answer of the partner missing, new attempt
+        state = LinkState::RECONNECTING;
+        round++;
+        digestSent = false;
+        digestComplete = false;
+        incoming = LinkDigest();
+    }
+    Logger::warn("[LinkRecovery] No digest received from partner - reconnecting...");
+    transport.close();
+    schedule(backoffMs, &LinkRecovery::attempt, forRound + 1);
+}
+
+void LinkRecovery::schedule(int delayMs, void (LinkRecovery::*action)(uint64_t), uint64_t forRound) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (forRound != round) {
+        return;
+    }
+    timer = timers.scheduleOnce(delayMs, [this, action, forRound]() { (this->*action)(forRound); });
+}
+
+void LinkRecovery::sendDigest() {
+    LinkDigest own = digest();
+    for (int i = 0; i <= LINK_SECTION_COUNT; i++) {
+        int word = own.word(i);
+        if (word != -1) {
+            transport.send(Event{SYNC_DIGEST, word});
+        }
+    }
+}
+
+void LinkRecovery::applyDifferences(const LinkDigest &received) {
+    LinkDigest own = digest();
+    // Only sections owned by the partner are adopted, own sections are
+    // corrected by the partner
+    uint32_t diff = own.differences(received) & received.getOwned() & ~own.getOwned();
+    for (int i = 0; i < LINK_SECTION_COUNT; i++) {
+        if (diff & (1u << i)) {
+            Logger::info("[LinkRecovery] Resync section " + std::to_string(i) + ": "
+                         + std::to_string(own.get((LinkSection) i)) + " -> "
+                         + std::to_string(received.get((LinkSection) i)));
+            for (ISyncParticipant *participant : participants) {
+                participant->apply((LinkSection) i, received.get((LinkSection) i));
+            }
+            nResynced++;
+        }
+    }
+    // Own sections the partner believes differently
+    uint32_t outdated = own.differences(received) & own.getOwned() & ~received.getOwned();
+    for (int i = 0; i < LINK_SECTION_COUNT; i++) {
+        if (outdated & (1u << i)) {
+            for (ISyncParticipant *participant : participants) {
+                participant->beliefDiffers((LinkSection) i, received.get((LinkSection) i));
+            }
+        }
+    }
+}
+
+void LinkRecovery::finishIfComplete(std::unique_lock<std::mutex> &lock) {
+    if (state != LinkState::RESYNCING || !digestSent || !digestComplete) {
+        return;
+    }
+    state = LinkState::CONNECTED;
+    digestSent = false;
+    digestComplete = false;
+    round++;
+    TimerId pending = timer;
+    timer = 0;
+    nRecoveries++;
+    lastRecoveryMs = clock.millisSince(lostAt);
+    lock.unlock();
+    timers.cancel(pending);
+    Logger::info("[LinkRecovery] Connection reestablished after " + std::to_string(lastRecoveryMs)
+                 + " ms");
+    if (onReestablished) {
+        onReestablished();
+    }
+}
@@ -0,0 +1,136 @@
+/*
+ * LinkRecovery.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "LinkDigest.h"
+#include "common/Clock.h"
+#include "common/TimerService.h"
+#include "events/events.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Backoff between connection attempts, doubled after each failed attempt
+#define LINK_BACKOFF_MIN_MS    20
+#define LINK_BACKOFF_MAX_MS    1000
+// Connection given up again if the partner does not answer the digest
+#define LINK_RESYNC_TIMEOUT_MS 500
+
+/**
+ * Connection to the partner system as seen by the LinkRecovery.
+ */
+class ILinkTransport {
+  public:
+    virtual ~ILinkTransport() {}
+
+    /**
+     * One attempt to connect to the partner system, must not block long.
+     *
+     * @return true if connected
+     */
+    virtual bool open() = 0;
+
+    virtual void close() = 0;
+
+    /**
+     * Sends an event to the partner, also while the link is resynchronized.
+     */
+    virtual void send(const Event &event) = 0;
+
+    /**
+     * Queues an event for the thread dispatching the events of this system.
+     */
+    virtual void post(const Event &event) = 0;
+};
+
+enum class LinkState { CONNECTED, RECONNECTING, RESYNCING };
+
+/**
+ * Reestablishes the link to the partner system after WD_CONN_LOST.
+ *
+ *   CONNECTED --connectionLost()--> RECONNECTING --open()--> RESYNCING
+ *   RESYNCING --digests exchanged--> CONNECTED
+ *   RESYNCING --timeout--> RECONNECTING
+ *
+ * Connection attempts are scheduled on the TimerService with exponential
+ * backoff. After connecting, both systems send a LinkDigest of their state
+ * (SYNC_DIGEST events). Each system compares the digest of the partner with
+ * its own and passes only the differing sections owned by the partner to
+ * the participants, the owner of a section is told about the differing
+ * belief of the partner. A system which did not notice the loss answers a digest
+ * with its own.
+ *
+ * startResync() and digestReceived() are called by the thread dispatching
+ * the events, the same thread which runs the FSMs.
+ */
+class LinkRecovery {
+  public:
+    using Callback = std::function<void()>;
+
+    LinkRecovery(ILinkTransport &transport, Callback onReestablished,
+                 TimerService &timers = TimerService::getInstance(),
+                 Clock &clock = Clock::getInstance());
+    virtual ~LinkRecovery();
+
+    void addParticipant(ISyncParticipant *participant);
+
+    /**
+     * Closes the link and starts reconnecting. Ignored if already reconnecting.
+     */
+    void connectionLost();
+
+    /**
+     * Sends the digest of this system (SYNC_START posted after connecting).
+     */
+    void startResync();
+
+    /**
+     * Adds a SYNC_DIGEST word received from the partner.
+     */
+    void digestReceived(int data);
+
+    /**
+     * @return digest of all participants of this system
+     */
+    LinkDigest digest();
+
+    LinkState getState();
+    uint64_t getAttempts() { return nAttempts; }
+    uint64_t getRecoveries() { return nRecoveries; }
+    uint64_t getResyncedSections() { return nResynced; }
+    int64_t getLastRecoveryMs() { return lastRecoveryMs; }
+
+  private:
+    ILinkTransport &transport;
+    Callback onReestablished;
+    TimerService &timers;
+    Clock &clock;
+    std::vector<ISyncParticipant *> participants;
+
+    std::mutex mtx;
+    LinkState state;
+    int backoffMs;
+    uint64_t round;       // incremented on each loss, invalidates timers
+    TimerId timer;
+    bool digestSent;
+    bool digestComplete;  // digest of the partner received
+    LinkDigest incoming;
+    Clock::time_point lostAt;
+
+    std::atomic<uint64_t> nAttempts;
+    std::atomic<uint64_t> nRecoveries;
+    std::atomic<uint64_t> nResynced;
+    std::atomic<int64_t> lastRecoveryMs;
+
+    void attempt(uint64_t forRound);
+    void resyncTimeout(uint64_t forRound);
+    void schedule(int delayMs, void (LinkRecovery::*action)(uint64_t), uint64_t forRound);
+    void sendDigest();
+    void applyDifferences(const LinkDigest &received);
+    void finishIfComplete(std::unique_lock<std::mutex> &lock);
+};
@@ -0,0 +1,75 @@
+/*
+ * PriorityEventQueue.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "PriorityEventQueue.h"
+
+PriorityEventQueue::PriorityEventQueue() : closed(false) {}
+
+void PriorityEventQueue::push(const Event &event, bool external) {
+    QueuedEvent qe;
+    qe.event = event;
+    qe.external = external;
+    qe.enqueued = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        lanes[(int) priorityOf(event.type)].push_back(qe);
+    }
+    cv.notify_one();
+}
+
+bool PriorityEventQueue::pop(QueuedEvent &out) {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [this] { return closed || countUnlocked() > 0; });
+    return takeNext(out);
+}
+
+bool PriorityEventQueue::tryPop(QueuedEvent &out) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return takeNext(out);
+}
+
+void PriorityEventQueue::close() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        closed = true;
+    }
+    cv.notify_all();
+}
+
+void PriorityEventQueue::open() {
+    std::lock_guard<std::mutex> lock(mtx);
+    closed = false;
+}
+
+std::size_t PriorityEventQueue::size(EventPriority prio) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return lanes[(int) prio].size();
+}
+
+std::size_t PriorityEventQueue::size() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return countUnlocked();
+}
+
+std::size_t PriorityEventQueue::countUnlocked() {
+    std::size_t n = 0;
+    for (const auto &lane : lanes) {
+        n += lane.size();
+    }
+    return n;
+}
+
+bool PriorityEventQueue::takeNext(QueuedEvent &out) {
+    // Lanes are ordered by priority: SAFETY first
+    for (auto &lane : lanes) {
+        if (!lane.empty()) {
+            out = lane.front();
+            lane.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
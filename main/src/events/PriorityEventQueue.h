@@ -0,0 +1,75 @@
+/*
+ * PriorityEventQueue.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "EventPriority.h"
+#include "events.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/**
+ * Event waiting to be dispatched by the EventManager.
+ */
+struct QueuedEvent {
+    Event event;
+    bool external{false};   // received from the other system
+    std::chrono::steady_clock::time_point enqueued;   // pushed, for the dispatch latency
+};
+
+/**
+ * Queue with one lane per EventPriority. pop() always takes the oldest
+ * event of the highest non-empty lane, so an EStop never waits behind
+ * queued telemetry. The order within one lane is kept.
+ */
+class PriorityEventQueue {
+  public:
+    PriorityEventQueue();
+
+    /**
+     * Appends the event to the lane of its priority class.
+     */
+    void push(const Event &event, bool external = false);
+
+    /**
+     * Blocks until an event is available or the queue was closed.
+     *
+     * @param out Next event to dispatch
+     * @return false if the queue was closed and is empty
+     */
+    bool pop(QueuedEvent &out);
+
+    /**
+     * Takes the next event without blocking.
+     *
+     * @return false if all lanes are empty
+     */
+    bool tryPop(QueuedEvent &out);
+
+    /**
+     * Wakes up all waiting threads, pop() returns false afterwards.
+     */
+    void close();
+
+    /**
+     * Opens the queue again after close().
+     */
+    void open();
+
+    std::size_t size(EventPriority prio);
+    std::size_t size();
+
+  private:
+    std::array<std::deque<QueuedEvent>, EVENT_PRIORITY_COUNT> lanes;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool closed;
+    bool takeNext(QueuedEvent &out);
+    std::size_t countUnlocked();
+};
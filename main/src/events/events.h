@@ -10,3 +10,6 @@
 #include "IEventHandler.h"
 #include "eventtypes_enum.h"
 #include "eventtypes_stringlist.h"
+
+// Number of different event types
+#define EVENT_TYPE_COUNT (sizeof(EventString) / sizeof(EventString[0]))
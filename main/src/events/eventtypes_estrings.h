@@ -130,3 +130,11 @@ ESTRING(WD_CONN_LOST)
 ESTRING(WD_CONN_REESTABLISHED)
 ESTRING(WD_M_HEARTBEAT)   // Heartbeat FBM1 -> FBM2
 ESTRING(WD_S_HEARTBEAT)   // Heartbeat FBM2 -> FBM1
+
+// Link recovery after WD_CONN_LOST
+ESTRING(SYNC_START)    // connected again -> send digest (internal only)
+ESTRING(SYNC_DIGEST)   // one word of a LinkDigest
+
+// MainFSM -> MainFSM: minimum gap on FBM2 elapsed (sent by the TimerService,
+// internal only)
+ESTRING(HANDOVER_GAP_ELAPSED)
@@ -7,6 +7,7 @@
 
 #include "Actuators.h"
 
+#include "common/TimerService.h"
 #include "configuration/Configuration.h"
 #include "logger/logger.hpp"
 #ifdef SIM_ACTIVE
@@ -23,10 +24,6 @@ Actuators::Actuators(std::shared_ptr<EventManager> mngr) : IActuators(mngr) {
 
     configurePins();
 
-    greenBlinking = false;
-    yellowBlinking = false;
-    redBlinking = false;
-
     standbyMode();
 
 	if(hasPusher) {
@@ -39,6 +36,10 @@ Actuators::Actuators(std::shared_ptr<EventManager> mngr) : IActuators(mngr) {
 }
 
 Actuators::~Actuators() {
+    stopBlinking(greenBlinkTimer);
+    stopBlinking(yellowBlinkTimer);
+    stopBlinking(redBlinkTimer);
+    TimerService::getInstance().cancel(pusherTimer);
     munmap_device_io(gpio_bank_1, SIZE_4KB);
     munmap_device_io(gpio_bank_2, SIZE_4KB);
 }
@@ -75,40 +76,44 @@ void Actuators::configurePins() {
 }
 
 void Actuators::setGreenBlinking(bool on) {
-    if (th_GreenBlinking.joinable()) {
-        greenBlinking = false;
-        th_GreenBlinking.join();
-    }
-
+    stopBlinking(greenBlinkTimer);
     if (on) {
-        th_GreenBlinking =
-            std::thread(&Actuators::thGreenLampFlashing, this, false);
+        greenBlinkTimer = startBlinking(&Actuators::greenLampOn,
+                                        &Actuators::greenLampOff, ON_TIME_SLOW_MS);
     }
 }
 
 void Actuators::setYellowBlinking(bool on) {
-    if (th_YellowBlinking.joinable()) {
-        yellowBlinking = false;
-        th_YellowBlinking.join();
-    }
-
+    stopBlinking(yellowBlinkTimer);
     if (on) {
-        th_YellowBlinking =
-            std::thread(&Actuators::thYellowLampFlashing, this, false);
+        yellowBlinkTimer = startBlinking(&Actuators::yellowLampOn,
+                                         &Actuators::yellowLampOff, ON_TIME_SLOW_MS);
     }
 }
 
 void Actuators::setRedBlinking(bool on, bool fast) {
-    if (redBlinking) {
-        redBlinking = false;
-        
-        if (th_RedBlinking.joinable()){
-            th_RedBlinking.join();
-        }
+    stopBlinking(redBlinkTimer);
+    if (on) {
+        redBlinkTimer = startBlinking(&Actuators::redLampOn, &Actuators::redLampOff,
+                                      fast ? ON_TIME_FAST_MS : ON_TIME_SLOW_MS);
     }
+}
 
-    if (on) {
-        th_RedBlinking = std::thread(&Actuators::thRedLampFlashing, this, fast);
+TimerId Actuators::startBlinking(void (Actuators::*lampOn)(),
+                                 void (Actuators::*lampOff)(), int onTimeMs) {
+    // Lamp is on for onTimeMs, then off for onTimeMs
+    (this->*lampOn)();
+    std::shared_ptr<bool> isOn = std::make_shared<bool>(true);
+    return TimerService::getInstance().schedulePeriodic(onTimeMs, [=]() {
+        *isOn = !*isOn;
+        *isOn ? (this->*lampOn)() : (this->*lampOff)();
+    });
+}
+
+void Actuators::stopBlinking(TimerId &timer) {
+    if (timer != 0) {
+        TimerService::getInstance().cancel(timer);
+        timer = 0;
     }
 }
 
@@ -236,79 +241,6 @@ void Actuators::redLampOff() {
     out32(GPIO_CLEARDATAOUT(gpio_bank_1), LAMP_RED_PIN);
 }
 
-void Actuators::thRedLampFlashing(bool fast) {
-    int t_ms = fast ? ON_TIME_FAST_MS : ON_TIME_SLOW_MS;
-    int t_actual;
-    redBlinking = true;
-    while (redBlinking) {
-        redLampOn();
-        t_actual = 0;
-        while(t_actual < t_ms) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(BLINK_POLL_TIME_MS));
-			if(!redBlinking)
-				return;
-			t_actual += 100;
-        }
-        redLampOff();
-        if(!redBlinking){ break; }
-        t_actual = 0;
-		while(t_actual < t_ms) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(BLINK_POLL_TIME_MS));
-			if(!redBlinking)
-				return;
-			t_actual += 100;
-		}
-    }
-}
-
-void Actuators::thYellowLampFlashing(bool fast) {
-    int t_ms = fast ? ON_TIME_FAST_MS : ON_TIME_SLOW_MS;
-    int t_actual;
-    yellowBlinking = true;
-    while (yellowBlinking) {
-        yellowLampOn();
-        t_actual = 0;
-        while(t_actual < t_ms) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(BLINK_POLL_TIME_MS));
-			if(!yellowBlinking)
-				return;
-			t_actual += 100;
-        }
-        yellowLampOff();
-        t_actual = 0;
-		while(t_actual < t_ms) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(BLINK_POLL_TIME_MS));
-			if(!yellowBlinking)
-				return;
-			t_actual += 100;
-		}
-    }
-}
-
-void Actuators::thGreenLampFlashing(bool fast) {
-    int t_ms = fast ? ON_TIME_FAST_MS : ON_TIME_SLOW_MS;
-    int t_actual;
-    greenBlinking = true;
-    while (greenBlinking) {
-    	greenLampOn();
-        t_actual = 0;
-        while(t_actual < t_ms) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(BLINK_POLL_TIME_MS));
-			if(!greenBlinking)
-				return;
-			t_actual += 100;
-        }
-        greenLampOff();
-        t_actual = 0;
-		while(t_actual < t_ms) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(BLINK_POLL_TIME_MS));
-			if(!greenBlinking)
-				return;
-			t_actual += 100;
-		}
-    }
-}
-
 void Actuators::startLedOn() {
     out32(GPIO_SETDATAOUT(gpio_bank_2), LED_START_PIN);
 }
@@ -389,12 +321,10 @@ void Actuators::sortOut() {
     // No pusher -> nothing to do, workpiece will be sorted out!
     if (hasPusher) {
         Logger::debug("[Actuators] Pusher out for " + std::to_string(ON_TIME_PUSHER_MS) + " ms to sort out workpiece");
-        std::thread t([=]() {
-            closeSwitch();
-            std::this_thread::sleep_for(std::chrono::milliseconds(ON_TIME_PUSHER_MS));
-            openSwitch();
-        });
-        t.detach();
+        closeSwitch();
+        TimerService &timers = TimerService::getInstance();
+        timers.cancel(pusherTimer);
+        pusherTimer = timers.scheduleOnce(ON_TIME_PUSHER_MS, [this]() { openSwitch(); });
     } else {
         Logger::debug("[Actuators] Let switch sort out workpiece");
         closeSwitch();
@@ -15,6 +15,7 @@
 
 #include "IActuators.h"
 #include "Sensors.h"
+#include "common/TimerService.h"
 #include "events/EventManager.h"
 #include "events/IEventHandler.h"
 #include "events/events.h"
@@ -24,9 +25,6 @@
 #define ON_TIME_PUSHER_MS 300
 #define ON_TIME_SWITCH_MS 1000
 
-// Check every x ms if "blinking thread" should be terminated
-#define BLINK_POLL_TIME_MS 100
-
 class Actuators : public IActuators {
   public:
     Actuators(std::shared_ptr<EventManager> mngr);
@@ -72,13 +70,11 @@ class Actuators : public IActuators {
     uintptr_t gpio_bank_1;
     uintptr_t gpio_bank_2;
     bool isMaster;
-    bool greenBlinking;
-    bool yellowBlinking;
-    bool redBlinking;
     bool hasPusher;
-    std::thread th_GreenBlinking;
-    std::thread th_YellowBlinking;
-    std::thread th_RedBlinking;
+    TimerId greenBlinkTimer{0};
+    TimerId yellowBlinkTimer{0};
+    TimerId redBlinkTimer{0};
+    TimerId pusherTimer{0};   // returns the pusher after sortOut()
     /**
      * @brief 
      * 
@@ -99,8 +95,13 @@ class Actuators : public IActuators {
      */
     void setMotorLeft(bool left);
     void configurePins();
-    void thGreenLampFlashing(bool fast);
-    void thYellowLampFlashing(bool fast);
-    void thRedLampFlashing(bool fast);
+    /**
+     * Lets a lamp blink with the TimerService.
+     *
+     * @return ID of the periodic timer
+     */
+    TimerId startBlinking(void (Actuators::*lampOn)(),
+                          void (Actuators::*lampOff)(), int onTimeMs);
+    void stopBlinking(TimerId &timer);
     bool handleLampEvent(EventType event, LampState state);
 };
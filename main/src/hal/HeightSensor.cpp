@@ -7,6 +7,11 @@
 
 #include "HeightSensor.h"
 
+#include <algorithm>
+
+#include "common/Quiescence.h"
+#include "common/Startup.h"
+#include "common/ThreadRegistry.h"
 #include "logger/logger.hpp"
 #ifdef SIM_ACTIVE
 #include "simqnxgpioapi.h"   // must be last include !!!
@@ -14,7 +19,10 @@
 #endif
 
 HeightSensor::HeightSensor(std::shared_ptr<EventManager> mngr)
-    : chanID(-1), conID(-1) {
+    : chanID(-1), conID(-1),
+      samples(MetricsRegistry::getInstance().counter("esep_height_samples_total")),
+      samplesPerSecond(MetricsRegistry::getInstance().gauge("esep_height_samples_per_second")),
+      sampleDelay(MetricsRegistry::getInstance().histogram("esep_height_sample_delay_us")) {
     adc = new ADC(tsc);
     window.reserve(ADC_SAMPLE_SIZE);
     Configuration &conf = Configuration::getInstance();
@@ -116,9 +124,10 @@ void HeightSensor::start() {
     adc->registerAdcISR(conID, PULSE_ADC_SAMPLING_DONE);
 
     // ### Start thread for handling interrupt messages.
-    measureThread = std::thread(&HeightSensor::threadFunction, this);
+    measureThread =
+        ThreadRegistry::getInstance().spawn("adc", &HeightSensor::threadFunction, this);
 
-    adc->sample();
+    startSample();
 }
 
 void HeightSensor::stop() {
@@ -162,16 +171,26 @@ void HeightSensor::addValue(int value) {
     window.push_back(value);
 }
 
+void HeightSensor::startSample() {
+    sampleStart = std::chrono::steady_clock::now();
+    adc->sample();
+}
+
 void HeightSensor::threadFunction() {
     ThreadCtl(_NTO_TCTL_IO, 0);   // Request IO privileges for this thread.
 
     Logger::debug("[HM] Height sensor started!");
-    Calibration adcCal = Configuration::getInstance().getCalibration();
+    Configuration &conf = Configuration::getInstance();
+    uint64_t confVersion = conf.getVersion();
+    Calibration adcCal = conf.getCalibration();
     calibrateOffset(adcCal.calOffset);
     calibrateRefHigh(adcCal.calRef);
 
     using namespace std;
     _pulse msg;
+    auto rateStart = chrono::steady_clock::now();
+    uint64_t rateSamples = 0;
+    bool sampled = false;   // ready with the first sample
     running = true;
     while (running) {
         int recvid = MsgReceivePulse(chanID, &msg, sizeof(_pulse), nullptr);
@@ -192,17 +211,42 @@ void HeightSensor::threadFunction() {
             // ADC interrupt value.
             if (msg.code == PULSE_ADC_SAMPLING_DONE) {
                 int heightRaw = msg.value.sival_int;
+                auto now = chrono::steady_clock::now();
+                sampleDelay.record(
+                    chrono::duration_cast<chrono::microseconds>(now - sampleStart).count());
+                if (!sampled) {
+                    Startup::getInstance().ready("height-sensor");
+                    sampled = true;
+                }
+                samples.inc();
+                rateSamples++;
+                if (now - rateStart >= chrono::seconds(1)) {
+                    auto elapsedMs =
+                        chrono::duration_cast<chrono::milliseconds>(now - rateStart).count();
+                    samplesPerSecond.set(rateSamples * 1000 / elapsedMs);
+                    rateStart = now;
+                    rateSamples = 0;
+                }
                 addValue(heightRaw);
                 nMeasurements++;
                 // Every x measurements -> notify via callback
                 if ((nMeasurements % ADC_SAMPLE_SIZE) == 0) {
                     nMeasurements = 0;
+                    // Calibration changed by a reload of the config file
+                    if (conf.getVersion() != confVersion) {
+                        confVersion = conf.getVersion();
+                        adcCal = conf.getCalibration();
+                        calibrateOffset(adcCal.calOffset);
+                        calibrateRefHigh(adcCal.calRef);
+                    }
                     float heightMillimeter = getMedianHeight();
                     if (heightValueCallback != nullptr) {
                         heightValueCallback(heightMillimeter);
                     }
                 }
-                adc->sample();
+                startSample();
+                // counted by the interrupt controller (headless simulation)
+                Quiescence::getInstance().end();
             }
 
             // Do not ignore OS pulses!
@@ -25,6 +25,7 @@
 #include "configuration/Configuration.h"
 #include "events/EventManager.h"
 #include "events/events.h"
+#include "metrics/Metrics.h"
 
 /*---------------------------------------------------------------------------
    ADC CONFIGURATION
@@ -56,6 +57,14 @@ class HeightSensor : public IHeightSensor, public IEventHandler {
     float getMedianHeight() override;
     int getLastRawValue() override;
 
+    /**
+     * Adds a raw ADC value to the window of the last ADC_SAMPLE_SIZE values
+     * (called by the measure thread for each sample)
+     *
+     * @param value raw ADC value
+     */
+    void addValue(int value);
+
   private:
     TSCADC tsc;
     ADC *adc;
@@ -66,8 +75,14 @@ class HeightSensor : public IHeightSensor, public IEventHandler {
     std::vector<int> window;
     int nMeasurements;
     std::mutex mtx;
-    void addValue(int value);
     bool running{false};
+    // Metrics: samples, sample rate and delay from the start of a sample to
+    // its pulse received by the measure thread (ADC interrupt latency)
+    Counter &samples;
+    Gauge &samplesPerSecond;
+    Histogram &sampleDelay;
+    std::chrono::steady_clock::time_point sampleStart;
+    void startSample();
     void threadFunction();
     float adcValueToMillimeter(int adcValue);
 };
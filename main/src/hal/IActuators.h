@@ -9,15 +9,17 @@
 #include <mutex>
 #include <thread>
 
+#include "common/Trace.h"
 #include "configuration/Configuration.h"
 #include "events/IEventManager.h"
 #include "events/events.h"
 #include "logger/logger.hpp"
+#include "metrics/Metrics.h"
 
 
 class IActuators : public IEventHandler {
   public:
-    virtual ~IActuators() {}
+    virtual ~IActuators() { eventManager->unsubscribe(subscription); }
 
     /**
      * Sets all actuators when Standby mode is entered:
@@ -199,17 +201,29 @@ class IActuators : public IEventHandler {
         	errorMode();
         	break;
         case EventType::MOTOR_M_STOP:
-        case EventType::MOTOR_S_STOP:
+        case EventType::MOTOR_S_STOP: {
             motorStop();
+            static Counter &stopCommands = MetricsRegistry::getInstance().counter(
+                "esep_actuator_motor_total{speed=\"stop\"}");
+            stopCommands.inc();
             break;
+        }
         case EventType::MOTOR_M_FAST:
-        case EventType::MOTOR_S_FAST:
+        case EventType::MOTOR_S_FAST: {
             motorFast();
+            static Counter &fastCommands = MetricsRegistry::getInstance().counter(
+                "esep_actuator_motor_total{speed=\"fast\"}");
+            fastCommands.inc();
             break;
+        }
         case EventType::MOTOR_M_SLOW:
-        case EventType::MOTOR_S_SLOW:
+        case EventType::MOTOR_S_SLOW: {
             motorSlow();
+            static Counter &slowCommands = MetricsRegistry::getInstance().counter(
+                "esep_actuator_motor_total{speed=\"slow\"}");
+            slowCommands.inc();
             break;
+        }
         case EventType::MODE_STANDBY:
             standbyMode();
             break;
@@ -239,9 +253,16 @@ class IActuators : public IEventHandler {
             handled = handleLampEvent(event.type, (LampState) event.data);
             break;
         case EventType::SORT_M_OUT:
-        case EventType::SORT_S_OUT:
+        case EventType::SORT_S_OUT: {
+            TraceSpan span("Actuators::switch", event.type);
             event.data == 1 ? sortOut() : letPass();
+            static Counter &sortedOut = MetricsRegistry::getInstance().counter(
+                "esep_actuator_switch_total{action=\"sort_out\"}");
+            static Counter &passed = MetricsRegistry::getInstance().counter(
+                "esep_actuator_switch_total{action=\"let_pass\"}");
+            (event.data == 1 ? sortedOut : passed).inc();
             break;
+        }
         case EventType::WD_CONN_LOST:
 		    connectionLost();
             break;
@@ -330,121 +351,32 @@ class IActuators : public IEventHandler {
     }
 
     void subscribeToEvents() {
-        // Subscribe to lamp events
-
-        // Subscribe to modes
-        eventManager->subscribe(
-            EventType::MODE_STANDBY,
-            std::bind(&IActuators::handleEvent, this, std::placeholders::_1));
-        eventManager->subscribe(
-            EventType::MODE_RUNNING,
-            std::bind(&IActuators::handleEvent, this, std::placeholders::_1));
-        eventManager->subscribe(
-            EventType::MODE_SERVICE,
-            std::bind(&IActuators::handleEvent, this, std::placeholders::_1));
-        eventManager->subscribe(
-            EventType::MODE_ESTOP,
-            std::bind(&IActuators::handleEvent, this, std::placeholders::_1));
-        eventManager->subscribe(
-            EventType::MODE_ERROR,
-            std::bind(&IActuators::handleEvent, this, std::placeholders::_1));
-        eventManager->subscribe(
-			EventType::ESTOP_M_PRESSED,
-			std::bind(&IActuators::handleEvent, this, std::placeholders::_1));
-        eventManager->subscribe(
-			EventType::ESTOP_S_PRESSED,
-			std::bind(&IActuators::handleEvent, this, std::placeholders::_1));
-
-
-        // System-dependent events
+        // Modes and EStop
+        EventMask mask = EventMask::range(EventType::MODE_STANDBY, EventType::MODE_ERROR);
+        mask.add(EventType::ESTOP_M_PRESSED);
+        mask.add(EventType::ESTOP_S_PRESSED);
+
+        // System-dependent events: lamps, LEDs, motor, switch and errors
         if (isMaster) {
-            eventManager->subscribe(
-    			EventType::ERROR_M_MAN_SOLVABLE,
-    			std::bind(&IActuators::handleEvent, this, std::placeholders::_1));
-            eventManager->subscribe(
-    			EventType::ERROR_M_SELF_SOLVABLE,
-    			std::bind(&IActuators::handleEvent, this, std::placeholders::_1));
-            eventManager->subscribe(EventType::LAMP_M_RED,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::LAMP_M_YELLOW,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::LAMP_M_GREEN,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::LED_M_START,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::LED_M_RESET,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::LED_M_Q1,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::LED_M_Q2,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::MOTOR_M_STOP,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::MOTOR_M_FAST,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::MOTOR_M_SLOW,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::SORT_M_OUT,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
+            mask |= EventMask::matching("LAMP_M_*") | EventMask::matching("LED_M_*");
+            mask |= EventMask{EventType::MOTOR_M_STOP, EventType::MOTOR_M_FAST,
+                              EventType::MOTOR_M_SLOW, EventType::SORT_M_OUT,
+                              EventType::ERROR_M_MAN_SOLVABLE,
+                              EventType::ERROR_M_SELF_SOLVABLE};
         } else {
-            eventManager->subscribe(
-    			EventType::ERROR_S_MAN_SOLVABLE,
-    			std::bind(&IActuators::handleEvent, this, std::placeholders::_1));
-            eventManager->subscribe(
-    			EventType::ERROR_S_SELF_SOLVABLE,
-    			std::bind(&IActuators::handleEvent, this, std::placeholders::_1));
-            eventManager->subscribe(EventType::LAMP_S_RED,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::LAMP_S_YELLOW,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::LAMP_S_GREEN,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::LED_S_START,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::LED_S_RESET,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::LED_S_Q1,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::LED_S_Q2,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::MOTOR_S_STOP,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::MOTOR_S_FAST,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::MOTOR_S_SLOW,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::SORT_S_OUT,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
-            eventManager->subscribe(EventType::WD_CONN_LOST,
-                                    std::bind(&IActuators::handleEvent, this,
-                                              std::placeholders::_1));
+            mask |= EventMask::matching("LAMP_S_*") | EventMask::matching("LED_S_*");
+            mask |= EventMask{EventType::MOTOR_S_STOP, EventType::MOTOR_S_FAST,
+                              EventType::MOTOR_S_SLOW, EventType::SORT_S_OUT,
+                              EventType::ERROR_S_MAN_SOLVABLE,
+                              EventType::ERROR_S_SELF_SOLVABLE,
+                              EventType::WD_CONN_LOST};
         }
+        subscription = eventManager->subscribe(mask, this);
     }
 
   private:
     std::shared_ptr<IEventManager> eventManager;
+    SubscriptionId subscription = 0;
     std::mutex mutex;
     bool isMaster;
 };
@@ -9,6 +9,10 @@
 
 #include <string>
 
+#include "common/Quiescence.h"
+#include "common/Startup.h"
+#include "common/ThreadRegistry.h"
+#include "common/Trace.h"
 #include "common/macros.h"
 #include "configuration/Configuration.h"
 #include "events/events.h"
@@ -44,10 +48,6 @@ Sensors::Sensors(std::shared_ptr<EventManager> mngr) : eventManager(mngr) {
 
     if (connect(mngr)) {
         Logger::debug("[Sensors] Connected to EventManager");
-        //belongs to the cheat for wd_conn_lost
-        mngr->subscribe(
-        EventType::WD_CONN_LOST,
-        std::bind(&Sensors::setDisconnect, this, std::placeholders::_1));
     } else {
         Logger::error("[Sensors] Error while connecting to EventManager");
     }
@@ -84,7 +84,6 @@ Sensors::~Sensors() {
 
     disconnect();
 }
-void Sensors::setDisconnect(Event event){ disconnected = true; }
 
 
 void Sensors::configurePins() {
@@ -170,7 +169,7 @@ void Sensors::handleEvent(Event event) {
 
 void Sensors::startEventLoop() {
     /* ### Start thread for handling interrupt messages. */
-    eventLoopThread = std::thread(&Sensors::eventLoop, this);
+    eventLoopThread = ThreadRegistry::getInstance().spawn("sensors", &Sensors::eventLoop, this);
 }
 
 void Sensors::stopEventLoop() {
@@ -245,6 +244,7 @@ void Sensors::eventLoop() {
 
     _pulse msg;
     receivingRunning = true;
+    Startup::getInstance().ready("sensors");
     while (receivingRunning) {
         int recvid = MsgReceivePulse(chanID, &msg, sizeof(_pulse), nullptr);
         if (recvid < 0) {
@@ -262,6 +262,8 @@ void Sensors::eventLoop() {
 
             if (msg.code == PULSE_INTR_ON_PORT0) {
                 handleGpioInterrupt();
+                // counted by the interrupt controller (headless simulation)
+                Quiescence::getInstance().end();
             }
 
             // Do not ignore OS pulses!
@@ -272,6 +274,7 @@ void Sensors::eventLoop() {
 }
 
 void Sensors::handleGpioInterrupt() {
+    TraceSpan span("Sensors::handleGpioInterrupt");
     uint32_t intrStatusReg = in32(GPIO_IRQSTATUS_1(gpio_bank_0));
 
     // clear interrupts and unmask
@@ -286,11 +289,6 @@ void Sensors::handleGpioInterrupt() {
             Logger::debug("[Sensors] ESTOP pressed");
             event.type = isMaster ? EventType::ESTOP_M_PRESSED
                                   : EventType::ESTOP_S_PRESSED;
-            // not pretty but avoids delay when evm is down
-            // direct call estop functions irq
-            if(disconnected){
-            eventManager->handleEvent(event.type);
-            }
         } else {
             Logger::debug("[Sensors] ESTOP released");
             event.type = isMaster ? EventType::ESTOP_M_RELEASED
@@ -397,6 +395,9 @@ void Sensors::handleGpioInterrupt() {
 
     // If IRQ is associated to an event, we send it!
     if ((int) event.type != -1) {
+        // each edge starts a trace (if enabled)
+        event.traceId = Tracer::getInstance().newTrace();
+        span.setTrace(event.traceId, event.type);
         sendEvent(event);
     }
 }
@@ -160,5 +160,5 @@ class TSCADC {
     unsigned int intStatus();
 
   private:
-    unsigned int baseAdd;
+    uintptr_t baseAdd;
 };
@@ -34,7 +34,7 @@
 #include <fstream>
 
 #include "common/macros.h"
-#include "events/EventManager.h"
+#include "events/IEventManager.h"
 #include "events/events.h"
 
 #define DEFAULT_LOG_FILE_FOLDER  "/tmp/esep_2.1/"
@@ -100,7 +100,7 @@ public:
 	 * @param eventManager reference to the EventManager where the Logger should
 	 * subscribe to all events
 	 */
-	static void registerEvents(std::shared_ptr<EventManager> eventManager) {
+	static void registerEvents(std::shared_ptr<IEventManager> eventManager) {
 		int nEvents = eventManager->subscribeToAllEvents(std::bind(&Logger::logEvent, std::placeholders::_1));
 		std::stringstream ss;
 		ss << "[Logger] Registered to all events (" << nEvents
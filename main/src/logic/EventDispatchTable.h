@@ -0,0 +1,70 @@
+/*
+ * EventDispatchTable.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "events/EventMask.h"
+#include "events/events.h"
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+
+/**
+ * Lookup table which maps an EventType directly to the handler of a
+ * FSM context. Replaces long switch statements in handleEvent(): the table
+ * is built once and dispatching an event is a single indexed call.
+ * The table selects the handler only, the target state of a transition is
+ * still chosen by the current state object.
+ */
+template <class Context> class EventDispatchTable {
+  public:
+    using Handler = void (*)(Context &context, const Event &event);
+
+    struct Entry {
+        EventType type;
+        Handler handler;
+    };
+
+    EventDispatchTable(std::initializer_list<Entry> entries) {
+        handlers.fill(nullptr);
+        for (const Entry &entry : entries) {
+            handlers[entry.type] = entry.handler;
+            events.add(entry.type);
+        }
+    }
+
+    /**
+     * Calls the handler registered for the event.
+     *
+     * @return true if a handler was registered for the event type
+     */
+    bool dispatch(Context &context, const Event &event) const {
+        if (event.type < 0 || event.type >= (int) EVENT_TYPE_COUNT) {
+            return false;
+        }
+        Handler handler = handlers[event.type];
+        if (handler == nullptr) {
+            return false;
+        }
+        handler(context, event);
+        return true;
+    }
+
+    bool handles(EventType type) const {
+        return type >= 0 && type < (int) EVENT_TYPE_COUNT &&
+               handlers[type] != nullptr;
+    }
+
+    /**
+     * @return all event types contained in the table, e.g. to subscribe to
+     * them with a single call
+     */
+    const EventMask &getEvents() const { return events; }
+
+  private:
+    std::array<Handler, EVENT_TYPE_COUNT> handlers;
+    EventMask events;
+};
@@ -0,0 +1,111 @@
+/*
+ * LinkSync.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "LinkSync.h"
+
+MasterLinkSync::MasterLinkSync(MainContext *mainFSM) : mainFSM(mainFSM) {
+}
+
+void MasterLinkSync::fill(LinkDigest &digest) {
+    MainContextData *data = mainFSM->data;
+    digest.set(LinkSection::RAMP_FBM2, data->isRampFBM2Blocked());
+    digest.set(LinkSection::ENTRY_FBM2, linkBarrier(data->entryFBM2.blocked, data->entryFBM2.passed));
+    digest.set(LinkSection::EXIT_FBM2, linkBarrier(data->exitFBM2.blocked, data->exitFBM2.passed));
+    digest.set(LinkSection::RAMP_FBM1, data->isRampFBM1Blocked(), true);
+    WorkpieceManager *wpm = data->wpManager;
+    digest.set(LinkSection::AREAS,
+               linkAreas(wpm->getNumberOfWorkpieces(AreaType::AREA_A),
+                         wpm->getNumberOfWorkpieces(AreaType::AREA_B),
+                         wpm->getNumberOfWorkpieces(AreaType::AREA_C),
+                         wpm->getNumberOfWorkpieces(AreaType::AREA_D)),
+               true);
+    digest.set(LinkSection::MAIN_STATE, mainFSM->getCurrentState(), true);
+}
+
+void MasterLinkSync::apply(LinkSection section, uint32_t value) {
+    switch (section) {
+    case LinkSection::RAMP_FBM2:
+        // Edge missed while disconnected
+        mainFSM->handleEvent(Event{value ? LBR_S_BLOCKED : LBR_S_UNBLOCKED});
+        break;
+    case LinkSection::ENTRY_FBM2:
+        applyBarrier(mainFSM->data->entryFBM2, value, true);
+        break;
+    case LinkSection::EXIT_FBM2:
+        applyBarrier(mainFSM->data->exitFBM2, value, false);
+        break;
+    default:
+        // owned by the master
+        break;
+    }
+}
+
+void MasterLinkSync::beliefDiffers(LinkSection section, uint32_t belief) {
+    if (section == LinkSection::MAIN_STATE) {
+        // Mode sent while disconnected
+        mainFSM->resendMode();
+    }
+}
+
+void MasterLinkSync::applyBarrier(MainContextData::BarrierFBM2 &belief, uint32_t value, bool entry) {
+    EventType blockedEvent = entry ? LBA_S_BLOCKED : LBE_S_BLOCKED;
+    EventType unblockedEvent = entry ? LBA_S_UNBLOCKED : LBE_S_UNBLOCKED;
+    bool blocked = linkBarrierBlocked(value);
+    uint32_t missed = linkBarrierPassedSince(value, linkBarrier(belief.blocked, belief.passed));
+    if (missed > 0 && belief.blocked) {
+        // Workpiece in the light barrier has passed
+        mainFSM->handleEvent(Event{unblockedEvent});
+        missed--;
+    }
+    if (missed > 0) {
+        // Workpieces passed completely while disconnected
+        mainFSM->slave_passesMissed(entry ? missed : 0, entry ? 0 : missed);
+    }
+    if (blocked != belief.blocked) {
+        mainFSM->handleEvent(Event{blocked ? blockedEvent : unblockedEvent});
+    }
+    // The slave counts the passes
+    belief.blocked = blocked;
+    belief.passed = value >> 1;
+}
+
+SlaveLinkSync::SlaveLinkSync(std::shared_ptr<IEventManager> eventManager, Blocked rampBlocked,
+                             Blocked entryBlocked, Blocked exitBlocked)
+    : rampBlocked(rampBlocked), entryBlocked(entryBlocked), exitBlocked(exitBlocked) {
+    eventManager->subscribe(EventType::LBA_S_UNBLOCKED, [this](Event) { entered++; });
+    eventManager->subscribe(EventType::LBE_S_UNBLOCKED, [this](Event) { left++; });
+    eventManager->subscribe(EventType::LBR_M_BLOCKED, [this](Event) { rampFBM1Blocked = true; });
+    eventManager->subscribe(EventType::LBR_M_UNBLOCKED, [this](Event) { rampFBM1Blocked = false; });
+    eventManager->subscribe(EventType::MODE_STANDBY, [this](Event) { mainState = MainState::STANDBY; });
+    eventManager->subscribe(EventType::MODE_RUNNING, [this](Event) { mainState = MainState::RUNNING; });
+    eventManager->subscribe(EventType::MODE_SERVICE, [this](Event) { mainState = MainState::SERVICEMODE; });
+    eventManager->subscribe(EventType::MODE_ESTOP, [this](Event) { mainState = MainState::ESTOP; });
+    eventManager->subscribe(EventType::MODE_ERROR, [this](Event) { mainState = MainState::ERROR; });
+}
+
+void SlaveLinkSync::fill(LinkDigest &digest) {
+    digest.set(LinkSection::RAMP_FBM2, rampBlocked(), true);
+    digest.set(LinkSection::ENTRY_FBM2, linkBarrier(entryBlocked(), entered), true);
+    digest.set(LinkSection::EXIT_FBM2, linkBarrier(exitBlocked(), left), true);
+    digest.set(LinkSection::RAMP_FBM1, rampFBM1Blocked);
+    digest.set(LinkSection::AREAS, areas);
+    digest.set(LinkSection::MAIN_STATE, mainState);
+}
+
+void SlaveLinkSync::apply(LinkSection section, uint32_t value) {
+    switch (section) {
+    case LinkSection::RAMP_FBM1:
+        rampFBM1Blocked = value != 0;
+        break;
+    case LinkSection::AREAS:
+        areas = value;
+        break;
+    default:
+        // MAIN_STATE follows the mode the master sends again, the others are
+        // owned by the slave
+        break;
+    }
+}
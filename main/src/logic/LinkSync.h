@@ -0,0 +1,67 @@
+/*
+ * LinkSync.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "events/IEventManager.h"
+#include "events/LinkDigest.h"
+#include "logic/main_fsm/MainContext.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+/**
+ * State of the master for the digest after a reconnect: owns the state of
+ * the main FSM, has a belief about the light barriers of FBM2. Edges missed
+ * while disconnected are passed to the main FSM, which reconciles them with
+ * the workpieces of Area_D. A slave which missed a mode gets it again.
+ */
+class MasterLinkSync : public ISyncParticipant {
+  public:
+    MasterLinkSync(MainContext *mainFSM);
+
+    void fill(LinkDigest &digest) override;
+    void apply(LinkSection section, uint32_t value) override;
+    void beliefDiffers(LinkSection section, uint32_t belief) override;
+
+  private:
+    MainContext *mainFSM;
+
+    void applyBarrier(MainContextData::BarrierFBM2 &belief, uint32_t value, bool entry);
+};
+
+/**
+ * State of the slave for the digest after a reconnect: owns the light
+ * barriers of FBM2. The passes are counted from the events of the own
+ * sensors, the occupancy is read from the light barrier. The belief about
+ * the ramp and the areas of the master is adopted from the digest of the
+ * master, the belief about its state follows the received modes only.
+ */
+class SlaveLinkSync : public ISyncParticipant {
+  public:
+    using Blocked = std::function<bool()>;
+
+    SlaveLinkSync(std::shared_ptr<IEventManager> eventManager, Blocked rampBlocked,
+                  Blocked entryBlocked, Blocked exitBlocked);
+
+    void fill(LinkDigest &digest) override;
+    void apply(LinkSection section, uint32_t value) override;
+
+    bool getRampFBM1Blocked() { return rampFBM1Blocked; }
+    uint32_t getAreas() { return areas; }
+    MainState getMainState() { return mainState; }
+
+  private:
+    Blocked rampBlocked;
+    Blocked entryBlocked;
+    Blocked exitBlocked;
+    std::atomic<uint32_t> entered{0};
+    std::atomic<uint32_t> left{0};
+    // belief about the master
+    std::atomic<bool> rampFBM1Blocked{false};
+    std::atomic<uint32_t> areas{0};
+    std::atomic<MainState> mainState{MainState::STANDBY};
+};
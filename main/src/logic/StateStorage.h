@@ -0,0 +1,83 @@
+/*
+ * StateStorage.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/**
+ * Preallocated memory for the state object of a FSM (or a substate).
+ * States are constructed in place, so entering a state never allocates
+ * memory on the heap. Transitions inside a state replace the state at its
+ * own address with transition(), because all states share the same storage.
+ *
+ * Only the declaration of Base is needed where the storage is declared,
+ * the complete type is needed where states are created or destroyed.
+ *
+ * The storage only removes the heap allocation per transition. Transitions,
+ * entry/exit and history stay in the state classes, there is no
+ * (state, event) -> target table.
+ */
+template <class Base, std::size_t Size> class StateStorage {
+  public:
+    StateStorage() = default;
+    ~StateStorage() { destroy(); }
+
+    StateStorage(const StateStorage &) = delete;
+    StateStorage &operator=(const StateStorage &) = delete;
+
+    /**
+     * Destroys the current state and constructs a new state of type S.
+     *
+     * @return pointer to the new state
+     */
+    template <class S> Base *create() {
+        check<S>();
+        destroy();
+        current = new (buffer) S;
+        return current;
+    }
+
+    /**
+     * Replaces a state in the storage by a new state of type S, used for
+     * transitions inside a state: 'exit(); transitionTo<Next>(); entry();'.
+     * The replaced state is destroyed before the new state is constructed,
+     * the caller has to save the members it passes on to the new state
+     * (data and actions pointers, see transitionTo() of the base states).
+     *
+     * @return pointer to the new state (same address as the replaced state)
+     */
+    template <class S> static Base *transition(Base *state) {
+        check<S>();
+        state->~Base();
+        return new (state) S;
+    }
+
+    /**
+     * Destroys the current state (if there is one).
+     */
+    void destroy() {
+        if (current != nullptr) {
+            current->~Base();
+            current = nullptr;
+        }
+    }
+
+    Base *get() const { return current; }
+
+  private:
+    template <class S> static void check() {
+        static_assert(std::is_base_of<Base, S>::value,
+                      "State must be derived from the base state");
+        static_assert(sizeof(S) <= Size, "State does not fit into storage");
+        static_assert(alignof(S) <= alignof(std::max_align_t),
+                      "State alignment not supported");
+    }
+
+    alignas(std::max_align_t) unsigned char buffer[Size];
+    Base *current = nullptr;
+};
@@ -9,6 +9,10 @@
 #include "HeightActions.h"
 #include "HeightContextData.h"
 #include "logger/logger.hpp"
+#include "logic/StateStorage.h"
+
+// Bytes reserved for the height state
+#define HEIGHT_STATE_STORAGE_SIZE 64
 
 enum HeightState { HEIGHT_NONE, WAIT_FOR_WS, WAIT_FOR_BELT };
 
@@ -50,4 +54,14 @@ class HeightBasestate {
      * The motor is running
      */
     virtual bool motorRunning() { return false; }
+
+  protected:
+    // Transition to the state S, which must fit into the storage of this state
+    template <class S> void transitionTo() {
+        HeightActions *actions = this->actions;
+        HeightContextData *data = this->data;
+        HeightBasestate *next = StateStorage<HeightBasestate, HEIGHT_STATE_STORAGE_SIZE>::transition<S>(this);
+        next->actions = actions;
+        next->data = data;
+    }
 };
@@ -18,7 +18,7 @@ HeightContext::HeightContext(HeightActions* actions, HeightContextData* data,
 	this->sensor = heightSensor;
 	this->data = data;
 	nBeltDetected = 0;
-	state = new WaitForWorkpiece();
+	state = stateStorage.create<WaitForWorkpiece>();
 	state->setData(data);
 	state->setAction(actions);
 	state->entry();
@@ -31,58 +31,46 @@ HeightContext::HeightContext(HeightActions* actions, HeightContextData* data,
 }
 
 HeightContext::~HeightContext() {
+	actions->eventManager->unsubscribe(subscription);
 	if (sensor != nullptr) {
 		sensor->stop();
 	}
-	delete state;
+	stateStorage.destroy();
 	delete actions;
 	delete data;
 }
 
 void HeightContext::subscribeToEvents() {
-	if (isMaster) {
-		actions->eventManager->subscribe(EventType::MOTOR_M_FAST,
-				std::bind(&HeightContext::handleEvent, this,
-						std::placeholders::_1));
-		actions->eventManager->subscribe(EventType::MOTOR_M_SLOW,
-				std::bind(&HeightContext::handleEvent, this,
-						std::placeholders::_1));
-		actions->eventManager->subscribe(EventType::MOTOR_M_STOP,
-				std::bind(&HeightContext::handleEvent, this,
-						std::placeholders::_1));
-	} else {
-		actions->eventManager->subscribe(EventType::MOTOR_S_FAST,
-				std::bind(&HeightContext::handleEvent, this,
-						std::placeholders::_1));
-		actions->eventManager->subscribe(EventType::MOTOR_S_SLOW,
-				std::bind(&HeightContext::handleEvent, this,
-						std::placeholders::_1));
-		actions->eventManager->subscribe(EventType::MOTOR_S_STOP,
-				std::bind(&HeightContext::handleEvent, this,
-						std::placeholders::_1));
-	}
+	// Only the state of the own motor
+	EventMask system = EventMask::matching(isMaster ? "*_M_*" : "*_S_*");
+	subscription = actions->eventManager->subscribe(dispatchTable().getEvents() & system, this);
+}
+
+const EventDispatchTable<HeightContext>& HeightContext::dispatchTable() {
+	static const EventDispatchTable<HeightContext> table = {
+		{ EventType::MOTOR_M_FAST, &HeightContext::onMotorRunning },
+		{ EventType::MOTOR_S_FAST, &HeightContext::onMotorRunning },
+		{ EventType::MOTOR_M_SLOW, &HeightContext::onMotorRunning },
+		{ EventType::MOTOR_S_SLOW, &HeightContext::onMotorRunning },
+		{ EventType::MOTOR_M_STOP, &HeightContext::onMotorStopped },
+		{ EventType::MOTOR_S_STOP, &HeightContext::onMotorStopped },
+	};
+	return table;
+}
+
+void HeightContext::onMotorRunning(HeightContext &ctx, const Event &event) {
+	Logger::debug("[HM] Motor running -> start measurement");
+	ctx.running = true;
+}
+
+void HeightContext::onMotorStopped(HeightContext &ctx, const Event &event) {
+	Logger::debug("[HM] Motor stopped -> stop measurement");
+	ctx.running = false;
 }
 
 void HeightContext::handleEvent(Event event) {
 	Logger::debug("[HFSM] handleEvent: " + EVENT_TO_STRING(event.type));
-	switch (event.type) {
-	case EventType::MOTOR_M_FAST:
-	case EventType::MOTOR_S_FAST:
-	case EventType::MOTOR_M_SLOW:
-	case EventType::MOTOR_S_SLOW: {
-		Logger::debug("[HM] Motor running -> start measurement");
-		this->running = true;
-		// sensor->start();
-		break;
-	}
-	case EventType::MOTOR_M_STOP:
-	case EventType::MOTOR_S_STOP: {
-		Logger::debug("[HM] Motor stopped -> stop measurement");
-		this->running = false;
-		// sensor->stop();
-		break;
-	}
-	default:
+	if (!dispatchTable().dispatch(*this, event)) {
 		Logger::warn("[HFSM] Event was not handled: " + EVENT_TO_STRING(event.type));
 	}
 }
@@ -17,6 +17,8 @@
 #include "events/events.h"
 #include "hal/HeightSensor.h"
 #include "hal/IHeightSensor.h"
+#include "logic/EventDispatchTable.h"
+#include "logic/StateStorage.h"
 
 #define BELT_THRESHOLD 5
 
@@ -41,10 +43,16 @@ class HeightContext : public IEventHandler {
     std::shared_ptr<IEventManager> eventManager;
     HeightActions *actions;
     HeightBasestate *state;
+    StateStorage<HeightBasestate, HEIGHT_STATE_STORAGE_SIZE> stateStorage;
     HeightContextData *data;
     std::shared_ptr<IHeightSensor> sensor;
     bool isMaster;
     bool running;
     int nBeltDetected;
+    SubscriptionId subscription = 0;
     void subscribeToEvents();
+
+    static const EventDispatchTable<HeightContext>& dispatchTable();
+    static void onMotorRunning(HeightContext &ctx, const Event &event);
+    static void onMotorStopped(HeightContext &ctx, const Event &event);
 };
@@ -23,7 +23,7 @@ bool WaitForBelt::beltDetected() {
     actions->sendHeightResult();
     actions->sendMotorSlowRequest(false);
     exit();
-    new (this) WaitForWorkpiece;
+    transitionTo<WaitForWorkpiece>();
     entry();
     return true;
 }
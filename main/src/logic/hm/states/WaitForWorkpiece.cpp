@@ -25,7 +25,7 @@ bool WaitForWorkpiece::workpieceHeightDetected(float height) {
 	data->addValue(height);
     actions->sendMotorSlowRequest(true);
     exit();
-    new (this) WaitForBelt;
+    transitionTo<WaitForBelt>();
     entry();
     return true;
 }
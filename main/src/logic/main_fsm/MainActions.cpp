@@ -6,6 +6,7 @@
  */
 
 #include "MainActions.h"
+#include "common/Trace.h"
 #include "configuration/Configuration.h"
 #include "hal/HeightSensor.h"
 #include "hal/IActuators.h"
@@ -63,7 +64,12 @@ void MainActions::slave_sendMotorRightRequest(bool right) {
     sender->sendEvent(event);
 }
 
+void MainActions::sendHandoverGapElapsed() {
+    sender->sendEvent(Event{HANDOVER_GAP_ELAPSED});
+}
+
 void MainActions::master_openGate(bool open) {
+    TraceSpan span("MainActions::master_openGate");
     // (EventData) 0: sort out, 1: open gate
     int eventData = open ? 0 : 1;
     sender->sendEvent(Event{SORT_M_OUT, eventData});
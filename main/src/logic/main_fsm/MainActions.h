@@ -23,6 +23,7 @@ class MainActions {
     void slave_sendMotorStopRequest(bool stop);
     void master_sendMotorRightRequest(bool right);
     void slave_sendMotorRightRequest(bool right);
+    void sendHandoverGapElapsed();
     void master_openGate(bool open);
     void slave_openGate(bool open);
     void setStandbyMode();
@@ -20,7 +20,7 @@ class MainBasestate {
     MainBasestate *substateError = nullptr;
     MainActions *actions;
     MainContextData *data;
-    MainState previousState;
+    MainState previousState = MAIN_NONE;
 
   public:
     virtual ~MainBasestate() {}
@@ -76,6 +76,12 @@ class MainBasestate {
     virtual bool slave_LBR_Blocked() { return false; }     // Rampe blockiert
     virtual bool slave_LBR_Unblocked() { return false; }   // Rampe wieder frei
 
+    /**
+     * Workpieces passed the start or the end of FBM2 while the connection to
+     * the slave was lost (resync after the reconnect).
+     */
+    virtual bool slave_passesMissed(int entered, int left) { return false; }
+
     // Buttons
     virtual bool master_btnStart_PressedShort() { return false; }
     virtual bool master_btnStart_PressedLong() { return false; }
@@ -96,7 +102,26 @@ class MainBasestate {
     virtual bool slave_EStop_Pressed() { return false; }
     virtual bool slave_EStop_Released() { return false; }
 
+    // Handover FBM1 -> FBM2: minimum gap elapsed or FBM2 started moving
+    virtual bool handoverCheck() { return false; }
+
     virtual bool selfSolvableErrorOccurred() { return false; }
     virtual bool errorSelfSolved() { return false; }
     virtual bool nonSelfSolvableErrorOccurred() { return false; }
+
+    // Link to the slave reestablished and resynchronized (WD_CONN_REESTABLISHED)
+    virtual bool connectionReestablished() { return false; }
+
+  protected:
+    // Transition to the state S, which must fit into the storage of this state
+    template <class S> void transitionTo() {
+        MainActions *actions = this->actions;
+        MainContextData *data = this->data;
+        MainState previousState = this->previousState;
+        MainBasestate *next =
+            StateStorage<MainBasestate, MAIN_STATE_STORAGE_SIZE>::transition<S>(this);
+        next->actions = actions;
+        next->data = data;
+        next->previousState = previousState;
+    }
 };
@@ -8,15 +8,19 @@
 #include "MainContext.h"
 #include "MainActions.h"
 #include "MainContextData.h"
+#include "common/Trace.h"
 #include "logger/logger.hpp"
 #include "states/Standby.h"
 
 #include <memory>
 
+// Table entry which calls a handler method without parameters
+#define MAIN_HANDLER(method) [](MainContext &ctx, const Event &) { ctx.method(); }
+
 MainContext::MainContext(MainActions* actions) {
 	this->actions = actions;
 	this->data = new MainContextData();
-	this->state = new Standby();
+	this->state = stateStorage.create<Standby>();
 	state->setAction(this->actions);
 	state->setData(this->data);
 	state->entry();
@@ -24,251 +28,102 @@ MainContext::MainContext(MainActions* actions) {
 }
 
 MainContext::~MainContext() {
-	delete state;
+	actions->eventManager->unsubscribe(subscription);
+	stateStorage.destroy();
 	delete data;
 	delete actions;
 }
 
+const EventDispatchTable<MainContext>& MainContext::dispatchTable() {
+	static const EventDispatchTable<MainContext> table = {
+		// Buttons and EStop
+		{ EventType::START_M_SHORT, MAIN_HANDLER(master_btnStart_PressedShort) },
+		{ EventType::START_M_LONG, MAIN_HANDLER(master_btnStart_PressedLong) },
+		{ EventType::STOP_M_SHORT, MAIN_HANDLER(master_btnStop_Pressed) },
+		{ EventType::RESET_M_SHORT, MAIN_HANDLER(master_btnReset_Pressed) },
+		{ EventType::RESET_M_LONG, MAIN_HANDLER(master_btnReset_PressedLong) },
+		{ EventType::ESTOP_M_PRESSED, MAIN_HANDLER(master_EStop_Pressed) },
+		{ EventType::ESTOP_M_RELEASED, MAIN_HANDLER(master_EStop_Released) },
+		{ EventType::START_S_SHORT, MAIN_HANDLER(slave_btnStart_PressedShort) },
+		{ EventType::START_S_LONG, MAIN_HANDLER(slave_btnStart_PressedLong) },
+		{ EventType::STOP_S_SHORT, MAIN_HANDLER(slave_btnStop_Pressed) },
+		{ EventType::RESET_S_SHORT, MAIN_HANDLER(slave_btnReset_Pressed) },
+		{ EventType::RESET_S_LONG, MAIN_HANDLER(slave_btnReset_PressedLong) },
+		{ EventType::ESTOP_S_PRESSED, MAIN_HANDLER(slave_EStop_Pressed) },
+		{ EventType::ESTOP_S_RELEASED, MAIN_HANDLER(slave_EStop_Released) },
+
+		// Light barriers
+		{ EventType::LBA_M_BLOCKED, MAIN_HANDLER(master_LBA_Blocked) },
+		{ EventType::LBA_M_UNBLOCKED, MAIN_HANDLER(master_LBA_Unblocked) },
+		{ EventType::LBW_M_BLOCKED, MAIN_HANDLER(master_LBW_Blocked) },
+		{ EventType::LBW_M_UNBLOCKED, MAIN_HANDLER(master_LBW_Unblocked) },
+		{ EventType::LBE_M_BLOCKED, MAIN_HANDLER(master_LBE_Blocked) },
+		{ EventType::LBE_M_UNBLOCKED, MAIN_HANDLER(master_LBE_Unblocked) },
+		{ EventType::LBR_M_BLOCKED, MAIN_HANDLER(master_LBR_Blocked) },
+		{ EventType::LBR_M_UNBLOCKED, MAIN_HANDLER(master_LBR_Unblocked) },
+		{ EventType::LBA_S_BLOCKED, MAIN_HANDLER(slave_LBA_Blocked) },
+		{ EventType::LBA_S_UNBLOCKED, MAIN_HANDLER(slave_LBA_Unblocked) },
+		{ EventType::LBW_S_BLOCKED, MAIN_HANDLER(slave_LBW_Blocked) },
+		{ EventType::LBW_S_UNBLOCKED, MAIN_HANDLER(slave_LBW_Unblocked) },
+		{ EventType::LBE_S_BLOCKED, MAIN_HANDLER(slave_LBE_Blocked) },
+		{ EventType::LBE_S_UNBLOCKED, MAIN_HANDLER(slave_LBE_Unblocked) },
+		{ EventType::LBR_S_BLOCKED, MAIN_HANDLER(slave_LBR_Blocked) },
+		{ EventType::LBR_S_UNBLOCKED, MAIN_HANDLER(slave_LBR_Unblocked) },
+
+		// Height Sensor
+		{ EventType::HM_M_WS_UNKNOWN, &MainContext::onMasterHeightResult },
+		{ EventType::HM_M_WS_F, &MainContext::onMasterHeightResult },
+		{ EventType::HM_M_WS_OB, &MainContext::onMasterHeightResult },
+		{ EventType::HM_M_WS_BOM, &MainContext::onMasterHeightResult },
+		{ EventType::HM_S_WS_UNKNOWN, &MainContext::onSlaveHeightResult },
+		{ EventType::HM_S_WS_F, &MainContext::onSlaveHeightResult },
+		{ EventType::HM_S_WS_OB, &MainContext::onSlaveHeightResult },
+		{ EventType::HM_S_WS_BOM, &MainContext::onSlaveHeightResult },
+
+		// Metal Sensor
+		{ EventType::MD_M_PAYLOAD, MAIN_HANDLER(master_metalDetected) },
+		{ EventType::MD_S_PAYLOAD, MAIN_HANDLER(slave_metalDetected) },
+
+		// Handover FBM1 -> FBM2: gap only elapses while FBM2 is moving
+		{ EventType::MOTOR_S_FAST, [](MainContext &ctx, const Event &) { ctx.slave_motorMoving(true); } },
+		{ EventType::MOTOR_S_SLOW, [](MainContext &ctx, const Event &) { ctx.slave_motorMoving(true); } },
+		{ EventType::MOTOR_S_STOP, [](MainContext &ctx, const Event &) { ctx.slave_motorMoving(false); } },
+		{ EventType::HANDOVER_GAP_ELAPSED, MAIN_HANDLER(handoverCheck) },
+
+		// Errors and error-solved events
+		{ EventType::ERROR_M_SELF_SOLVABLE, MAIN_HANDLER(selfSolvableErrorOccurred) },
+		{ EventType::ERROR_S_SELF_SOLVABLE, MAIN_HANDLER(selfSolvableErrorOccurred) },
+		{ EventType::ERROR_M_MAN_SOLVABLE, MAIN_HANDLER(nonSelfSolvableErrorOccurred) },
+		{ EventType::ERROR_S_MAN_SOLVABLE, MAIN_HANDLER(nonSelfSolvableErrorOccurred) },
+		{ EventType::ERROR_M_SELF_SOLVED, MAIN_HANDLER(errorSelfSolved) },
+		{ EventType::ERROR_S_SELF_SOLVED, MAIN_HANDLER(errorSelfSolved) },
+		{ EventType::WD_CONN_REESTABLISHED, MAIN_HANDLER(connectionReestablished) },
+		{ EventType::HAL_PUSHER_MOUNTED, [](MainContext &ctx, const Event &) {
+			ctx.data->slave_pusherMounted = true;
+		} },
+	};
+	return table;
+}
+
+void MainContext::onMasterHeightResult(MainContext &ctx, const Event &event) {
+	ctx.master_heightResultReceived(event.type, ((float) event.data) / 10);
+}
+
+void MainContext::onSlaveHeightResult(MainContext &ctx, const Event &event) {
+	ctx.slave_heightResultReceived(event.type, ((float) event.data) / 10);
+}
+
 void MainContext::subscribeToEvents() {
-	actions->eventManager->subscribe(EventType::START_M_SHORT,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::START_M_LONG,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::STOP_M_SHORT,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::RESET_M_SHORT,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::RESET_M_LONG,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::ESTOP_M_PRESSED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::ESTOP_M_RELEASED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-
-	actions->eventManager->subscribe(EventType::START_S_SHORT,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::START_S_LONG,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::STOP_S_SHORT,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::RESET_S_SHORT,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::RESET_S_LONG,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::ESTOP_S_PRESSED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::ESTOP_S_RELEASED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-
-	actions->eventManager->subscribe(EventType::LBA_M_BLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBA_M_UNBLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBW_M_BLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBW_M_UNBLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBE_M_BLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBE_M_UNBLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBR_M_BLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBR_M_UNBLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-
-	actions->eventManager->subscribe(EventType::LBA_S_BLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBA_S_UNBLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBW_S_BLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBW_S_UNBLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBE_S_BLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBE_S_UNBLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBR_S_BLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::LBR_S_UNBLOCKED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-
-	// Height Sensor
-	actions->eventManager->subscribe(EventType::HM_M_WS_UNKNOWN,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::HM_M_WS_F,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::HM_M_WS_OB,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::HM_M_WS_BOM,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::HM_S_WS_UNKNOWN,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::HM_S_WS_F,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::HM_S_WS_OB,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::HM_S_WS_BOM,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-
-	// Metal Sensor
-	actions->eventManager->subscribe(EventType::MD_M_PAYLOAD,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::MD_S_PAYLOAD,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-
-	// Subscribe to errors and error-solved event
-	actions->eventManager->subscribe(EventType::ERROR_M_SELF_SOLVABLE,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::ERROR_M_MAN_SOLVABLE,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::ERROR_M_SELF_SOLVED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::ERROR_S_SELF_SOLVABLE,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::ERROR_S_MAN_SOLVABLE,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::ERROR_S_SELF_SOLVED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
-	actions->eventManager->subscribe(EventType::HAL_PUSHER_MOUNTED,
-			std::bind(&MainContext::handleEvent, this, std::placeholders::_1));
+	subscription = actions->eventManager->subscribe(dispatchTable().getEvents(), this);
 }
 
 void MainContext::handleEvent(Event event) {
+	TraceSpan span("MainContext::handleEvent", event.type);
 	Logger::debug("MainFSM handle Event: " + EVENT_TO_STRING(event.type));
-	switch (event.type) {
-	case EventType::START_M_SHORT:
-		master_btnStart_PressedShort();
-		break;
-	case EventType::START_M_LONG:
-		master_btnStart_PressedLong();
-		break;
-	case EventType::STOP_M_SHORT:
-		master_btnStop_Pressed();
-		break;
-	case EventType::RESET_M_SHORT:
-		master_btnReset_Pressed();
-		break;
-	case EventType::RESET_M_LONG:
-		master_btnReset_PressedLong();
-		break;
-	case EventType::ESTOP_M_PRESSED:
-		master_EStop_Pressed();
-		break;
-	case EventType::ESTOP_M_RELEASED:
-		master_EStop_Released();
-		break;
-	case EventType::START_S_SHORT:
-		slave_btnStart_PressedShort();
-		break;
-	case EventType::START_S_LONG:
-		slave_btnStart_PressedLong();
-		break;
-	case EventType::STOP_S_SHORT:
-		slave_btnStop_Pressed();
-		break;
-	case EventType::RESET_S_SHORT:
-		slave_btnReset_Pressed();
-		break;
-	case EventType::RESET_S_LONG:
-		slave_btnReset_PressedLong();
-		break;
-	case EventType::ESTOP_S_PRESSED:
-		slave_EStop_Pressed();
-		break;
-	case EventType::ESTOP_S_RELEASED:
-		slave_EStop_Released();
-		break;
-	case EventType::LBA_M_BLOCKED:
-		master_LBA_Blocked();
-		break;
-	case EventType::LBA_M_UNBLOCKED:
-		master_LBA_Unblocked();
-		break;
-	case EventType::LBW_M_BLOCKED:
-		master_LBW_Blocked();
-		break;
-	case EventType::LBW_M_UNBLOCKED:
-		master_LBW_Unblocked();
-		break;
-	case EventType::LBE_M_BLOCKED:
-		master_LBE_Blocked();
-		break;
-	case EventType::LBE_M_UNBLOCKED:
-		master_LBE_Unblocked();
-		break;
-	case EventType::LBR_M_BLOCKED:
-		master_LBR_Blocked();
-		break;
-	case EventType::LBR_M_UNBLOCKED:
-		master_LBR_Unblocked();
-		break;
-	case EventType::LBA_S_BLOCKED:
-		slave_LBA_Blocked();
-		break;
-	case EventType::LBA_S_UNBLOCKED:
-		slave_LBA_Unblocked();
-		break;
-	case EventType::LBW_S_BLOCKED:
-		slave_LBW_Blocked();
-		break;
-	case EventType::LBW_S_UNBLOCKED:
-		slave_LBW_Unblocked();
-		break;
-	case EventType::LBE_S_BLOCKED:
-		slave_LBE_Blocked();
-		break;
-	case EventType::LBE_S_UNBLOCKED:
-		slave_LBE_Unblocked();
-		break;
-	case EventType::LBR_S_BLOCKED:
-		slave_LBR_Blocked();
-		break;
-	case EventType::LBR_S_UNBLOCKED:
-		slave_LBR_Unblocked();
-		break;
-	case EventType::HM_M_WS_F:
-	case EventType::HM_M_WS_OB:
-	case EventType::HM_M_WS_BOM:
-	case EventType::HM_M_WS_UNKNOWN: {
-		master_heightResultReceived(event.type, ((float) event.data) / 10);
-		break;
-	}
-	case EventType::HM_S_WS_F:
-	case EventType::HM_S_WS_OB:
-	case EventType::HM_S_WS_BOM:
-	case EventType::HM_S_WS_UNKNOWN: {
-		slave_heightResultReceived(event.type, ((float) event.data) / 10);
-		break;
-	}
-	case EventType::MD_M_PAYLOAD:
-		master_metalDetected();
-		break;
-	case EventType::MD_S_PAYLOAD:
-		slave_metalDetected();
-		break;
-	case EventType::ERROR_M_SELF_SOLVABLE:
-	case EventType::ERROR_S_SELF_SOLVABLE:
-		selfSolvableErrorOccurred();
-		break;
-	case EventType::ERROR_M_MAN_SOLVABLE:
-	case EventType::ERROR_S_MAN_SOLVABLE:
-		nonSelfSolvableErrorOccurred();
-		break;
-	case EventType::ERROR_M_SELF_SOLVED:
-	case EventType::ERROR_S_SELF_SOLVED:
-		errorSelfSolved();
-		break;
-	case EventType::HAL_PUSHER_MOUNTED: {
-		data->slave_pusherMounted = true;
-		break;
-	}
-	default:
+	if (!dispatchTable().dispatch(*this, event)) {
 		Logger::warn(
 				"[MainFSM] Event was not handled: "
 						+ EVENT_TO_STRING(event.type));
-		break;
 	}
 }
 
@@ -319,10 +174,13 @@ void MainContext::master_metalDetected() {
 }
 
 void MainContext::slave_LBA_Blocked() {
+	data->entryFBM2.blocked = true;
 	state->slave_LBA_Blocked();
 }
 
 void MainContext::slave_LBA_Unblocked() {
+	data->entryFBM2.blocked = false;
+	data->entryFBM2.passed++;
 	state->slave_LBA_Unblocked();
 }
 
@@ -335,10 +193,13 @@ void MainContext::slave_LBW_Unblocked() {
 }
 
 void MainContext::slave_LBE_Blocked() {
+	data->exitFBM2.blocked = true;
 	state->slave_LBE_Blocked();
 }
 
 void MainContext::slave_LBE_Unblocked() {
+	data->exitFBM2.blocked = false;
+	data->exitFBM2.passed++;
 	state->slave_LBE_Unblocked();
 }
 
@@ -352,6 +213,10 @@ void MainContext::slave_LBR_Unblocked() {
 	state->slave_LBR_Unblocked();
 }
 
+void MainContext::slave_passesMissed(int entered, int left) {
+	state->slave_passesMissed(entered, left);
+}
+
 void MainContext::slave_heightResultReceived(EventType event, float average) {
 	state->slave_heightResultReceived(event, average);
 }
@@ -360,6 +225,17 @@ void MainContext::slave_metalDetected() {
 	state->slave_metalDetected();
 }
 
+void MainContext::slave_motorMoving(bool moving) {
+	data->handover->setBeltMoving(moving);
+	if (moving) {
+		state->handoverCheck();
+	}
+}
+
+void MainContext::handoverCheck() {
+	state->handoverCheck();
+}
+
 void MainContext::master_btnStart_PressedShort() {
 	state->master_btnStart_PressedShort();
 }
@@ -430,3 +306,29 @@ void MainContext::nonSelfSolvableErrorOccurred() {
 	Logger::error("Error occurred (manual solvable)");
 	state->nonSelfSolvableErrorOccurred();
 }
+
+void MainContext::connectionReestablished() {
+	state->connectionReestablished();
+}
+
+void MainContext::resendMode() {
+	switch (state->getCurrentState()) {
+	case MainState::STANDBY:
+		actions->setStandbyMode();
+		break;
+	case MainState::RUNNING:
+		actions->setRunningMode();
+		break;
+	case MainState::SERVICEMODE:
+		actions->setServiceMode();
+		break;
+	case MainState::ERROR:
+		actions->setErrorMode();
+		break;
+	case MainState::ESTOP:
+		actions->setEStopMode();
+		break;
+	default:
+		break;
+	}
+}
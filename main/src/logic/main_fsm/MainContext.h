@@ -12,6 +12,8 @@
 #include "events/IEventManager.h"
 #include "events/IEventHandler.h"
 #include "events/events.h"
+#include "logic/EventDispatchTable.h"
+#include "logic/StateStorage.h"
 
 #include <memory>
 
@@ -44,10 +46,16 @@ class MainContext : public IEventHandler {
     void slave_LBE_Unblocked();
     void slave_LBR_Blocked();
     void slave_LBR_Unblocked();
+    // Resync after a lost connection, see MasterLinkSync
+    void slave_passesMissed(int entered, int left);
 
     void slave_heightResultReceived(EventType event, float average);
     void slave_metalDetected();
 
+    // Commands of the MotorFSM of FBM2
+    void slave_motorMoving(bool moving);
+    void handoverCheck();
+
     // Buttons
     void master_btnStart_PressedShort();
     void master_btnStart_PressedLong();
@@ -71,12 +79,25 @@ class MainContext : public IEventHandler {
     void selfSolvableErrorOccurred();
     void errorSelfSolved();
     void nonSelfSolvableErrorOccurred();
+    void connectionReestablished();
+
+    /**
+     * Sends the mode of the current state again, for a slave which has missed
+     * it while the link was lost.
+     */
+    void resendMode();
    
 
     MainContextData *data;
   private:
     MainActions *actions;
     MainBasestate *state;
+    StateStorage<MainBasestate, MAIN_STATE_STORAGE_SIZE> stateStorage;
     std::shared_ptr<IEventManager> eventManager;
+    SubscriptionId subscription = 0;
     void subscribeToEvents();
+
+    static const EventDispatchTable<MainContext>& dispatchTable();
+    static void onMasterHeightResult(MainContext &ctx, const Event &event);
+    static void onSlaveHeightResult(MainContext &ctx, const Event &event);
 };
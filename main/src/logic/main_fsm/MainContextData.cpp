@@ -6,11 +6,13 @@
  */
 
 #include "MainContextData.h"
+#include "MainBasestate.h"
 #include "logger/logger.hpp"
 #include "configuration/Configuration.h"
 
 MainContextData::MainContextData() {
     wpManager = new WorkpieceManager();
+    handover = new HandoverControl(wpManager);
     setRampFBM1Blocked(false);
     setRampFBM2Blocked(false);
     bool isMaster = Configuration::getInstance().systemIsMaster();
@@ -23,7 +25,11 @@ MainContextData::MainContextData() {
     }
 }
 
-MainContextData::~MainContextData() { delete wpManager; }
+MainContextData::~MainContextData() {
+    substateStorage.destroy();
+    delete handover;
+    delete wpManager;
+}
 
 void MainContextData::setRampFBM1Blocked(bool blocked) {
     this->rampFBM1Blocked = blocked;
@@ -5,8 +5,17 @@
  *      Author: Maik
  */
 #pragma once
+#include "data/HandoverControl.h"
 #include "data/Workpiece.h"
 #include "data/WorkpieceManager.h"
+#include "logic/StateStorage.h"
+
+#include <cstdint>
+
+// Bytes reserved for the main state and for the active substate
+#define MAIN_STATE_STORAGE_SIZE 128
+
+class MainBasestate;
 
 struct SelftestSensorsResult {
     bool master_lbStartOk{false};
@@ -21,9 +30,19 @@ struct SelftestSensorsResult {
 
 class MainContextData {
   public:
+    /**
+     * Light barrier of FBM2 as seen by the master, compared with the slave
+     * after a lost connection (see MasterLinkSync).
+     */
+    struct BarrierFBM2 {
+        bool blocked{false};
+        uint32_t passed{0};   // unblocked edges
+    };
+
     MainContextData();
     virtual ~MainContextData();
     WorkpieceManager *wpManager;
+    HandoverControl *handover;
     void setRampFBM1Blocked(bool blocked);
     void setRampFBM2Blocked(bool blocked);
     bool isRampFBM1Blocked();
@@ -33,9 +52,17 @@ class MainContextData {
     bool getSelftestSensorsResult();
 
     SelftestSensorsResult ssResult;
+    BarrierFBM2 entryFBM2;   // LBA
+    BarrierFBM2 exitFBM2;    // LBE
     bool master_pusherMounted;
     bool slave_pusherMounted;
 
+    /**
+     * Storage for the substate of EStop, Error or ServiceMode. Only one of
+     * them can be active at the same time.
+     */
+    StateStorage<MainBasestate, MAIN_STATE_STORAGE_SIZE> substateStorage;
+
   private:
     bool rampFBM1Blocked;
     bool rampFBM2Blocked;
@@ -20,12 +20,13 @@ void EStop::entry() {
     initSubStateEStop();
     actions->setEStopMode();
     data->wpManager->reset_wpm();
+    data->handover->reset();
 }
 
-void EStop::exit() { delete substateEStop; }
+void EStop::exit() { data->substateStorage.destroy(); }
 
 void EStop::initSubStateEStop() {
-    substateEStop = new SubEStopOnePressed;
+    substateEStop = data->substateStorage.create<SubEStopOnePressed>();
     substateEStop->setAction(actions);
     substateEStop->setData(data);
     substateEStop->entry();
@@ -51,7 +52,7 @@ bool EStop::master_btnReset_Pressed() {
     bool handled = substateEStop->master_btnReset_Pressed();
     if (substateEStop->isSubEndState()) {
         exit();
-        new (this) Standby;
+        transitionTo<Standby>();
         entry();
         return true;
     }
@@ -62,7 +63,7 @@ bool EStop::slave_btnReset_Pressed() {
     bool handled = substateEStop->slave_btnReset_Pressed();
     if (substateEStop->isSubEndState()) {
         exit();
-        new (this) Standby;
+        transitionTo<Standby>();
         entry();
         return true;
     }
@@ -24,11 +24,12 @@ void Error::entry() {
 void Error::exit() {
 	actions->master_sendMotorStopRequest(false);
 	actions->slave_sendMotorStopRequest(false);
+	data->substateStorage.destroy();
 	previousState = MainState::ERROR;
 }
 
 void Error::initSubStateError() {
-	substateError = new SubErrorPendingUnresigned;
+	substateError = data->substateStorage.create<SubErrorPendingUnresigned>();
 	substateError->setAction(actions);
 	substateError->setData(data);
 	substateError->entry();
@@ -50,22 +51,19 @@ bool Error::nonSelfSolvableErrorOccurred() {
 	return substateError->nonSelfSolvableErrorOccurred();
 }
 
+bool Error::connectionReestablished() {
+	// Only the lost link was pending: production goes on without reset
+	if (substateError->connectionReestablished() && substateError->isSubEndState()) {
+		leaveError();
+		return true;
+	}
+	return false;
+}
+
 bool Error::master_btnReset_Pressed() {
 	substateError->master_btnReset_Pressed();
 	if (substateError->isSubEndState()) {
-		if (previousState == MainState::RUNNING) {
-			exit();
-			new (this) Running;
-			entryHistory();
-		} else if (previousState == MainState::SERVICEMODE) {
-			exit();
-			new (this) ServiceMode;
-			entry();
-		} else {
-			exit();
-			new (this) Standby;
-			entry();
-		}
+		leaveError();
 		return true;
 	}
 	return false;
@@ -74,19 +72,7 @@ bool Error::master_btnReset_Pressed() {
 bool Error::slave_btnReset_Pressed() {
 	substateError->slave_btnReset_Pressed();
 	if (substateError->isSubEndState()) {
-		if (previousState == MainState::RUNNING) {
-			exit();
-			new (this) Running;
-			entryHistory();
-		} else if (previousState == MainState::SERVICEMODE) {
-			exit();
-			new (this) ServiceMode;
-			entry();
-		} else {
-			exit();
-			new (this) Standby;
-			entry();
-		}
+		leaveError();
 		return true;
 	}
 	return false;
@@ -95,19 +81,7 @@ bool Error::slave_btnReset_Pressed() {
 bool Error::master_btnStart_PressedShort() {
 	substateError->master_btnStart_PressedShort();
 	if (substateError->isSubEndState()) {
-		if (previousState == MainState::RUNNING) {
-			exit();
-			new (this) Running;
-			entryHistory();
-		} else if (previousState == MainState::SERVICEMODE) {
-			exit();
-			new (this) ServiceMode;
-			entry();
-		} else {
-			exit();
-			new (this) Standby;
-			entry();
-		}
+		leaveError();
 		return true;
 	}
 	return false;
@@ -116,20 +90,24 @@ bool Error::master_btnStart_PressedShort() {
 bool Error::slave_btnStart_PressedShort() {
 	substateError->slave_btnStart_PressedShort();
 	if (substateError->isSubEndState()) {
-		if (previousState == MainState::RUNNING) {
-			exit();
-			new (this) Running;
-			entryHistory();
-		} else if (previousState == MainState::SERVICEMODE) {
-			exit();
-			new (this) ServiceMode;
-			entry();
-		} else {
-			exit();
-			new (this) Standby;
-			entry();
-		}
+		leaveError();
 		return true;
 	}
 	return false;
 }
+
+void Error::leaveError() {
+	if (previousState == MainState::RUNNING) {
+		exit();
+		transitionTo<Running>();
+		entryHistory();
+	} else if (previousState == MainState::SERVICEMODE) {
+		exit();
+		transitionTo<ServiceMode>();
+		entry();
+	} else {
+		exit();
+		transitionTo<Standby>();
+		entry();
+	}
+}
@@ -18,12 +18,14 @@ class Error : public MainBasestate {
     bool nonSelfSolvableErrorOccurred() override;
 
     bool errorSelfSolved() override;
+    bool connectionReestablished() override;
     bool master_btnReset_Pressed() override;
     bool slave_btnReset_Pressed() override;
     bool master_btnStart_PressedShort() override;
     bool slave_btnStart_PressedShort() override;
 
   private:
+    void leaveError();
     bool selfSolving;
     bool manualSolving;
 };
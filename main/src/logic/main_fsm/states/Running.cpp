@@ -6,6 +6,7 @@
  */
 
 #include "Running.h"
+#include "common/TimerService.h"
 #include "configuration/Configuration.h"
 
 #include <chrono>
@@ -21,6 +22,10 @@ MainState Running::getCurrentState() {
 	return MainState::RUNNING;
 }
 
+Running::~Running() {
+	cancelTimers();
+}
+
 void Running::entry() {
 	Logger::info("Entered Running mode");
 	data->wpManager->printCurrentOrder();
@@ -32,12 +37,25 @@ void Running::entry() {
 	if (data->isRampFBM2Blocked()) {
 		setRampBlocked_S(true);
 	}
+	admitWaitingWorkpiece();
 }
 
 void Running::exit() {
+	cancelTimers();
 	previousState = MainState::RUNNING;
 }
 
+void Running::cancelTimers() {
+	// The callbacks must not outlive this state, the storage is reused
+	TimerService &timers = TimerService::getInstance();
+	timers.cancel(gapTimer);
+	timers.cancel(rampWarningTimer_M);
+	timers.cancel(rampWarningTimer_S);
+	gapTimer = 0;
+	rampWarningTimer_M = 0;
+	rampWarningTimer_S = 0;
+}
+
 void Running::entryHistory() {
 	actions->slave_openGate(false);
 	Logger::info("Entered Running mode - restored previous state");
@@ -49,6 +67,7 @@ void Running::entryHistory() {
 	if (data->isRampFBM2Blocked()) {
 		setRampBlocked_S(true);
 	}
+	admitWaitingWorkpiece();
 }
 
 bool Running::master_LBA_Blocked() {
@@ -146,13 +165,10 @@ bool Running::master_LBW_Unblocked() {
 
 bool Running::master_LBE_Blocked() {
 	if (!data->wpManager->isQueueempty(AreaType::AREA_C)) {
-		Workpiece *wp = data->wpManager->getHeadOfArea(AreaType::AREA_C);
-		if (!data->wpManager->isFBM_SEmpty())
-		/*{
-		 // If FBM2 empty -> start FBM2 motor
-		 actions->slave_sendMotorRightRequest(true);
-		 } else */{
-			// If FBM2 occupied -> stop FBM1 motor
+		if (!data->handover->mayAdmit()) {
+			// FBM2 cannot take the workpiece yet -> stop FBM1 motor
+			Logger::debug("[MainFSM] Workpiece at end of FBM1 waits for admission to FBM2");
+			data->handover->setWaiting(true);
 			actions->master_sendMotorRightRequest(false);
 		}
 		// Close switch if open
@@ -165,10 +181,12 @@ bool Running::master_LBE_Blocked() {
 
 bool Running::master_LBE_Unblocked() {
 	if (!data->wpManager->isQueueempty(AreaType::AREA_C)) {
-		if (data->wpManager->isQueueempty(AreaType::AREA_D)) {
-			data->wpManager->moveFromAreaToArea(AreaType::AREA_C, AreaType::AREA_D);
-			actions->slave_sendMotorRightRequest(true);
-		}
+		Workpiece *wp = data->wpManager->getHeadOfArea(AreaType::AREA_C);
+		wp->posFBM2 = PositionFBM2::TRANSFER;
+		data->handover->setWaiting(false);
+		data->handover->countAdmitted();
+		data->wpManager->moveFromAreaToArea(AreaType::AREA_C, AreaType::AREA_D);
+		actions->slave_sendMotorRightRequest(true);
 		return true;
 	}
 	return false;
@@ -195,7 +213,9 @@ bool Running::master_LBR_Unblocked() {
 
 //---------------------------------------------------------------------------------
 bool Running::slave_LBA_Blocked() {
-	if (!data->wpManager->isQueueempty(AreaType::AREA_D)) {
+	Workpiece *wp = data->wpManager->getFirstOnFBM2At(PositionFBM2::TRANSFER);
+	if (wp != nullptr) {
+		wp->posFBM2 = PositionFBM2::START;
 		if (data->wpManager->isFBM_MEmpty()) {
 			actions->master_sendMotorRightRequest(false);
 		}
@@ -204,24 +224,33 @@ bool Running::slave_LBA_Blocked() {
 }
 
 bool Running::slave_LBA_Unblocked() {
+	Workpiece *wp = data->wpManager->getFirstOnFBM2At(PositionFBM2::START);
+	if (wp != nullptr) {
+		// Workpiece is completely on FBM2 -> next one may follow after the gap
+		wp->posFBM2 = PositionFBM2::BELT;
+		data->handover->workpieceEntered();
+		admitWaitingWorkpiece();
+	}
 	return true;
 }
 
 bool Running::slave_heightResultReceived(EventType event, float average) {
-	Logger::debug("[MainFSM] Received FBM1 height result: " + EVENT_TO_STRING(event) + " - avg: " + std::to_string(average) + " mm");
+	Logger::debug("[MainFSM] Received FBM2 height result: " + EVENT_TO_STRING(event) + " - avg: " + std::to_string(average) + " mm");
 
-	if (!data->wpManager->isQueueempty(AreaType::AREA_D)) {
-		data->wpManager->setHeight(AreaType::AREA_D, average);    // setheight()
-		data->wpManager->setTypeEvent(event, AreaType::AREA_D);   // setType()
+	Workpiece *wp = data->wpManager->getFirstOnFBM2Before(PositionFBM2::MEASURED);
+	if (wp != nullptr) {
+		data->wpManager->setHeight(wp, AreaType::AREA_D, average);    // setheight()
+		data->wpManager->setTypeEvent(event, wp, AreaType::AREA_D);   // setType()
+		wp->posFBM2 = PositionFBM2::MEASURED;
 	}
 
 	return true;
 }
 
 bool Running::slave_metalDetected() {
-	if (!data->wpManager->isQueueempty(AreaType::AREA_D)) {
-		Workpiece *wp = data->wpManager->getHeadOfArea(AreaType::AREA_D);
-		data->wpManager->setMetal(AreaType::AREA_D);   // setMetal()
+	Workpiece *wp = data->wpManager->getFirstOnFBM2Before(PositionFBM2::SWITCH);
+	if (wp != nullptr) {
+		wp->metal = true;   // setMetal()
 
 		if (wp->S_type == WorkpieceType::WS_BOM) {     // setType()
 			wp->S_type = WorkpieceType::WS_BUM;
@@ -235,8 +264,9 @@ bool Running::slave_metalDetected() {
 }
 
 bool Running::slave_LBW_Blocked() {
-	if (!data->wpManager->isQueueempty(AreaType::AREA_D)) {
-		Workpiece *wp = data->wpManager->getHeadOfArea(AreaType::AREA_D);
+	Workpiece *wp = data->wpManager->getFirstOnFBM2Before(PositionFBM2::SWITCH);
+	if (wp != nullptr) {
+		wp->posFBM2 = PositionFBM2::SWITCH;
 		Logger::info(data->wpManager->to_string_Workpiece_FBM2(wp));
 
 		WorkpieceType slave_type = wp->S_type;
@@ -272,14 +302,14 @@ bool Running::slave_LBW_Unblocked() {
 }
 
 bool Running::slave_LBE_Blocked() {
-	if (!data->wpManager->isQueueempty(AreaType::AREA_D)) {
-		Workpiece *wp = data->wpManager->getHeadOfArea(AreaType::AREA_D);
-		if (!data->wpManager->isQueueempty(AreaType::AREA_D)) {
-			if (wp->M_type != wp->S_type)
-				wp->flipped = true;
-			Logger::info(data->wpManager->to_string_Workpiece_FBM2(wp)); // print()
-			actions->slave_sendMotorRightRequest(false);
-		}
+	Workpiece *wp = getNextLeavingFBM2(false);
+	if (wp == nullptr) {
+		unknownWorkpieceLeftFBM2(false);
+	} else {
+		if (wp->M_type != wp->S_type)
+			wp->flipped = true;
+		Logger::info(data->wpManager->to_string_Workpiece_FBM2(wp)); // print()
+		actions->slave_sendMotorRightRequest(false);
 		// Close switch if open
 		if (!data->slave_pusherMounted) {
 			actions->slave_openGate(false);
@@ -290,37 +320,24 @@ bool Running::slave_LBE_Blocked() {
 }
 
 bool Running::slave_LBE_Unblocked() {
-	Workpiece *wp = data->wpManager->removeFromArea(AreaType::AREA_D);
+	Workpiece *wp = getNextLeavingFBM2(false);
 	if (wp == nullptr)
 		return false;
-
-	if (!data->wpManager->isFBM_MEmpty()) {
-		// FBM1 waiting for FBM2 to get free -> start motor of FBM1 as well
-		actions->master_sendMotorRightRequest(true);
-	} else {
-		// FBM1 not waiting -> stop FBM2
-		actions->slave_sendMotorRightRequest(false);
-	}
-
+	data->wpManager->removeFromArea(AreaType::AREA_D, wp);
+	workpieceLeftFBM2();
 	return true;
 }
 
 bool Running::slave_LBR_Blocked() {
 	setRampBlocked_S(true);
 
-	Workpiece *wp = data->wpManager->removeFromArea(AreaType::AREA_D);
-	if (wp == nullptr)
+	Workpiece *wp = getNextLeavingFBM2(true);
+	if (wp == nullptr) {
+		unknownWorkpieceLeftFBM2(true);
 		return false;
-
-	if (!data->wpManager->isFBM_MEmpty()) {
-		// FBM1 waiting for FBM2 to get free -> start motor of FBM1 as well
-		actions->master_sendMotorRightRequest(true);
-		actions->slave_sendMotorRightRequest(false);
-	} else {
-		// FBM1 not waiting -> stop FBM2
-		actions->slave_sendMotorRightRequest(false);
 	}
-
+	data->wpManager->removeFromArea(AreaType::AREA_D, wp);
+	workpieceLeftFBM2();
 	return true;
 }
 
@@ -329,6 +346,29 @@ bool Running::slave_LBR_Unblocked() {
 	return true;
 }
 
+bool Running::slave_passesMissed(int entered, int left) {
+	// Workpieces handed over to FBM2 are completely on the belt now
+	for (int i = 0; i < entered; i++) {
+		Workpiece *wp = data->wpManager->getFirstOnFBM2Before(PositionFBM2::BELT);
+		if (wp == nullptr || wp->posFBM2 == PositionFBM2::NONE) {
+			break;
+		}
+		wp->posFBM2 = PositionFBM2::BELT;
+		data->handover->workpieceEntered();
+	}
+	// The oldest workpieces not sorted out have left at the end
+	for (int i = 0; i < left; i++) {
+		Workpiece *wp = data->wpManager->getFirstOnFBM2(false);
+		if (wp == nullptr) {
+			break;
+		}
+		Logger::warn("[MainFSM] WP id: " + std::to_string(wp->id) + " left FBM2 while disconnected");
+		data->wpManager->removeFromArea(AreaType::AREA_D, wp);
+	}
+	workpieceLeftFBM2();
+	return true;
+}
+
 bool Running::master_btnStop_Pressed() {
 	bool warning = data->wpManager->getRamp_one() || data->wpManager->getRamp_two();
 	if (warning) {
@@ -336,7 +376,7 @@ bool Running::master_btnStop_Pressed() {
 		return false;
 	}
 	exit();
-	new (this) Standby;
+	transitionTo<Standby>();
 	entry();
 	return true;
 }
@@ -348,36 +388,43 @@ bool Running::slave_btnStop_Pressed() {
 		return false;
 	}
 	exit();
-	new (this) Standby;
+	transitionTo<Standby>();
 	entry();
 	return true;
 }
 
 bool Running::master_btnReset_PressedLong() {
 	data->wpManager->revertNextWorkpiece();
+	return true;
 }
 
 bool Running::slave_btnReset_PressedLong() {
 	data->wpManager->revertNextWorkpiece();
+	return true;
 }
 
 bool Running::master_EStop_Pressed() {
 	exit();
-	new (this) EStop;
+	transitionTo<EStop>();
 	entry();
 	return true;
 }
 
 bool Running::slave_EStop_Pressed() {
 	exit();
-	new (this) EStop;
+	transitionTo<EStop>();
 	entry();
 	return true;
 }
 
+bool Running::handoverCheck() {
+	admitWaitingWorkpiece();
+	return true;
+}
+
 bool Running::selfSolvableErrorOccurred() {
 	exit();
-	new (this) Error;
+	transitionTo<Error>();
 	entry();
 	selfSolvableErrorOccurred();
 	return true;
@@ -385,25 +432,84 @@ bool Running::selfSolvableErrorOccurred() {
 
 bool Running::nonSelfSolvableErrorOccurred() {
 	exit();
-	new (this) Error;
+	transitionTo<Error>();
 	entry();
 	nonSelfSolvableErrorOccurred();
 	return true;
 }
 
+Workpiece *Running::getNextLeavingFBM2(bool sortOut) {
+	return data->wpManager->getNextLeavingFBM2(sortOut);
+}
+
+void Running::unknownWorkpieceLeftFBM2(bool sortOut) {
+	if (data->wpManager->isQueueempty(AreaType::AREA_D)) {
+		return;   // nothing on FBM2, e.g. a workpiece put on the ramp by hand
+	}
+	// Workpieces are on FBM2, but none passed the switch (e.g. the event was
+	// missed). Guessing which one left could sort the following ones wrong.
+	Logger::error(std::string("[MainFSM] Workpiece reached the ") + (sortOut ? "ramp" : "end")
+	              + " of FBM2 without passing the switch");
+	actions->slave_manualSolvingErrorOccurred();
+}
+
+void Running::workpieceLeftFBM2() {
+	if (data->wpManager->isFBM_SEmpty()) {
+		actions->slave_sendMotorRightRequest(false);
+	} else {
+		// Further workpieces on FBM2 -> keep FBM2 running
+		actions->slave_sendMotorRightRequest(true);
+	}
+	admitWaitingWorkpiece();
+}
+
+void Running::admitWaitingWorkpiece() {
+	HandoverControl *handover = data->handover;
+	if (!handover->isWaiting()) {
+		return;
+	}
+	TimerService &timers = TimerService::getInstance();
+	timers.cancel(gapTimer);
+	gapTimer = 0;
+	if (data->wpManager->isQueueempty(AreaType::AREA_C)) {
+		handover->setWaiting(false);
+		return;
+	}
+	if (handover->mayAdmit()) {
+		// FBM1 waiting for FBM2 -> start motor of FBM1 again
+		handover->setWaiting(false);
+		actions->master_sendMotorRightRequest(true);
+		return;
+	}
+
+	int remaining = handover->remainingGapMs();
+	if (remaining > 0 && handover->isBeltMoving()) {
+		// Only the minimum gap is missing -> check again after it has passed.
+		// The timer only sends an event, the check is done by the FSM thread.
+		// If FBM2 stops meanwhile, it is checked again when it starts.
+		MainActions *actions = this->actions;
+		gapTimer = timers.scheduleOnce(remaining, [actions]() {
+			actions->sendHandoverGapElapsed();
+		});
+	}
+}
+
 void Running::setRampBlocked_M(bool blocked) {
 	data->setRampFBM1Blocked(blocked);
+	TimerService &timers = TimerService::getInstance();
+	timers.cancel(rampWarningTimer_M);
+	rampWarningTimer_M = 0;
 
 	if (blocked) {
 		// If still blocked after 1s -> display warning
-		std::thread t([=]() {
-			std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+		MainContextData *data = this->data;
+		MainActions *actions = this->actions;
+		rampWarningTimer_M = timers.scheduleOnce(1000, [data, actions]() {
 			if (data->isRampFBM1Blocked()) {
 				actions->master_warningOn();
 				actions->master_q2LedOn();
 			}
 		});
-		t.detach();
 	} else {
 		actions->master_warningOff();
 		actions->master_q2LedOff();
@@ -412,17 +518,20 @@ void Running::setRampBlocked_M(bool blocked) {
 
 void Running::setRampBlocked_S(bool blocked) {
 	data->setRampFBM2Blocked(blocked);
+	TimerService &timers = TimerService::getInstance();
+	timers.cancel(rampWarningTimer_S);
+	rampWarningTimer_S = 0;
 
 	if (blocked) {
 		// If still blocked after 1s -> display warning
-		std::thread t([=]() {
-			std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+		MainContextData *data = this->data;
+		MainActions *actions = this->actions;
+		rampWarningTimer_S = timers.scheduleOnce(1000, [data, actions]() {
 			if (data->isRampFBM2Blocked()) {
 				actions->slave_warningOn();
 				actions->slave_q1LedOn();
 			}
 		});
-		t.detach();
 	} else {
 		actions->slave_warningOff();
 		actions->slave_q1LedOff();
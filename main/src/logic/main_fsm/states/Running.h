@@ -7,8 +7,13 @@
 #pragma once
 
 #include "../MainBasestate.h"
+#include "common/TimerService.h"
 
 class Running : public MainBasestate {
+  public:
+    ~Running() override;
+
+  private:
     void entry() override;
     void exit() override;
 
@@ -33,6 +38,7 @@ class Running : public MainBasestate {
     bool slave_LBE_Unblocked() override;
     bool slave_LBR_Blocked() override;
     bool slave_LBR_Unblocked() override;
+    bool slave_passesMissed(int entered, int left) override;
 
     bool master_heightResultReceived(EventType event, float average) override;
     bool slave_heightResultReceived(EventType event, float average) override;
@@ -49,6 +55,8 @@ class Running : public MainBasestate {
     bool master_EStop_Pressed() override;
     bool slave_EStop_Pressed() override;
 
+    bool handoverCheck() override;
+
     bool selfSolvableErrorOccurred() override;
     bool nonSelfSolvableErrorOccurred() override;
 
@@ -56,4 +64,15 @@ class Running : public MainBasestate {
     bool pusherMounted;
     void setRampBlocked_M(bool blocked);
     void setRampBlocked_S(bool blocked);
+    Workpiece *getNextLeavingFBM2(bool sortOut);
+    void unknownWorkpieceLeftFBM2(bool sortOut);
+    void workpieceLeftFBM2();
+    void admitWaitingWorkpiece();
+
+    // Sends HANDOVER_GAP_ELAPSED, cancelled when Running is left
+    TimerId gapTimer = 0;
+    // Ramp still blocked after 1 s -> warning, cancelled when Running is left
+    TimerId rampWarningTimer_M = 0;
+    TimerId rampWarningTimer_S = 0;
+    void cancelTimers();
 };
@@ -25,12 +25,12 @@ void ServiceMode::entry() {
 }
 
 void ServiceMode::exit() {
-	delete substateServiceMode;
+	data->substateStorage.destroy();
 	previousState = MainState::SERVICEMODE;
 }
 
 void ServiceMode::initSubStateServiceMode() {
-    substateServiceMode = new SubServiceModeCalOffset;
+    substateServiceMode = data->substateStorage.create<SubServiceModeCalOffset>();
     substateServiceMode->setAction(actions);
     substateServiceMode->setData(data);
     substateServiceMode->entry();
@@ -104,7 +104,7 @@ bool ServiceMode::master_btnStart_PressedShort() {
     bool handled = substateServiceMode->master_btnStart_PressedShort();
     if (substateServiceMode->isSubEndState()) {
         exit();
-        new (this) Standby;
+        transitionTo<Standby>();
         entry();
         return true;
     }
@@ -113,7 +113,7 @@ bool ServiceMode::master_btnStart_PressedShort() {
 
 bool ServiceMode::master_btnStop_Pressed() {
     exit();
-    new (this) Standby;
+    transitionTo<Standby>();
     entry();
     return true;
 }
@@ -122,7 +122,7 @@ bool ServiceMode::master_btnReset_Pressed() {
     bool handled = substateServiceMode->master_btnReset_Pressed();
     if (substateServiceMode->isSubEndState()) {
         exit();
-        new (this) Standby;
+        transitionTo<Standby>();
         entry();
         return true;
     }
@@ -133,7 +133,7 @@ bool ServiceMode::slave_btnStart_PressedShort() {
     bool handled = substateServiceMode->slave_btnStart_PressedShort();
     if (substateServiceMode->isSubEndState()) {
         exit();
-        new (this) Standby;
+        transitionTo<Standby>();
         entry();
         return true;
     }
@@ -142,7 +142,7 @@ bool ServiceMode::slave_btnStart_PressedShort() {
 
 bool ServiceMode::slave_btnStop_Pressed() {
     exit();
-    new (this) Standby;
+    transitionTo<Standby>();
     entry();
     return true;
 }
@@ -151,7 +151,7 @@ bool ServiceMode::slave_btnReset_Pressed() {
     bool handled = substateServiceMode->slave_btnReset_Pressed();
     if (substateServiceMode->isSubEndState()) {
         exit();
-        new (this) Standby;
+        transitionTo<Standby>();
         entry();
         return true;
     }
@@ -160,14 +160,14 @@ bool ServiceMode::slave_btnReset_Pressed() {
 
 bool ServiceMode::master_EStop_Pressed() {
     exit();
-    new (this) EStop;
+    transitionTo<EStop>();
     entry();
     return true;
 }
 
 bool ServiceMode::slave_EStop_Pressed() {
     exit();
-    new (this) EStop;
+    transitionTo<EStop>();
     entry();
     return true;
 }
@@ -37,21 +37,21 @@ bool Standby::master_btnStart_PressedShort() {
 		return false;
 	}
     exit();
-    new (this) Running;
+    transitionTo<Running>();
     entry();
     return true;
 }
 
 bool Standby::master_btnStart_PressedLong() {
     exit();
-    new (this) ServiceMode;
+    transitionTo<ServiceMode>();
     entry();
     return true;
 }
 
 bool Standby::master_EStop_Pressed() {
     exit();
-    new (this) EStop;
+    transitionTo<EStop>();
     entry();
     return true;
 }
@@ -62,27 +62,28 @@ bool Standby::slave_btnStart_PressedShort() {
 		return false;
 	}
     exit();
-    new (this) Running;
+    transitionTo<Running>();
     entry();
     return true;
 }
 
 bool Standby::slave_btnStart_PressedLong() {
     exit();
-    new (this) ServiceMode;
+    transitionTo<ServiceMode>();
     entry();
     return true;
 }
 
 bool Standby::slave_EStop_Pressed() {
     exit();
-    new (this) EStop;
+    transitionTo<EStop>();
     entry();
     return true;
 }
 
 bool Standby::master_btnReset_PressedLong() {
 	data->wpManager->reset_wpm();
+	data->handover->reset();
 	actions->master_sendMotorRightRequest(false);
 	actions->slave_sendMotorRightRequest(false);
 	return true;
@@ -90,6 +91,7 @@ bool Standby::master_btnReset_PressedLong() {
 
 bool Standby::slave_btnReset_PressedLong() {
 	data->wpManager->reset_wpm();
+	data->handover->reset();
 	actions->master_sendMotorRightRequest(false);
 	actions->slave_sendMotorRightRequest(false);
 	return true;
@@ -33,7 +33,7 @@ bool SubEStopBothReleased::master_btnReset_Pressed() {
     if (masterReset && slaveReset) {
         Logger::debug("EStop was resetted -> leave EStop mode");
         exit();
-        new (this) SubEStopEndState;
+        transitionTo<SubEStopEndState>();
         entry();
         return true;
     }
@@ -47,7 +47,7 @@ bool SubEStopBothReleased::slave_btnReset_Pressed() {
     if (masterReset && slaveReset) {
         Logger::debug("EStop was resetted -> leave EStop mode");
         exit();
-        new (this) SubEStopEndState;
+        transitionTo<SubEStopEndState>();
         entry();
         return true;
     }
@@ -56,14 +56,14 @@ bool SubEStopBothReleased::slave_btnReset_Pressed() {
 
 bool SubEStopBothReleased::master_EStop_Pressed() {
     exit();
-    new (this) SubEStopOnePressed;
+    transitionTo<SubEStopOnePressed>();
     entry();
     return true;
 }
 
 bool SubEStopBothReleased::slave_EStop_Pressed() {
     exit();
-    new (this) SubEStopOnePressed;
+    transitionTo<SubEStopOnePressed>();
     entry();
     return true;
 }
@@ -23,28 +23,28 @@ void SubEStopOnePressed::exit() {}
 
 bool SubEStopOnePressed::master_EStop_Pressed() {
     exit();
-    new (this) SubEStopTwoPressed;
+    transitionTo<SubEStopTwoPressed>();
     entry();
     return true;
 }
 
 bool SubEStopOnePressed::master_EStop_Released() {
     exit();
-    new (this) SubEStopBothReleased;
+    transitionTo<SubEStopBothReleased>();
     entry();
     return true;
 }
 
 bool SubEStopOnePressed::slave_EStop_Pressed() {
     exit();
-    new (this) SubEStopTwoPressed;
+    transitionTo<SubEStopTwoPressed>();
     entry();
     return true;
 }
 
 bool SubEStopOnePressed::slave_EStop_Released() {
     exit();
-    new (this) SubEStopBothReleased;
+    transitionTo<SubEStopBothReleased>();
     entry();
     return true;
 }
@@ -15,14 +15,14 @@ void SubEStopTwoPressed::entry() { Logger::info("Both E-Stop's are pressed"); }
 
 bool SubEStopTwoPressed::master_EStop_Released() {
     exit();
-    new (this) SubEStopOnePressed;
+    transitionTo<SubEStopOnePressed>();
     entry();
     return true;
 }
 
 bool SubEStopTwoPressed::slave_EStop_Released() {
     exit();
-    new (this) SubEStopOnePressed;
+    transitionTo<SubEStopOnePressed>();
     entry();
     return true;
 }
@@ -23,14 +23,14 @@ void SubErrorPendingResigned::exit() {}
 
 bool SubErrorPendingResigned::master_btnStart_PressedShort() {
     exit();
-    new (this) SubErrorEndState;
+    transitionTo<SubErrorEndState>();
     entry();
     return true;
 }
 
 bool SubErrorPendingResigned::slave_btnStart_PressedShort() {
     exit();
-    new (this) SubErrorEndState;
+    transitionTo<SubErrorEndState>();
     entry();
     return true;
 }
@@ -6,6 +6,7 @@
  */
 
 #include "SubErrorPendingUnresigned.h"
+#include "SubErrorEndState.h"
 #include "SubErrorPendingResigned.h"
 #include "SubErrorSolvedUnresigned.h"
 #include "logger/logger.hpp"
@@ -35,7 +36,20 @@ bool SubErrorPendingUnresigned::errorSelfSolved() {
     selfSolving = false;
     if (!manualSolving) {
         exit();
-        new (this) SubErrorSolvedUnresigned;
+        transitionTo<SubErrorSolvedUnresigned>();
+        entry();
+        return true;
+    }
+    return false;
+}
+
+bool SubErrorPendingUnresigned::connectionReestablished() {
+    // The lost link was the self-solving error, it is solved after the resync
+    if (selfSolving && !manualSolving) {
+        selfSolving = false;
+        Logger::info("Connection reestablished - Error solved");
+        exit();
+        transitionTo<SubErrorEndState>();
         entry();
         return true;
     }
@@ -49,7 +63,7 @@ bool SubErrorPendingUnresigned::master_btnReset_Pressed() {
 			return false;
 		}
         exit();
-        new (this) SubErrorPendingResigned;
+        transitionTo<SubErrorPendingResigned>();
         entry();
         return true;
     }
@@ -63,7 +77,7 @@ bool SubErrorPendingUnresigned::slave_btnReset_Pressed() {
 			return false;
 		}
         exit();
-        new (this) SubErrorPendingResigned;
+        transitionTo<SubErrorPendingResigned>();
         entry();
         return true;
     }
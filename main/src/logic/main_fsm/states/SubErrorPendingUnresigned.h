@@ -16,6 +16,7 @@ class SubErrorPendingUnresigned : public MainBasestate {
     bool nonSelfSolvableErrorOccurred() override;
 
     bool errorSelfSolved() override;
+    bool connectionReestablished() override;
     bool master_btnReset_Pressed() override;
     bool slave_btnReset_Pressed() override;
 
@@ -19,16 +19,24 @@ void SubErrorSolvedUnresigned::entry() {
 
 void SubErrorSolvedUnresigned::exit() {}
 
+bool SubErrorSolvedUnresigned::connectionReestablished() {
+    // Error solved itself by the reconnect of the partner
+    exit();
+    transitionTo<SubErrorEndState>();
+    entry();
+    return true;
+}
+
 bool SubErrorSolvedUnresigned::master_btnReset_Pressed() {
     exit();
-    new (this) SubErrorEndState;
+    transitionTo<SubErrorEndState>();
     entry();
     return true;
 }
 
 bool SubErrorSolvedUnresigned::slave_btnReset_Pressed() {
     exit();
-    new (this) SubErrorEndState;
+    transitionTo<SubErrorEndState>();
     entry();
     return true;
 }
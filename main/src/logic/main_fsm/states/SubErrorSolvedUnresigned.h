@@ -12,6 +12,8 @@ class SubErrorSolvedUnresigned : public MainBasestate {
     void entry() override;
     void exit() override;
 
+    bool connectionReestablished() override;
+
     bool master_btnReset_Pressed() override;
     bool slave_btnReset_Pressed() override;
 };
@@ -38,7 +38,7 @@ bool SubServiceModeCalOffset::master_btnStart_PressedShort() {
 bool SubServiceModeCalOffset::master_btnReset_Pressed() {
     if (done) {
         exit();
-        new (this) SubServiceModeCalRef;
+        transitionTo<SubServiceModeCalRef>();
         entry();
         return true;
     } else {
@@ -58,7 +58,7 @@ bool SubServiceModeCalOffset::slave_btnStart_PressedShort() {
 bool SubServiceModeCalOffset::slave_btnReset_Pressed() {
     if (done) {
         exit();
-        new (this) SubServiceModeCalRef;
+        transitionTo<SubServiceModeCalRef>();
         entry();
         return true;
     } else {
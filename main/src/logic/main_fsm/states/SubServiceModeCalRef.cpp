@@ -40,7 +40,7 @@ bool SubServiceModeCalRef::master_btnReset_Pressed() {
     if (done) {
         actions->saveCalibration();
         exit();
-        new (this) SubServiceModeSelftestSensors;
+        transitionTo<SubServiceModeSelftestSensors>();
         entry();
         return true;
     } else {
@@ -61,7 +61,7 @@ bool SubServiceModeCalRef::slave_btnReset_Pressed() {
     if (done) {
         actions->saveCalibration();
         exit();
-        new (this) SubServiceModeSelftestSensors;
+        transitionTo<SubServiceModeSelftestSensors>();
         entry();
         return true;
     } else {
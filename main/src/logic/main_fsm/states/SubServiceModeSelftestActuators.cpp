@@ -30,28 +30,28 @@ void SubServiceModeSelftestActuators::exit() {
 
 bool SubServiceModeSelftestActuators::master_btnStart_PressedShort() {
     exit();
-    new (this) SubServiceModeEndState;
+    transitionTo<SubServiceModeEndState>();
     entry();
     return true;
 }
 
 bool SubServiceModeSelftestActuators::master_btnReset_Pressed() {
     exit();
-    new (this) SubServiceModeTestsFailed;
+    transitionTo<SubServiceModeTestsFailed>();
     entry();
     return true;
 }
 
 bool SubServiceModeSelftestActuators::slave_btnStart_PressedShort() {
     exit();
-    new (this) SubServiceModeEndState;
+    transitionTo<SubServiceModeEndState>();
     entry();
     return true;
 }
 
 bool SubServiceModeSelftestActuators::slave_btnReset_Pressed() {
     exit();
-    new (this) SubServiceModeTestsFailed;
+    transitionTo<SubServiceModeTestsFailed>();
     entry();
     return true;
 }
@@ -28,12 +28,12 @@ bool SubServiceModeSelftestSensors::master_btnStart_PressedShort() {
     if (data->getSelftestSensorsResult()) {
     	Logger::info("Sensors selftest pass!");
         exit();
-        new (this) SubServiceModeSelftestActuators;
+        transitionTo<SubServiceModeSelftestActuators>();
         entry();
         return true;
     } else {
         exit();
-        new (this) SubServiceModeTestsFailed;
+        transitionTo<SubServiceModeTestsFailed>();
         entry();
         return true;
     }
@@ -41,21 +41,21 @@ bool SubServiceModeSelftestSensors::master_btnStart_PressedShort() {
 
 bool SubServiceModeSelftestSensors::master_btnReset_Pressed() {
     exit();
-    new (this) SubServiceModeTestsFailed;
+    transitionTo<SubServiceModeTestsFailed>();
     entry();
     return true;
 }
 
 bool SubServiceModeSelftestSensors::slave_btnStart_PressedShort() {
     exit();
-    new (this) SubServiceModeSelftestActuators;
+    transitionTo<SubServiceModeSelftestActuators>();
     entry();
     return true;
 }
 
 bool SubServiceModeSelftestSensors::slave_btnReset_Pressed() {
     exit();
-    new (this) SubServiceModeTestsFailed;
+    transitionTo<SubServiceModeTestsFailed>();
     entry();
     return true;
 }
@@ -6,7 +6,7 @@
  */
 #pragma once
 
-#include "events/EventManager.h"
+#include "events/IEventManager.h"
 #include "events/IEventSender.h"
 #include <memory>
 
@@ -8,6 +8,10 @@
 
 #include "MotorActions.h"
 #include "MotorContextData.h"
+#include "logic/StateStorage.h"
+
+// Bytes reserved for the motor state
+#define MOTOR_STATE_STORAGE_SIZE 64
 
 enum MotorState { MOTOR_NONE, STOPPED, RIGHT_FAST, RIGHT_SLOW };
 
@@ -31,4 +35,14 @@ class MotorBasestate {
     virtual bool motorRightFast() { return false; }
     virtual bool motorRightSlow() { return false; }
     virtual bool motorStopped() { return false; }
+
+  protected:
+    // Transition to the state S, which must fit into the storage of this state
+    template <class S> void transitionTo() {
+        MotorActions *actions = this->actions;
+        MotorContextData *data = this->data;
+        MotorBasestate *next = StateStorage<MotorBasestate, MOTOR_STATE_STORAGE_SIZE>::transition<S>(this);
+        next->actions = actions;
+        next->data = data;
+    }
 };
@@ -17,7 +17,7 @@ MotorContext::MotorContext(MotorActions* actions, bool master) {
     isMaster = master;
     this->actions = actions;
     this->data = new MotorContextData();
-    this->state = new Stopped();
+    this->state = stateStorage.create<Stopped>();
     state->setAction(actions);
     state->setData(data);
     state->entry();
@@ -25,35 +25,45 @@ MotorContext::MotorContext(MotorActions* actions, bool master) {
 }
 
 MotorContext::~MotorContext() {
+    actions->eventManager->unsubscribe(subscription);
     delete actions;
+    stateStorage.destroy();
     delete data;
-    delete state;
 }
 
 MotorState MotorContext::getCurrentState() { return state->getCurrentState(); }
 
 void MotorContext::subscribeToEvents() {
-    if (isMaster) {
-        actions->eventManager->subscribe(
-            EventType::MOTOR_M_STOP_REQ,
-            std::bind(&MotorContext::handleEvent, this, std::placeholders::_1));
-        actions->eventManager->subscribe(
-            EventType::MOTOR_M_SLOW_REQ,
-            std::bind(&MotorContext::handleEvent, this, std::placeholders::_1));
-        actions->eventManager->subscribe(
-            EventType::MOTOR_M_RIGHT_REQ,
-            std::bind(&MotorContext::handleEvent, this, std::placeholders::_1));
-    } else {
-        actions->eventManager->subscribe(
-            EventType::MOTOR_S_STOP_REQ,
-            std::bind(&MotorContext::handleEvent, this, std::placeholders::_1));
-        actions->eventManager->subscribe(
-            EventType::MOTOR_S_SLOW_REQ,
-            std::bind(&MotorContext::handleEvent, this, std::placeholders::_1));
-        actions->eventManager->subscribe(
-            EventType::MOTOR_S_RIGHT_REQ,
-            std::bind(&MotorContext::handleEvent, this, std::placeholders::_1));
-    }
+    // Only the requests for the own motor
+    EventMask system = EventMask::matching(isMaster ? "*_M_*" : "*_S_*");
+    subscription = actions->eventManager->subscribe(dispatchTable().getEvents() & system, this);
+}
+
+const EventDispatchTable<MotorContext>& MotorContext::dispatchTable() {
+    static const EventDispatchTable<MotorContext> table = {
+        { EventType::MOTOR_M_STOP_REQ, &MotorContext::onStopRequest },
+        { EventType::MOTOR_S_STOP_REQ, &MotorContext::onStopRequest },
+        { EventType::MOTOR_M_SLOW_REQ, &MotorContext::onSlowRequest },
+        { EventType::MOTOR_S_SLOW_REQ, &MotorContext::onSlowRequest },
+        { EventType::MOTOR_M_RIGHT_REQ, &MotorContext::onRightRequest },
+        { EventType::MOTOR_S_RIGHT_REQ, &MotorContext::onRightRequest },
+    };
+    return table;
+}
+
+void MotorContext::onStopRequest(MotorContext &ctx, const Event &event) {
+    ctx.data->setStopFlag(event.data == 1);
+    ctx.state->handleFlagsUpdated();
+}
+
+void MotorContext::onSlowRequest(MotorContext &ctx, const Event &event) {
+    ctx.data->setSlowFlag(event.data == 1);
+    ctx.state->handleFlagsUpdated();
+}
+
+void MotorContext::onRightRequest(MotorContext &ctx, const Event &event) {
+    ctx.data->setRightFlag(event.data == 1);
+    ctx.state->handleFlagsUpdated();
 }
 
 void MotorContext::handleEvent(Event event) {
@@ -62,23 +72,7 @@ void MotorContext::handleEvent(Event event) {
 	} else {
 		Logger::debug("[MotorFSM_S] Event received: " + EVENT_TO_STRING(event.type));
 	}
-    switch (event.type) {
-    case EventType::MOTOR_M_STOP_REQ:
-    case EventType::MOTOR_S_STOP_REQ:
-        data->setStopFlag(event.data == 1);
-        state->handleFlagsUpdated();
-        break;
-    case EventType::MOTOR_M_SLOW_REQ:
-    case EventType::MOTOR_S_SLOW_REQ:
-        data->setSlowFlag(event.data == 1);
-        state->handleFlagsUpdated();
-        break;
-    case EventType::MOTOR_M_RIGHT_REQ:
-    case EventType::MOTOR_S_RIGHT_REQ:
-        data->setRightFlag(event.data == 1);
-        state->handleFlagsUpdated();
-        break;
-    default:
+    if (!dispatchTable().dispatch(*this, event)) {
         Logger::warn("[MotorFSM] Event was not handled by FSM -> " +
                      EVENT_TO_STRING(event.type));
     }
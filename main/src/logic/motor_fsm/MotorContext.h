@@ -12,6 +12,8 @@
 #include "events/IEventManager.h"
 #include "events/IEventHandler.h"
 #include "events/events.h"
+#include "logic/EventDispatchTable.h"
+#include "logic/StateStorage.h"
 
 #include <memory>
 
@@ -27,7 +29,14 @@ class MotorContext : public IEventHandler {
     MotorActions *actions;
     MotorContextData *data;
     MotorBasestate *state;
+    StateStorage<MotorBasestate, MOTOR_STATE_STORAGE_SIZE> stateStorage;
     std::shared_ptr<IEventManager> eventManager;
+    SubscriptionId subscription = 0;
     void subscribeToEvents();
+
+    static const EventDispatchTable<MotorContext>& dispatchTable();
+    static void onStopRequest(MotorContext &ctx, const Event &event);
+    static void onSlowRequest(MotorContext &ctx, const Event &event);
+    static void onRightRequest(MotorContext &ctx, const Event &event);
     bool isMaster;
 };
@@ -21,12 +21,12 @@ bool RightFast::handleFlagsUpdated() {
     std::stringstream ss;
     if (data->getStop() || !data->getRight()) {
         exit();
-        new (this) Stopped;
+        transitionTo<Stopped>();
         entry();
         return true;
     } else if (!data->getStop() && data->getRight() && data->getSlow()) {
         exit();
-        new (this) RightSlow;
+        transitionTo<RightSlow>();
         entry();
         return true;
     }
@@ -20,12 +20,12 @@ MotorState RightSlow::getCurrentState() { return MotorState::RIGHT_SLOW; };
 bool RightSlow::handleFlagsUpdated() {
     if (!data->getStop() && data->getRight() && !data->getSlow()) {
         exit();
-        new (this) RightFast;
+        transitionTo<RightFast>();
         entry();
         return true;
     } else if (data->getStop() || !data->getRight()) {
         exit();
-        new (this) Stopped;
+        transitionTo<Stopped>();
         entry();
         return true;
     }
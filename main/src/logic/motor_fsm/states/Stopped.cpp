@@ -19,12 +19,12 @@ MotorState Stopped::getCurrentState() { return MotorState::STOPPED; };
 bool Stopped::handleFlagsUpdated() {
     if (!data->getStop() && data->getRight() && !data->getSlow()) {
         exit();
-        new (this) RightFast;
+        transitionTo<RightFast>();
         entry();
         return true;
     } else if (!data->getStop() && data->getRight() && data->getSlow()) {
         exit();
-        new (this) RightSlow;
+        transitionTo<RightSlow>();
         entry();
         return true;
     }
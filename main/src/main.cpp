@@ -8,7 +8,11 @@
 #include <iostream>
 #include <thread>
 
+#include "common/Startup.h"
+#include "common/ThreadRegistry.h"
+#include "common/Trace.h"
 #include "common/macros.h"
+#include "configuration/ConfigWatcher.h"
 #include "configuration/Configuration.h"
 #include "configuration/options.hpp"
 #include "events/EventManager.h"
@@ -17,8 +21,10 @@
 #include "hal/Actuators.h"
 #include "hal/HeightSensor.h"
 #include "logger/logger.hpp"
+#include "logic/LinkSync.h"
 #include "logic/main_fsm/MainContext.h"
 #include "logic/motor_fsm/MotorContext.h"
+#include "metrics/MetricsExporter.h"
 #include "watchdog/Watchdog.h"
 #ifdef SIM_ACTIVE
 #include "simqnxgpioapi.h"   // must be last include !!!
@@ -37,10 +43,33 @@ std::shared_ptr<EventManager> eventManager;
 std::shared_ptr<MainContext> mainFSM;
 std::shared_ptr<MotorContext> motorFSM_Master;
 std::shared_ptr<MotorContext> motorFSM_Slave;
+std::shared_ptr<ISyncParticipant> linkSync;
+ConfigWatcher configWatcher;
+MetricsExporter metricsExporter;
+std::string traceFile;
 
 // Set this variable to false to stop main function from executing...
 std::atomic<bool> running(true);
 
+/**
+ * Writes the recorded traces and logs the latency from a sensor edge to the
+ * switch
+ */
+void writeTrace() {
+    Tracer &tracer = Tracer::getInstance();
+    if (!tracer.isEnabled()) {
+        return;
+    }
+    if (tracer.exportChromeTrace(traceFile)) {
+        Logger::info("Trace written to " + traceFile);
+    } else {
+        Logger::error("Failed to write trace " + traceFile);
+    }
+    Logger::info("Latency sensor edge -> switch:\n"
+                 + Tracer::histogram(tracer.latencies("Sensors::handleGpioInterrupt",
+                                                      "Actuators::switch")));
+}
+
 /**
  * Signal Handler which must be called if the program is terminated.
  * Does all necessary stuff for cleanup to avoid memory leaks.
@@ -59,60 +88,15 @@ void cleanup(int exitCode) {
     	eventManager->sendExternalEvent(Event{ERROR_S_MAN_SOLVABLE});
     }
     actuators->allOff();
+    writeTrace();
     running = false;
     exit(EXIT_FAILURE);
 }
 
-/**
- * If there are some events queued up by the Kernel,
- * we receive them without handling them.
- */
-void _flushEvents() {
-    Logger::info("Flushing pending internal events...");
-    using namespace std;
-
-    int chid = ChannelCreate(0);
-    if (chid == -1) {
-        throw std::runtime_error("ChannelCreate failed");
-    }
-    int coid = ConnectAttach(0, 0, chid, _NTO_SIDE_CHANNEL, 0);
-    if (coid == -1) {
-        throw std::runtime_error("ConnectAttach failed");
-    }
-    thread flushThread([chid]() {
-        bool running = true;
-        int eventsFlushed = 0;
-        while(running) {
-        	_pulse pulse;
-        	int rtrn = MsgReceivePulse(chid, &pulse, sizeof(pulse), NULL);
-        	if (rtrn < 0) {
-        		perror("Error during MsgReceivePulse");
-        	}
-        	if (pulse.code == PULSE_STOP_THREAD) {
-        		running = false;
-        		continue;
-        	}
-        	Event event;
-        	event.type = (EventType) pulse.code;
-        	event.data = pulse.value.sival_int;
-    		Logger::info("Event flushed: " + EVENT_TO_STRING(event.type));
-        	eventsFlushed++;
-        }
-        Logger::info("Events flushed during startup: " + std::to_string(eventsFlushed));
-    });
-
-    this_thread::sleep_for(chrono::seconds(3));
-    int res = MsgSendPulse(coid, -1, PULSE_STOP_THREAD, 0);
-    if (res < 0) {
-    	throw std::runtime_error("Failed to send pulse message");
-    }
-    flushThread.join();
-
-    ConnectDetach(coid);
-    ChannelDestroy(chid);
-}
-
 int main(int argc, char **argv) {
+    // Time to ready, exported as esep_startup_ready_ms
+    Startup &startup = Startup::getInstance();
+    startup.begin();
     // Initialize Logger
     const char *debugValue = getenv("QNX_DEBUG");
     const std::string debug = debugValue ? debugValue : "";
@@ -132,6 +116,12 @@ int main(int argc, char **argv) {
         return result;
     }
 
+    if (!options.traceFile.empty()) {
+        traceFile = options.traceFile;
+        Tracer::getInstance().setEnabled(true);
+        Logger::info("Tracing enabled, written to " + traceFile + " at exit");
+    }
+
     Configuration &conf = Configuration::getInstance();
     conf.setMaster(options.mode == MASTER);
     if (conf.systemIsMaster()) {
@@ -145,6 +135,18 @@ int main(int argc, char **argv) {
         Logger::error("Error reading config file - terminating...");
         return EXIT_FAILURE;
     }
+    // Scheduling of all threads started from now on, defaults of the
+    // ThreadRegistry unless set in the config file
+    ThreadRegistry &threadRegistry = ThreadRegistry::getInstance();
+    for (const auto &policy : conf.getThreadPolicies()) {
+        threadRegistry.setPolicy(policy.first, policy.second);
+    }
+    threadRegistry.setEnabled(true);
+
+    // Changes of the file (e.g. calibration or order) are applied at runtime
+    configWatcher.start();
+    // Snapshot on request (socket) and every 10 s (file)
+    metricsExporter.start("/tmp/esep_2.1/metrics.sock", "/tmp/esep_2.1/metrics.txt", 10000);
 
     if (options.pusher) {
         Logger::info("Configured hardware: Use 'Pusher' for sorting out");
@@ -178,16 +180,13 @@ int main(int argc, char **argv) {
 
     actuators->standbyMode();
     actuators->setYellowBlinking(true);
-    _flushEvents();
-    Logger::info("Waiting for system initialization and connection to partner system...");
+    Logger::info("Waiting for connection to partner system...");
 
     Logger::registerEvents(eventManager);
-    eventManager->start();
-    std::this_thread::sleep_for(std::chrono::seconds(2));
-
-    // Start Watchdog -> send and receive heartbeats via EventManager
-    Watchdog wd(eventManager);
-    wd.start();
+    // Connecting blocks until the partner system is up, the local components
+    // are created meanwhile. Their events wait in the internal channel until
+    // the EventManager is connected.
+    std::thread linkThread([]() { eventManager->start(); });
 
     // Run FSM's only at Master
     if (options.mode == Mode::MASTER) {
@@ -198,18 +197,29 @@ int main(int argc, char **argv) {
         MainActions* mainActions = new MainActions(eventManager, new EventSender());
         mainFSM = std::make_shared<MainContext>(mainActions);
         mainActions->setData(mainFSM->data);
+        linkSync = std::make_shared<MasterLinkSync>(mainFSM.get());
+        eventManager->getLinkRecovery().addParticipant(linkSync.get());
     }
 
-    std::this_thread::sleep_for(std::chrono::seconds(1));
-
     sensors = std::make_shared<Sensors>(eventManager);
     sensors->startEventLoop();
+    if (options.mode == Mode::SLAVE) {
+        linkSync = std::make_shared<SlaveLinkSync>(
+            eventManager, []() { return sensors->lbRampBlocked(); },
+            []() { return sensors->lbStartBlocked(); }, []() { return sensors->lbEndBlocked(); });
+        eventManager->getLinkRecovery().addParticipant(linkSync.get());
+    }
 
     heightSensor = std::make_shared<HeightSensor>(eventManager);
     HeightContextData* heightData = new HeightContextData();
     HeightActions* heightActions = new HeightActions(heightData, new EventSender(), eventManager);
     heightFSM = std::make_shared<HeightContext>(heightActions, heightData, heightSensor);
 
+    linkThread.join();
+    // Start Watchdog -> send and receive heartbeats via EventManager
+    Watchdog wd(eventManager);
+    wd.start();
+
     // If Slave: tell master if pusher mounted
     if(options.mode == Mode::SLAVE && options.pusher) {
         EventSender sender;
@@ -219,12 +229,17 @@ int main(int argc, char **argv) {
     }
 
     actuators->setYellowBlinking(false);
+    startup.ready("system");
+    Logger::info("Ready after " + std::to_string(startup.elapsedMs()) + " ms");
 
     // do nothing until termination...
     //std::cin.get();
     while (running) {
         // Sleep to save CPU resources
         std::this_thread::sleep_for(std::chrono::seconds(10));
+        if (Tracer::getInstance().isEnabled()) {
+            Tracer::getInstance().collect();
+        }
     }
 
     cleanup(EXIT_SUCCESS);
@@ -0,0 +1,185 @@
+/*
+ * Metrics.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "Metrics.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+namespace {
+
+unsigned int highestBit(uint64_t value) { return 63 - __builtin_clzll(value); }
+
+// esep_x{a="1"} + _sum -> esep_x_sum{a="1"}
+std::string withSuffix(const std::string &name, const std::string &suffix) {
+    size_t brace = name.find('{');
+    if (brace == std::string::npos) {
+        return name + suffix;
+    }
+    return name.substr(0, brace) + suffix + name.substr(brace);
+}
+
+// esep_x{a="1"} + q="0.5" -> esep_x{a="1",q="0.5"}
+std::string withLabel(const std::string &name, const std::string &label) {
+    if (name.empty() || name.back() != '}') {
+        return name + "{" + label + "}";
+    }
+    return name.substr(0, name.size() - 1) + "," + label + "}";
+}
+
+std::string baseName(const std::string &name) { return name.substr(0, name.find('{')); }
+
+// TYPE line once for all metrics of a base name
+void typeLine(std::ostream &out, std::string &lastBase, const std::string &name,
+              const char *type) {
+    std::string base = baseName(name);
+    if (base != lastBase) {
+        out << "# TYPE " << base << ' ' << type << '\n';
+        lastBase = base;
+    }
+}
+
+}
+
+void *Counter::operator new(std::size_t size) {
+    void *p = nullptr;
+    if (posix_memalign(&p, alignof(Counter), size) != 0) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void Counter::operator delete(void *p) noexcept { free(p); }
+
+uint64_t Counter::value() const {
+    uint64_t sum = 0;
+    for (const Shard &shard : shards) {
+        sum += shard.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+unsigned int Counter::shardIndex() {
+    static std::atomic<unsigned int> nextShard{0};
+    thread_local unsigned int index =
+        nextShard.fetch_add(1, std::memory_order_relaxed) % METRICS_COUNTER_SHARDS;
+    return index;
+}
+
+unsigned int Histogram::bucketOf(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return (unsigned int) value;   // exact
+    }
+    unsigned int msb = highestBit(value);
+    if (msb >= METRICS_HISTOGRAM_MAX_BITS) {
+        return BUCKETS - 1;
+    }
+    unsigned int shift = msb - METRICS_HISTOGRAM_SUB_BITS;
+    unsigned int sub = (unsigned int) (value >> shift) - SUB_BUCKETS;
+    return (shift + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t Histogram::upperBoundOf(unsigned int bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    unsigned int shift = bucket / SUB_BUCKETS - 1;
+    uint64_t lower = (uint64_t) (SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+    return lower + ((uint64_t) 1 << shift) - 1;
+}
+
+void Histogram::record(uint64_t value) {
+    counts[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(value, std::memory_order_relaxed);
+    uint64_t seen = largest.load(std::memory_order_relaxed);
+    while (value > seen && !largest.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t Histogram::count() const {
+    uint64_t n = 0;
+    for (const auto &bucket : counts) {
+        n += bucket.load(std::memory_order_relaxed);
+    }
+    return n;
+}
+
+uint64_t Histogram::percentile(double quantile) const {
+    uint64_t n = count();
+    if (n == 0) {
+        return 0;
+    }
+    // nearest rank
+    uint64_t rank = (uint64_t) (quantile * n + 0.999999);
+    rank = rank == 0 ? 1 : rank;
+    uint64_t seen = 0;
+    for (unsigned int bucket = 0; bucket < BUCKETS; bucket++) {
+        seen += counts[bucket].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(upperBoundOf(bucket), max());
+        }
+    }
+    return max();
+}
+
+MetricsRegistry &MetricsRegistry::getInstance() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+Counter &MetricsRegistry::counter(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::unique_ptr<Counter> &metric = counters[name];
+    if (!metric) {
+        metric.reset(new Counter());
+    }
+    return *metric;
+}
+
+Gauge &MetricsRegistry::gauge(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::unique_ptr<Gauge> &metric = gauges[name];
+    if (!metric) {
+        metric.reset(new Gauge());
+    }
+    return *metric;
+}
+
+Histogram &MetricsRegistry::histogram(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::unique_ptr<Histogram> &metric = histograms[name];
+    if (!metric) {
+        metric.reset(new Histogram());
+    }
+    return *metric;
+}
+
+std::string MetricsRegistry::snapshot() {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::stringstream out;
+    std::string lastBase;
+    for (const auto &entry : counters) {
+        typeLine(out, lastBase, entry.first, "counter");
+        out << entry.first << ' ' << entry.second->value() << '\n';
+    }
+    for (const auto &entry : gauges) {
+        typeLine(out, lastBase, entry.first, "gauge");
+        out << entry.first << ' ' << entry.second->value() << '\n';
+    }
+    for (const auto &entry : histograms) {
+        typeLine(out, lastBase, entry.first, "summary");
+        const Histogram &h = *entry.second;
+        for (const char *quantile : {"0.5", "0.9", "0.99", "0.999"}) {
+            out << withLabel(entry.first, std::string("quantile=\"") + quantile + "\"") << ' '
+                << h.percentile(std::stod(quantile)) << '\n';
+        }
+        out << withSuffix(entry.first, "_max") << ' ' << h.max() << '\n';
+        out << withSuffix(entry.first, "_sum") << ' ' << h.sum() << '\n';
+        out << withSuffix(entry.first, "_count") << ' ' << h.count() << '\n';
+    }
+    return out.str();
+}
@@ -0,0 +1,122 @@
+/*
+ * Metrics.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Shards of a Counter, threads are assigned round robin
+#define METRICS_COUNTER_SHARDS 16
+// Histogram: 2^5 sub-buckets per power of two -> values within ~3 %
+#define METRICS_HISTOGRAM_SUB_BITS 5
+// Histogram: largest value 2^40 (e.g. ~12 days in us)
+#define METRICS_HISTOGRAM_MAX_BITS 40
+
+/**
+ * Monotonic counter. Each thread increments its own shard (one cache line),
+ * so threads do not contend for the counter. Reading sums up the shards.
+ */
+class Counter {
+  public:
+    void inc(uint64_t n = 1) { shards[shardIndex()].value.fetch_add(n, std::memory_order_relaxed); }
+
+    uint64_t value() const;
+
+    // C++14: new does not respect the alignment of the shards
+    static void *operator new(std::size_t size);
+    static void operator delete(void *p) noexcept;
+
+  private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+    std::array<Shard, METRICS_COUNTER_SHARDS> shards;
+
+    static unsigned int shardIndex();
+};
+
+/**
+ * Current value, e.g. a queue depth
+ */
+class Gauge {
+  public:
+    void set(int64_t v) { current.store(v, std::memory_order_relaxed); }
+    void add(int64_t n) { current.fetch_add(n, std::memory_order_relaxed); }
+    int64_t value() const { return current.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic<int64_t> current{0};
+};
+
+/**
+ * Latency histogram with logarithmic buckets of linear sub-buckets (as HDR
+ * histograms): constant relative precision from 1 to 2^40 in a fixed array.
+ * Recording increments the bucket and the sum, the count is summed up when
+ * read.
+ */
+class Histogram {
+  public:
+    static constexpr unsigned int SUB_BUCKETS = 1u << METRICS_HISTOGRAM_SUB_BITS;
+    static constexpr unsigned int BUCKETS =
+        (METRICS_HISTOGRAM_MAX_BITS - METRICS_HISTOGRAM_SUB_BITS + 1) * SUB_BUCKETS;
+
+    void record(uint64_t value);
+
+    uint64_t count() const;
+    uint64_t sum() const { return total.load(std::memory_order_relaxed); }
+    uint64_t max() const { return largest.load(std::memory_order_relaxed); }
+
+    /**
+     * @param quantile 0.0 ... 1.0
+     * @return upper bound of the bucket of the quantile, 0 if empty
+     */
+    uint64_t percentile(double quantile) const;
+
+    static unsigned int bucketOf(uint64_t value);
+    static uint64_t upperBoundOf(unsigned int bucket);
+
+  private:
+    std::array<std::atomic<uint64_t>, BUCKETS> counts{};
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> largest{0};
+};
+
+/**
+ * All metrics of the process by name. A name may contain labels in the
+ * Prometheus notation, e.g. esep_events_total{type="LBA_M_BLOCKED"}.
+ *
+ * Registering returns the existing metric of the name, references stay
+ * valid until the end of the process. Components keep the reference,
+ * updates do not touch the registry.
+ */
+class MetricsRegistry {
+  public:
+    static MetricsRegistry &getInstance();
+
+    Counter &counter(const std::string &name);
+    Gauge &gauge(const std::string &name);
+    Histogram &histogram(const std::string &name);
+
+    /**
+     * Text snapshot of all metrics (Prometheus text format, histograms as
+     * summary with quantiles)
+     */
+    std::string snapshot();
+
+  private:
+    MetricsRegistry() {}
+
+    std::mutex mtx;
+    std::map<std::string, std::unique_ptr<Counter>> counters;
+    std::map<std::string, std::unique_ptr<Gauge>> gauges;
+    std::map<std::string, std::unique_ptr<Histogram>> histograms;
+};
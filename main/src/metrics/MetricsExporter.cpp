@@ -0,0 +1,138 @@
+/*
+ * MetricsExporter.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "MetricsExporter.h"
+#include "common/ThreadRegistry.h"
+#include "logger/logger.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+MetricsExporter::MetricsExporter(MetricsRegistry &registry)
+    : registry(registry), listenFd(-1), stopPipe{-1, -1} {}
+
+MetricsExporter::~MetricsExporter() { stop(); }
+
+bool MetricsExporter::start(const std::string &socketPath, const std::string &dumpPath,
+                            int intervalMs) {
+    if (exportThread.joinable()) {
+        return true;
+    }
+    struct sockaddr_un addr;
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        Logger::warn("[MetricsExporter] Socket path too long: " + socketPath);
+        return false;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        Logger::warn("[MetricsExporter] Unix sockets not available - no metrics socket");
+        return false;
+    }
+    unlink(socketPath.c_str());   // left over by a previous run
+    if (bind(listenFd, (struct sockaddr *) &addr, sizeof(addr)) != 0 || listen(listenFd, 4) != 0
+        || pipe(stopPipe) != 0) {
+        Logger::warn("[MetricsExporter] Cannot listen on " + socketPath);
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    this->socketPath = socketPath;
+    exportThread = ThreadRegistry::getInstance().spawn("metrics", &MetricsExporter::serve, this,
+                                                          dumpPath, intervalMs);
+    Logger::debug("[MetricsExporter] Serving metrics on " + socketPath);
+    return true;
+}
+
+void MetricsExporter::stop() {
+    if (exportThread.joinable()) {
+        char stopByte = 0;
+        if (write(stopPipe[1], &stopByte, 1) != 1) {
+            Logger::error("[MetricsExporter] Cannot stop export thread");
+        }
+        exportThread.join();
+    }
+    for (int fd : {listenFd, stopPipe[0], stopPipe[1]}) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    if (listenFd >= 0) {
+        unlink(socketPath.c_str());
+    }
+    listenFd = -1;
+    stopPipe[0] = stopPipe[1] = -1;
+}
+
+bool MetricsExporter::dump(const std::string &path) {
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath);
+        if (!out.is_open()) {
+            return false;
+        }
+        out << registry.snapshot();
+        if (!out.good()) {
+            return false;
+        }
+    }
+    return std::rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+void MetricsExporter::serve(std::string dumpPath, int intervalMs) {
+    using namespace std::chrono;
+    struct pollfd fds[2] = {{listenFd, POLLIN, 0}, {stopPipe[0], POLLIN, 0}};
+    steady_clock::time_point nextDump = steady_clock::now() + milliseconds(intervalMs);
+    while (true) {
+        int timeout = -1;
+        if (!dumpPath.empty()) {
+            auto left = duration_cast<milliseconds>(nextDump - steady_clock::now()).count();
+            timeout = left > 0 ? (int) left : 0;
+        }
+        if (poll(fds, 2, timeout) < 0) {
+            continue;
+        }
+        if (fds[1].revents & POLLIN) {
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            int client = accept(listenFd, NULL, NULL);
+            if (client >= 0) {
+                std::string text = registry.snapshot();
+                size_t sent = 0;
+                while (sent < text.size()) {
+                    // a client closing early must not raise SIGPIPE
+                    ssize_t n =
+                        send(client, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+                    if (n <= 0) {
+                        break;
+                    }
+                    sent += n;
+                }
+                close(client);
+            }
+        }
+        if (!dumpPath.empty() && steady_clock::now() >= nextDump) {
+            if (!dump(dumpPath)) {
+                Logger::warn("[MetricsExporter] Cannot write " + dumpPath);
+            }
+            nextDump += milliseconds(intervalMs);
+        }
+    }
+}
@@ -0,0 +1,47 @@
+/*
+ * MetricsExporter.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "Metrics.h"
+
+#include <string>
+#include <thread>
+
+/**
+ * Exposes MetricsRegistry::snapshot() on a local (Unix domain) socket: each
+ * connection receives one snapshot and is closed, e.g.
+ * socat - UNIX-CONNECT:/tmp/esep_2.1/metrics.sock
+ * Additionally the snapshot is written to a file periodically.
+ */
+class MetricsExporter {
+  public:
+    MetricsExporter(MetricsRegistry &registry = MetricsRegistry::getInstance());
+    virtual ~MetricsExporter();
+
+    /**
+     * @param socketPath path of the socket, an existing one is replaced
+     * @param dumpPath file of the periodic snapshot, empty for none
+     * @param intervalMs period of the dump
+     * @return false if the socket cannot be created
+     */
+    bool start(const std::string &socketPath, const std::string &dumpPath = "",
+               int intervalMs = 10000);
+    void stop();
+
+    /**
+     * Writes the snapshot to the file (replaced by a rename, readers never
+     * see a partial snapshot)
+     */
+    bool dump(const std::string &path);
+
+  private:
+    MetricsRegistry &registry;
+    int listenFd;
+    int stopPipe[2];
+    std::string socketPath;
+    std::thread exportThread;
+    void serve(std::string dumpPath, int intervalMs);
+};
@@ -13,6 +13,8 @@
 #include "data/Workpiece.h"
 #include "data/WorkpieceManager.h"
 #include "data/workpiecetype_enum.h"
+#include "common/Clock.h"
+#include "common/TimerService.h"
 #include "logic/main_fsm/MainContext.h"
 #include <gtest/gtest.h>
 #include <thread>
@@ -21,6 +23,7 @@
 
 class IntegrationTest_Running : public ::testing::Test {
   protected:
+	VirtualClock clock;
 	std::shared_ptr<EventManagerMock> evm = std::make_shared<EventManagerMock>();
     IEventSender* sender;
     MainActions* mainActions;
@@ -31,7 +34,10 @@ class IntegrationTest_Running : public ::testing::Test {
      * OPTIONAL: Prepare objects before each test
      */
     void SetUp() override {
+    	Clock::setInstance(&clock);
     	Configuration::getInstance().setDesiredWorkpieceOrder({WS_F, WS_BOM, WS_OB});
+    	Configuration::getInstance().setOffsetCalibration(3600);
+    	Configuration::getInstance().setReferenceCalibration(2500);
     	sender = new EventSenderMock();
         mainActions = new MainActions(evm, sender);
         fsm = new MainContext(mainActions);
@@ -39,8 +45,6 @@ class IntegrationTest_Running : public ::testing::Test {
     	fsm->master_btnStart_PressedShort();
     	evm->clearLastHandledEvents();
     	clearBelt();
-    	Configuration::getInstance().setOffsetCalibration(3600);
-    	Configuration::getInstance().setReferenceCalibration(2500);
     }
 
     /**
@@ -48,6 +52,18 @@ class IntegrationTest_Running : public ::testing::Test {
      */
     void TearDown() override {
     	delete fsm;
+    	Clock::setInstance(nullptr);
+    }
+
+    /**
+     * Advances the virtual time and waits until the timers which are due have
+     * been executed
+     */
+    void advance(int ms) {
+    	clock.advance(ms);
+    	for (int i = 0; i < 1000 && !TimerService::getInstance().isIdle(); i++) {
+    		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    	}
     }
 
     void clearBelt() {
@@ -104,7 +120,7 @@ TEST_F(IntegrationTest_Running, RampBlockedWhenRunningStarted) {
 	EXPECT_TRUE(wpm->getRamp_one());
 	EXPECT_TRUE(wpm->getRamp_two());
 
-	std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+	advance(1100);
 	EXPECT_TRUE(evm->lastHandledEventsContain(Event{EventType::LAMP_M_YELLOW, (int) LampState::FLASHING_SLOW}));
 	EXPECT_TRUE(evm->lastHandledEventsContain(Event{EventType::LAMP_S_YELLOW, (int) LampState::FLASHING_SLOW}));
 }
@@ -120,12 +136,12 @@ TEST_F(IntegrationTest_Running, IfRampOccupiedDisplayWarning) {
 	EXPECT_TRUE(wpm->getRamp_one());
 	EXPECT_FALSE(wpm->getRamp_two());
 	// after 1 sec. -> display warning
-	std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+	advance(1100);
 	EXPECT_TRUE(evm->lastHandledEventsContain(Event{EventType::LAMP_M_YELLOW, (int) LampState::FLASHING_SLOW}));
 	// is unblocked -> ramp free again
 	fsm->master_LBR_Unblocked();
 	EXPECT_FALSE(wpm->getRamp_one());
-	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	advance(100);
 	EXPECT_TRUE(evm->lastHandledEventsContain(Event{EventType::LAMP_M_YELLOW, (int) LampState::OFF}));
 
 	// FBM2 Ramp is blocked
@@ -134,7 +150,7 @@ TEST_F(IntegrationTest_Running, IfRampOccupiedDisplayWarning) {
 	EXPECT_TRUE(wpm->getRamp_two());
 	EXPECT_FALSE(wpm->getRamp_one());
 	// after 1 sec. -> display warning
-	std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+	advance(1100);
 	EXPECT_TRUE(evm->lastHandledEventsContain(Event{EventType::LAMP_S_YELLOW, (int) LampState::FLASHING_SLOW}));
 	// is unblocked -> ramp free again
 	fsm->slave_LBR_Unblocked();
@@ -142,6 +158,17 @@ TEST_F(IntegrationTest_Running, IfRampOccupiedDisplayWarning) {
 	EXPECT_TRUE(evm->lastHandledEventsContain(Event{EventType::LAMP_S_YELLOW, (int) LampState::OFF}));
 }
 
+// The warning timer of Running must not fire after Running has been left
+TEST_F(IntegrationTest_Running, RampWarningCancelledWhenLeft) {
+	fsm->master_LBR_Blocked();
+	fsm->master_EStop_Pressed();
+	EXPECT_EQ(MainState::ESTOP, fsm->getCurrentState());
+	evm->clearLastHandledEvents();
+
+	advance(1100);
+	EXPECT_FALSE(evm->lastHandledEventsContain(Event{EventType::LAMP_M_YELLOW, (int) LampState::FLASHING_SLOW}));
+}
+
 TEST_F(IntegrationTest_Running, NewWorkpieceInsertedStartMotor) {
 	fsm->master_btnStop_Pressed();
 	evm->clearLastHandledEvents();
@@ -362,3 +389,173 @@ TEST_F(IntegrationTest_Running, RunningToStandbyToRunningBothFBMFree) {
 	EXPECT_FALSE(evm->lastHandledEventsContain(Event{MOTOR_M_RIGHT_REQ, 1}));
 	EXPECT_FALSE(evm->lastHandledEventsContain(Event{MOTOR_S_RIGHT_REQ, 1}));
 }
+
+TEST_F(IntegrationTest_Running, HandoverWaitsWhileFBM2EntryOccupied) {
+	fsm->data->handover->setMinGapMs(0);
+
+	// First workpiece is handed over, but is still at the start of FBM2
+	wpRunUntilSwitchAtFBM1(EventType::HM_M_WS_F, 21.0, false);
+	fsm->master_LBW_Unblocked();
+	fsm->master_LBE_Blocked();
+	fsm->master_LBE_Unblocked();
+	fsm->slave_LBA_Blocked();
+	EXPECT_EQ(1, wpm->getNumberOfWorkpiecesFBM2());
+
+	// Second workpiece reaches end of FBM1 -> FBM1 must wait
+	wpRunUntilSwitchAtFBM1(EventType::HM_M_WS_BOM, 25.0, false);
+	fsm->master_LBW_Unblocked();
+	evm->clearLastHandledEvents();
+	fsm->master_LBE_Blocked();
+	EXPECT_TRUE(evm->lastHandledEventsContain(Event{EventType::MOTOR_M_RIGHT_REQ, 0}));
+	EXPECT_TRUE(fsm->data->handover->isWaiting());
+
+	// First workpiece completely on FBM2 -> FBM1 may continue
+	evm->clearLastHandledEvents();
+	fsm->slave_LBA_Unblocked();
+	EXPECT_TRUE(evm->lastHandledEventsContain(Event{EventType::MOTOR_M_RIGHT_REQ, 1}));
+	EXPECT_FALSE(fsm->data->handover->isWaiting());
+}
+
+TEST_F(IntegrationTest_Running, HandoverTwoWorkpiecesOnFBM2) {
+	fsm->data->handover->setMinGapMs(0);
+
+	// First workpiece is handed over and enters FBM2 completely
+	wpRunUntilSwitchAtFBM1(EventType::HM_M_WS_F, 21.0, false);
+	fsm->master_LBW_Unblocked();
+	fsm->master_LBE_Blocked();
+	fsm->master_LBE_Unblocked();
+	fsm->slave_LBA_Blocked();
+	fsm->slave_LBA_Unblocked();
+
+	// Second workpiece follows without waiting for the first to leave
+	wpRunUntilSwitchAtFBM1(EventType::HM_M_WS_BOM, 25.0, false);
+	fsm->master_LBW_Unblocked();
+	evm->clearLastHandledEvents();
+	fsm->master_LBE_Blocked();
+	EXPECT_FALSE(evm->lastHandledEventsContain(Event{EventType::MOTOR_M_RIGHT_REQ, 0}));
+	fsm->master_LBE_Unblocked();
+	EXPECT_EQ(2, wpm->getNumberOfWorkpiecesFBM2());
+	EXPECT_EQ(1, fsm->data->handover->getPipelinedCount());
+
+	// Height results are assigned in order of arrival
+	fsm->slave_heightResultReceived(EventType::HM_S_WS_F, 21.0);
+	fsm->slave_LBA_Blocked();
+	fsm->slave_LBA_Unblocked();
+	fsm->slave_heightResultReceived(EventType::HM_S_WS_BOM, 25.0);
+
+	Workpiece *first = wpm->getHeadOfArea(AreaType::AREA_D);
+	Workpiece *second = wpm->getTailOfArea(AreaType::AREA_D);
+	EXPECT_EQ(WorkpieceType::WS_F, first->S_type);
+	EXPECT_EQ(WorkpieceType::WS_BOM, second->S_type);
+
+	// First leaves at the end, FBM2 keeps running for the second one
+	fsm->slave_LBW_Blocked();
+	fsm->slave_LBW_Unblocked();
+	fsm->slave_LBE_Blocked();
+	evm->clearLastHandledEvents();
+	fsm->slave_LBE_Unblocked();
+	EXPECT_EQ(1, wpm->getNumberOfWorkpiecesFBM2());
+	EXPECT_TRUE(evm->lastHandledEventsContain(Event{EventType::MOTOR_S_RIGHT_REQ, 1}));
+
+	// Second leaves at the end, FBM2 stops
+	fsm->slave_LBW_Blocked();
+	fsm->slave_LBW_Unblocked();
+	fsm->slave_LBE_Blocked();
+	evm->clearLastHandledEvents();
+	fsm->slave_LBE_Unblocked();
+	EXPECT_TRUE(wpm->isFBM_SEmpty());
+	EXPECT_TRUE(evm->lastHandledEventsContain(Event{EventType::MOTOR_S_RIGHT_REQ, 0}));
+}
+
+// A workpiece reaches the end of FBM2 but none has passed the switch: it is not
+// guessed which one it is
+TEST_F(IntegrationTest_Running, UnknownWorkpieceAtEndOfFBM2IsError) {
+	wpRunUntilSwitchAtFBM1(EventType::HM_M_WS_F, 21.0, false);
+	fsm->master_LBW_Unblocked();
+	fsm->master_LBE_Blocked();
+	fsm->master_LBE_Unblocked();
+	fsm->slave_LBA_Blocked();
+	fsm->slave_LBA_Unblocked();
+	fsm->slave_heightResultReceived(EventType::HM_S_WS_F, 21.0);
+
+	evm->clearLastHandledEvents();
+	fsm->slave_LBE_Blocked();
+	EXPECT_TRUE(evm->lastHandledEventsContain(Event{EventType::ERROR_S_MAN_SOLVABLE}));
+	fsm->slave_LBE_Unblocked();
+	EXPECT_EQ(1, wpm->getNumberOfWorkpiecesFBM2());
+}
+
+TEST_F(IntegrationTest_Running, HandoverGapOnlyElapsesWhileFBM2Moving) {
+	HandoverControl *handover = fsm->data->handover;
+	handover->setMinGapMs(300);
+	handover->workpieceEntered();
+
+	// FBM2 stopped -> no distance to the previous workpiece
+	clock.advance(500);
+	EXPECT_EQ(300, handover->remainingGapMs());
+
+	fsm->handleEvent(Event{EventType::MOTOR_S_FAST});
+	clock.advance(200);
+	EXPECT_EQ(100, handover->remainingGapMs());
+	fsm->handleEvent(Event{EventType::MOTOR_S_STOP});
+	clock.advance(500);
+	EXPECT_EQ(100, handover->remainingGapMs());
+	fsm->handleEvent(Event{EventType::MOTOR_S_SLOW});
+	clock.advance(100);
+	EXPECT_EQ(0, handover->remainingGapMs());
+}
+
+TEST_F(IntegrationTest_Running, HandoverGapElapsedRestartsFBM1) {
+	fsm->data->handover->setMinGapMs(100);
+	fsm->handleEvent(Event{EventType::MOTOR_S_STOP});
+
+	// First workpiece enters FBM2 completely, FBM2 is not moving yet
+	wpRunUntilSwitchAtFBM1(EventType::HM_M_WS_F, 21.0, false);
+	fsm->master_LBW_Unblocked();
+	fsm->master_LBE_Blocked();
+	fsm->master_LBE_Unblocked();
+	fsm->slave_LBA_Blocked();
+	fsm->slave_LBA_Unblocked();
+
+	// Second workpiece waits for the gap
+	wpRunUntilSwitchAtFBM1(EventType::HM_M_WS_BOM, 25.0, false);
+	fsm->master_LBW_Unblocked();
+	fsm->master_LBE_Blocked();
+	EXPECT_TRUE(fsm->data->handover->isWaiting());
+	advance(200);
+	EXPECT_TRUE(fsm->data->handover->isWaiting());
+
+	// FBM2 moves -> HANDOVER_GAP_ELAPSED after the gap restarts FBM1
+	evm->clearLastHandledEvents();
+	fsm->handleEvent(Event{EventType::MOTOR_S_FAST});
+	EXPECT_FALSE(evm->lastHandledEventsContain(Event{EventType::MOTOR_M_RIGHT_REQ, 1}));
+	advance(300);
+	EXPECT_TRUE(evm->lastHandledEventsContain(Event{EventType::HANDOVER_GAP_ELAPSED}));
+	EXPECT_TRUE(evm->lastHandledEventsContain(Event{EventType::MOTOR_M_RIGHT_REQ, 1}));
+	EXPECT_FALSE(fsm->data->handover->isWaiting());
+}
+
+TEST_F(IntegrationTest_Running, HandoverTimerCancelledByEStop) {
+	fsm->data->handover->setMinGapMs(100);
+	fsm->handleEvent(Event{EventType::MOTOR_S_FAST});
+
+	wpRunUntilSwitchAtFBM1(EventType::HM_M_WS_F, 21.0, false);
+	fsm->master_LBW_Unblocked();
+	fsm->master_LBE_Blocked();
+	fsm->master_LBE_Unblocked();
+	fsm->slave_LBA_Blocked();
+	fsm->slave_LBA_Unblocked();
+	wpRunUntilSwitchAtFBM1(EventType::HM_M_WS_BOM, 25.0, false);
+	fsm->master_LBW_Unblocked();
+	fsm->master_LBE_Blocked();
+	EXPECT_TRUE(fsm->data->handover->isWaiting());
+
+	// Leaving Running cancels the gap timer and forgets the waiting workpiece
+	fsm->master_EStop_Pressed();
+	EXPECT_EQ(MainState::ESTOP, fsm->getCurrentState());
+	EXPECT_FALSE(fsm->data->handover->isWaiting());
+	evm->clearLastHandledEvents();
+	advance(300);
+	EXPECT_FALSE(evm->lastHandledEventsContain(Event{EventType::HANDOVER_GAP_ELAPSED}));
+	EXPECT_FALSE(evm->lastHandledEventsContain(Event{EventType::MOTOR_M_RIGHT_REQ, 1}));
+}
@@ -0,0 +1,93 @@
+/*
+ * UnitTest_Clock.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "common/Clock.h"
+#include "common/TimerService.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono;
+
+class UnitTest_Clock : public ::testing::Test {
+  protected:
+    VirtualClock clock;
+
+    // Timer thread reacts asynchronously on advance()
+    bool waitFor(std::function<bool()> condition) {
+        for (int i = 0; i < 5000 && !condition(); i++) {
+            std::this_thread::sleep_for(microseconds(100));
+        }
+        return condition();
+    }
+};
+
+TEST_F(UnitTest_Clock, SystemClockIsDefault) {
+	Clock &system = Clock::getInstance();
+	Clock::setInstance(&clock);
+	EXPECT_EQ(&clock, &Clock::getInstance());
+	Clock::setInstance(nullptr);
+	EXPECT_EQ(&system, &Clock::getInstance());
+}
+
+TEST_F(UnitTest_Clock, VirtualTimeOnlyAdvancesManually) {
+	Clock::time_point start = clock.now();
+	std::this_thread::sleep_for(milliseconds(20));
+	EXPECT_EQ(0, clock.millisSince(start));
+	clock.advance(1500);
+	EXPECT_EQ(1500, clock.millisSince(start));
+	EXPECT_EQ(1500u, clock.getElapsedMs());
+}
+
+TEST_F(UnitTest_Clock, SleepEndsWithAdvance) {
+	std::atomic<bool> woken{false};
+	std::thread sleeper([&]() {
+		clock.sleepFor(200);
+		woken = true;
+	});
+	std::this_thread::sleep_for(milliseconds(20));
+	clock.advance(100);
+	std::this_thread::sleep_for(milliseconds(20));
+	EXPECT_FALSE(woken);
+	clock.advance(100);
+	EXPECT_TRUE(waitFor([&]() { return woken.load(); }));
+	sleeper.join();
+}
+
+TEST_F(UnitTest_Clock, TimerFollowsVirtualClock) {
+	TimerService timers(clock);
+	std::atomic<bool> fired{false};
+	timers.scheduleOnce(1000, [&]() { fired = true; });
+
+	std::this_thread::sleep_for(milliseconds(50));
+	EXPECT_FALSE(fired);
+	clock.advance(990);
+	std::this_thread::sleep_for(milliseconds(20));
+	EXPECT_FALSE(fired);
+	clock.advance(10);
+	EXPECT_TRUE(waitFor([&]() { return fired.load(); }));
+}
+
+// 10 simulated minutes of a 500 ms periodic timer in 20 ms slices
+TEST_F(UnitTest_Clock, FasterThanRealTime) {
+	TimerService timers(clock);
+	std::atomic<int> nCalls{0};
+	timers.schedulePeriodic(500, [&]() { nCalls++; });
+
+	steady_clock::time_point start = steady_clock::now();
+	for (int t = 0; t < 600 * 1000; t += 20) {
+		clock.advance(20);
+		if (t % 500 == 0) {
+			// let the timer thread keep up
+			int expected = t / 500;
+			waitFor([&]() { return nCalls >= expected; });
+		}
+	}
+	EXPECT_TRUE(waitFor([&]() { return nCalls == 1200; }));
+	int realMs = duration_cast<milliseconds>(steady_clock::now() - start).count();
+	EXPECT_LT(realMs, 10 * 1000);
+}
@@ -0,0 +1,225 @@
+/*
+ * UnitTest_Configuration.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "configuration/ConfigWatcher.h"
+#include "configuration/Configuration.h"
+#include "hal/IHeightSensor.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+using namespace std::chrono;
+
+class UnitTest_Configuration : public ::testing::Test {
+  protected:
+    Configuration &conf = Configuration::getInstance();
+    ConfigSnapshot saved;
+    std::string savedPath;
+    std::string dir;
+    std::string path;
+
+    void SetUp() override {
+        saved = *conf.snapshot();
+        savedPath = conf.getConfigFilePath();
+        char tmpl[] = "/tmp/esep_conf_XXXXXX";
+        ASSERT_NE(nullptr, mkdtemp(tmpl));
+        dir = tmpl;
+        path = dir + "/conf.txt";
+        conf.setConfigFilePath(path);
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+        rmdir(dir.c_str());
+        conf.setConfigFilePath(savedPath);
+        conf.setDesiredWorkpieceOrder(saved.order);
+        conf.setOffsetCalibration(saved.cal.calOffset);
+        conf.setReferenceCalibration(saved.cal.calRef);
+    }
+
+    // Writes the file like an editor: temporary file renamed over the config
+    void writeFile(const std::string &content) {
+        std::string tmp = dir + "/edit.tmp";
+        std::ofstream out(tmp);
+        out << content;
+        out.close();
+        std::rename(tmp.c_str(), path.c_str());
+    }
+
+    std::string readFile() {
+        std::ifstream in(path);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+
+    bool waitForVersion(uint64_t version) {
+        for (int i = 0; i < 200 && conf.getVersion() < version; i++) {
+            std::this_thread::sleep_for(milliseconds(10));
+        }
+        return conf.getVersion() >= version;
+    }
+};
+
+TEST_F(UnitTest_Configuration, SnapshotsVersioned) {
+	conf.setOffsetCalibration(3600);
+	std::shared_ptr<const ConfigSnapshot> before = conf.snapshot();
+	uint64_t version = conf.getVersion();
+
+	conf.setOffsetCalibration(3600);   // unchanged -> no new snapshot
+	EXPECT_EQ(version, conf.getVersion());
+
+	conf.setOffsetCalibration(3700);
+	EXPECT_EQ(version + 1, conf.getVersion());
+	EXPECT_EQ(3700, conf.getCalibration().calOffset);
+	// old snapshot still readable and unchanged
+	EXPECT_EQ(3600, before->cal.calOffset);
+	EXPECT_EQ(version, before->version);
+}
+
+TEST_F(UnitTest_Configuration, OldSnapshotFreedByLastReader) {
+	std::weak_ptr<const ConfigSnapshot> old;
+	{
+		std::shared_ptr<const ConfigSnapshot> reader = conf.snapshot();
+		old = reader;
+		conf.setOffsetCalibration(reader->cal.calOffset + 1);
+		EXPECT_FALSE(old.expired());
+	}
+	EXPECT_TRUE(old.expired());
+	EXPECT_FALSE(std::weak_ptr<const ConfigSnapshot>(conf.snapshot()).expired());
+}
+
+TEST_F(UnitTest_Configuration, MissingFilePublishesDefaults) {
+	conf.setDesiredWorkpieceOrder({WS_OB, WS_F, WS_BOM});
+	conf.setOffsetCalibration(3000);
+	uint64_t version = conf.getVersion();
+	ASSERT_NE(0, access(path.c_str(), F_OK));
+
+	EXPECT_TRUE(conf.readConfigFromFile());
+	EXPECT_EQ(version + 1, conf.getVersion());
+	EXPECT_EQ(ADC_DEFAULT_OFFSET, conf.getCalibration().calOffset);
+	EXPECT_EQ(ADC_DEFAULT_HIGH, conf.getCalibration().calRef);
+	EXPECT_EQ(WS_F, conf.getDesiredOrder().at(0));
+	// file and published configuration agree
+	conf.setOffsetCalibration(3000);
+	EXPECT_TRUE(conf.reloadConfigFromFile());
+	EXPECT_EQ(ADC_DEFAULT_OFFSET, conf.getCalibration().calOffset);
+}
+
+TEST_F(UnitTest_Configuration, SaveByAtomicRename) {
+	conf.setDesiredWorkpieceOrder({WS_OB, WS_F, WS_BOM});
+	conf.setOffsetCalibration(3650);
+	conf.setReferenceCalibration(2450);
+	conf.saveCurrentConfigToFile();
+	EXPECT_EQ("ORDER=OB,F,BOM\nCAL_OFFSET=3650\nCAL_REF=2450\n", readFile());
+	EXPECT_NE(0, access((path + ".tmp").c_str(), F_OK));
+
+	conf.setOffsetCalibration(3000);
+	EXPECT_TRUE(conf.readConfigFromFile());
+	EXPECT_EQ(3650, conf.getCalibration().calOffset);
+	EXPECT_EQ(WS_OB, conf.getDesiredOrder().at(0));
+}
+
+TEST_F(UnitTest_Configuration, InvalidFileKeepsConfiguration) {
+	conf.setOffsetCalibration(3600);
+	uint64_t version = conf.getVersion();
+	writeFile("ORDER=F,XY,OB\nCAL_OFFSET=3500\nCAL_REF=2500\n");
+	EXPECT_FALSE(conf.reloadConfigFromFile());
+	writeFile("ORDER=F,BOM,OB\nCAL_OFFSET=abc\nCAL_REF=2500\n");
+	EXPECT_FALSE(conf.reloadConfigFromFile());
+	EXPECT_EQ(version, conf.getVersion());
+	EXPECT_EQ(3600, conf.getCalibration().calOffset);
+}
+
+// Readers never see offset and reference of different files
+TEST_F(UnitTest_Configuration, ReadersSeeConsistentSnapshots) {
+	std::atomic<bool> done{false};
+	std::atomic<int> inconsistent{0};
+	std::atomic<uint64_t> reads{0};
+	auto reader = [&]() {
+		while (!done) {
+			Calibration cal = conf.getCalibration();
+			if (cal.calOffset - cal.calRef != 1000) {
+				inconsistent++;
+			}
+			reads++;
+		}
+	};
+	conf.setOffsetCalibration(3500);
+	conf.setReferenceCalibration(2500);
+	std::thread r1(reader);
+	std::thread r2(reader);
+	for (int i = 0; i < 200; i++) {
+		int offset = 3000 + (i % 2) * 500;
+		writeFile("ORDER=F,BOM,OB\nCAL_OFFSET=" + std::to_string(offset)
+		          + "\nCAL_REF=" + std::to_string(offset - 1000) + "\n");
+		EXPECT_TRUE(conf.reloadConfigFromFile());
+	}
+	done = true;
+	r1.join();
+	r2.join();
+	EXPECT_EQ(0, inconsistent);
+	EXPECT_GT(reads, 0u);
+}
+
+TEST_F(UnitTest_Configuration, HotReload) {
+	conf.setDesiredWorkpieceOrder({WS_F, WS_BOM, WS_OB});
+	conf.setOffsetCalibration(3600);
+	conf.setReferenceCalibration(2500);
+	conf.saveCurrentConfigToFile();
+
+	ConfigWatcher watcher(conf);
+	ASSERT_TRUE(watcher.start());
+	uint64_t version = conf.getVersion();
+
+	writeFile("ORDER=BUM,OB,F\nCAL_OFFSET=3620\nCAL_REF=2480\n");
+	ASSERT_TRUE(waitForVersion(version + 1));
+	EXPECT_EQ(3620, conf.getCalibration().calOffset);
+	EXPECT_EQ(2480, conf.getCalibration().calRef);
+	EXPECT_EQ(WS_BUM, conf.getDesiredOrder().at(0));
+
+	// own save is seen by the watcher, but publishes nothing
+	uint64_t reloads = watcher.getReloads();
+	conf.saveCurrentConfigToFile();
+	for (int i = 0; i < 100 && watcher.getReloads() == reloads; i++) {
+		std::this_thread::sleep_for(milliseconds(10));
+	}
+	EXPECT_GT(watcher.getReloads(), reloads);
+	EXPECT_EQ(version + 1, conf.getVersion());
+	watcher.stop();
+}
+
+TEST_F(UnitTest_Configuration, ThreadPolicies) {
+	writeFile("ORDER=F,BOM,OB\nCAL_OFFSET=3600\nCAL_REF=2500\n"
+	          "THREAD=sensors:fifo:45:0\nTHREAD=metrics:other:0\n");
+	ASSERT_TRUE(conf.reloadConfigFromFile());
+	std::map<std::string, ThreadPolicy> threads = conf.getThreadPolicies();
+	ASSERT_EQ(2u, threads.size());
+	EXPECT_EQ((ThreadPolicy{SchedPolicy::FIFO, 45, 0}), threads["sensors"]);
+	EXPECT_EQ(SchedPolicy::OTHER, threads["metrics"].policy);
+
+	// kept when the configuration is saved
+	conf.saveCurrentConfigToFile();
+	EXPECT_EQ("ORDER=F,BOM,OB\nCAL_OFFSET=3600\nCAL_REF=2500\n"
+	          "THREAD=metrics:other:0\nTHREAD=sensors:fifo:45:0\n",
+	          readFile());
+
+	uint64_t version = conf.getVersion();
+	writeFile("ORDER=F,BOM,OB\nCAL_OFFSET=3600\nCAL_REF=2500\nTHREAD=sensors:fast:45\n");
+	EXPECT_FALSE(conf.reloadConfigFromFile());
+	EXPECT_EQ(version, conf.getVersion());
+
+	// removed lines remove the policy
+	writeFile("ORDER=F,BOM,OB\nCAL_OFFSET=3600\nCAL_REF=2500\n");
+	ASSERT_TRUE(conf.reloadConfigFromFile());
+	EXPECT_TRUE(conf.getThreadPolicies().empty());
+}
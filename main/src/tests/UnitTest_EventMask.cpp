@@ -0,0 +1,134 @@
+/*
+ * UnitTest_EventMask.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "mocks/EventManagerMock.h"
+
+#include "events/EventMask.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+class CountingHandler : public IEventHandler {
+  public:
+    void handleEvent(Event event) override { received.push_back(event.type); }
+    std::vector<EventType> received;
+};
+
+class UnitTest_EventMask : public ::testing::Test {
+  protected:
+    std::shared_ptr<EventManagerMock> eventManager = std::make_shared<EventManagerMock>();
+};
+
+TEST_F(UnitTest_EventMask, MatchingByName) {
+	EventMask lbMaster = EventMask::matching("LB*_M_*");
+	EXPECT_EQ(8, lbMaster.count());
+	EXPECT_TRUE(lbMaster.contains(EventType::LBA_M_BLOCKED));
+	EXPECT_TRUE(lbMaster.contains(EventType::LBR_M_UNBLOCKED));
+	EXPECT_FALSE(lbMaster.contains(EventType::LBA_S_BLOCKED));
+
+	EventMask lamps = EventMask::matching("LAMP_*");
+	EXPECT_EQ(6, lamps.count());
+
+	EXPECT_TRUE(EventMask::matching("NO_SUCH_EVENT").empty());
+}
+
+TEST_F(UnitTest_EventMask, RangeAndCombination) {
+	EventMask modes = EventMask::range(EventType::MODE_STANDBY, EventType::MODE_ERROR);
+	EXPECT_EQ(5, modes.count());
+
+	EventMask mask = modes | EventMask{EventType::ESTOP_M_PRESSED};
+	EXPECT_EQ(6, mask.count());
+	EXPECT_EQ(1, (mask & EventMask::matching("ESTOP_*")).count());
+}
+
+TEST_F(UnitTest_EventMask, MaskSubscriberReceivesOnlyMaskedEvents) {
+	CountingHandler handler;
+	eventManager->subscribe(EventMask::matching("LB*_S_*"), &handler);
+
+	eventManager->handleEvent(Event{EventType::LBA_S_BLOCKED});
+	eventManager->handleEvent(Event{EventType::LBA_M_BLOCKED});
+	eventManager->handleEvent(Event{EventType::LBE_S_UNBLOCKED});
+
+	ASSERT_EQ(2, handler.received.size());
+	EXPECT_EQ(EventType::LBA_S_BLOCKED, handler.received[0]);
+	EXPECT_EQ(EventType::LBE_S_UNBLOCKED, handler.received[1]);
+}
+
+TEST_F(UnitTest_EventMask, SubscribeToAllEventsWithOneCallback) {
+	int nCalls = 0;
+	int nEvents = eventManager->subscribeToAllEvents([&nCalls](const Event &) { nCalls++; });
+	EXPECT_GT(nEvents, 0);
+
+	eventManager->handleEvent(Event{EventType::START_M_SHORT});
+	eventManager->handleEvent(Event{EventType::MODE_RUNNING});
+	EXPECT_EQ(2, nCalls);
+}
+
+// Type and mask subscribers are notified in the order they subscribed
+TEST_F(UnitTest_EventMask, OrderOfSubscriptionKept) {
+	std::vector<int> calls;
+	eventManager->subscribe(EventType::LBA_M_BLOCKED, [&calls](const Event &) { calls.push_back(1); });
+	eventManager->subscribe(EventMask{EventType::LBA_M_BLOCKED},
+	                        [&calls](const Event &) { calls.push_back(2); });
+	eventManager->subscribe(EventType::LBA_M_BLOCKED, [&calls](const Event &) { calls.push_back(3); });
+	CountingHandler handler;
+	eventManager->subscribe(EventMask{EventType::LBA_M_BLOCKED}, &handler);
+
+	eventManager->handleEvent(Event{EventType::LBA_M_BLOCKED});
+	EXPECT_EQ((std::vector<int>{1, 2, 3}), calls);
+	EXPECT_EQ(1, handler.received.size());
+}
+
+TEST_F(UnitTest_EventMask, UnsubscribedNotNotified) {
+	CountingHandler handler;
+	int nCalls = 0;
+	SubscriptionId byHandler = eventManager->subscribe(EventMask::matching("LBA_*"), &handler);
+	SubscriptionId byCallback = eventManager->subscribe(EventMask::matching("LBA_*"),
+	                                                    [&nCalls](const Event &) { nCalls++; });
+	EXPECT_NE(byHandler, byCallback);
+	eventManager->handleEvent(Event{EventType::LBA_M_BLOCKED});
+
+	eventManager->unsubscribe(byHandler);
+	eventManager->unsubscribe(byCallback);
+	eventManager->unsubscribe(byCallback);   // ignored
+	eventManager->handleEvent(Event{EventType::LBA_M_BLOCKED});
+	EXPECT_EQ(1, handler.received.size());
+	EXPECT_EQ(1, nCalls);
+}
+
+// A subscriber may unsubscribe itself while it is notified
+TEST_F(UnitTest_EventMask, UnsubscribeWhileNotified) {
+	int nCalls = 0;
+	SubscriptionId self = 0;
+	self = eventManager->subscribe(EventMask::matching("LBA_*"), [&](const Event &) {
+		nCalls++;
+		eventManager->unsubscribe(self);
+	});
+	eventManager->handleEvent(Event{EventType::LBA_M_BLOCKED});
+	eventManager->handleEvent(Event{EventType::LBA_M_BLOCKED});
+	EXPECT_EQ(1, nCalls);
+}
+
+// Unsubscribe returns only after a running notification has finished
+TEST_F(UnitTest_EventMask, UnsubscribeWaitsForNotification) {
+	std::atomic<bool> entered{false};
+	std::atomic<bool> finished{false};
+	auto slowCallback = [&](const Event &) {
+		entered = true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		finished = true;
+	};
+	SubscriptionId subscription = eventManager->subscribe(EventMask::matching("LBA_*"), slowCallback);
+	std::thread dispatcher([&]() { eventManager->handleEvent(Event{EventType::LBA_M_BLOCKED}); });
+	while (!entered) {
+		std::this_thread::yield();
+	}
+	eventManager->unsubscribe(subscription);
+	EXPECT_TRUE(finished);
+	dispatcher.join();
+}
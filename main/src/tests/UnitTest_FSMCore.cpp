@@ -0,0 +1,122 @@
+/*
+ * UnitTest_FSMCore.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "mocks/EventManagerMock.h"
+#include "mocks/EventSenderMock.h"
+
+#include "configuration/Configuration.h"
+#include "logic/EventDispatchTable.h"
+#include "logic/StateStorage.h"
+#include "logic/main_fsm/MainContext.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+struct TestBase {
+    virtual ~TestBase() {}
+    virtual int id() { return 0; }
+};
+
+int nDestroyed = 0;
+
+struct TestStateA : public TestBase {
+    ~TestStateA() { nDestroyed++; }
+    int id() override { return 1; }
+};
+
+struct TestStateB : public TestBase {
+    ~TestStateB() { nDestroyed++; }
+    int id() override { return 2; }
+};
+
+struct TestContext {
+    int nStart{0};
+    int lastData{0};
+};
+
+}
+
+class UnitTest_FSMCore : public ::testing::Test {
+  protected:
+	std::shared_ptr<EventManagerMock> eventManager = std::make_shared<EventManagerMock>();
+    IEventSender* sender;
+    MainActions* mainActions;
+    MainContext* fsm;
+
+    void SetUp() override {
+    	Configuration::getInstance().setDesiredWorkpieceOrder({WS_F, WS_BOM, WS_OB});
+    	Configuration::getInstance().setOffsetCalibration(3600);
+    	Configuration::getInstance().setReferenceCalibration(2500);
+    	sender = new EventSenderMock();
+        mainActions = new MainActions(eventManager, sender);
+        fsm = new MainContext(mainActions);
+        nDestroyed = 0;
+    }
+
+    void TearDown() override {
+    	delete fsm;
+    }
+};
+
+TEST_F(UnitTest_FSMCore, StateStorageReplacesState) {
+	StateStorage<TestBase, 32> storage;
+	EXPECT_EQ(nullptr, storage.get());
+
+	TestBase *a = storage.create<TestStateA>();
+	EXPECT_EQ(1, a->id());
+	EXPECT_EQ(0, nDestroyed);
+
+	// Same memory is reused for the next state
+	TestBase *b = storage.create<TestStateB>();
+	EXPECT_EQ(2, b->id());
+	EXPECT_EQ(a, b);
+	EXPECT_EQ(1, nDestroyed);
+
+	storage.destroy();
+	EXPECT_EQ(nullptr, storage.get());
+	EXPECT_EQ(2, nDestroyed);
+}
+
+TEST_F(UnitTest_FSMCore, StateStorageTransitionDestroysReplacedState) {
+	StateStorage<TestBase, 32> storage;
+	TestBase *a = storage.create<TestStateA>();
+
+	TestBase *b = StateStorage<TestBase, 32>::transition<TestStateB>(a);
+	EXPECT_EQ(a, b);
+	EXPECT_EQ(2, b->id());
+	EXPECT_EQ(1, nDestroyed);
+
+	storage.destroy();
+	EXPECT_EQ(2, nDestroyed);
+}
+
+TEST_F(UnitTest_FSMCore, DispatchTableCallsHandler) {
+	EventDispatchTable<TestContext> table = {
+		{ EventType::START_M_SHORT, [](TestContext &ctx, const Event &) { ctx.nStart++; } },
+		{ EventType::LBA_M_BLOCKED, [](TestContext &ctx, const Event &ev) { ctx.lastData = ev.data; } },
+	};
+	TestContext ctx;
+
+	EXPECT_TRUE(table.dispatch(ctx, Event{EventType::START_M_SHORT}));
+	EXPECT_TRUE(table.dispatch(ctx, Event{EventType::LBA_M_BLOCKED, 42}));
+	EXPECT_FALSE(table.dispatch(ctx, Event{EventType::STOP_M_SHORT}));
+	EXPECT_EQ(1, ctx.nStart);
+	EXPECT_EQ(42, ctx.lastData);
+
+	EXPECT_EQ(2, table.getEvents().count());
+	EXPECT_TRUE(table.getEvents().contains(EventType::LBA_M_BLOCKED));
+}
+
+TEST_F(UnitTest_FSMCore, MainContextHandlesEventsFromTable) {
+	fsm->handleEvent(Event{EventType::START_M_SHORT});
+	EXPECT_EQ(MainState::RUNNING, fsm->getCurrentState());
+	fsm->handleEvent(Event{EventType::ESTOP_S_PRESSED});
+	EXPECT_EQ(MainState::ESTOP, fsm->getCurrentState());
+
+	// Not subscribed event must be ignored
+	fsm->handleEvent(Event{EventType::MOTOR_M_FAST});
+	EXPECT_EQ(MainState::ESTOP, fsm->getCurrentState());
+}
@@ -0,0 +1,191 @@
+/*
+ * UnitTest_FailureDetector.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "watchdog/FailureDetector.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono;
+
+class UnitTest_FailureDetector : public ::testing::Test {
+  protected:
+    VirtualClock clock;
+    TimerService timers{clock};
+    std::atomic<int> failures{0};
+
+    FailureDetector::Config fixed{440, 0.0, 10, 10.0};
+    FailureDetector::Config phi{440, 8.0, 10, 10.0};
+
+    FailureDetector::Callback onFailure() {
+        return [this]() { failures++; };
+    }
+
+    // Heartbeats in the given intervals, jitter alternating +/-
+    void heartbeats(FailureDetector &detector, int n, int intervalMs, int jitterMs = 0) {
+        for (int i = 0; i < n; i++) {
+            clock.advance(intervalMs + (i % 2 == 0 ? jitterMs : -jitterMs));
+            detector.heartbeat();
+        }
+    }
+
+    // Advances in timer ticks until the failure has been detected, returns
+    // the virtual ms since the call or -1
+    int silence(int maxMs) {
+        for (int t = 0; t <= maxMs; t += TIMER_TICK_MS) {
+            // timer thread reacts asynchronously on advance()
+            for (int i = 0; i < 20 && failures == 0; i++) {
+                std::this_thread::sleep_for(microseconds(100));
+            }
+            if (failures > 0) {
+                return t;
+            }
+            clock.advance(TIMER_TICK_MS);
+        }
+        return -1;
+    }
+};
+
+TEST_F(UnitTest_FailureDetector, FixedTimeoutDetected) {
+	FailureDetector detector(fixed, onFailure(), clock, timers);
+	detector.start();
+	heartbeats(detector, 20, 200);
+	EXPECT_EQ(0, failures);
+	EXPECT_EQ(440, detector.deadlineMs());
+
+	int detectedAfter = silence(1000);
+	EXPECT_GE(detectedAfter, 440);
+	EXPECT_LE(detectedAfter, 440 + TIMER_TICK_MS);
+	EXPECT_TRUE(detector.failed());
+
+	// no further callbacks, late heartbeats are ignored
+	detector.heartbeat();
+	clock.advance(1000);
+	std::this_thread::sleep_for(milliseconds(20));
+	EXPECT_EQ(1, failures);
+}
+
+TEST_F(UnitTest_FailureDetector, FirstHeartbeatExpectedWithinTimeout) {
+	FailureDetector detector(phi, onFailure(), clock, timers);
+	detector.start();
+	int detectedAfter = silence(1000);
+	EXPECT_GE(detectedAfter, 440);
+	EXPECT_LE(detectedAfter, 440 + TIMER_TICK_MS);
+}
+
+// Regular heartbeats: the phi deadline is shorter than the fixed timeout,
+// which is the lower bound
+TEST_F(UnitTest_FailureDetector, PhiNotBelowFixedTimeout) {
+	FailureDetector detector(phi, onFailure(), clock, timers);
+	detector.start();
+	heartbeats(detector, 30, 200, 5);
+	EXPECT_EQ(0, failures);
+	EXPECT_EQ(440, detector.deadlineMs());
+
+	int detectedAfter = silence(1000);
+	EXPECT_GE(detectedAfter, 440);
+	EXPECT_LE(detectedAfter, 440 + TIMER_TICK_MS);
+}
+
+TEST_F(UnitTest_FailureDetector, PhiAdaptsToJitter) {
+	FailureDetector detector(phi, onFailure(), clock, timers);
+	detector.start();
+	heartbeats(detector, 30, 200, 5);
+	int regular = detector.deadlineMs();
+	heartbeats(detector, 100, 200, 80);
+	EXPECT_EQ(0, failures);
+	EXPECT_GT(detector.deadlineMs(), regular + 100);
+
+	// suspicion grows with the silence and reaches the threshold at the deadline
+	double before = detector.phi();
+	clock.advance(detector.deadlineMs() / 2);
+	double half = detector.phi();
+	EXPECT_LT(before, half);
+	EXPECT_LT(half, 8.0);
+	clock.advance(detector.deadlineMs() - detector.deadlineMs() / 2);
+	EXPECT_NEAR(8.0, detector.phi(), 0.1);
+}
+
+TEST_F(UnitTest_FailureDetector, Statistics) {
+	FailureDetector detector(phi, onFailure(), clock, timers);
+	detector.start();
+	clock.advance(50);
+	detector.heartbeat();
+	heartbeats(detector, 10, 200, 20);
+
+	HeartbeatStatistics stats = detector.statistics();
+	EXPECT_EQ(11u, stats.count);
+	EXPECT_DOUBLE_EQ(200.0, stats.meanMs);
+	EXPECT_DOUBLE_EQ(20.0, stats.stdDevMs);
+	EXPECT_EQ(180, stats.minMs);
+	EXPECT_EQ(220, stats.maxMs);
+
+	// only the recent intervals are estimated
+	heartbeats(detector, FD_WINDOW_SIZE, 300);
+	stats = detector.statistics();
+	EXPECT_DOUBLE_EQ(300.0, stats.meanMs);
+	EXPECT_DOUBLE_EQ(0.0, stats.stdDevMs);
+	EXPECT_EQ(300, stats.maxMs);
+}
+
+// Other messages of the partner re-arm the deadline, their short intervals do
+// not shorten the deadline for the next idle phase
+TEST_F(UnitTest_FailureDetector, TrafficRearmsWithoutSamples) {
+	FailureDetector detector(phi, onFailure(), clock, timers);
+	detector.start();
+	heartbeats(detector, 20, 200, 20);
+	HeartbeatStatistics before = detector.statistics();
+	int deadline = detector.deadlineMs();
+
+	for (int i = 0; i < 100; i++) {
+		clock.advance(20);
+		detector.alive();
+	}
+	std::this_thread::sleep_for(milliseconds(20));
+	EXPECT_EQ(0, failures);
+	HeartbeatStatistics after = detector.statistics();
+	EXPECT_EQ(before.count, after.count);
+	EXPECT_DOUBLE_EQ(before.meanMs, after.meanMs);
+	EXPECT_EQ(deadline, detector.deadlineMs());
+
+	int detectedAfter = silence(1000);
+	EXPECT_GE(detectedAfter, deadline);
+	EXPECT_LE(detectedAfter, deadline + TIMER_TICK_MS);
+}
+
+// A message after an idle gap replaces the heartbeat of the partner
+TEST_F(UnitTest_FailureDetector, IdleGapArrivalsSampled) {
+	FailureDetector::Config config = phi;
+	config.idleGapMs = 200;
+	FailureDetector detector(config, onFailure(), clock, timers);
+	detector.start();
+	clock.advance(300);
+	detector.alive();   // measured from start()
+	for (int i = 0; i < 10; i++) {
+		clock.advance(20);
+		detector.alive();
+		clock.advance(230);
+		detector.alive();
+	}
+
+	HeartbeatStatistics stats = detector.statistics();
+	EXPECT_EQ(11u, stats.count);
+	EXPECT_DOUBLE_EQ(230.0, stats.meanMs);
+	EXPECT_EQ(230, stats.minMs);
+}
+
+TEST_F(UnitTest_FailureDetector, StoppedWithoutFailure) {
+	FailureDetector detector(fixed, onFailure(), clock, timers);
+	detector.start();
+	heartbeats(detector, 3, 200);
+	detector.stop();
+	clock.advance(2000);
+	std::this_thread::sleep_for(milliseconds(20));
+	EXPECT_EQ(0, failures);
+	EXPECT_FALSE(detector.failed());
+	EXPECT_EQ(0, timers.getActiveTimers());
+}
@@ -0,0 +1,395 @@
+/*
+ * UnitTest_LinkRecovery.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "mocks/EventManagerMock.h"
+#include "mocks/EventSenderMock.h"
+
+#include "configuration/Configuration.h"
+#include "events/LinkRecovery.h"
+#include "logic/LinkSync.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace std::chrono;
+
+namespace {
+
+// Stand-in for the GNS connection of one system. Sent events are queued for
+// the partner, posted events for the own dispatcher.
+class LocalTransport : public ILinkTransport {
+  public:
+    LocalTransport *partner = nullptr;
+    std::atomic<bool> *network = nullptr;
+    std::atomic<bool> connected{true};
+    std::atomic<bool> mute{false};   // sent events get lost
+    std::mutex mtx;
+    std::deque<Event> inbox;
+
+    bool open() override {
+        connected = network->load();
+        return connected;
+    }
+    void close() override { connected = false; }
+    void send(const Event &event) override {
+        if (*network && connected && !mute) {
+            partner->deliver(event);
+        }
+    }
+    void post(const Event &event) override { deliver(event); }
+
+    void deliver(const Event &event) {
+        std::lock_guard<std::mutex> lock(mtx);
+        inbox.push_back(event);
+    }
+
+    // Dispatches the queued events like the EventManager
+    void dispatch(LinkRecovery &recovery) {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (!inbox.empty()) {
+            Event event = inbox.front();
+            inbox.pop_front();
+            lock.unlock();
+            if (event.type == SYNC_START) {
+                recovery.startResync();
+            } else if (event.type == SYNC_DIGEST) {
+                recovery.digestReceived(event.data);
+            }
+            lock.lock();
+        }
+    }
+};
+
+}
+
+class UnitTest_LinkRecovery : public ::testing::Test {
+  protected:
+    VirtualClock clock;
+    TimerService timers{clock};
+    std::atomic<bool> network{true};
+    LocalTransport masterLink;
+    LocalTransport slaveLink;
+    std::atomic<int> masterReestablished{0};
+    std::atomic<int> slaveReestablished{0};
+    // like EventManager::linkReestablished()
+    LinkRecovery master{masterLink,
+                        [this]() {
+                            masterReestablished++;
+                            mainFSM->handleEvent(Event{WD_CONN_REESTABLISHED});
+                            mainFSM->handleEvent(Event{ERROR_M_SELF_SOLVED});
+                            mainFSM->handleEvent(Event{ERROR_S_SELF_SOLVED});
+                        },
+                        timers, clock};
+    LinkRecovery slave{slaveLink, [this]() { slaveReestablished++; }, timers, clock};
+
+    std::shared_ptr<IEventManager> eventManager = std::make_shared<EventManagerMock>();
+    MainContext *mainFSM;
+    std::shared_ptr<IEventManager> slaveEvents = std::make_shared<EventManagerMock>();
+    bool slaveRampBlocked = false;
+    bool slaveEntryBlocked = false;
+    bool slaveExitBlocked = false;
+    MasterLinkSync *masterSync;
+    SlaveLinkSync slaveSync{slaveEvents, [this]() { return slaveRampBlocked; },
+                            [this]() { return slaveEntryBlocked; },
+                            [this]() { return slaveExitBlocked; }};
+
+    void SetUp() override {
+        Configuration::getInstance().setDesiredWorkpieceOrder({WS_F, WS_BOM, WS_OB});
+        Configuration::getInstance().setOffsetCalibration(3600);
+        Configuration::getInstance().setReferenceCalibration(2500);
+        mainFSM = new MainContext(new MainActions(eventManager, new EventSenderMock()));
+        masterSync = new MasterLinkSync(mainFSM);
+        masterLink.partner = &slaveLink;
+        masterLink.network = &network;
+        slaveLink.partner = &masterLink;
+        slaveLink.network = &network;
+        master.addParticipant(masterSync);
+        slave.addParticipant(&slaveSync);
+        // Modes of the master reach the slave while the network is up
+        eventManager->subscribe(EventMask::range(MODE_STANDBY, MODE_ERROR), [this](Event event) {
+            if (network) {
+                slaveEvents->handleEvent(event);
+            }
+        });
+    }
+
+    void TearDown() override {
+        delete masterSync;
+        delete mainFSM;
+    }
+
+    // Advances the virtual time in 5 ms steps and dispatches the events
+    void run(int ms) {
+        for (int t = 0; t < ms; t += 5) {
+            clock.advance(5);
+            // timer thread reacts asynchronously on advance()
+            std::this_thread::sleep_for(microseconds(200));
+            masterLink.dispatch(master);
+            slaveLink.dispatch(slave);
+        }
+    }
+
+    // Light barrier of FBM2: the slave sees every edge, the master only the
+    // ones sent while connected
+    void edge(EventType type, bool connected = true) {
+        slaveEvents->handleEvent(Event{type});
+        if (connected) {
+            mainFSM->handleEvent(Event{type});
+        }
+    }
+
+    // Runs until both systems are connected, returns the virtual ms or -1
+    int runUntilConnected(int maxMs) {
+        for (int t = 0; t <= maxMs; t += 5) {
+            if (master.getState() == LinkState::CONNECTED && slave.getState() == LinkState::CONNECTED) {
+                return t;
+            }
+            run(5);
+        }
+        return -1;
+    }
+};
+
+TEST_F(UnitTest_LinkRecovery, DigestWords) {
+	LinkDigest digest;
+	digest.set(LinkSection::ENTRY_FBM2, 0xFF123456, true);   // cut to 24 bit
+	digest.set(LinkSection::RAMP_FBM2, 1);
+
+	LinkDigest received;
+	for (int i = 0; i < LINK_SECTION_COUNT; i++) {
+		if (digest.word(i) != -1) {
+			EXPECT_FALSE(received.addWord(digest.word(i)));
+		}
+	}
+	EXPECT_TRUE(received.addWord(digest.word(LINK_SECTION_COUNT)));
+	EXPECT_EQ(0x123456u, received.get(LinkSection::ENTRY_FBM2));
+	EXPECT_EQ(1u, received.get(LinkSection::RAMP_FBM2));
+	EXPECT_EQ(digest.getOwned(), received.getOwned());
+	EXPECT_EQ(digest.getKnown(), received.getKnown());
+	EXPECT_EQ(0u, digest.differences(received));
+
+	LinkDigest other;
+	other.set(LinkSection::RAMP_FBM2, 0);
+	other.set(LinkSection::EXIT_FBM2, 3);   // not known to the first one
+	EXPECT_EQ(LINK_SECTION_BIT(LinkSection::RAMP_FBM2), digest.differences(other));
+}
+
+TEST_F(UnitTest_LinkRecovery, BarrierValue) {
+	uint32_t value = linkBarrier(true, 5);
+	EXPECT_TRUE(linkBarrierBlocked(value));
+	EXPECT_EQ(5u, value >> 1);
+	EXPECT_EQ(2u, linkBarrierPassedSince(linkBarrier(false, 7), value));
+	EXPECT_EQ(0u, linkBarrierPassedSince(value, value));
+	// the number of passes wraps
+	EXPECT_EQ(2u, linkBarrierPassedSince(linkBarrier(false, 1), linkBarrier(false, 0x7FFFFF)));
+}
+
+// Network blip of 300 ms: production can go on within a second
+TEST_F(UnitTest_LinkRecovery, TransientBlipRecoveredWithinASecond) {
+	network = false;
+	master.connectionLost();
+	slave.connectionLost();
+	EXPECT_EQ(LinkState::RECONNECTING, master.getState());
+	run(300);
+	EXPECT_EQ(LinkState::RECONNECTING, master.getState());
+	EXPECT_EQ(0, masterReestablished);
+	network = true;
+
+	ASSERT_NE(-1, runUntilConnected(1000));
+	EXPECT_EQ(1, masterReestablished);
+	EXPECT_EQ(1, slaveReestablished);
+	EXPECT_LT(master.getLastRecoveryMs(), 1000);
+	EXPECT_LT(slave.getLastRecoveryMs(), 1000);
+	// attempts after 20, 40, 80, 160 ms, ... with exponential backoff
+	EXPECT_GE(master.getAttempts(), 4u);
+	EXPECT_LE(master.getAttempts(), 7u);
+	EXPECT_EQ(0u, master.getResyncedSections());
+}
+
+TEST_F(UnitTest_LinkRecovery, BackoffLimited) {
+	network = false;
+	master.connectionLost();
+	slave.connectionLost();
+	run(10000);
+	// 20 + 40 + ... + 640 ms, then one attempt per second
+	EXPECT_GE(master.getAttempts(), 13u);
+	EXPECT_LE(master.getAttempts(), 17u);
+	network = true;
+	int ms = runUntilConnected(2000);
+	EXPECT_NE(-1, ms);
+	EXPECT_LE(ms, LINK_BACKOFF_MAX_MS + 50);
+}
+
+// Ramp of FBM2 was blocked during the outage: only this section is passed to
+// the main FSM
+TEST_F(UnitTest_LinkRecovery, OnlyDifferencesResynced) {
+	mainFSM->master_btnStart_PressedShort();
+	ASSERT_EQ(MainState::RUNNING, mainFSM->getCurrentState());
+	mainFSM->data->wpManager->addWorkpiece();
+
+	network = false;
+	master.connectionLost();
+	slave.connectionLost();
+	run(100);
+	slaveRampBlocked = true;
+	network = true;
+	ASSERT_NE(-1, runUntilConnected(1000));
+
+	EXPECT_TRUE(mainFSM->data->isRampFBM2Blocked());
+	EXPECT_EQ(1u, master.getResyncedSections());
+	// the slave adopts the areas, the mode has not changed
+	EXPECT_EQ(1u, slave.getResyncedSections());
+	EXPECT_EQ(1u, linkAreaCount(slaveSync.getAreas(), 0));
+	EXPECT_EQ(MainState::RUNNING, slaveSync.getMainState());
+	// ramp warning timer of Running on the global TimerService
+	std::this_thread::sleep_for(milliseconds(1100));
+}
+
+// Only the master noticed the loss, the slave answers the digest
+TEST_F(UnitTest_LinkRecovery, PartnerWithoutLossAnswers) {
+	slaveRampBlocked = true;
+	master.connectionLost();
+	EXPECT_NE(-1, runUntilConnected(500));
+	EXPECT_EQ(1, masterReestablished);
+	EXPECT_EQ(0, slaveReestablished);
+	EXPECT_EQ(1u, master.getRecoveries());
+	EXPECT_EQ(1u, master.getResyncedSections());
+}
+
+// Digest of the partner lost -> new connection attempt after the timeout
+TEST_F(UnitTest_LinkRecovery, ResyncTimeout) {
+	master.connectionLost();
+	slaveLink.mute = true;
+	run(100);
+	EXPECT_EQ(LinkState::RESYNCING, master.getState());
+	run(LINK_RESYNC_TIMEOUT_MS);
+	EXPECT_NE(LinkState::CONNECTED, master.getState());
+	EXPECT_GE(master.getAttempts(), 2u);
+
+	slaveLink.mute = false;
+	EXPECT_NE(-1, runUntilConnected(1000));
+	EXPECT_EQ(1, masterReestablished);
+}
+
+// Workpieces moved on FBM2 during the outage: the slave reports the passes of
+// the light barriers, the master updates Area_D
+TEST_F(UnitTest_LinkRecovery, WorkpiecesPassedWhileDisconnected) {
+	mainFSM->master_btnStart_PressedShort();
+	ASSERT_EQ(MainState::RUNNING, mainFSM->getCurrentState());
+	WorkpieceManager *wpm = mainFSM->data->wpManager;
+	Workpiece *first = wpm->addWorkpiece();
+	Workpiece *second = wpm->addWorkpiece();
+	for (Workpiece *wp : {first, second}) {
+		// handed over at the end of FBM1
+		wpm->moveFromAreaToArea(AreaType::AREA_A, AreaType::AREA_D);
+		wp->posFBM2 = PositionFBM2::TRANSFER;
+	}
+	edge(LBA_S_BLOCKED);
+	edge(LBA_S_UNBLOCKED);
+	ASSERT_EQ(PositionFBM2::BELT, first->posFBM2);
+
+	network = false;
+	master.connectionLost();
+	slave.connectionLost();
+	edge(LBA_S_BLOCKED, false);     // second enters FBM2
+	edge(LBA_S_UNBLOCKED, false);
+	edge(LBE_S_BLOCKED, false);     // first leaves at the end
+	edge(LBE_S_UNBLOCKED, false);
+	slaveExitBlocked = true;        // second is at the end
+	edge(LBE_S_BLOCKED, false);
+	run(100);
+	network = true;
+	ASSERT_NE(-1, runUntilConnected(1000));
+
+	EXPECT_EQ(2u, master.getResyncedSections());
+	ASSERT_EQ(1, wpm->getNumberOfWorkpiecesFBM2());
+	EXPECT_EQ(second, wpm->getHeadOfArea(AreaType::AREA_D));
+	EXPECT_EQ(PositionFBM2::BELT, second->posFBM2);
+	EXPECT_EQ(2u, mainFSM->data->entryFBM2.passed);
+	EXPECT_EQ(1u, mainFSM->data->exitFBM2.passed);
+	EXPECT_TRUE(mainFSM->data->exitFBM2.blocked);
+
+	// resynced, the next digest has no differences
+	master.connectionLost();
+	slave.connectionLost();
+	ASSERT_NE(-1, runUntilConnected(1000));
+	EXPECT_EQ(2u, master.getResyncedSections());
+}
+
+// Lost link is the only error: the main FSM leaves Error without a reset
+// after the resync. Time from the loss (300 ms blip) to RUNNING is measured.
+TEST_F(UnitTest_LinkRecovery, LossToRunningWithinASecond) {
+	mainFSM->master_btnStart_PressedShort();
+	ASSERT_EQ(MainState::RUNNING, mainFSM->getCurrentState());
+
+	// like Watchdog::heartbeatsMissing()
+	network = false;
+	master.connectionLost();
+	slave.connectionLost();
+	mainFSM->handleEvent(Event{ERROR_M_SELF_SOLVABLE});
+	mainFSM->handleEvent(Event{ERROR_S_SELF_SOLVABLE});
+	ASSERT_EQ(MainState::ERROR, mainFSM->getCurrentState());
+	run(300);
+	EXPECT_EQ(MainState::ERROR, mainFSM->getCurrentState());
+	network = true;
+
+	int ms = 300;
+	while (ms < 2000 && mainFSM->getCurrentState() != MainState::RUNNING) {
+		run(5);
+		ms += 5;
+	}
+	EXPECT_EQ(MainState::RUNNING, mainFSM->getCurrentState());
+	EXPECT_LT(ms, 1000);
+	EXPECT_EQ(MainState::RUNNING, slaveSync.getMainState());
+}
+
+// Error of the operator pending besides the lost link: reset still needed
+TEST_F(UnitTest_LinkRecovery, ManualErrorNotResumed) {
+	mainFSM->master_btnStart_PressedShort();
+	network = false;
+	master.connectionLost();
+	slave.connectionLost();
+	mainFSM->handleEvent(Event{ERROR_M_SELF_SOLVABLE});
+	mainFSM->handleEvent(Event{ERROR_M_MAN_SOLVABLE});
+	run(100);
+	network = true;
+	ASSERT_NE(-1, runUntilConnected(1000));
+	EXPECT_EQ(MainState::ERROR, mainFSM->getCurrentState());
+}
+
+// Digest covers the state of the master: the slave adopts ramp and areas,
+// a mode missed by the slave is sent again
+TEST_F(UnitTest_LinkRecovery, SlaveAdoptsStateOfMaster) {
+	slaveEvents->handleEvent(Event{MODE_ERROR});   // belief of the slave
+	mainFSM->data->setRampFBM1Blocked(true);
+	mainFSM->data->wpManager->addWorkpiece();
+	mainFSM->data->wpManager->moveFromAreaToArea(AreaType::AREA_A, AreaType::AREA_D);
+	std::static_pointer_cast<EventManagerMock>(eventManager)->clearLastHandledEvents();
+
+	master.connectionLost();
+	slave.connectionLost();
+	ASSERT_NE(-1, runUntilConnected(1000));
+
+	EXPECT_EQ(3u, slave.getResyncedSections());
+	EXPECT_TRUE(slaveSync.getRampFBM1Blocked());
+	EXPECT_EQ(0u, linkAreaCount(slaveSync.getAreas(), 0));
+	EXPECT_EQ(1u, linkAreaCount(slaveSync.getAreas(), 3));
+	EXPECT_TRUE(std::static_pointer_cast<EventManagerMock>(eventManager)
+	                ->lastHandledEventsContain(Event{MODE_STANDBY}));
+	EXPECT_EQ(MainState::STANDBY, slaveSync.getMainState());
+}
+
+TEST_F(UnitTest_LinkRecovery, AreasValue) {
+	uint32_t value = linkAreas(1, 0, 2, 100);
+	EXPECT_EQ(1u, linkAreaCount(value, 0));
+	EXPECT_EQ(0u, linkAreaCount(value, 1));
+	EXPECT_EQ(2u, linkAreaCount(value, 2));
+	EXPECT_EQ(LINK_AREA_MAX, linkAreaCount(value, 3));
+	EXPECT_EQ(0u, value & ~LINK_VALUE_MASK);
+}
@@ -0,0 +1,215 @@
+/*
+ * UnitTest_LivenessTracker.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "configuration/Configuration.h"
+#include "events/EventManager.h"
+#include "watchdog/FailureDetector.h"
+#include "watchdog/LivenessTracker.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <sys/dispatch.h>
+#include <sys/neutrino.h>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace {
+
+// Service of the partner system, records the pulses it receives
+class PartnerService {
+  public:
+    PartnerService() {
+        const char *name = Configuration::getInstance().systemIsMaster() ? ATTACH_POINT_LOCAL_S
+                                                                         : ATTACH_POINT_LOCAL_M;
+        attach = name_attach(NULL, name, NAME_FLAG_ATTACH_GLOBAL);
+        receiver = std::thread([this]() {
+            _pulse pulse;
+            while (MsgReceivePulse(attach->chid, &pulse, sizeof(pulse), NULL) != -1) {
+                std::lock_guard<std::mutex> lock(mtx);
+                received.push_back((EventType) pulse.code);
+            }
+        });
+    }
+
+    ~PartnerService() {
+        name_detach(attach, 0);
+        receiver.join();
+    }
+
+    std::vector<EventType> getReceived() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return received;
+    }
+
+  private:
+    name_attach_t *attach;
+    std::thread receiver;
+    std::mutex mtx;
+    std::vector<EventType> received;
+};
+
+template <class Predicate>
+bool waitFor(Predicate predicate) {
+    for (int i = 0; i < 200 && !predicate(); i++) {
+        std::this_thread::sleep_for(milliseconds(10));
+    }
+    return predicate();
+}
+
+}
+
+class UnitTest_LivenessTracker : public ::testing::Test {
+  protected:
+    VirtualClock clock;
+    LivenessTracker partner{200, clock};   // sending side
+    LivenessTracker local{200, clock};     // receiving side
+    int nextHeartbeat = 200;                // [ms] planned by the sending thread
+
+    // One ms of the link: the partner sends an event if requested and a
+    // heartbeat if it is due, the local system receives both
+    void step(bool event) {
+        if (event) {
+            partner.sent();
+            local.received();
+        }
+        if (clock.getElapsedMs() >= (uint64_t) nextHeartbeat) {
+            if (partner.heartbeatDue()) {
+                partner.sent();
+                local.received(true);
+            }
+            nextHeartbeat = clock.getElapsedMs() + partner.nextHeartbeatMs();
+        }
+        clock.advance(1);
+    }
+};
+
+TEST_F(UnitTest_LivenessTracker, HeartbeatsWhenIdle) {
+	for (int t = 0; t < 2000; t++) {
+		step(false);
+	}
+	EXPECT_EQ(9u, partner.getHeartbeats());   // at 200, 400, ... 1800 ms
+	EXPECT_EQ(0u, partner.getSuppressed());
+	EXPECT_EQ(partner.getHeartbeats(), local.getReceived());
+}
+
+TEST_F(UnitTest_LivenessTracker, TrafficSuppressesHeartbeats) {
+	for (int t = 0; t < 2000; t++) {
+		step(t % 50 == 0);
+	}
+	EXPECT_EQ(0u, partner.getHeartbeats());
+	EXPECT_GE(partner.getSuppressed(), 9u);
+	// only the events cross the link
+	EXPECT_EQ(40u, partner.getSent());
+	EXPECT_EQ(40u, local.getReceived());
+
+	// idle again -> heartbeat one gap after the last event
+	for (int t = 0; t < 150; t++) {
+		step(false);
+	}
+	EXPECT_EQ(0u, partner.getHeartbeats());
+	step(false);
+	EXPECT_EQ(1u, partner.getHeartbeats());
+}
+
+TEST_F(UnitTest_LivenessTracker, ListenerNotifiedForAllMessages) {
+	int notified = 0;
+	int heartbeats = 0;
+	local.setListener([&](bool heartbeat) {
+		notified++;
+		heartbeats += heartbeat;
+	});
+	for (int t = 0; t < 1000; t++) {
+		step(t < 500 && t % 100 == 0);
+	}
+	EXPECT_EQ(local.getReceived(), (uint64_t) notified);
+	EXPECT_EQ(2u, partner.getHeartbeats());   // at 600, 800 ms
+	EXPECT_EQ(2, heartbeats);
+	EXPECT_EQ(7, notified);
+	local.setListener(nullptr);
+	step(true);
+	EXPECT_EQ(7, notified);
+}
+
+// Bursts of events followed by idle phases with heartbeats do not trip the
+// failure detector, a silent partner is detected
+TEST_F(UnitTest_LivenessTracker, BurstsWithoutFalseFailure) {
+	TimerService timers(clock);
+	std::atomic<int> failures{0};
+	FailureDetector detector(FailureDetector::Config{440, 8.0, 10, 50.0, 200},
+	                         [&]() { failures++; }, clock, timers);
+	local.setListener([&](bool heartbeat) {
+		if (heartbeat) {
+			detector.heartbeat();
+		} else {
+			detector.alive();
+		}
+	});
+	detector.start();
+
+	for (int burst = 0; burst < 20; burst++) {
+		for (int t = 0; t < 1000; t++) {
+			step(t < 100 && t % 5 == 0);
+		}
+	}
+	std::this_thread::sleep_for(milliseconds(20));
+	EXPECT_EQ(0, failures);
+	EXPECT_GT(partner.getSuppressed(), 0u);
+	HeartbeatStatistics stats = detector.statistics();
+	// the events of the bursts are not sampled
+	EXPECT_EQ(partner.getHeartbeats(), stats.count);
+	EXPECT_NEAR(200.0, stats.meanMs, 1.0);
+	EXPECT_LE(stats.maxMs, 200);
+
+	// partner stopped
+	local.setListener(nullptr);
+	for (int t = 0; t < 500 && failures == 0; t += TIMER_TICK_MS) {
+		clock.advance(TIMER_TICK_MS);
+		for (int i = 0; i < 20 && failures == 0; i++) {
+			std::this_thread::sleep_for(microseconds(100));
+		}
+	}
+	EXPECT_EQ(1, failures);
+}
+
+// Heartbeats go directly from and to the link: they are counted by the
+// liveness tracker, but neither queued nor dispatched to subscribers
+TEST(UnitTest_LivenessTrackerLink, HeartbeatsBypassDispatcher) {
+	bool master = Configuration::getInstance().systemIsMaster();
+	EventType ownHeartbeat = master ? EventType::WD_M_HEARTBEAT : EventType::WD_S_HEARTBEAT;
+	EventType partnerHeartbeat = master ? EventType::WD_S_HEARTBEAT : EventType::WD_M_HEARTBEAT;
+	PartnerService partner;
+	auto manager = std::make_shared<EventManager>();
+	std::mutex mtx;
+	std::vector<EventType> dispatched;
+	manager->subscribeToAllEvents([&](Event event) {
+		std::lock_guard<std::mutex> lock(mtx);
+		dispatched.push_back(event.type);
+	});
+	manager->start();
+
+	manager->sendHeartbeat();
+	EXPECT_TRUE(waitFor([&]() { return partner.getReceived().size() == 1; }));
+	EXPECT_EQ(std::vector<EventType>{ownHeartbeat}, partner.getReceived());
+
+	int coid = name_open(master ? ATTACH_POINT_LOCAL_M : ATTACH_POINT_LOCAL_S, NAME_FLAG_ATTACH_GLOBAL);
+	ASSERT_NE(-1, coid);
+	MsgSendPulse(coid, -1, partnerHeartbeat, 0);
+	MsgSendPulse(coid, -1, EventType::LBA_M_BLOCKED, 0);
+	EXPECT_TRUE(waitFor([&]() { return manager->getLiveness().getReceived() == 2; }));
+	EXPECT_TRUE(waitFor([&]() {
+		std::lock_guard<std::mutex> lock(mtx);
+		return !dispatched.empty();
+	}));
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		EXPECT_EQ(std::vector<EventType>{EventType::LBA_M_BLOCKED}, dispatched);
+	}
+	name_close(coid);
+	manager->stop();
+}
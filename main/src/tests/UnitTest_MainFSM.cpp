@@ -28,6 +28,8 @@ class UnitTest_MainFSM : public ::testing::Test {
 
     void SetUp() override {
     	Configuration::getInstance().setDesiredWorkpieceOrder({WS_F, WS_BOM, WS_OB});
+    	Configuration::getInstance().setOffsetCalibration(3600);
+    	Configuration::getInstance().setReferenceCalibration(2500);
     	sender = new EventSenderMock();
         mainActions = new MainActions(eventManager, sender);
         fsm = new MainContext(mainActions);
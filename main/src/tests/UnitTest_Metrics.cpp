@@ -0,0 +1,153 @@
+/*
+ * UnitTest_Metrics.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "metrics/Metrics.h"
+#include "metrics/MetricsExporter.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+std::string readSocket(const std::string &path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    std::string text;
+    if (connect(fd, (struct sockaddr *) &addr, sizeof(addr)) == 0) {
+        char buffer[1024];
+        ssize_t n;
+        while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+            text.append(buffer, n);
+        }
+    }
+    close(fd);
+    return text;
+}
+
+}
+
+TEST(UnitTest_Metrics, CounterShardedAcrossThreads) {
+	Counter counter;
+	const int nThreads = 8;
+	const int nIncrements = 100000;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < nThreads; t++) {
+		threads.emplace_back([&counter]() {
+			for (int i = 0; i < nIncrements; i++) {
+				counter.inc();
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ((uint64_t) nThreads * nIncrements, counter.value());
+	counter.inc(5);
+	EXPECT_EQ((uint64_t) nThreads * nIncrements + 5, counter.value());
+}
+
+TEST(UnitTest_Metrics, GaugeSetAndAdd) {
+	Gauge gauge;
+	gauge.set(3);
+	gauge.add(-5);
+	EXPECT_EQ(-2, gauge.value());
+}
+
+TEST(UnitTest_Metrics, HistogramBuckets) {
+	// exact below the sub-buckets
+	for (uint64_t v = 0; v < Histogram::SUB_BUCKETS; v++) {
+		EXPECT_EQ(v, Histogram::upperBoundOf(Histogram::bucketOf(v)));
+	}
+	// each value lies within its bucket, relative error below 1/32
+	for (uint64_t v : {32ull, 33ull, 100ull, 1000ull, 123456ull, 1ull << 30, (1ull << 40) - 1}) {
+		unsigned int bucket = Histogram::bucketOf(v);
+		uint64_t upper = Histogram::upperBoundOf(bucket);
+		EXPECT_LE(v, upper) << v;
+		EXPECT_LE(upper - v, v / Histogram::SUB_BUCKETS) << v;
+		EXPECT_GT(v, Histogram::upperBoundOf(bucket - 1)) << v;
+	}
+	EXPECT_EQ(Histogram::BUCKETS - 1, Histogram::bucketOf(1ull << 50));
+}
+
+TEST(UnitTest_Metrics, HistogramPercentiles) {
+	Histogram h;
+	EXPECT_EQ(0u, h.percentile(0.5));
+	for (uint64_t i = 1; i <= 1000; i++) {
+		h.record(i);
+	}
+	EXPECT_EQ(1000u, h.count());
+	EXPECT_EQ(500500u, h.sum());
+	EXPECT_EQ(1000u, h.max());
+	EXPECT_NEAR(500, (double) h.percentile(0.5), 500 / 32.0);
+	EXPECT_NEAR(990, (double) h.percentile(0.99), 990 / 32.0);
+	EXPECT_EQ(1000u, h.percentile(1.0));
+}
+
+TEST(UnitTest_Metrics, RegistrySnapshot) {
+	MetricsRegistry &registry = MetricsRegistry::getInstance();
+	Counter &counter = registry.counter("esep_test_total{type=\"A\"}");
+	EXPECT_EQ(&counter, &registry.counter("esep_test_total{type=\"A\"}"));
+	counter.inc(3);
+	registry.gauge("esep_test_depth").set(7);
+	registry.histogram("esep_test_latency_us{stage=\"x\"}").record(10);
+
+	std::string text = registry.snapshot();
+	EXPECT_NE(std::string::npos, text.find("# TYPE esep_test_total counter\n"));
+	EXPECT_NE(std::string::npos, text.find("esep_test_total{type=\"A\"} 3\n"));
+	EXPECT_NE(std::string::npos, text.find("# TYPE esep_test_depth gauge\nesep_test_depth 7\n"));
+	EXPECT_NE(std::string::npos, text.find("# TYPE esep_test_latency_us summary\n"));
+	EXPECT_NE(std::string::npos,
+	          text.find("esep_test_latency_us{stage=\"x\",quantile=\"0.99\"} 10\n"));
+	EXPECT_NE(std::string::npos, text.find("esep_test_latency_us_count{stage=\"x\"} 1\n"));
+	EXPECT_NE(std::string::npos, text.find("esep_test_latency_us_sum{stage=\"x\"} 10\n"));
+}
+
+TEST(UnitTest_Metrics, ExporterSocketAndDump) {
+	MetricsRegistry::getInstance().counter("esep_test_exported_total").inc();
+	std::string socketPath = "/tmp/esep_metrics_test.sock";
+	std::string dumpPath = "/tmp/esep_metrics_test.txt";
+	std::remove(dumpPath.c_str());
+
+	MetricsExporter exporter;
+	ASSERT_TRUE(exporter.start(socketPath, dumpPath, 50));
+	std::string text = readSocket(socketPath);
+	EXPECT_NE(std::string::npos, text.find("esep_test_exported_total 1\n"));
+
+	std::string dumped;
+	for (int i = 0; i < 100 && dumped.empty(); i++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		std::ifstream in(dumpPath);
+		std::stringstream ss;
+		ss << in.rdbuf();
+		dumped = ss.str();
+	}
+	EXPECT_NE(std::string::npos, dumped.find("esep_test_exported_total 1\n"));
+
+	exporter.stop();
+	EXPECT_NE(0, access(socketPath.c_str(), F_OK));
+	std::remove(dumpPath.c_str());
+}
+
+// Shards of a registered counter are on separate cache lines
+TEST(UnitTest_Metrics, CounterAligned) {
+	Counter &counter = MetricsRegistry::getInstance().counter("esep_test_aligned_total");
+	EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(&counter) % 64);
+	std::unique_ptr<Counter> owned(new Counter());
+	EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(owned.get()) % 64);
+}
@@ -0,0 +1,235 @@
+/*
+ * UnitTest_PriorityEventQueue.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "events/PriorityEventQueue.h"
+#include "configuration/Configuration.h"
+#include "events/EventManager.h"
+#include "events/EventSender.h"
+#include "metrics/Metrics.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Dispatch time of one telemetry event in the latency test
+#define TELEMETRY_HANDLING_US 100
+// Number of queued telemetry events in the latency test (=> 200 ms backlog)
+#define TELEMETRY_BACKLOG 2000
+
+namespace {
+
+// Service of the partner system, receives and drops the forwarded events
+class PartnerService {
+  public:
+    PartnerService() {
+        const char *name = Configuration::getInstance().systemIsMaster() ? ATTACH_POINT_LOCAL_S
+                                                                         : ATTACH_POINT_LOCAL_M;
+        attach = name_attach(NULL, name, NAME_FLAG_ATTACH_GLOBAL);
+        receiver = std::thread([this]() {
+            _pulse pulse;
+            while (MsgReceivePulse(attach->chid, &pulse, sizeof(pulse), NULL) != -1) {
+            }
+        });
+    }
+
+    ~PartnerService() {
+        name_detach(attach, 0);
+        receiver.join();
+    }
+
+  private:
+    name_attach_t *attach;
+    std::thread receiver;
+};
+
+}
+
+class UnitTest_PriorityEventQueue : public ::testing::Test {
+  protected:
+    PriorityEventQueue queue;
+};
+
+TEST_F(UnitTest_PriorityEventQueue, EventsAreClassified) {
+	EXPECT_EQ(EventPriority::SAFETY, priorityOf(EventType::ESTOP_M_PRESSED));
+	EXPECT_EQ(EventPriority::SAFETY, priorityOf(EventType::ERROR_S_MAN_SOLVABLE));
+	EXPECT_EQ(EventPriority::CONTROL, priorityOf(EventType::LBA_M_BLOCKED));
+	EXPECT_EQ(EventPriority::CONTROL, priorityOf(EventType::HM_S_WS_F));
+	EXPECT_EQ(EventPriority::TELEMETRY, priorityOf(EventType::WD_M_HEARTBEAT));
+	EXPECT_EQ(EventPriority::TELEMETRY, priorityOf(EventType::LAMP_S_RED));
+	// modes switch the motor
+	EXPECT_EQ(EventPriority::SAFETY, priorityOf(EventType::MODE_ESTOP));
+	EXPECT_EQ(EventPriority::SAFETY, priorityOf(EventType::MODE_ERROR));
+	EXPECT_EQ(EventPriority::SAFETY, priorityOf(EventType::MODE_RUNNING));
+}
+
+TEST_F(UnitTest_PriorityEventQueue, HigherPriorityFirstOrderInLaneKept) {
+	queue.push(Event{EventType::WD_M_HEARTBEAT});
+	queue.push(Event{EventType::LBA_M_BLOCKED});
+	queue.push(Event{EventType::LBA_M_UNBLOCKED});
+	queue.push(Event{EventType::ESTOP_M_PRESSED});
+	EXPECT_EQ(4, queue.size());
+	EXPECT_EQ(2, queue.size(EventPriority::CONTROL));
+
+	QueuedEvent next;
+	ASSERT_TRUE(queue.tryPop(next));
+	EXPECT_EQ(EventType::ESTOP_M_PRESSED, next.event.type);
+	ASSERT_TRUE(queue.tryPop(next));
+	EXPECT_EQ(EventType::LBA_M_BLOCKED, next.event.type);
+	ASSERT_TRUE(queue.tryPop(next));
+	EXPECT_EQ(EventType::LBA_M_UNBLOCKED, next.event.type);
+	ASSERT_TRUE(queue.tryPop(next));
+	EXPECT_EQ(EventType::WD_M_HEARTBEAT, next.event.type);
+	EXPECT_FALSE(queue.tryPop(next));
+}
+
+TEST_F(UnitTest_PriorityEventQueue, CloseWakesUpDispatcher) {
+	std::thread dispatcher([this]() {
+		QueuedEvent next;
+		while (queue.pop(next)) {}
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	queue.close();
+	dispatcher.join();
+	SUCCEED();
+}
+
+// EStop is sent while the telemetry lane of the EventManager holds a large
+// backlog (lamps from the FSM). It must be dispatched after at most the event
+// currently in handling, not after the backlog.
+TEST_F(UnitTest_PriorityEventQueue, EStopLatencyWithSaturatedTelemetry) {
+	using namespace std::chrono;
+	PartnerService partner;
+	auto manager = std::make_shared<EventManager>();
+	std::atomic<bool> estopHandled{false};
+	std::atomic<int> nTelemetryBefore{0};
+	steady_clock::time_point estopDispatched;
+
+	manager->subscribe(EventType::LAMP_M_GREEN, [&](Event) {
+		if (!estopHandled) {
+			nTelemetryBefore++;
+			std::this_thread::sleep_for(microseconds(TELEMETRY_HANDLING_US));
+		}
+	});
+	manager->subscribe(EventType::ESTOP_M_PRESSED, [&](Event) {
+		estopDispatched = steady_clock::now();
+		estopHandled = true;
+	});
+	manager->start();
+	Histogram &dispatchLatency = MetricsRegistry::getInstance().histogram(
+			std::string("esep_event_dispatch_latency_us{system=\"")
+			+ (Configuration::getInstance().systemIsMaster() ? "master" : "slave") + "\"}");
+	uint64_t dispatchedBefore = dispatchLatency.count();
+
+	EventSender fsm;
+	EventSender buttons;
+	fsm.connect(manager);
+	buttons.connect(manager);
+	for (int i = 0; i < TELEMETRY_BACKLOG; i++) {
+		fsm.sendEvent(Event{EventType::LAMP_M_GREEN, (int) LampState::ON});
+	}
+
+	std::this_thread::sleep_for(milliseconds(5));
+	steady_clock::time_point estopSent = steady_clock::now();
+	buttons.sendEvent(Event{EventType::ESTOP_M_PRESSED});
+
+	for (int i = 0; i < 2000 && !estopHandled; i++) {
+		std::this_thread::sleep_for(milliseconds(1));
+	}
+	ASSERT_TRUE(estopHandled);
+	auto latencyUs = duration_cast<microseconds>(estopDispatched - estopSent).count();
+	fsm.disconnect();
+	buttons.disconnect();
+	manager->stop();
+
+	// FIFO would need TELEMETRY_BACKLOG * TELEMETRY_HANDLING_US (200 ms)
+	EXPECT_LT(latencyUs, 20000);
+	EXPECT_LT(nTelemetryBefore, TELEMETRY_BACKLOG / 2);
+	// from the queue to the end of the dispatch, the EStop included
+	EXPECT_GE(dispatchLatency.count() - dispatchedBefore, (uint64_t) nTelemetryBefore + 1);
+	EXPECT_GE(dispatchLatency.max(), (uint64_t) TELEMETRY_HANDLING_US);
+}
+
+// Events of several senders are queued while the dispatcher is busy. Classes
+// overtake each other, the order within a class is the order of sending.
+TEST_F(UnitTest_PriorityEventQueue, OrderInClassKeptAcrossSenders) {
+	PartnerService partner;
+	auto manager = std::make_shared<EventManager>();
+	std::mutex mtx;
+	std::condition_variable cv;
+	bool busy = false;
+	bool release = false;
+	std::vector<EventType> dispatched;
+
+	manager->subscribe(EventType::LBA_M_BLOCKED, [&](Event) {
+		std::unique_lock<std::mutex> lock(mtx);
+		busy = true;
+		cv.notify_all();
+		cv.wait(lock, [&]() { return release; });
+	});
+	std::vector<EventType> sent = {EventType::LAMP_M_GREEN, EventType::MODE_RUNNING,
+	                               EventType::LBE_M_BLOCKED, EventType::ESTOP_M_PRESSED,
+	                               EventType::LBE_M_UNBLOCKED, EventType::MODE_ESTOP,
+	                               EventType::LAMP_M_RED};
+	for (EventType type : sent) {
+		manager->subscribe(type, [&](Event event) {
+			std::lock_guard<std::mutex> lock(mtx);
+			dispatched.push_back(event.type);
+		});
+	}
+	manager->start();
+
+	EventSender fsm;
+	EventSender sensors;
+	EventSender buttons;
+	fsm.connect(manager);
+	sensors.connect(manager);
+	buttons.connect(manager);
+	sensors.sendEvent(Event{EventType::LBA_M_BLOCKED});
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return busy; }));
+	}
+
+	fsm.sendEvent(Event{EventType::LAMP_M_GREEN});
+	fsm.sendEvent(Event{EventType::MODE_RUNNING});
+	sensors.sendEvent(Event{EventType::LBE_M_BLOCKED});
+	buttons.sendEvent(Event{EventType::ESTOP_M_PRESSED});
+	sensors.sendEvent(Event{EventType::LBE_M_UNBLOCKED});
+	fsm.sendEvent(Event{EventType::MODE_ESTOP});
+	fsm.sendEvent(Event{EventType::LAMP_M_RED});
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));   // all queued
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		release = true;
+		cv.notify_all();
+	}
+
+	for (int i = 0; i < 200; i++) {
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			if (dispatched.size() == sent.size()) {
+				break;
+			}
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		EXPECT_EQ((std::vector<EventType>{EventType::MODE_RUNNING, EventType::ESTOP_M_PRESSED,
+		                                  EventType::MODE_ESTOP, EventType::LBE_M_BLOCKED,
+		                                  EventType::LBE_M_UNBLOCKED, EventType::LAMP_M_GREEN,
+		                                  EventType::LAMP_M_RED}),
+		          dispatched);
+	}
+	fsm.disconnect();
+	sensors.disconnect();
+	buttons.disconnect();
+	manager->stop();
+}
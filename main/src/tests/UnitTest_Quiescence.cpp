@@ -0,0 +1,91 @@
+/*
+ * UnitTest_Quiescence.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "common/Clock.h"
+#include "common/Quiescence.h"
+#include "common/TimerService.h"
+#include "simclockadvancer.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+class UnitTest_Quiescence : public ::testing::Test {
+  protected:
+    Quiescence quiescence;
+
+    void SetUp() override { quiescence.setEnabled(true); }
+};
+
+TEST_F(UnitTest_Quiescence, NotCountedUnlessEnabled) {
+	quiescence.setEnabled(false);
+	quiescence.begin();
+	EXPECT_EQ(0, quiescence.getPending());
+	EXPECT_TRUE(quiescence.waitIdle(10));
+}
+
+TEST_F(UnitTest_Quiescence, WaitsForPendingWork) {
+	quiescence.begin();
+	quiescence.begin();   // created by the handling of the first
+	quiescence.end();
+	EXPECT_FALSE(quiescence.waitIdle(10));
+
+	std::thread worker([&]() {
+		std::this_thread::sleep_for(milliseconds(20));
+		quiescence.end();
+	});
+	EXPECT_TRUE(quiescence.waitIdle(2000));
+	EXPECT_EQ(0, quiescence.getPending());
+	worker.join();
+}
+
+// A timer which is due after advance() keeps the application busy until its
+// callback has returned
+TEST_F(UnitTest_Quiescence, DueTimerIsNotIdle) {
+	VirtualClock clock;
+	TimerService timers(clock);
+	quiescence.addProbe([&]() { return timers.isIdle(); });
+	std::atomic<bool> done{false};
+	timers.scheduleOnce(100, [&]() {
+		std::this_thread::sleep_for(milliseconds(20));
+		done = true;
+	});
+	EXPECT_TRUE(quiescence.waitIdle(10));
+
+	clock.advance(100);
+	EXPECT_TRUE(quiescence.waitIdle(2000));
+	EXPECT_TRUE(done);
+}
+
+// The headless simulation only advances the clock after the application is idle
+TEST_F(UnitTest_Quiescence, ClockAdvancedAfterIdle) {
+	std::mutex mtx;
+	std::vector<std::string> calls;
+	auto call = [&](std::string name) {
+		std::lock_guard<std::mutex> lock(mtx);
+		calls.push_back(name);
+	};
+	SimClockAdvancer advancer([&](unsigned int ms) { call("advance " + std::to_string(ms)); },
+	                          [&]() {
+		                          call("wait");
+		                          return quiescence.waitIdle(2000);
+	                          });
+	SimulationIOImage image;
+	quiescence.begin();
+	std::thread worker([&]() {
+		std::this_thread::sleep_for(milliseconds(20));
+		call("handled");
+		quiescence.end();
+	});
+	advancer.cycleCompletedWith(20, image, 0);
+	worker.join();
+	EXPECT_EQ((std::vector<std::string>{"wait", "handled", "advance 20"}), calls);
+}
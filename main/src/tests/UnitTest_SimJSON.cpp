@@ -0,0 +1,129 @@
+/*
+ * UnitTest_SimJSON.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "simjsonmessagehandler.h"
+#include "simitemhandlingaction.h"
+#include "simhciaction.h"
+#include "simconfaction.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+const std::string itemMessage = "{\"type\":\"itemaction\", \"atTime\": 1200, \"action\": \"add\", "
+        "\"kind\": \"metalup\", \"x\": 20.5, \"y\": 60.0, \"f\": false, \"sticky\": true}";
+
+const std::vector<std::string> validMessages = {
+    itemMessage,
+    "{\"type\":\"itemaction\", \"atTime\": 0, \"action\": \"removeid\", \"id\": 17}",
+    "{\"type\":\"simctrl\", \"action\": \"restart\"}",
+    "{\"type\":\"hciaction\", \"atTime\": 3000, \"pattern\": 1}",
+    "{\"type\": \"simconfaction\", \"atTime\": 10, \"parameter\": \"showroi\", \"value\": true}",
+};
+
+// Parses the message from a buffer of exactly its size (no zero termination)
+bool dispatch(SimJSONMessageHandler &handler, const std::string &message) {
+    std::vector<char> buffer(message.begin(), message.end());
+    return handler.dispatchMessage(buffer.data(), buffer.size());
+}
+
+}
+
+class UnitTest_SimJSON : public ::testing::Test {
+  protected:
+    SimItemHandling itemhandling;
+    SimHCI hci;
+    SimConfHandler confhandler;
+    SimJSONMessageHandler handler{&itemhandling, nullptr, &hci, &confhandler};
+};
+
+TEST_F(UnitTest_SimJSON, ItemActionParsed) {
+	SimItemHandlingAction action;
+	ASSERT_TRUE(action.parseJSON(itemMessage));
+	EXPECT_EQ(1200u, action.atTime);
+	EXPECT_EQ(SimItemHandlingActionKind::add, action.actionkind);
+	EXPECT_EQ(ItemKinds::metalup, action.kind);
+	EXPECT_DOUBLE_EQ(20.5, action.x);
+	EXPECT_DOUBLE_EQ(60.0, action.y);
+	EXPECT_FALSE(action.flip);
+	EXPECT_TRUE(action.sticky);
+
+	// single quotes, white space and exponents as before
+	ASSERT_TRUE(action.parseJSON("{ 'type' : 'itemaction' ,\n'action':'removeid', 'id': 1.7e1 }"));
+	EXPECT_EQ(SimItemHandlingActionKind::removeid, action.actionkind);
+	EXPECT_EQ(17u, action.ID);
+}
+
+TEST_F(UnitTest_SimJSON, MalformedRejected) {
+	SimItemHandlingAction action;
+	for (const char *message : {"", "{", "{\"type\":\"itemaction\"", "{\"type\":\"itemaction\",}",
+			"{\"type\" \"itemaction\"}", "{\"type\":\"itemaction, \"x\": 1}",
+			"{\"type\":\"itemaction\", \"x\": 1..2}", "{\"type\":\"itemaction\", \"x\": -}",
+			"{\"type\":\"itemaction\", \"kind\": \"metal\"}", "{\"type\":\"itemaction\", \"z\": 1}",
+			"{\"type\":\"itemaction\", \"x\": {\"a\": 1}}", "{\"type\":\"itemaction\", \"f\": null}",
+			"{\"type\":\"itemaction\", \"x\": 1234567890123456789012345678901234567890}"}) {
+		EXPECT_FALSE(action.parseJSON(message)) << message;
+	}
+	// defaults after a failed parse
+	EXPECT_EQ(SimItemHandlingActionKind::nop, action.actionkind);
+}
+
+TEST_F(UnitTest_SimJSON, MessagesDispatched) {
+	EXPECT_TRUE(dispatch(handler, validMessages[0]));
+	EXPECT_TRUE(dispatch(handler, validMessages[1]));
+	EXPECT_EQ(2u, itemhandling.numberOfActions());
+	EXPECT_FALSE(dispatch(handler, validMessages[2]));   // no control handler
+	EXPECT_TRUE(dispatch(handler, validMessages[3]));
+	EXPECT_TRUE(dispatch(handler, validMessages[4]));
+
+	// the type does not have to be the first key
+	EXPECT_TRUE(dispatch(handler, "{\"atTime\": 5, \"type\":\"itemaction\", \"action\": \"removeall\"}"));
+	EXPECT_FALSE(dispatch(handler, "{\"type\":\"itemactions\", \"action\": \"removeall\"}"));
+	EXPECT_EQ(3u, itemhandling.numberOfActions());
+}
+
+TEST_F(UnitTest_SimJSON, ConfigurationNames) {
+	EXPECT_EQ(SimConfCodes::showroi, SimConfiguration::codeOf("showroi"));
+	EXPECT_EQ(SimConfCodes::showreport, SimConfiguration::codeOf("showreport"));
+	EXPECT_EQ(SimConfCodes::None, SimConfiguration::codeOf("showro"));
+	EXPECT_EQ(SimConfCodes::None, SimConfiguration::codeOf(""));
+}
+
+// Mutates valid messages (bit flips, truncation, duplicated and removed
+// ranges). Run with -fsanitize=address to detect reads behind the buffer.
+TEST_F(UnitTest_SimJSON, Fuzz) {
+	std::mt19937 random(4711);
+	const int nRuns = 100000;
+	for (int i = 0; i < nRuns; i++) {
+		std::string message = validMessages[random() % validMessages.size()];
+		int nMutations = 1 + random() % 4;
+		for (int m = 0; m < nMutations && !message.empty(); m++) {
+			size_t pos = random() % message.size();
+			switch (random() % 5) {
+				case 0:
+					message[pos] ^= (char) (1 << (random() % 8));
+					break;
+				case 1:
+					message.resize(pos);
+					break;
+				case 2:
+					message.insert(pos, message.substr(pos, random() % 16));
+					break;
+				case 3:
+					message.erase(pos, random() % 8);
+					break;
+				default:
+					message[pos] = "{}\"':,\\ 0e.-"[random() % 13];
+			}
+		}
+		dispatch(handler, message);
+	}
+	// all prefixes of a valid message are incomplete
+	for (size_t length = 0; length < itemMessage.size(); length++) {
+		EXPECT_FALSE(dispatch(handler, itemMessage.substr(0, length))) << length;
+	}
+}
@@ -0,0 +1,186 @@
+/*
+ * UnitTest_SimScenario.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "simulation.h"
+#include "simconfquery.h"
+#include "simitemhandling.h"
+#include "simmasks.h"
+#include "simscenariogenerator.h"
+#include "simscenariorunner.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Stops the belt with the red lamp while the E-Stop is pressed and until
+// reset, lets all items pass otherwise
+class EStopStrategy : public ISimScenarioStrategy {
+    bool stopped = false;
+  public:
+    void control(Simulation &sim) override {
+        unsigned short in = sim.readIn();
+        if ((in & SIM_EMERGENCY_STOP) == 0) {
+            stopped = true;
+        } else if (in & SIM_BUTTON_RESET) {
+            stopped = false;
+        }
+        sim.writeOut(stopped ? SIM_DRIVE_STOP | SIM_ALARM_LAMP_RED
+                             : SIM_DRIVE_DIRECTION_RIGHT | SIM_FEED_SEPARATOR | SIM_ALARM_LAMP_GREEN);
+    }
+};
+
+std::unique_ptr<ISimScenarioStrategy> eStop() {
+    return std::unique_ptr<ISimScenarioStrategy>(new EStopStrategy());
+}
+
+// Lets all items pass
+class PassAllStrategy : public ISimScenarioStrategy {
+  public:
+    void control(Simulation &sim) override {
+        sim.writeOut(SIM_DRIVE_DIRECTION_RIGHT | SIM_FEED_SEPARATOR);
+    }
+};
+
+std::unique_ptr<ISimScenarioStrategy> passAll() {
+    return std::unique_ptr<ISimScenarioStrategy>(new PassAllStrategy());
+}
+
+}
+
+TEST(UnitTest_SimScenario, SameSeedSameScenario) {
+	const std::string description = "# test\nmix flat 1 metalup 1\nflip 0.5\npoisson 20 2000\n";
+	SimScenarioGenerator generator;
+	SimScenario first, second, other;
+	ASSERT_TRUE(generator.generate(description, 3, first)) << generator.error();
+	ASSERT_TRUE(generator.generate(description, 3, second));
+	ASSERT_TRUE(generator.generate(description, 4, other));
+
+	ASSERT_EQ(20u, first.script.size());
+	bool different = false;
+	for (unsigned int i = 0; i < first.script.size(); i++) {
+		EXPECT_EQ(first.script[i].atTime, second.script[i].atTime);
+		EXPECT_EQ(first.script[i].kind, second.script[i].kind);
+		EXPECT_EQ(first.script[i].flip, second.script[i].flip);
+		EXPECT_TRUE(first.script[i].kind == ItemKinds::flat || first.script[i].kind == ItemKinds::metalup);
+		if (i > 0) {
+			EXPECT_GE(first.script[i].atTime - first.script[i - 1].atTime, SimScenarioGenerator::defaultMinGap);
+		}
+		different = different || first.script[i].atTime != other.script[i].atTime;
+	}
+	EXPECT_TRUE(different);
+	// duration until the last item has passed
+	EXPECT_GT(first.duration, first.script.back().atTime + 10000);
+}
+
+TEST(UnitTest_SimScenario, StatementsCompiled) {
+	SimScenarioGenerator generator;
+	SimScenario scenario;
+	ASSERT_TRUE(generator.generate("duration 60000\nat 2000\nperiodic 2 1000\n"
+			"burst 2 3 900 5000   # two bursts\nestop 10000 2000\nrampfull 20000 metaldown\n"
+			"rampclear 25000\n", 1, scenario)) << generator.error();
+
+	EXPECT_EQ(60000u, scenario.duration);
+	ASSERT_EQ(10u, scenario.script.size());
+	std::vector<unsigned int> times = {2000, 3000, 4000, 4900, 5800, 11700, 12600, 13500};
+	for (unsigned int i = 0; i < times.size(); i++) {
+		EXPECT_EQ(SimItemHandlingActionKind::add, scenario.script[i].actionkind);
+		EXPECT_EQ(times[i], scenario.script[i].atTime) << i;
+	}
+	EXPECT_EQ(SimItemHandlingActionKind::fillslide, scenario.script[8].actionkind);
+	EXPECT_EQ(ItemKinds::metaldown, scenario.script[8].kind);
+	EXPECT_EQ(SimItemHandlingActionKind::removeallslide, scenario.script[9].actionkind);
+	ASSERT_EQ(3u, scenario.hciScript.size());
+	EXPECT_EQ(10000u, scenario.hciScript[0].atTime);
+	EXPECT_EQ(0, scenario.hciScript[0].pattern & SIM_EMERGENCY_STOP);
+	EXPECT_EQ(12000u, scenario.hciScript[1].atTime);
+	EXPECT_NE(0, scenario.hciScript[1].pattern & SIM_BUTTON_RESET);
+	// repeated until the end
+	scenario = SimScenario();
+	ASSERT_TRUE(generator.generate("duration 10000\nrampclear 1000 4000\n", 1, scenario));
+	ASSERT_EQ(3u, scenario.script.size());
+	EXPECT_EQ(9000u, scenario.script[2].atTime);
+}
+
+TEST(UnitTest_SimScenario, SyntaxErrorsReported) {
+	SimScenarioGenerator generator;
+	for (const char *description : {"periodic 3\n", "periodic 3 x\n", "mix flat\n", "mix flat 1 metal 2\n",
+			"mix\n", "flip 1.5\n", "poisson 10 500\n", "poisson 10 2000 x\n", "estop 1000\n",
+			"rampfull 1000 metal\n", "speed 10\n", "sortout\n", "order flat metal\n"}) {
+		SimScenario scenario;
+		EXPECT_FALSE(generator.generate(std::string("periodic 1 1000\n") + description, 1, scenario))
+				<< description;
+		EXPECT_EQ(0u, generator.error().find("line 2: ")) << generator.error();
+	}
+}
+
+TEST(UnitTest_SimScenario, FillSlideAction) {
+	SimItemHandlingAction action;
+	ASSERT_TRUE(action.parseJSON("{\"type\":\"itemaction\", \"atTime\": 100, \"action\": \"fillslide\", \"kind\": \"holeup\"}"));
+	EXPECT_EQ(SimItemHandlingActionKind::fillslide, action.actionkind);
+	EXPECT_NE(std::string::npos, action.toJSONString().find("\"fillslide\""));
+
+	SimItemHandling handling;
+	handling.addAction(action);
+	Simulation sim(&handling);
+	EXPECT_NE(0, sim.readIn() & SIM_BUFFER_IS_FULL);
+	sim.simulateTime(2000);
+	EXPECT_EQ(0, sim.readIn() & SIM_BUFFER_IS_FULL);
+	EXPECT_EQ(3u, sim.getItems().size());
+}
+
+TEST(UnitTest_SimScenario, FaultsStopTheLine) {
+	SimScenarioGenerator generator;
+	SimScenario scenario;
+	ASSERT_TRUE(generator.generate("mix metalup 1\nperiodic 6 2500\nestop 4000 2000\nduration 40000\n",
+			1, scenario)) << generator.error();
+	SimScenarioRunner runner(eStop, 1);
+	SimScenarioResult result = runner.run({scenario})[0];
+
+	EXPECT_EQ(1u, result.errorStops);
+	EXPECT_EQ(6u, result.passed);
+	ASSERT_EQ(6u, result.transitTimes.size());
+	// items on the belt waited until the reset
+	EXPECT_GT(result.transitTimes[1], result.transitTimes[5] + 1500);
+}
+
+// Outcome is graded by the configured order, not by the strategy
+TEST(UnitTest_SimScenario, GradedByOrder) {
+	SimScenarioGenerator generator;
+	SimScenario scenario;
+	ASSERT_TRUE(generator.generate("order flat holeup\nsortout metalup\nmix flat 1\nperiodic 2 3000\n"
+			"mix holeup 1\nperiodic 1 3000\nmix metalup 1\nperiodic 1 3000\n", 1, scenario))
+			<< generator.error();
+	ASSERT_EQ(1u, scenario.sortOrder.sortOut.size());
+	ASSERT_EQ(2u, scenario.sortOrder.order.size());
+	SimScenarioRunner runner(passAll, 1);
+	SimScenarioResult result = runner.run({scenario})[0];
+
+	ASSERT_EQ(4u, result.passed);
+	// second flat item and the metal item belong on the slide
+	EXPECT_EQ(2u, result.asOrdered);
+	EXPECT_DOUBLE_EQ(0.5, SimScenarioRunner::summarize({result}).orderAccuracy);
+}
+
+// Workers of the runner do not write to the console, even if it is configured
+TEST(UnitTest_SimScenario, RunsQuiet) {
+	SimScenarioGenerator generator;
+	SimScenario scenario;
+	ASSERT_TRUE(generator.generate("mix flat 1\nperiodic 2 3000\n", 1, scenario)) << generator.error();
+	SimScenarioRunner runner(passAll, 2);
+	bool active = SIMCONFQUERRY_ISACTIVE(showroi);
+	SIMCONF_ACTIVATE(SimConfCodes::showroi);
+	testing::internal::CaptureStdout();
+	SimScenarioSummary summary = SimScenarioRunner::summarize(runner.run({scenario, scenario}));
+	std::string output = testing::internal::GetCapturedStdout();
+	if (!active) {
+		SIMCONF_DEACTIVATE(SimConfCodes::showroi);
+	}
+
+	EXPECT_EQ(4u, summary.passed);
+	EXPECT_EQ(std::string::npos, output.find("<SIM>")) << output;
+	EXPECT_TRUE(SIMCONFQUERRY_ISACTIVE(showroi) == active);
+}
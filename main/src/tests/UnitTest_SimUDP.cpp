@@ -0,0 +1,183 @@
+/*
+ * UnitTest_SimUDP.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "UDPMessageRing.h"
+#include "UDPIOThread.h"
+#include "UDPReceiverThreadSimItemHandling.h"
+#include "UDPSendersim.h"
+#include "simitem.h"
+#include "simitemhandling.h"
+
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace {
+
+// Socket bound to a free port of the loopback interface
+int openLoopback(struct sockaddr_in &address) {
+    int fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    bind(fd, (struct sockaddr *) &address, sizeof(address));
+    socklen_t length = sizeof(address);
+    getsockname(fd, (struct sockaddr *) &address, &length);
+    return fd;
+}
+
+class LoopbackConfiguration : public UDPConfiguration {
+public:
+    uint16_t targetPort = 0;   // network byte order
+    struct in_addr getTargeHostIP() override {
+        struct in_addr address;
+        address.s_addr = htonl(INADDR_LOOPBACK);
+        return address;
+    }
+    uint16_t getTargetHostPort() override {
+        return targetPort;
+    }
+    uint16_t getLocalPort() override {
+        return 0;   // any free port
+    }
+};
+
+const std::string removeAll = "{\"type\":\"itemaction\", \"atTime\": 0, \"action\": \"removeall\"}";
+
+}
+
+class UnitTest_SimUDP : public ::testing::Test {
+  protected:
+    struct sockaddr_in senderAddress;
+    struct sockaddr_in receiverAddress;
+    int sender = -1;
+    int receiver = -1;
+
+    void SetUp() override {
+        sender = openLoopback(senderAddress);
+        receiver = openLoopback(receiverAddress);
+    }
+    void TearDown() override {
+        close(sender);
+        close(receiver);
+    }
+};
+
+TEST_F(UnitTest_SimUDP, BatchSentAndReceived) {
+    UDPSendBatch batch;
+    std::string messages[SIM_UDP_BATCH + 2];
+    for (unsigned int i = 0; i < SIM_UDP_BATCH + 2; i++) {
+        messages[i] = "message " + std::to_string(i);
+        batch.add(sender, messages[i].data(), messages[i].size(), receiverAddress);
+    }
+    // the full batch has been sent when adding the last messages
+    EXPECT_EQ(2u, batch.size());
+    batch.flush(sender);
+    EXPECT_EQ(0u, batch.size());
+    EXPECT_EQ(SIM_UDP_BATCH + 2u, batch.messages);
+
+    UDPReceiveRing ring;
+    unsigned int received = 0;
+    while (received < SIM_UDP_BATCH + 2u) {
+        unsigned int n = ring.receive(receiver, true);
+        ASSERT_GT(n, 0u);
+        for (unsigned int i = 0; i < n; i++) {
+            EXPECT_STREQ(messages[received].c_str(), ring.message(i));
+            EXPECT_EQ(messages[received].size(), ring.length(i));
+            EXPECT_EQ(senderAddress.sin_port, ring.source(i).sin_port);
+            received++;
+        }
+    }
+    EXPECT_EQ(SIM_UDP_BATCH + 2u, ring.messages);
+#ifndef SIM_UDP_NO_MMSG
+    EXPECT_EQ(2u, batch.calls);
+    EXPECT_EQ(2u, ring.calls);
+#endif
+    // nothing left, does not block
+    EXPECT_EQ(0u, ring.receive(receiver, false));
+}
+
+TEST_F(UnitTest_SimUDP, IOThreadDispatches) {
+    LoopbackConfiguration conf;
+    SimItemHandling itemhandling;
+    SimJSONMessageHandler handler(&itemhandling, nullptr, nullptr, nullptr);
+    UDPReceiverThreadSimItemHandling simreceiver(conf, &handler);
+    ASSERT_GE(simreceiver.open(), 0);
+    struct sockaddr_in target;
+    socklen_t length = sizeof(target);
+    getsockname(simreceiver.getSocket(), (struct sockaddr *) &target, &length);
+    target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    UDPIOThread io(10);
+    io.addEndpoint(&simreceiver);
+    std::thread iothread(std::ref(io));
+
+    UDPSendBatch batch;
+    for (int i = 0; i < 3; i++) {
+        batch.add(sender, removeAll.data(), removeAll.size(), target);
+    }
+    batch.flush(sender);
+    for (int wait = 0; wait < 200 && itemhandling.numberOfActions() < 3; wait++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    io.stop();
+    iothread.join();
+    EXPECT_EQ(3u, itemhandling.numberOfActions());
+}
+
+// Items dropped in one cycle are sent to the twin at the end of the cycle
+TEST_F(UnitTest_SimUDP, DropsSentOncePerCycle) {
+    LoopbackConfiguration conf;
+    conf.targetPort = receiverAddress.sin_port;
+    UDPSenderSim drops(conf);
+    SimItemStore store(2);
+    drops.dropEnd(store.create(ItemKinds::flat, 0.0, 10.0));
+    drops.dropEnd(store.create(ItemKinds::metalup, 0.0, 20.0));
+
+    UDPReceiveRing ring;
+    EXPECT_EQ(0u, ring.receive(receiver, false));
+    SimulationIOImage image;
+    drops.cycleCompletedWith(20, image, 0);
+    unsigned int received = 0;
+    while (received < 2) {
+        unsigned int n = ring.receive(receiver, true);
+        ASSERT_GT(n, 0u);
+        received += n;
+    }
+    EXPECT_NE(nullptr, strstr(ring.message(0), "itemaction"));
+    // nothing pending, the next cycle sends nothing
+    drops.cycleCompletedWith(40, image, 0);
+    EXPECT_EQ(0u, ring.receive(receiver, false));
+}
+
+// Twin link load: all messages arrive with one system call per batch instead of
+// one sendto()/recvfrom() per message
+TEST_F(UnitTest_SimUDP, BatchDeliversAll) {
+    const int nRounds = 2000;
+    UDPSendBatch batch;
+    UDPReceiveRing ring;
+
+    for (int r = 0; r < nRounds; r++) {
+        for (int i = 0; i < SIM_UDP_BATCH; i++) {
+            batch.add(sender, removeAll.data(), removeAll.size(), receiverAddress);
+        }
+        batch.flush(sender);
+        for (unsigned int n = 0; n < SIM_UDP_BATCH; ) {
+            n += ring.receive(receiver, true);
+        }
+    }
+
+    EXPECT_EQ((unsigned long) nRounds * SIM_UDP_BATCH, ring.messages);
+    EXPECT_EQ((unsigned long) nRounds * SIM_UDP_BATCH, batch.messages);
+#ifdef SIM_UDP_MMSG_AVAILABLE
+    EXPECT_EQ((unsigned long) nRounds, batch.calls);
+    EXPECT_LT(ring.calls, ring.messages);
+#endif
+}
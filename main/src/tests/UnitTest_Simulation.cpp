@@ -0,0 +1,406 @@
+/*
+ * UnitTest_Simulation.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "simulation.h"
+#include "simitemhandling.h"
+#include "simitemhandlingaction.h"
+#include "simmasks.h"
+#include "simheightprofile.h"
+#include "simscenariorunner.h"
+#include "simreport.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Counts all heap allocations of the test binary
+static std::atomic<unsigned long> nAllocations{0};
+
+void *operator new(std::size_t size) {
+    nAllocations++;
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Sorts out metal items: switch stays closed if the metal sensor detected
+// the item in front of it
+class MetalSortStrategy : public ISimScenarioStrategy {
+    bool metal = false;
+  public:
+    void control(Simulation &sim) override {
+        unsigned short in = sim.readIn();
+        unsigned short out = SIM_DRIVE_DIRECTION_RIGHT;
+        if (in & SIM_ITEM_IS_METTAL) {
+            metal = true;
+        }
+        if ((in & SIM_ITEM_AT_JUNCTION) == 0) {
+            if (!metal) {
+                out |= SIM_FEED_SEPARATOR;
+            }
+        } else if ((in & SIM_ITEM_IS_METTAL) == 0) {
+            metal = false;
+        }
+        sim.writeOut(out);
+    }
+};
+
+// Records the simulation time of each edge of the given input bits
+class EdgeRecorder : public ISimulationCycleEndHandler {
+    unsigned short mask;
+    unsigned short last;
+  public:
+    std::vector<unsigned long> edges;
+    unsigned long cycles = 0;
+
+    EdgeRecorder(unsigned short mask) : mask(mask), last(mask) {}
+    void cycleCompletedWith(unsigned long simulationtime, const SimulationIOImage &result,
+                            unsigned short) override {
+        cycles++;
+        if ((result.in & mask) != last) {
+            last = result.in & mask;
+            edges.push_back(simulationtime);
+        }
+    }
+};
+
+// Records the wall clock time of each cycle
+class CycleTimeRecorder : public ISimulationCycleEndHandler {
+  public:
+    std::vector<std::chrono::steady_clock::time_point> times;
+    void cycleCompletedWith(unsigned long, const SimulationIOImage &, unsigned short) override {
+        times.push_back(std::chrono::steady_clock::now());
+    }
+};
+
+// Decodes each report and compares it with the JSON report of the cycle
+class ReportChecker : public ISimulationReportHandler {
+    Simulation *sim = nullptr;
+  public:
+    SimReportDecoder decoder;
+    unsigned long reports = 0;
+    unsigned long mismatches = 0;
+    unsigned long bytes = 0;
+
+    void attach(Simulation *simulation) {
+        sim = simulation;
+        sim->addReportHandler(this);
+    }
+    void handlereport(const uint8_t *report, unsigned int size) override {
+        reports++;
+        bytes += size;
+        if (!decoder.decode(report, size) || decoder.toJSON() != sim->generateJSONStatusReport()) {
+            mismatches++;
+        }
+    }
+};
+
+// Collects the encoded reports
+class ReportCollector : public ISimulationReportHandler {
+  public:
+    std::vector<std::vector<uint8_t>> reports;
+    void handlereport(const uint8_t *report, unsigned int size) override {
+        reports.emplace_back(report, report + size);
+    }
+};
+
+std::unique_ptr<ISimScenarioStrategy> metalSort() {
+    return std::unique_ptr<ISimScenarioStrategy>(new MetalSortStrategy());
+}
+
+}
+
+class UnitTest_Simulation : public ::testing::Test {
+  protected:
+    // Adds the items at the begin of the simulation
+    void addItem(SimItemHandling &handling, double x,
+                 ItemKinds kind = ItemKinds::flat) {
+        SimItemHandlingAction action(0, kind);
+        action.x = x;
+        handling.addAction(action);
+    }
+
+    // Moves an item from 200 mm through the light barrier at the height
+    // sensor (290 mm) and records the edges
+    void passHeightSensor(unsigned int timeslice, unsigned int substep, EdgeRecorder &recorder) {
+        SimItemHandling handling;
+        addItem(handling, 200.0);
+        Simulation sim(&handling);
+        sim.setTimeslice(timeslice);
+        sim.setSubstep(substep);
+        sim.addCycleEndHandler(&recorder);
+        sim.writeOut(SIM_DRIVE_DIRECTION_RIGHT);
+        for (int t = 0; t < 4000; t += timeslice) {
+            sim.simulateTime(timeslice);
+        }
+        EXPECT_EQ(4000u, sim.currentSimTime());
+    }
+};
+
+TEST_F(UnitTest_Simulation, LightBarrierOnlyNearItem) {
+	SimItemHandling handling;
+	addItem(handling, 100.0);
+	addItem(handling, 290.0);
+	addItem(handling, 655.0);
+	Simulation sim(&handling);
+	sim.simulateTime(SimulationBase::timeslice);
+
+	unsigned short in = sim.readIn();
+	EXPECT_EQ(SIM_ITEM_DETECTED, in & SIM_ITEM_DETECTED);   // active low
+	EXPECT_EQ(0, in & SIM_ITEM_AT_HEIGHT_SENSOR);
+	EXPECT_EQ(SIM_ITEM_AT_JUNCTION, in & SIM_ITEM_AT_JUNCTION);
+	EXPECT_EQ(0, in & (0x0001 << 7));                      // end of belt
+}
+
+TEST_F(UnitTest_Simulation, SensorsFollowMovingItems) {
+	SimItemHandling handling;
+	addItem(handling, 250.0, ItemKinds::metalup);
+	addItem(handling, 20.0);
+	Simulation sim(&handling);
+	sim.simulateTime(SimulationBase::timeslice);
+	EXPECT_EQ(0, sim.readIn() & SIM_ITEM_DETECTED);
+	EXPECT_EQ(0, sim.readIn() & SIM_ITEM_IS_METTAL);
+
+	// Move until the metal item passes the metal sensor at 395 mm
+	sim.writeOut(SIM_DRIVE_DIRECTION_RIGHT);
+	bool metalDetected = false;
+	bool heightSensorPassed = false;
+	for (int i = 0; i < 300 && !metalDetected; i++) {
+		sim.simulateTime(SimulationBase::timeslice);
+		metalDetected = sim.readIn() & SIM_ITEM_IS_METTAL;
+		heightSensorPassed |= (sim.readIn() & SIM_ITEM_AT_HEIGHT_SENSOR) == 0;
+	}
+	EXPECT_TRUE(metalDetected);
+	EXPECT_TRUE(heightSensorPassed);
+	EXPECT_EQ(SIM_ITEM_DETECTED, sim.readIn() & SIM_ITEM_DETECTED);
+}
+
+TEST_F(UnitTest_Simulation, ItemStoreSlotsStable) {
+	auto store = std::make_shared<SimItemStore>(2);
+	unsigned long allocationsBefore = nAllocations;
+	SimItem *a = store->create(ItemKinds::metalup, 100.0, 60.0);
+	SimItem *b = store->create(ItemKinds::flat, 200.0, 60.0);
+	EXPECT_EQ(0u, nAllocations - allocationsBefore);
+	EXPECT_TRUE(store->isFull());
+	EXPECT_EQ(nullptr, store->create(ItemKinds::flat, 300.0, 60.0));
+	EXPECT_EQ(2u, store->size());
+
+	unsigned int slot = b->getSlot();
+	store->moveBelt(5.0, 0.0, 700.0);
+	EXPECT_DOUBLE_EQ(105.0, a->x);
+	EXPECT_DOUBLE_EQ(205.0, store->x[slot]);
+	EXPECT_EQ(ItemKinds::metalup, store->kind[a->getSlot()]);
+
+	// Slot is reused after the item has been destroyed
+	store->destroy(b);
+	EXPECT_FALSE(store->isFull());
+	SimItem *c = store->create(ItemKinds::holeup, 50.0, 60.0);
+	EXPECT_EQ(slot, c->getSlot());
+	EXPECT_DOUBLE_EQ(50.0, c->x);
+	EXPECT_EQ(ItemState::onBelt, c->state);
+}
+
+TEST_F(UnitTest_Simulation, HeightProfile) {
+	EXPECT_DOUBLE_EQ(10.0, SimHeightProfile::height(ItemKinds::holeup, 0.0));
+	EXPECT_DOUBLE_EQ(25.0, SimHeightProfile::height(ItemKinds::holeup, -15.0));
+	EXPECT_DOUBLE_EQ(21.0, SimHeightProfile::height(ItemKinds::flat, 20.0));
+	EXPECT_DOUBLE_EQ(0.0, SimHeightProfile::height(ItemKinds::flat, 21.0));
+	EXPECT_DOUBLE_EQ(0.0, SimHeightProfile::height(ItemKinds::lego1, 40.0));
+	EXPECT_NEAR(24.2, SimHeightProfile::height(ItemKinds::lego1, 25.0), 1e-9);
+	EXPECT_NEAR(24.2, SimHeightProfile::height(ItemKinds::lego2, 10.0), 1e-9);
+
+	// ADC values are interpolated between the 1 mm measurements
+	short int left = SimHeightProfile::adc(ItemKinds::holeup, -7.0);
+	short int right = SimHeightProfile::adc(ItemKinds::holeup, -6.0);
+	short int middle = SimHeightProfile::adc(ItemKinds::holeup, -6.5);
+	EXPECT_EQ((left + right) / 2, middle);
+	EXPECT_EQ((short int) 0xFFFF, SimHeightProfile::adc(ItemKinds::flat, 20.5));
+	EXPECT_NE((short int) 0xFFFF, SimHeightProfile::adc(ItemKinds::lego3, 31.0));
+
+	SimItemStore store(1);
+	SimItem *item = store.create(ItemKinds::codeC, 0.0, 60.0);
+	EXPECT_EQ(SimHeightProfile::adc(ItemKinds::codeC, 3.25), item->getADCHeight(3.25));
+}
+
+TEST_F(UnitTest_Simulation, SubstepsRefineEdges) {
+	EdgeRecorder coarse(SIM_ITEM_AT_HEIGHT_SENSOR);
+	passHeightSensor(20, 0, coarse);
+	EdgeRecorder fine(SIM_ITEM_AT_HEIGHT_SENSOR);
+	passHeightSensor(20, 1, fine);
+
+	ASSERT_EQ(2u, coarse.edges.size());
+	ASSERT_EQ(2u, fine.edges.size());
+	for (int i = 0; i < 2; i++) {
+		EXPECT_EQ(0u, coarse.edges[i] % 20);
+		// the coarse edge is reported at the end of the timeslice
+		EXPECT_LE(fine.edges[i], coarse.edges[i]);
+		EXPECT_GT(fine.edges[i] + 20, coarse.edges[i]);
+	}
+	EXPECT_NE(0u, fine.edges[0] % 20);
+	// 1 ms cycles only around the sensors
+	EXPECT_GT(fine.cycles, coarse.cycles);
+	EXPECT_LT(fine.cycles, 4000u);
+}
+
+// Real time mode: the sub-steps of a timeslice follow each other in real time
+TEST_F(UnitTest_Simulation, RealTimeSubstepsPaced) {
+	SimItemHandling handling;
+	addItem(handling, 290.0);
+	Simulation sim(&handling);
+	sim.setTimeslice(20);
+	sim.setSubstep(5);
+	sim.setRealTime(true);
+	sim.simulateTime(20);   // add items
+	sim.writeOut(SIM_DRIVE_DIRECTION_RIGHT);
+
+	CycleTimeRecorder recorder;
+	sim.addCycleEndHandler(&recorder);
+	recorder.times.clear();
+	sim.simulateTime(20);
+	ASSERT_EQ(4u, recorder.times.size());
+	for (int i = 1; i < 4; i++) {
+		EXPECT_GE(recorder.times[i] - recorder.times[0], std::chrono::milliseconds(5 * i));
+	}
+	EXPECT_EQ(40u, sim.currentSimTime());
+}
+
+TEST_F(UnitTest_Simulation, TimesliceConfigurable) {
+	EdgeRecorder coarse(SIM_ITEM_AT_HEIGHT_SENSOR);
+	passHeightSensor(20, 0, coarse);
+	EdgeRecorder fine(SIM_ITEM_AT_HEIGHT_SENSOR);
+	passHeightSensor(5, 0, fine);
+
+	ASSERT_EQ(2u, fine.edges.size());
+	EXPECT_EQ(4u * coarse.cycles - 3, fine.cycles);
+	// same belt speed, edges differ less than one coarse timeslice
+	EXPECT_LE(fine.edges[0], coarse.edges[0]);
+	EXPECT_GT(fine.edges[0] + 20, coarse.edges[0]);
+}
+
+TEST_F(UnitTest_Simulation, ReportDecodesToJSON) {
+	SimItemHandling handling;
+	addItem(handling, 100.0, ItemKinds::metalup);
+	addItem(handling, 400.0, ItemKinds::holeup);
+	addItem(handling, 600.0);
+	Simulation sim(&handling);
+	ReportChecker checker;
+	checker.attach(&sim);
+	sim.writeOut(SIM_DRIVE_DIRECTION_RIGHT | SIM_FEED_SEPARATOR);
+	// items drop off at the end of the belt
+	for (int i = 0; i < 500; i++) {
+		sim.simulateTime(sim.getTimeslice());
+	}
+	EXPECT_EQ(500u, checker.reports);
+	EXPECT_EQ(0u, checker.mismatches);
+	EXPECT_TRUE(sim.getItems().empty());
+	EXPECT_TRUE(checker.decoder.getItems().empty());
+}
+
+TEST_F(UnitTest_Simulation, ReportResynchronizesWithKeyframe) {
+	SimItemHandling handling;
+	addItem(handling, 100.0);
+	Simulation sim(&handling);
+	ReportCollector collector;
+	sim.addReportHandler(&collector);
+	sim.writeOut(SIM_DRIVE_DIRECTION_RIGHT);
+	for (int i = 0; i < 2 * SIM_REPORT_KEYFRAME_INTERVAL; i++) {
+		sim.simulateTime(sim.getTimeslice());
+	}
+
+	SimReportDecoder decoder;
+	ASSERT_TRUE(decoder.decode(collector.reports[0].data(), collector.reports[0].size()));
+	EXPECT_EQ(SIM_REPORT_FLAG_KEYFRAME, collector.reports[0][3]);
+	EXPECT_TRUE(decoder.decode(collector.reports[1].data(), collector.reports[1].size()));
+	// report 2 lost
+	for (unsigned int i = 3; i < SIM_REPORT_KEYFRAME_INTERVAL; i++) {
+		EXPECT_FALSE(decoder.decode(collector.reports[i].data(), collector.reports[i].size()));
+	}
+	const std::vector<uint8_t> &keyframe = collector.reports[SIM_REPORT_KEYFRAME_INTERVAL];
+	EXPECT_EQ(SIM_REPORT_FLAG_KEYFRAME, keyframe[3]);
+	EXPECT_TRUE(decoder.decode(keyframe.data(), keyframe.size()));
+	ASSERT_EQ(1u, decoder.getItems().size());
+	EXPECT_EQ(sim.getItems().size(), 1u);
+
+	// delta report of a moving item: header and one record of 7 bytes
+	EXPECT_EQ(SIM_REPORT_HEADER_SIZE + 7u, collector.reports[SIM_REPORT_KEYFRAME_INTERVAL + 1].size());
+	EXPECT_FALSE(decoder.decode(keyframe.data(), 3));
+}
+
+// Binary delta report against the former JSON report of each cycle
+TEST_F(UnitTest_Simulation, ReportSmallerThanJSON) {
+	SimItemHandling handling;
+	for (int i = 0; i < 100; i++) {
+		addItem(handling, 20.0 + 6.0 * i);
+	}
+	Simulation sim(&handling);
+	sim.simulateTime(sim.getTimeslice());   // add items
+	sim.writeOut(SIM_DRIVE_DIRECTION_RIGHT);
+	const int nCycles = 500;
+
+	unsigned long jsonBytes = 0;
+	for (int i = 0; i < nCycles; i++) {
+		jsonBytes += sim.generateJSONStatusReport().size() + 1;
+	}
+
+	SimReportEncoder encoder('A', 'F', SimulationBase::itemCapacity);
+	SimulationIOImage image;
+	unsigned long binaryBytes = 0;
+	unsigned long allocations = 0;
+	for (int i = 0; i < nCycles; i++) {
+		sim.simulateTime(sim.getTimeslice());   // items move between the reports
+		unsigned long allocationsBefore = nAllocations;
+		binaryBytes += encoder.encode(sim.currentSimTime(), image, sim.getItems());
+		allocations += nAllocations - allocationsBefore;
+	}
+	EXPECT_EQ(0u, allocations);
+	EXPECT_LT(binaryBytes, jsonBytes);
+}
+
+TEST_F(UnitTest_Simulation, ScenarioSameSeedSameResult) {
+	SimScenarioRunner runner(metalSort, 2);
+	std::vector<SimScenario> scenarios = {SimScenario::random(7, 5, 3000, 30000),
+			SimScenario::random(7, 5, 3000, 30000), SimScenario::random(8, 5, 3000, 30000)};
+	std::vector<SimScenarioResult> results = runner.run(scenarios);
+
+	ASSERT_EQ(3u, results.size());
+	EXPECT_EQ(7u, results[0].seed);
+	EXPECT_EQ(5u, results[0].added);
+	EXPECT_EQ(results[0].passed, results[1].passed);
+	EXPECT_EQ(results[0].sortedOut, results[1].sortedOut);
+	EXPECT_EQ(8u, results[2].seed);
+}
+
+TEST_F(UnitTest_Simulation, ScenarioSortAccuracy) {
+	SimScenarioRunner runner(metalSort);
+	std::vector<SimScenario> scenarios;
+	unsigned int nMetalDown = 0;
+	for (unsigned int seed = 1; seed <= 8; seed++) {
+		scenarios.push_back(SimScenario::random(seed, 8, 3000, 40000));
+		scenarios.back().sortOrder.sortOut = {ItemKinds::metalup, ItemKinds::metaldown};
+		for (const auto &action : scenarios.back().script) {
+			nMetalDown += action.kind == ItemKinds::metaldown ? 1 : 0;
+		}
+	}
+	SimScenarioSummary summary = SimScenarioRunner::summarize(runner.run(scenarios));
+
+	EXPECT_EQ(8u, summary.runs);
+	EXPECT_EQ(64u, summary.added);
+	EXPECT_EQ(summary.added, summary.passed + summary.sortedOut);
+	EXPECT_GT(summary.sortedOut, 0u);
+	// metal at the bottom is not detected by the strategy
+	ASSERT_GT(nMetalDown, 0u);
+	EXPECT_EQ(summary.added - nMetalDown, summary.asOrdered);
+	EXPECT_DOUBLE_EQ((double) (summary.added - nMetalDown) / summary.added, summary.orderAccuracy);
+}
@@ -0,0 +1,122 @@
+/*
+ * UnitTest_Startup.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "common/Startup.h"
+#include "configuration/Configuration.h"
+#include "events/EventManager.h"
+#include "events/EventSender.h"
+#include "metrics/Metrics.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Service of the partner system, attached after a delay
+class PartnerService {
+  public:
+    explicit PartnerService(int delayMs) {
+        const char *name = Configuration::getInstance().systemIsMaster() ? ATTACH_POINT_LOCAL_S
+                                                                         : ATTACH_POINT_LOCAL_M;
+        receiver = std::thread([this, name, delayMs]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                attach = name_attach(NULL, name, NAME_FLAG_ATTACH_GLOBAL);
+            }
+            _pulse pulse;
+            while (MsgReceivePulse(attach->chid, &pulse, sizeof(pulse), NULL) != -1) {
+            }
+        });
+    }
+
+    ~PartnerService() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            name_detach(attach, 0);
+        }
+        receiver.join();
+    }
+
+  private:
+    std::mutex mtx;
+    name_attach_t *attach = nullptr;
+    std::thread receiver;
+};
+
+}
+
+class UnitTest_Startup : public ::testing::Test {
+  protected:
+    Startup &startup = Startup::getInstance();
+
+    void SetUp() override { startup.begin(); }
+};
+
+TEST_F(UnitTest_Startup, ReadyOnce) {
+	EXPECT_FALSE(startup.isReady("test-component"));
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	startup.ready("test-component");
+	int64_t readyMs = startup.readyTimes().at("test-component");
+	EXPECT_GE(readyMs, 20);
+	EXPECT_LE(readyMs, startup.elapsedMs());
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	startup.ready("test-component");   // later calls keep the first time
+	EXPECT_EQ(readyMs, startup.readyTimes().at("test-component"));
+	EXPECT_TRUE(startup.isReady("test-component"));
+	EXPECT_NE(std::string::npos, MetricsRegistry::getInstance().snapshot().find(
+	                                 "esep_startup_ready_ms{component=\"test-component\"}"));
+
+	startup.begin();
+	EXPECT_FALSE(startup.isReady("test-component"));
+}
+
+TEST_F(UnitTest_Startup, WaitFor) {
+	EXPECT_FALSE(startup.waitFor("test-late", 10));
+	std::thread component([&]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		startup.ready("test-late");
+	});
+	EXPECT_TRUE(startup.waitFor("test-late", 2000));
+	component.join();
+	EXPECT_TRUE(startup.waitFor("test-late"));
+}
+
+// Partner system comes up shortly after: start() returns within the backoff,
+// events sent before are delivered once connected
+TEST_F(UnitTest_Startup, EventManagerConnectsWhenPartnerAppears) {
+	auto manager = std::make_shared<EventManager>();
+	std::mutex mtx;
+	std::condition_variable cv;
+	bool received = false;
+	manager->subscribe(EventType::LBW_M_BLOCKED, [&](Event) {
+		std::lock_guard<std::mutex> lock(mtx);
+		received = true;
+		cv.notify_one();
+	});
+	EventSender sensor;
+	sensor.connect(manager);
+	sensor.sendEvent(Event{EventType::LBW_M_BLOCKED});
+
+	auto begin = std::chrono::steady_clock::now();
+	PartnerService partner(100);
+	manager->start();
+	auto connectMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+	                     std::chrono::steady_clock::now() - begin).count();
+	EXPECT_TRUE(startup.isReady("event-manager"));
+	EXPECT_GE(connectMs, 100);
+	EXPECT_LT(connectMs, 400);
+
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return received; }));
+	}
+	sensor.disconnect();
+	manager->stop();
+}
@@ -0,0 +1,158 @@
+/*
+ * UnitTest_ThreadRegistry.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "common/ThreadRegistry.h"
+#include "metrics/Metrics.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Busy threads at default priority, e.g. logging or simulation work
+class SyntheticLoad {
+  public:
+    explicit SyntheticLoad(int nThreads) {
+        for (int i = 0; i < nThreads; i++) {
+            threads.emplace_back([this]() {
+                volatile uint64_t spins = 0;
+                while (!done) {
+                    spins++;
+                }
+            });
+        }
+    }
+
+    ~SyntheticLoad() {
+        done = true;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+  private:
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+};
+
+// FIFO needs root or CAP_SYS_NICE (Linux), tests run without as well
+bool realtimeAllowed() {
+    bool allowed = false;
+    std::thread([&]() {
+        allowed = ThreadRegistry::applyToCurrentThread("rt-check", {SchedPolicy::FIFO, 1, -1});
+    }).join();
+    return allowed;
+}
+
+}
+
+class UnitTest_ThreadRegistry : public ::testing::Test {
+  protected:
+    ThreadRegistry &registry = ThreadRegistry::getInstance();
+
+    void TearDown() override { registry.setEnabled(false); }
+};
+
+TEST_F(UnitTest_ThreadRegistry, ParsePolicy) {
+	ThreadPolicy policy{SchedPolicy::OTHER, 0, -1};
+	ASSERT_TRUE(ThreadPolicy::parse("fifo:40:1", policy));
+	EXPECT_EQ((ThreadPolicy{SchedPolicy::FIFO, 40, 1}), policy);
+	EXPECT_EQ("fifo:40:1", policy.toString());
+	ASSERT_TRUE(ThreadPolicy::parse("rr:10", policy));
+	EXPECT_EQ((ThreadPolicy{SchedPolicy::RR, 10, -1}), policy);
+	EXPECT_EQ("rr:10", policy.toString());
+	ASSERT_TRUE(ThreadPolicy::parse("other:0", policy));
+	EXPECT_EQ(SchedPolicy::OTHER, policy.policy);
+
+	for (const char *invalid : {"", "fifo", "idle:1", "fifo:x", "fifo:0", "fifo:10:a", "rr:5:-2"}) {
+		EXPECT_FALSE(ThreadPolicy::parse(invalid, policy)) << invalid;
+	}
+	EXPECT_EQ(SchedPolicy::OTHER, policy.policy);   // unchanged
+}
+
+TEST_F(UnitTest_ThreadRegistry, DefaultsAndOverrides) {
+	EXPECT_EQ(SchedPolicy::FIFO, registry.getPolicy("sensors").policy);
+	EXPECT_GT(registry.getPolicy("sensors").priority, registry.getPolicy("wd-send").priority);
+	EXPECT_EQ((ThreadPolicy{SchedPolicy::OTHER, 0, -1}), registry.getPolicy("unknown"));
+
+	registry.setPolicy("test-override", {SchedPolicy::RR, 12, 0});
+	EXPECT_EQ((ThreadPolicy{SchedPolicy::RR, 12, 0}), registry.getPolicy("test-override"));
+}
+
+TEST_F(UnitTest_ThreadRegistry, SpawnedThreadNamedAndListed) {
+	std::atomic<bool> release{false};
+	char name[16] = {};
+	std::thread thread = registry.spawn("test-listed", [&](int arg) {
+		EXPECT_EQ(42, arg);
+		pthread_getname_np(pthread_self(), name, sizeof(name));
+		while (!release) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}, 42);
+
+	bool listed = false;
+	for (int i = 0; i < 100 && !listed; i++) {
+		for (const ThreadInfo &info : registry.threads()) {
+			listed |= info.name == "test-listed" && !info.applied;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	EXPECT_TRUE(listed);
+	release = true;
+	thread.join();
+	EXPECT_STREQ("test-listed", name);
+	for (const ThreadInfo &info : registry.threads()) {
+		EXPECT_NE("test-listed", info.name);
+	}
+}
+
+TEST_F(UnitTest_ThreadRegistry, PolicyAppliedWhenEnabled) {
+	if (!realtimeAllowed()) {
+		GTEST_SKIP() << "no permission for SCHED_FIFO";
+	}
+	registry.setPolicy("test-fifo", {SchedPolicy::FIFO, 20, 0});
+	registry.setEnabled(true);
+	int policy = -1;
+	struct sched_param param = {};
+	int cpus = 1;
+	std::thread thread = registry.spawn("test-fifo", [&]() {
+		pthread_getschedparam(pthread_self(), &policy, &param);
+#ifndef __QNXNTO__
+		cpu_set_t set;
+		pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+		cpus = CPU_COUNT(&set);
+#endif
+	});
+	thread.join();
+	EXPECT_EQ(SCHED_FIFO, policy);
+	EXPECT_EQ(20, param.sched_priority);
+	EXPECT_EQ(1, cpus);
+}
+
+// Wake-up latency of a periodic thread while busy threads occupy the CPUs
+TEST_F(UnitTest_ThreadRegistry, WakeupLatencyUnderLoad) {
+	bool realtime = realtimeAllowed();
+	registry.setPolicy("test-probe-other", {SchedPolicy::OTHER, 0, -1});
+	registry.setPolicy("test-probe-fifo", {SchedPolicy::FIFO, 30, -1});
+	const int samples = 200;
+
+	SyntheticLoad load(2 * std::thread::hardware_concurrency());
+	Histogram &other = registry.measureWakeupLatency("test-probe-other", 1000, samples);
+	Histogram &fifo = registry.measureWakeupLatency("test-probe-fifo", 1000, samples);
+
+	EXPECT_EQ((uint64_t) samples, other.count());
+	EXPECT_EQ((uint64_t) samples, fifo.count());
+	EXPECT_NE(std::string::npos, MetricsRegistry::getInstance().snapshot().find(
+	                                 "esep_thread_wakeup_latency_us_count{thread=\"test-probe-fifo\"}"));
+	if (realtime) {
+		// a FIFO thread preempts the load as soon as its timer expires
+		EXPECT_LT(fifo.percentile(0.99), 2000u);
+	}
+}
@@ -0,0 +1,118 @@
+/*
+ * UnitTest_TimerService.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "common/TimerService.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono;
+
+class UnitTest_TimerService : public ::testing::Test {
+  protected:
+    TimerService timers;
+};
+
+TEST_F(UnitTest_TimerService, OneShotNotBeforeDelay) {
+	std::atomic<bool> fired{false};
+	steady_clock::time_point firedAt;
+	steady_clock::time_point start = steady_clock::now();
+	timers.scheduleOnce(100, [&]() {
+		firedAt = steady_clock::now();
+		fired = true;
+	});
+	EXPECT_EQ(1, timers.getActiveTimers());
+
+	// wait for the timer thread, which may be delayed on a loaded host
+	for (int i = 0; i < 100 && !fired; i++) {
+		std::this_thread::sleep_for(milliseconds(10));
+	}
+	ASSERT_TRUE(fired);
+	EXPECT_GE(duration_cast<milliseconds>(firedAt - start).count(), 100);
+	EXPECT_EQ(0, timers.getActiveTimers());
+}
+
+TEST_F(UnitTest_TimerService, PeriodicUntilCancelled) {
+	std::atomic<int> nCalls{0};
+	TimerId id = timers.schedulePeriodic(50, [&]() { nCalls++; });
+	std::this_thread::sleep_for(milliseconds(275));
+	EXPECT_TRUE(timers.cancel(id));
+	int n = nCalls;
+	EXPECT_GE(n, 4);
+	EXPECT_LE(n, 6);
+
+	std::this_thread::sleep_for(milliseconds(120));
+	EXPECT_EQ(n, nCalls);
+	EXPECT_FALSE(timers.cancel(id));
+}
+
+TEST_F(UnitTest_TimerService, CancelledOneShotNotExecuted) {
+	std::atomic<bool> fired{false};
+	TimerId id = timers.scheduleOnce(50, [&]() { fired = true; });
+	EXPECT_TRUE(timers.cancel(id));
+	std::this_thread::sleep_for(milliseconds(100));
+	EXPECT_FALSE(fired);
+}
+
+// Delay longer than level 0 of the wheel (2.56 s) -> cascaded from level 1
+TEST_F(UnitTest_TimerService, LongDelayIsCascaded) {
+	std::atomic<bool> shortFired{false};
+	std::atomic<bool> longFired{false};
+	timers.scheduleOnce(2700, [&]() { longFired = true; });
+	timers.scheduleOnce(30, [&]() { shortFired = true; });
+
+	std::this_thread::sleep_for(milliseconds(2600));
+	EXPECT_TRUE(shortFired);
+	EXPECT_FALSE(longFired);
+	std::this_thread::sleep_for(milliseconds(200));
+	EXPECT_TRUE(longFired);
+}
+
+// Three blinking lamps (500 ms / 1000 ms) for 2 s. Before, every lamp had its
+// own thread waking up every 100 ms (3 threads, 30 wake-ups/s).
+TEST_F(UnitTest_TimerService, WakeupsOfBlinkingLamps) {
+	std::atomic<int> nToggles{0};
+	TimerId green = timers.schedulePeriodic(1000, [&]() { nToggles++; });
+	TimerId yellow = timers.schedulePeriodic(1000, [&]() { nToggles++; });
+	TimerId red = timers.schedulePeriodic(500, [&]() { nToggles++; });
+
+	std::this_thread::sleep_for(milliseconds(2050));
+	timers.cancel(green);
+	timers.cancel(yellow);
+	timers.cancel(red);
+
+	double wakeupsPerSecond = timers.getWakeups() / 2.05;
+	EXPECT_EQ(8, nToggles);
+	EXPECT_LT(wakeupsPerSecond, 10.0);
+}
+
+// The clock of the application is replaced after the timers have been started
+// (headless simulation): pending timers continue on the new clock
+TEST_F(UnitTest_TimerService, FollowsReplacedClock) {
+	std::atomic<bool> fired{false};
+	timers.scheduleOnce(200, [&]() { fired = true; });
+	{
+		VirtualClock clock;
+		Clock::setInstance(&clock);
+		std::this_thread::sleep_for(milliseconds(300));
+		EXPECT_FALSE(fired);
+
+		clock.advance(200 + TIMER_TICK_MS);   // delay is rounded up to the next tick
+		for (int i = 0; i < 100 && !fired; i++) {
+			std::this_thread::sleep_for(milliseconds(10));
+		}
+		EXPECT_TRUE(fired);
+
+		fired = false;
+		timers.scheduleOnce(100, [&]() { fired = true; });
+		Clock::setInstance(nullptr);
+	}
+	for (int i = 0; i < 100 && !fired; i++) {
+		std::this_thread::sleep_for(milliseconds(10));
+	}
+	EXPECT_TRUE(fired);
+}
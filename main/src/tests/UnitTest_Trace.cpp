@@ -0,0 +1,204 @@
+/*
+ * UnitTest_Trace.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+#include "common/Trace.h"
+#include "configuration/Configuration.h"
+#include "events/EventManager.h"
+#include "events/EventSender.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+// Service of the partner system, receives and drops the forwarded events
+class PartnerService {
+  public:
+    PartnerService() {
+        const char *name = Configuration::getInstance().systemIsMaster() ? ATTACH_POINT_LOCAL_S
+                                                                         : ATTACH_POINT_LOCAL_M;
+        attach = name_attach(NULL, name, NAME_FLAG_ATTACH_GLOBAL);
+        receiver = std::thread([this]() {
+            _pulse pulse;
+            while (MsgReceivePulse(attach->chid, &pulse, sizeof(pulse), NULL) != -1) {
+            }
+        });
+    }
+
+    ~PartnerService() {
+        name_detach(attach, 0);
+        receiver.join();
+    }
+
+  private:
+    name_attach_t *attach;
+    std::thread receiver;
+};
+
+}
+
+class UnitTest_Trace : public ::testing::Test {
+  protected:
+    Tracer &tracer = Tracer::getInstance();
+
+    void SetUp() override {
+        tracer.clear();
+        tracer.setEnabled(true);
+    }
+
+    void TearDown() override {
+        tracer.setEnabled(false);
+        tracer.clear();
+    }
+};
+
+TEST_F(UnitTest_Trace, RingDropsWhenFull) {
+	TraceRing ring(1);
+	TraceRecord record{"span", 1, 1, -1, 0, 1};
+	for (int i = 0; i < TRACE_RING_CAPACITY; i++) {
+		EXPECT_TRUE(ring.push(record));
+	}
+	EXPECT_FALSE(ring.push(record));
+	EXPECT_EQ(1u, ring.getDropped());
+
+	std::vector<TraceRecord> drained;
+	ring.drain(drained);
+	EXPECT_EQ((size_t) TRACE_RING_CAPACITY, drained.size());
+	EXPECT_TRUE(ring.push(record));
+}
+
+TEST_F(UnitTest_Trace, DisabledRecordsNothing) {
+	tracer.setEnabled(false);
+	EXPECT_EQ(0u, tracer.newTrace());
+	{
+		TraceScope scope(7);
+		TraceSpan span("span");
+	}
+	tracer.setEnabled(true);
+	{
+		TraceSpan span("untraced");   // no current trace
+	}
+	EXPECT_TRUE(tracer.getRecords().empty());
+}
+
+TEST_F(UnitTest_Trace, SpansOfCurrentTrace) {
+	uint32_t id = tracer.newTrace();
+	ASSERT_NE(0u, id);
+	{
+		TraceScope scope(id);
+		TraceSpan outer("outer", EventType::LBW_M_BLOCKED);
+		TraceSpan inner("inner");
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	EXPECT_EQ(0u, Tracer::current());
+
+	std::vector<TraceRecord> records = tracer.getRecords();
+	ASSERT_EQ(2u, records.size());
+	EXPECT_STREQ("inner", records[0].name);
+	EXPECT_STREQ("outer", records[1].name);
+	for (const TraceRecord &r : records) {
+		EXPECT_EQ(id, r.traceId);
+		EXPECT_GE(r.endNs - r.beginNs, 1000000u);
+	}
+	EXPECT_EQ(EventType::LBW_M_BLOCKED, records[1].event);
+	EXPECT_LE(records[1].beginNs, records[0].beginNs);
+}
+
+// Sensor edge -> EventManager -> logic sends SORT_M_OUT -> EventManager ->
+// actuator, as on the target (pulses, receiver and dispatcher thread)
+TEST_F(UnitTest_Trace, PropagatedThroughEventManager) {
+	PartnerService partner;
+	auto manager = std::make_shared<EventManager>();
+	EventSender logicSender;
+	std::mutex mtx;
+	std::condition_variable cv;
+	int switched = 0;
+	manager->subscribe(EventType::LBW_M_BLOCKED, [&](Event) {
+		TraceSpan span("MainActions::master_openGate");
+		logicSender.sendEvent(Event{EventType::SORT_M_OUT, 1});
+	});
+	manager->subscribe(EventType::SORT_M_OUT, [&](Event event) {
+		TraceSpan span("Actuators::switch", event.type);
+		std::lock_guard<std::mutex> lock(mtx);
+		switched++;
+		cv.notify_one();
+	});
+	manager->start();
+	logicSender.connect(manager);
+	EventSender sensor;
+	sensor.connect(manager);
+
+	const int nEdges = 20;
+	for (int i = 0; i < nEdges; i++) {
+		{
+			TraceSpan span("Sensors::handleGpioInterrupt");
+			Event event{EventType::LBW_M_BLOCKED};
+			event.traceId = tracer.newTrace();
+			span.setTrace(event.traceId, event.type);
+			sensor.sendEvent(event);
+		}
+		std::unique_lock<std::mutex> lock(mtx);
+		ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return switched == i + 1; }));
+	}
+	sensor.disconnect();
+	logicSender.disconnect();
+	manager->stop();
+
+	std::vector<uint64_t> latencies =
+		tracer.latencies("Sensors::handleGpioInterrupt", "Actuators::switch");
+	EXPECT_EQ((size_t) nEdges, latencies.size());
+	for (uint64_t latency : latencies) {
+		EXPECT_LT(latency, 1000000u);
+	}
+	// edge, 2x dispatch, logic, switch
+	std::vector<TraceRecord> records = tracer.getRecords();
+	EXPECT_EQ(5u * nEdges, records.size());
+	EXPECT_EQ(0u, tracer.getDropped());
+
+	std::string report = Tracer::histogram(latencies);
+	EXPECT_NE(std::string::npos, report.find(std::to_string(nEdges) + " traces"));
+}
+
+TEST_F(UnitTest_Trace, ChromeTraceExport) {
+	uint32_t id = tracer.newTrace();
+	{
+		TraceScope scope(id);
+		TraceSpan span("EventManager::dispatch", EventType::SORT_M_OUT);
+		tracer.instant("edge", id);
+	}
+	std::string path = "/tmp/esep_trace_test.json";
+	ASSERT_TRUE(tracer.exportChromeTrace(path));
+	std::ifstream in(path);
+	std::stringstream ss;
+	ss << in.rdbuf();
+	std::string json = ss.str();
+	std::remove(path.c_str());
+
+	EXPECT_EQ(0u, json.find("{\"displayTimeUnit\": \"ms\", \"traceEvents\": ["));
+	EXPECT_NE(std::string::npos, json.find("\"ph\": \"M\""));
+	EXPECT_NE(std::string::npos, json.find("\"name\": \"EventManager::dispatch\""));
+	EXPECT_NE(std::string::npos, json.find("\"ph\": \"X\""));
+	EXPECT_NE(std::string::npos, json.find("\"ph\": \"i\""));
+	EXPECT_NE(std::string::npos, json.find("\"event\": \"SORT_M_OUT\""));
+	EXPECT_NE(std::string::npos, json.find("\"trace\": " + std::to_string(id)));
+	EXPECT_EQ(json.size() - 3, json.rfind("]}\n"));
+}
+
+TEST_F(UnitTest_Trace, HistogramPercentiles) {
+	std::vector<uint64_t> latencies;
+	for (uint64_t i = 1; i <= 100; i++) {
+		latencies.push_back(i * 10);
+	}
+	std::string report = Tracer::histogram(latencies);
+	EXPECT_EQ(0u, report.find("100 traces, p50 500 us, p90 900 us, p99 990 us, max 1000 us\n"));
+	EXPECT_NE(std::string::npos, report.find("<=     1024 us"));
+	EXPECT_EQ("no latencies recorded\n", Tracer::histogram({}));
+}
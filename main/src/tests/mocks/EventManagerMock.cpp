@@ -30,42 +30,44 @@ int EventManagerMock::connectInternalClient() {
 }
 
 void EventManagerMock::subscribe(EventType type, EventCallback callback) {
-    if (subscribers.find(type) == subscribers.end()) {
-        // If event doesn't exist yet, create a new list and add it to the map
-        subscribers[type] = std::vector<EventCallback>();
-    }
-    subscribers[type].push_back(callback);
+    subscribers.add(type, callback);
+}
+
+SubscriptionId EventManagerMock::subscribe(const EventMask &mask, EventDelegate handler) {
+    return subscribers.add(mask, handler);
+}
+
+SubscriptionId EventManagerMock::subscribe(const EventMask &mask, EventCallback callback) {
+    return subscribers.add(mask, callback);
 }
 
 int EventManagerMock::subscribeToAllEvents(EventCallback callback) {
-    int nEvents = 0;
-    for (int i = static_cast<int>(EventType::PULSE_STOP_THREAD);
-         i <= static_cast<int>(EventType::ERROR_S_SELF_SOLVED); i++) {
-        EventType eventType = static_cast<EventType>(i);
-        subscribe(eventType, callback);
-        nEvents++;
-    }
-    return nEvents;
+    // One callback for all events instead of one copy per EventType
+    EventMask mask = EventMask::range(EventType::PULSE_STOP_THREAD, EventType::ERROR_S_SELF_SOLVED);
+    subscribe(mask, callback);
+    return mask.count();
 }
 
 void EventManagerMock::unsubscribe(EventType type, EventCallback callback) {
 
 }
 
+void EventManagerMock::unsubscribe(SubscriptionId subscription) {
+    subscribers.remove(subscription);
+}
+
 void EventManagerMock::handleEvent(const Event &event) {
-	lastEvents.push_back(event);
+	{
+		std::lock_guard<std::mutex> lock(lastEventsMtx);
+		lastEvents.push_back(event);
+	}
 
     std::stringstream ss;
     ss << "[EventManagerMock] handleEvent: " << EVENT_TO_STRING(event.type);
     if (event.data != -1)
         ss << ", data: " << event.data;
 
-    if (subscribers.find(event.type) != subscribers.end()) {
-        int i = 1;
-        for (const auto &callback : subscribers[event.type]) {
-            callback(event);
-        }
-    } else {
+    if (subscribers.notify(event) == 0) {
         ss << " -> No subscribers for Event!";
     }
     Logger::debug(ss.str());
@@ -90,10 +92,12 @@ void EventManagerMock::connectToService(const std::string& name) {
 }
 
 Event EventManagerMock::getLastHandledEvent() {
+	std::lock_guard<std::mutex> lock(lastEventsMtx);
 	return lastEvents.back();
 }
 
 bool EventManagerMock::lastHandledEventsContain(const Event& event) {
+	std::lock_guard<std::mutex> lock(lastEventsMtx);
 	for(auto const& ev: lastEvents) {
 		if(ev.type == event.type && ev.data == event.data) {
 			return true;
@@ -103,5 +107,6 @@ bool EventManagerMock::lastHandledEventsContain(const Event& event) {
 }
 
 void EventManagerMock::clearLastHandledEvents() {
+	std::lock_guard<std::mutex> lock(lastEventsMtx);
 	std::vector<Event>().swap(lastEvents);
 }
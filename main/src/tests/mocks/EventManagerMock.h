@@ -13,9 +13,13 @@ public:
 	EventManagerMock();
 	~EventManagerMock() override;
 	int connectInternalClient() override;
+	using IEventManager::subscribe;
 	void subscribe(EventType type, EventCallback callback) override;
+	SubscriptionId subscribe(const EventMask &mask, EventDelegate handler) override;
+	SubscriptionId subscribe(const EventMask &mask, EventCallback callback) override;
 	int subscribeToAllEvents(EventCallback callback) override;
 	void unsubscribe(EventType type, EventCallback callback) override;
+	void unsubscribe(SubscriptionId subscription) override;
 	void handleEvent(const Event &event) override;
 	void sendExternalEvent(const Event &event) override;
 	int start() override;
@@ -26,5 +30,6 @@ public:
 	bool lastHandledEventsContain(const Event& event);
 	void clearLastHandledEvents();
 private:
+	std::mutex lastEventsMtx;   // events are also handled by timer threads
 	std::vector<Event> lastEvents;
 };
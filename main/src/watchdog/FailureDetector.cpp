@@ -0,0 +1,181 @@
+/*
+ * FailureDetector.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "FailureDetector.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Logistic approximation of the normal distribution (Bowling et al.), exponent
+// for the standardized interval y: P(X > y) = 1 / (1 + exp(exponent(y)))
+double exponent(double y) {
+    return y * (1.5976 + 0.070566 * y * y);
+}
+
+}
+
+FailureDetector::FailureDetector(Config config, Callback onFailure, Clock &clock,
+                                 TimerService &timers)
+    : config(config), onFailure(onFailure), clock(clock), timers(timers),
+      window(FD_WINDOW_SIZE, 0) {
+}
+
+FailureDetector::~FailureDetector() { stop(); }
+
+void FailureDetector::start() {
+    std::lock_guard<std::mutex> lock(mtx);
+    running = true;
+    hasFailed = false;
+    lastArrival = clock.now();
+    sinceStart = true;
+    arm();
+}
+
+void FailureDetector::stop() {
+    TimerId pending;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        running = false;
+        pending = timer;
+        timer = 0;
+    }
+    // Outside the lock, an expiring callback might wait for it
+    timers.cancel(pending);
+}
+
+void FailureDetector::heartbeat() { arrived(true); }
+
+void FailureDetector::alive() { arrived(false); }
+
+void FailureDetector::arrived(bool isHeartbeat) {
+    TimerId previous;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!running) {
+            return;
+        }
+        Clock::time_point now = clock.now();
+        int64_t interval = std::chrono::duration_cast<std::chrono::milliseconds>(
+                               now - lastArrival).count();
+        lastArrival = now;
+        bool fromStart = sinceStart;
+        sinceStart = false;
+        // traffic in between heartbeats only proves that the partner is alive
+        bool sample = isHeartbeat || (config.idleGapMs > 0 && interval >= config.idleGapMs);
+        if (sample) {
+            count++;
+        }
+        // interval measured from start() is not a heartbeat interval
+        if (sample && !fromStart) {
+            if (samplesLocked() == FD_WINDOW_SIZE) {
+                windowSum -= window[windowNext];
+                windowSquares -= (double) window[windowNext] * window[windowNext];
+            }
+            window[windowNext] = interval;
+            windowNext = (windowNext + 1) % FD_WINDOW_SIZE;
+            windowSum += interval;
+            windowSquares += (double) interval * interval;
+            minMs = intervals++ == 0 ? interval : std::min(minMs, interval);
+            maxMs = std::max(maxMs, interval);
+        }
+        previous = timer;
+        arm();
+    }
+    timers.cancel(previous);
+}
+
+double FailureDetector::phi() {
+    std::lock_guard<std::mutex> lock(mtx);
+    double elapsed = clock.millisSince(lastArrival);
+    if (intervals < config.minSamples) {
+        return elapsed >= config.timeoutMs ? INFINITY : 0.0;
+    }
+    double y = (elapsed - meanLocked()) / stdDevLocked();
+    double e = exponent(y);
+    // P(later) = 1 / (1 + exp(e)), for large e -log10 of it is e / ln(10)
+    if (e > 30.0) {
+        return e / std::log(10.0);
+    }
+    return std::log10(1.0 + std::exp(e));
+}
+
+int FailureDetector::deadlineMs() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return deadlineLocked();
+}
+
+HeartbeatStatistics FailureDetector::statistics() {
+    std::lock_guard<std::mutex> lock(mtx);
+    HeartbeatStatistics stats;
+    stats.count = count;
+    if (intervals > 0) {
+        stats.meanMs = meanLocked();
+        stats.stdDevMs = jitterLocked();
+        stats.minMs = minMs;
+        stats.maxMs = maxMs;
+    }
+    return stats;
+}
+
+void FailureDetector::arm() {
+    uint64_t armed = ++generation;
+    timer = timers.scheduleOnce(deadlineLocked(), [this, armed]() { expired(armed); });
+}
+
+void FailureDetector::expired(uint64_t armed) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        // timer re-armed meanwhile -> stale deadline
+        if (!running || armed != generation) {
+            return;
+        }
+        running = false;
+        hasFailed = true;
+        timer = 0;
+    }
+    onFailure();
+}
+
+int FailureDetector::deadlineLocked() {
+    if (config.phiThreshold <= 0.0 || intervals < config.minSamples) {
+        return config.timeoutMs;
+    }
+    // Standardized interval at which phi reaches the threshold:
+    // exponent(y) = ln(10^threshold - 1), exponent() is monotonic
+    double target = std::log(std::pow(10.0, config.phiThreshold) - 1.0);
+    double low = -10.0, high = 10.0;
+    while (exponent(high) < target) {
+        high *= 2.0;
+    }
+    for (int i = 0; i < 50; i++) {
+        double mid = (low + high) / 2.0;
+        (exponent(mid) < target ? low : high) = mid;
+    }
+    double deadline = meanLocked() + high * stdDevLocked();
+    return std::max(config.timeoutMs, (int) std::ceil(deadline));
+}
+
+unsigned int FailureDetector::samplesLocked() {
+    return std::min<uint64_t>(intervals, FD_WINDOW_SIZE);
+}
+
+double FailureDetector::meanLocked() {
+    unsigned int samples = samplesLocked();
+    return samples > 0 ? windowSum / samples : 0.0;
+}
+
+double FailureDetector::jitterLocked() {
+    unsigned int samples = samplesLocked();
+    double mean = meanLocked();
+    double variance = samples > 0 ? windowSquares / samples - mean * mean : 0.0;
+    return std::sqrt(std::max(variance, 0.0));
+}
+
+double FailureDetector::stdDevLocked() {
+    return std::max(jitterLocked(), config.minStdDevMs);
+}
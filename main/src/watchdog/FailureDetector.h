@@ -0,0 +1,129 @@
+/*
+ * FailureDetector.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "common/Clock.h"
+#include "common/TimerService.h"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Heartbeat intervals kept for the phi estimation
+#define FD_WINDOW_SIZE 64
+
+/**
+ * Heartbeat inter-arrival statistics. min, max and count since the start,
+ * mean and standard deviation of the last FD_WINDOW_SIZE intervals.
+ */
+struct HeartbeatStatistics {
+    uint64_t count{0};       // received heartbeats (and idle-gap arrivals)
+    double meanMs{0.0};
+    double stdDevMs{0.0};
+    int64_t minMs{0};
+    int64_t maxMs{0};
+};
+
+/**
+ * Deadline based failure detector. Every message of the partner re-arms a
+ * one-shot timer of the TimerService, the failure callback is called once
+ * when the deadline expires without a message. No thread polls the arrival
+ * of messages.
+ *
+ * The deadline is either the last message + a fixed timeout or, with a phi
+ * threshold > 0, the time at which the phi accrual suspicion level
+ * -log10(P(no heartbeat yet)) reaches the threshold, estimated from the
+ * normal distribution of the recent heartbeat intervals. The fixed timeout
+ * is the lower bound and is used until minSamples intervals have been seen.
+ *
+ * Only explicit heartbeats and messages after an idle gap feed the
+ * statistics: the partner sends a heartbeat after an idle gap, the short
+ * intervals of other traffic would make the deadline too short for the next
+ * idle phase.
+ */
+class FailureDetector {
+  public:
+    using Callback = std::function<void()>;
+
+    struct Config {
+        int timeoutMs;          // fixed deadline after the last message, lower bound
+        double phiThreshold;    // 0: fixed timeout only
+        unsigned int minSamples;
+        double minStdDevMs;     // lower bound of the estimated jitter
+        int idleGapMs{0};       // other messages after this silence are samples, 0: none
+    };
+
+    FailureDetector(Config config, Callback onFailure, Clock &clock = Clock::getInstance(),
+                    TimerService &timers = TimerService::getInstance());
+    virtual ~FailureDetector();
+
+    /**
+     * Starts monitoring, the first heartbeat is expected within the timeout.
+     */
+    void start();
+
+    /**
+     * Stops monitoring without calling the failure callback.
+     */
+    void stop();
+
+    /**
+     * Records the arrival of a heartbeat and re-arms the deadline. Ignored
+     * after a failure has been detected, until start() is called again.
+     */
+    void heartbeat();
+
+    /**
+     * Re-arms the deadline for any other message of the partner. Only
+     * recorded as heartbeat after an idle gap.
+     */
+    void alive();
+
+    /**
+     * @return suspicion level of the current time since the last heartbeat
+     */
+    double phi();
+
+    /**
+     * @return ms after the last message at which a failure is detected
+     */
+    int deadlineMs();
+
+    HeartbeatStatistics statistics();
+    bool failed() { return hasFailed; }
+
+  private:
+    Config config;
+    Callback onFailure;
+    Clock &clock;
+    TimerService &timers;
+
+    std::mutex mtx;
+    bool running{false};
+    bool hasFailed{false};
+    TimerId timer{0};
+    uint64_t generation{0};     // incremented each time the timer is armed
+    Clock::time_point lastArrival;
+    bool sinceStart{true};      // lastArrival is the time of start()
+    uint64_t count{0};
+    uint64_t intervals{0};
+    std::vector<int64_t> window;
+    unsigned int windowNext{0};
+    double windowSum{0.0};
+    double windowSquares{0.0};
+    int64_t minMs{0};
+    int64_t maxMs{0};
+
+    void arrived(bool isHeartbeat);
+    void arm();
+    void expired(uint64_t armed);
+    int deadlineLocked();
+    unsigned int samplesLocked();
+    double meanLocked();
+    double jitterLocked();
+    double stdDevLocked();   // jitter, at least minStdDevMs
+};
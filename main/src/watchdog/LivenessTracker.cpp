@@ -0,0 +1,51 @@
+/*
+ * LivenessTracker.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "LivenessTracker.h"
+
+#include <algorithm>
+
+LivenessTracker::LivenessTracker(int idleGapMs, Clock &clock)
+    : idleGapMs(idleGapMs), clock(clock), lastSentMs(0), nReceived(0), nSent(0), nHeartbeats(0),
+      nSuppressed(0) {
+    start = clock.now();
+}
+
+void LivenessTracker::setListener(Listener onPartnerTraffic) {
+    std::lock_guard<std::mutex> lock(mtxListener);
+    this->onPartnerTraffic = onPartnerTraffic;
+}
+
+void LivenessTracker::received(bool heartbeat) {
+    nReceived++;
+    std::lock_guard<std::mutex> lock(mtxListener);
+    if (onPartnerTraffic) {
+        onPartnerTraffic(heartbeat);
+    }
+}
+
+void LivenessTracker::sent() {
+    nSent++;
+    lastSentMs = clock.millisSince(start);
+}
+
+bool LivenessTracker::heartbeatDue() {
+    int64_t now = clock.millisSince(start);
+    if (now - lastSentMs < idleGapMs) {
+        nSuppressed++;
+        return false;
+    }
+    // Heartbeat is sent asynchronously by the EventManager, do not plan the
+    // next one before it has been sent
+    lastSentMs = now;
+    nHeartbeats++;
+    return true;
+}
+
+int LivenessTracker::nextHeartbeatMs() {
+    int64_t due = lastSentMs + idleGapMs - clock.millisSince(start);
+    return (int) std::max<int64_t>(due, 1);
+}
@@ -0,0 +1,78 @@
+/*
+ * LivenessTracker.h
+ *
+ *  Created on: 19.10.2026
+ */
+#pragma once
+
+#include "common/Clock.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+/**
+ * Liveness of the link to the partner system, fed by the EventManager with
+ * all messages it sends to and receives from the partner.
+ *
+ * Any received message proves that the partner is alive, so the listener
+ * (the failure detector of the Watchdog) is notified for all of them, not only
+ * for heartbeats. Heartbeats are flagged, only their intervals are expected
+ * to be regular. Any sent message proves the same to the partner, so an
+ * explicit heartbeat is only due after an idle gap without sent messages.
+ */
+class LivenessTracker {
+  public:
+    using Listener = std::function<void(bool heartbeat)>;
+
+    LivenessTracker(int idleGapMs, Clock &clock = Clock::getInstance());
+
+    /**
+     * Sets the listener called for every message from the partner.
+     */
+    void setListener(Listener onPartnerTraffic);
+
+    /**
+     * A message has been received from the partner.
+     *
+     * @param heartbeat true for an explicit heartbeat
+     */
+    void received(bool heartbeat = false);
+
+    /**
+     * A message has been sent to the partner.
+     */
+    void sent();
+
+    /**
+     * Called when a heartbeat was planned. If nothing has been sent during the
+     * idle gap, the heartbeat is due and counted as sent. Otherwise it is
+     * counted as suppressed.
+     *
+     * @return true if the heartbeat has to be sent
+     */
+    bool heartbeatDue();
+
+    /**
+     * @return ms until the next heartbeat is planned
+     */
+    int nextHeartbeatMs();
+
+    uint64_t getReceived() { return nReceived; }
+    uint64_t getSent() { return nSent; }
+    uint64_t getHeartbeats() { return nHeartbeats; }
+    uint64_t getSuppressed() { return nSuppressed; }
+
+  private:
+    int idleGapMs;
+    Clock &clock;
+    Clock::time_point start;
+    std::mutex mtxListener;
+    Listener onPartnerTraffic;
+    std::atomic<int64_t> lastSentMs;   // since start
+    std::atomic<uint64_t> nReceived;
+    std::atomic<uint64_t> nSent;
+    std::atomic<uint64_t> nHeartbeats;
+    std::atomic<uint64_t> nSuppressed;
+};
@@ -6,7 +6,9 @@
  */
 
 #include "Watchdog.h"
-#include "configuration/Configuration.h"
+#include "common/Clock.h"
+#include "common/Startup.h"
+#include "common/ThreadRegistry.h"
 #include "logger/logger.hpp"
 
 #include <chrono>
@@ -14,51 +16,65 @@
 #include <thread>
 
 
-Watchdog::Watchdog(std::shared_ptr<EventManager> eventManager) {
+Watchdog::Watchdog(std::shared_ptr<EventManager> eventManager)
+    : detector(FailureDetector::Config{WD_TIMEOUT_MILLIS, WD_PHI_THRESHOLD, WD_PHI_MIN_SAMPLES,
+                                       WD_PHI_MIN_STDDEV_MILLIS, WD_SEND_INTERVAL_MILLIS},
+               std::bind(&Watchdog::heartbeatsMissing, this)),
+      arrivalInterval(
+          MetricsRegistry::getInstance().histogram("esep_watchdog_heartbeat_interval_ms")) {
     this->eventManager = eventManager;
-    this->isMaster = Configuration::getInstance().systemIsMaster();
-    heartBeatreceived = 0;
-
-    if (!connect(eventManager)) {
-        throw std::runtime_error("[Watchdog] Error while connecting to EventManager");
-    }
+    sendingRunning = false;
 
-    if (isMaster) {
-        Logger::debug("Watchdog Subscribe to Slave Heartbeat");
-        eventManager->subscribe(EventType::WD_S_HEARTBEAT, std::bind(&Watchdog::handleEvent, this, std::placeholders::_1));
-    } else {
-        Logger::debug("Watchdog Subscribe to Master Heartbeat");
-        eventManager->subscribe(EventType::WD_M_HEARTBEAT, std::bind(&Watchdog::handleEvent, this, std::placeholders::_1));
-    }
+    // Heartbeats and all other events of the partner re-arm the deadline,
+    // the partner sends a heartbeat after WD_SEND_INTERVAL_MILLIS without events
+    eventManager->getLiveness().setListener(
+        std::bind(&Watchdog::partnerAlive, this, std::placeholders::_1));
+    eventManager->subscribe(EventType::WD_CONN_REESTABLISHED, std::bind(&Watchdog::handleEvent, this, std::placeholders::_1));
 }
 
 Watchdog::~Watchdog() {
+    eventManager->getLiveness().setListener(nullptr);
     stop();
-    disconnect();
 }
 
 void Watchdog::handleEvent(Event event) {
+    // Heartbeats are not subscribed, the EventManager reports all partner
+    // traffic to the failure detector (see LivenessTracker)
     switch (event.type) {
-    case WD_M_HEARTBEAT:
-    case WD_S_HEARTBEAT:
-        heartbeatReceived();
+    case WD_CONN_REESTABLISHED:
+        Logger::debug("[WD] Connection reestablished, receiving heartbeats...");
+        detector.start();
         break;
     default:
         break;
     }
 }
 
+void Watchdog::partnerAlive(bool heartbeat) {
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      Clock::getInstance().now().time_since_epoch()).count();
+    int64_t last = lastArrivalMs.exchange(now);
+    if (last >= 0 && now >= last) {
+        arrivalInterval.record(now - last);
+    }
+    if (heartbeat) {
+        detector.heartbeat();
+    } else {
+        detector.alive();
+    }
+}
+
 void Watchdog::start() {
-	th_send = std::thread(&Watchdog::sendingThread, this);
-	std::this_thread::sleep_for(std::chrono::milliseconds(200));
-    th_receive = std::thread(&Watchdog::receivingThread, this);
+	th_send = ThreadRegistry::getInstance().spawn("wd-send", &Watchdog::sendingThread, this);
+    // No delay: started after the link is up, the first heartbeat of the
+    // partner is due within WD_SEND_INTERVAL_MILLIS
+    Logger::debug("[WD] Started receiving heartbeats...");
+    detector.start();
+    Startup::getInstance().ready("watchdog");
 }
 
 void Watchdog::stop() {
-    receivingRunning = false;
-    if (th_receive.joinable()) {
-        th_receive.join();
-    }
+    detector.stop();
     sendingRunning = false;
     if (th_send.joinable()) {
         th_send.join();
@@ -67,35 +83,39 @@ void Watchdog::stop() {
 
 void Watchdog::sendingThread() {
     Logger::debug("[WD] Started sending heartbeats...");
+    LivenessTracker &liveness = eventManager->getLiveness();
     sendingRunning = true;
     while (sendingRunning) {
-        sendHeartbeat();
-        std::this_thread::sleep_for(std::chrono::milliseconds(WD_SEND_INTERVAL_MILLIS));
+        Clock::getInstance().sleepFor(liveness.nextHeartbeatMs());
+        if (liveness.heartbeatDue()) {
+            sendHeartbeat();
+        }
     }
     sendingRunning = false;
-    Logger::debug("[WD] Stopped sending heartbeats");
+    Logger::debug("[WD] Stopped sending heartbeats: " + std::to_string(liveness.getHeartbeats())
+                  + " sent, " + std::to_string(liveness.getSuppressed()) + " suppressed");
 }
 
 void Watchdog::sendHeartbeat() {
-    if (isMaster) {
-        sendEvent(Event{WD_M_HEARTBEAT});
-    } else if(!isMaster) {
-        sendEvent(Event{WD_S_HEARTBEAT});
-    }
+    // Directly to the partner, heartbeats do not pass the dispatchers
+    eventManager->sendHeartbeat();
 }
 
-void Watchdog::receivingThread() {
-    using namespace std::chrono;
-    Logger::debug("[WD] Started receiving heartbeats...");
-    receivingRunning = true;
-    while (heartBeatreceived < WD_TIMEOUT_MILLIS) {
-    	std::this_thread::sleep_for(std::chrono::milliseconds(WD_SEND_INTERVAL_MILLIS));
-    	heartBeatreceived += 100;
-    }
+HeartbeatStatistics Watchdog::heartbeatStatistics() {
+    return detector.statistics();
+}
 
-    sendingRunning = false;
-    receivingRunning = false;
-    Logger::debug("[WD] Stopped receiving heartbeats");
+// Called by the timer of the failure detector, the deadline after the last
+// heartbeat has expired
+void Watchdog::heartbeatsMissing() {
+    HeartbeatStatistics stats = detector.statistics();
+    // Heartbeats are still sent, they are dropped until the EventManager has
+    // reconnected
+    Logger::debug("[WD] Stopped receiving heartbeats after " + std::to_string(stats.count)
+                  + " heartbeats, interval mean " + std::to_string((int) stats.meanMs)
+                  + " ms, stddev " + std::to_string((int) stats.stdDevMs) + " ms, max "
+                  + std::to_string(stats.maxMs) + " ms, " + std::to_string(eventManager->getLiveness().getReceived())
+                  + " messages received");
     eventManager->handleEvent(Event{WD_CONN_LOST});
     eventManager->handleEvent(Event{MODE_ERROR});
 
@@ -105,9 +125,3 @@ void Watchdog::receivingThread() {
     eventManager->handleEvent(Event{ERROR_S_SELF_SOLVABLE});
 
 }
-
-void Watchdog::heartbeatReceived() {
-
-    heartBeatreceived = 0;
-
-}
@@ -7,37 +7,45 @@
 #pragma once
 
 #include "events/EventManager.h"
-#include "events/EventSender.h"
 #include "events/IEventHandler.h"
+#include "FailureDetector.h"
+#include "metrics/Metrics.h"
+#include <atomic>
 #include <memory>
 #include <thread>
 
 
+// Idle gap after which a heartbeat is sent, any other event sent to the
+// partner replaces it
 #define WD_SEND_INTERVAL_MILLIS 200
-#define WD_CHECK_INTERVAL 100
 #define WD_TIMEOUT_MILLIS       440
+// Phi accrual threshold of the failure detector, 0: fixed WD_TIMEOUT_MILLIS
+#define WD_PHI_THRESHOLD        8.0
+// Heartbeat intervals before the phi threshold is used
+#define WD_PHI_MIN_SAMPLES      10
+// Lower bound of the expected heartbeat jitter
+#define WD_PHI_MIN_STDDEV_MILLIS 50.0
 
 
-class Watchdog : public IEventHandler, public EventSender {
+class Watchdog : public IEventHandler {
   public:
     Watchdog(std::shared_ptr<EventManager> eventManager);
     virtual ~Watchdog();
     void handleEvent(Event event) override;
     void sendingThread();
-    void receivingThread();
     void start();
     void stop();
+    HeartbeatStatistics heartbeatStatistics();
 
   private:
     std::shared_ptr<EventManager> eventManager;
-    bool isMaster;
     bool connectionLost{false};
-    std::atomic<int> heartBeatreceived;
-    std::thread th_receive;
+    FailureDetector detector;
     std::thread th_send;
     std::atomic<bool> sendingRunning;
-    std::atomic<bool> receivingRunning;
-    std::chrono::steady_clock::time_point lastReceiveTime;
-    void heartbeatReceived();
+    Histogram &arrivalInterval;             // between messages of the partner
+    std::atomic<int64_t> lastArrivalMs{-1};   // since epoch of the Clock
+    void partnerAlive(bool heartbeat);
+    void heartbeatsMissing();
     void sendHeartbeat();
 };